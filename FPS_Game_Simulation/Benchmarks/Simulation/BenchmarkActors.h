@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+namespace BenchmarkActors
+{
+template <int32_t Bytes>
+struct LeadingPadding
+{
+	char LeadingData[Bytes] = {};
+};
+
+template <>
+struct LeadingPadding<0>
+{
+};
+
+template <int32_t Bytes>
+struct TrailingPadding
+{
+	char TrailingData[Bytes] = {};
+};
+
+template <>
+struct TrailingPadding<0>
+{
+};
+}	 // namespace BenchmarkActors
+
+/**
+ * \brief Stand-in for the engine actor a benchmark's baseline works on: Payload holds the fields the baseline touches,
+ * LeadingBytes and TrailingBytes of the actor's other data (components, the rest of AActor) sit around them. Allocate
+ * each instance on its own, as SpawnActor does, so walking many of them misses the cache the way actors do.
+ */
+template <typename Payload, int32_t LeadingBytes, int32_t TrailingBytes>
+struct TPaddedActor : BenchmarkActors::LeadingPadding<LeadingBytes>,
+					  Payload,
+					  BenchmarkActors::TrailingPadding<TrailingBytes>
+{
+};
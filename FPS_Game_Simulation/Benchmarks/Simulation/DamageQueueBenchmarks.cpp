@@ -0,0 +1,219 @@
+#include "BenchmarkActors.h"
+#include "Simulation/DamageQueueCore.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr int32_t NumEnemies = 10000;
+constexpr int32_t NumPlayers = 4;
+constexpr float EnemyHealth = 100.f;
+constexpr float ShotDamage = 20.f;
+constexpr int32_t MaxLevel = 10;
+
+struct EnemyHealthState
+{
+	float Health = EnemyHealth;
+	int32_t Lives = 0;
+
+	// Respawns in place, as a pooled enemy would
+	void Kill()
+	{
+		Health = EnemyHealth;
+		++Lives;
+	}
+};
+
+// Stand-in for an enemy actor, health among the rest of its data
+using EnemyActor = TPaddedActor<EnemyHealthState, 256, 256>;
+
+/**
+ * \brief Stand-in for a player's XP and level bookkeeping.
+ */
+struct PlayerActor
+{
+	int32_t ExperiencePoints = 0;
+	int32_t KillScore = 0;
+	int32_t Level = 0;
+	int32_t LevelBounds[MaxLevel] = {};
+
+	PlayerActor()
+	{
+		int32_t NeededXP = 100;
+		for (int32_t I = 0; I < MaxLevel; ++I)
+		{
+			LevelBounds[I] = NeededXP;
+			NeededXP *= 2;
+		}
+	}
+
+	void GainKillRewards(int32_t Kills)
+	{
+		ExperiencePoints += 75 * Kills;
+		KillScore += Kills;
+		for (int32_t I = Level; I < MaxLevel; ++I)
+		{
+			if (ExperiencePoints >= LevelBounds[I])
+			{
+				Level = I + 1;
+			}
+		}
+	}
+};
+
+struct DamageEvent
+{
+	int32_t Enemy;
+	uint32_t Shot;
+	int32_t Player;
+};
+
+/**
+ * \brief [NumEnemies] enemies and [NumPlayers] players, and the [Count] damage events of a frame: shots from random
+ * players pierce through 1 to 4 random enemies, one in ten enemies is reported twice by its shot.
+ */
+struct DamageWorld
+{
+	std::vector<std::unique_ptr<EnemyActor>> Enemies;
+	PlayerActor Players[NumPlayers];
+	std::vector<DamageEvent> Events;
+
+	explicit DamageWorld(int32_t Count)
+	{
+		for (int32_t I = 0; I < NumEnemies; ++I)
+		{
+			Enemies.push_back(std::make_unique<EnemyActor>());
+		}
+
+		std::mt19937 Random(11);
+		std::uniform_int_distribution<int32_t> PickEnemy(0, NumEnemies - 1);
+		std::uniform_int_distribution<int32_t> PickPlayer(0, NumPlayers - 1);
+		std::uniform_int_distribution<int32_t> Pierce(1, 4);
+		std::uniform_int_distribution<int32_t> Percent(0, 99);
+		for (uint32_t Shot = 1; static_cast<int32_t>(Events.size()) < Count; ++Shot)
+		{
+			const int32_t Player = PickPlayer(Random);
+			for (int32_t Hit = Pierce(Random); Hit > 0 && static_cast<int32_t>(Events.size()) < Count; --Hit)
+			{
+				const int32_t Enemy = PickEnemy(Random);
+				Events.push_back({Enemy, Shot, Player});
+				if (Percent(Random) < 10 && static_cast<int32_t>(Events.size()) < Count)
+				{
+					Events.push_back({Enemy, Shot, Player});
+				}
+			}
+		}
+	}
+
+	int64_t TotalKills() const
+	{
+		int64_t Kills = 0;
+		for (const PlayerActor& Player : Players)
+		{
+			Kills += Player.KillScore;
+		}
+		return Kills;
+	}
+};
+}	 // namespace
+
+/**
+ * \brief Baseline: [range(0)] damage events applied one by one as they happen, each kill rewarding its player at once.
+ * Duplicate reports of a shot damage twice.
+ */
+static void BM_Damage_Immediate(benchmark::State& state)
+{
+	DamageWorld World(static_cast<int32_t>(state.range(0)));
+
+	for (auto _ : state)
+	{
+		for (const DamageEvent& Event : World.Events)
+		{
+			EnemyActor& Enemy = *World.Enemies[Event.Enemy];
+			Enemy.Health -= ShotDamage;
+			if (Enemy.Health <= 0.f)
+			{
+				World.Players[Event.Player].GainKillRewards(1);
+				Enemy.Kill();
+			}
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(World.Events.size()));
+	state.counters["KillsPerFrame"] = static_cast<double>(World.TotalKills()) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_Damage_Immediate)->Arg(100000);
+
+/**
+ * \brief The same events queued in FDamageQueueCore and applied once per frame: one hit per damaged enemy, duplicates
+ * dropped, each player rewarded once for the frame's kills.
+ */
+static void BM_Damage_Queued(benchmark::State& state)
+{
+	DamageWorld World(static_cast<int32_t>(state.range(0)));
+	FDamageQueueCore Queue;
+	Queue.Reserve(NumEnemies + NumPlayers);
+
+	// Players are targets too, their ids are the instigators
+	std::vector<FSimAgentId> EnemyTarget;
+	std::vector<int32_t> EnemyOfTarget(NumEnemies + NumPlayers, -1);
+	std::vector<int32_t> PlayerOfTarget(NumEnemies + NumPlayers, -1);
+	for (int32_t I = 0; I < NumEnemies; ++I)
+	{
+		EnemyTarget.push_back(Queue.AddTarget());
+		EnemyOfTarget[EnemyTarget.back()] = I;
+	}
+	std::vector<FSimAgentId> PlayerTarget;
+	for (int32_t I = 0; I < NumPlayers; ++I)
+	{
+		PlayerTarget.push_back(Queue.AddTarget());
+		PlayerOfTarget[PlayerTarget.back()] = I;
+	}
+
+	int64_t Hits = 0;
+	int64_t Duplicates = 0;
+	for (auto _ : state)
+	{
+		for (const DamageEvent& Event : World.Events)
+		{
+			Queue.Push(EnemyTarget[Event.Enemy], ShotDamage, Event.Shot, PlayerTarget[Event.Player]);
+		}
+
+		const int32_t NumHits = Queue.Resolve();
+		float* Health = Queue.GetHitHealth();
+		for (int32_t Hit = 0; Hit < NumHits; ++Hit)
+		{
+			Health[Hit] = World.Enemies[EnemyOfTarget[Queue.HitTargetAt(Hit)]]->Health;
+		}
+		Queue.ApplyHits();
+		for (int32_t Hit = 0; Hit < NumHits; ++Hit)
+		{
+			World.Enemies[EnemyOfTarget[Queue.HitTargetAt(Hit)]]->Health = Health[Hit];
+		}
+
+		int32_t KillsByPlayer[NumPlayers] = {};
+		for (int32_t Hit : Queue.GetKills())
+		{
+			World.Enemies[EnemyOfTarget[Queue.HitTargetAt(Hit)]]->Kill();
+			++KillsByPlayer[PlayerOfTarget[Queue.HitInstigatorAt(Hit)]];
+		}
+		for (int32_t Player = 0; Player < NumPlayers; ++Player)
+		{
+			World.Players[Player].GainKillRewards(KillsByPlayer[Player]);
+		}
+
+		Hits += NumHits;
+		Duplicates += Queue.GetStats().NumDuplicates;
+	}
+
+	const double Frames = static_cast<double>(state.iterations());
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(World.Events.size()));
+	state.counters["HitsPerFrame"] = static_cast<double>(Hits) / Frames;
+	state.counters["DuplicatesPerFrame"] = static_cast<double>(Duplicates) / Frames;
+	state.counters["KillsPerFrame"] = static_cast<double>(World.TotalKills()) / Frames;
+}
+BENCHMARK(BM_Damage_Queued)->Arg(100000);
@@ -0,0 +1,280 @@
+#include "Simulation/EffectCore.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr int32_t NumOwners = 10000;
+constexpr int32_t NumStats = 4;
+constexpr int32_t NumSpecs = 16;
+constexpr float FrameTime = 1.f / 60.f;
+
+/**
+ * \brief [NumSpecs] effects with durations of 1 to 30 seconds, on all stats and with every modifier, half of them
+ * refreshed by applying them again and half stacking. Owners get [Count] / [NumOwners] different specs each, so [Count]
+ * effects are active at once, and the refreshing ones are listed for restarting them while they run.
+ */
+struct EffectWorld
+{
+	std::vector<FEffectSpec> Specs;
+	// Owner and spec of each application
+	std::vector<FExpiredEffect> Applications;
+	std::vector<FExpiredEffect> Refreshable;
+
+	explicit EffectWorld(int32_t Count)
+	{
+		std::mt19937 Random(5);
+		std::uniform_real_distribution<float> Duration(1.f, 30.f);
+		for (int32_t Spec = 0; Spec < NumSpecs; ++Spec)
+		{
+			FEffectSpec EffectSpec;
+			EffectSpec.Stat = Spec % NumStats;
+			EffectSpec.Modifier = static_cast<EEffectModifier>(Spec % 3);
+			EffectSpec.Magnitude = EffectSpec.Modifier == EEffectModifier::Multiply ? 1.1f : 10.f;
+			EffectSpec.Duration = Duration(Random);
+			EffectSpec.Stacking = Spec % 2 == 0 ? EEffectStacking::Refresh : EEffectStacking::Stack;
+			EffectSpec.MaxStacks = NumSpecs;
+			Specs.push_back(EffectSpec);
+		}
+
+		std::vector<int32_t> OwnerSpecs(NumSpecs);
+		for (int32_t Owner = 0; Owner < NumOwners; ++Owner)
+		{
+			for (int32_t Spec = 0; Spec < NumSpecs; ++Spec)
+			{
+				OwnerSpecs[Spec] = Spec;
+			}
+			std::shuffle(OwnerSpecs.begin(), OwnerSpecs.end(), Random);
+			for (int32_t I = 0; I < Count / NumOwners; ++I)
+			{
+				Applications.push_back({Owner, OwnerSpecs[I]});
+				if (Specs[OwnerSpecs[I]].Stacking == EEffectStacking::Refresh)
+				{
+					Refreshable.push_back({Owner, OwnerSpecs[I]});
+				}
+			}
+		}
+		std::shuffle(Refreshable.begin(), Refreshable.end(), Random);
+	}
+};
+
+/**
+ * \brief The way talents were timed before: every effect arms a timer of its own in a queue ordered by time, like
+ * FTimerManager's heap, and its reset handler computes the owner's stats again at once. A heap entry can't be moved,
+ * restarting an effect pushes a new timer and leaves the old one to be skipped when it comes up.
+ */
+struct TimerHeapEffects
+{
+	struct ActiveEffect
+	{
+		int32_t Spec;
+		int32_t Timer;
+	};
+
+	struct Timer
+	{
+		float Time;
+		int32_t Owner;
+		int32_t Id;
+
+		bool operator>(const Timer& Other) const { return Time > Other.Time; }
+	};
+
+	const std::vector<FEffectSpec>& Specs;
+	std::vector<std::vector<ActiveEffect>> Effects;
+	std::vector<float> BaseStats;
+	std::vector<float> Stats;
+	std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> Timers;
+	float Now = 0.f;
+	int32_t NextTimer = 0;
+
+	explicit TimerHeapEffects(const std::vector<FEffectSpec>& InSpecs)
+		: Specs(InSpecs)
+		, Effects(NumOwners)
+		, BaseStats(NumOwners * NumStats, 100.f)
+		, Stats(NumOwners * NumStats, 100.f)
+	{
+	}
+
+	void Apply(int32_t Owner, int32_t Spec)
+	{
+		const int32_t Id = NextTimer++;
+		Timers.push({Now + Specs[Spec].Duration, Owner, Id});
+
+		if (Specs[Spec].Stacking == EEffectStacking::Refresh)
+		{
+			for (ActiveEffect& Effect : Effects[Owner])
+			{
+				if (Effect.Spec == Spec)
+				{
+					Effect.Timer = Id;
+					return;
+				}
+			}
+		}
+
+		Effects[Owner].push_back({Spec, Id});
+		Recompute(Owner);
+	}
+
+	// Appends the owner and spec of each effect that ran out
+	void Advance(float DeltaTime, std::vector<FExpiredEffect>& Expired)
+	{
+		Now += DeltaTime;
+		while (!Timers.empty() && Timers.top().Time <= Now)
+		{
+			const Timer Due = Timers.top();
+			Timers.pop();
+
+			std::vector<ActiveEffect>& OwnerEffects = Effects[Due.Owner];
+			for (size_t I = 0; I < OwnerEffects.size(); ++I)
+			{
+				if (OwnerEffects[I].Timer == Due.Id)
+				{
+					Expired.push_back({Due.Owner, OwnerEffects[I].Spec});
+					OwnerEffects.erase(OwnerEffects.begin() + I);
+					Recompute(Due.Owner);
+					break;
+				}
+			}
+		}
+	}
+
+	void Recompute(int32_t Owner)
+	{
+		float Sum[NumStats] = {};
+		float Product[NumStats] = {1.f, 1.f, 1.f, 1.f};
+		float Override[NumStats] = {};
+		bool bOverridden[NumStats] = {};
+		for (const ActiveEffect& Effect : Effects[Owner])
+		{
+			const FEffectSpec& Spec = Specs[Effect.Spec];
+			switch (Spec.Modifier)
+			{
+			case EEffectModifier::Add:
+				Sum[Spec.Stat] += Spec.Magnitude;
+				break;
+			case EEffectModifier::Multiply:
+				Product[Spec.Stat] *= Spec.Magnitude;
+				break;
+			case EEffectModifier::Override:
+				Override[Spec.Stat] = Spec.Magnitude;
+				bOverridden[Spec.Stat] = true;
+				break;
+			}
+		}
+
+		for (int32_t Stat = 0; Stat < NumStats; ++Stat)
+		{
+			const float Base = BaseStats[Owner * NumStats + Stat];
+			Stats[Owner * NumStats + Stat] = bOverridden[Stat] ? Override[Stat] : (Base + Sum[Stat]) * Product[Stat];
+		}
+	}
+};
+}	 // namespace
+
+/**
+ * \brief Baseline: [range(0)] active effects on [NumOwners] owners, each with a timer of its own. A frame advances
+ * the timers by 1/60 s, applies an effect again for every one that ran out, so the count stays the same, and restarts
+ * [range(1)] running effects the way a player keeps using a talent.
+ */
+static void BM_Effects_TimerHeap(benchmark::State& state)
+{
+	const int32_t NumRefreshes = static_cast<int32_t>(state.range(1));
+	EffectWorld World(static_cast<int32_t>(state.range(0)));
+	TimerHeapEffects Effects(World.Specs);
+	for (const FExpiredEffect& Application : World.Applications)
+	{
+		Effects.Apply(Application.Owner, Application.Spec);
+	}
+
+	std::vector<FExpiredEffect> Expired;
+	int64_t NumExpired = 0;
+	size_t NextRefresh = 0;
+	for (auto _ : state)
+	{
+		Expired.clear();
+		Effects.Advance(FrameTime, Expired);
+		for (const FExpiredEffect& Effect : Expired)
+		{
+			Effects.Apply(Effect.Owner, Effect.Spec);
+		}
+		for (int32_t I = 0; I < NumRefreshes; ++I)
+		{
+			const FExpiredEffect& Refresh = World.Refreshable[NextRefresh];
+			NextRefresh = (NextRefresh + 1) % World.Refreshable.size();
+			Effects.Apply(Refresh.Owner, Refresh.Spec);
+		}
+		NumExpired += static_cast<int64_t>(Expired.size());
+		benchmark::DoNotOptimize(Effects.Stats.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(World.Applications.size()));
+	state.counters["ExpiredPerFrame"] = static_cast<double>(NumExpired) / static_cast<double>(state.iterations());
+	state.counters["Timers"] = static_cast<double>(Effects.Timers.size());
+}
+BENCHMARK(BM_Effects_TimerHeap)->Args({100000, 0})->Args({100000, 1000});
+
+/**
+ * \brief The same effects in FEffectCore: expiry by the timing wheel, restarting moves the effect's timer, stats
+ * computed once per changed owner and frame.
+ */
+static void BM_Effects_TimingWheel(benchmark::State& state)
+{
+	const int32_t NumRefreshes = static_cast<int32_t>(state.range(1));
+	EffectWorld World(static_cast<int32_t>(state.range(0)));
+
+	FEffectConfig Config;
+	Config.NumStats = NumStats;
+	Config.EffectsPerOwner = NumSpecs;
+	FEffectCore Effects(Config);
+	for (const FEffectSpec& Spec : World.Specs)
+	{
+		Effects.AddSpec(Spec);
+	}
+
+	Effects.Reserve(NumOwners);
+	const float BaseStats[NumStats] = {100.f, 100.f, 100.f, 100.f};
+	for (int32_t Owner = 0; Owner < NumOwners; ++Owner)
+	{
+		Effects.AddOwner(BaseStats);
+	}
+	for (const FExpiredEffect& Application : World.Applications)
+	{
+		Effects.Apply(Application.Owner, Application.Spec);
+	}
+	Effects.Update(0.f);
+
+	int64_t NumExpired = 0;
+	int64_t NumRecomputed = 0;
+	size_t NextRefresh = 0;
+	for (auto _ : state)
+	{
+		Effects.Update(FrameTime);
+		for (const FExpiredEffect& Effect : Effects.GetExpired())
+		{
+			Effects.Apply(Effect.Owner, Effect.Spec);
+		}
+		for (int32_t I = 0; I < NumRefreshes; ++I)
+		{
+			const FExpiredEffect& Refresh = World.Refreshable[NextRefresh];
+			NextRefresh = (NextRefresh + 1) % World.Refreshable.size();
+			Effects.Apply(Refresh.Owner, Refresh.Spec);
+		}
+		NumExpired += Effects.GetStats().NumExpired;
+		NumRecomputed += Effects.GetStats().NumRecomputed;
+	}
+
+	const double Frames = static_cast<double>(state.iterations());
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(World.Applications.size()));
+	state.counters["Active"] = Effects.GetStats().NumActive;
+	state.counters["ExpiredPerFrame"] = static_cast<double>(NumExpired) / Frames;
+	state.counters["RecomputedPerFrame"] = static_cast<double>(NumRecomputed) / Frames;
+}
+BENCHMARK(BM_Effects_TimingWheel)->Args({100000, 0})->Args({100000, 1000});
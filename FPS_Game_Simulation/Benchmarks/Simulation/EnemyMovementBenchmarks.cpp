@@ -0,0 +1,195 @@
+#include "BenchmarkActors.h"
+#include "Simulation/EnemyMovementCore.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr float DeltaTime = 1.f / 60.f;
+constexpr float MovementSpeed = 500.f;
+
+// What AEnemy::Tick touches
+struct MovementState
+{
+	FSimVector Location;
+	FSimVector BaseLocation;
+	FSimVector CurrentVelocity;
+	FSimVector NewLocation;
+	bool bBackToBaseLocation = false;
+	float DistanceSquared = std::numeric_limits<float>::max();
+};
+
+/**
+ * \brief Stand-in for AEnemy before the movement core, among a character's and its movement component's data and
+ * ticked through a virtual call.
+ */
+struct TickedActor : TPaddedActor<MovementState, 512, 512>
+{
+	virtual ~TickedActor() = default;
+
+	virtual void Tick(float Delta)
+	{
+		if (!CurrentVelocity.IsZero())
+		{
+			NewLocation = Location + CurrentVelocity * Delta;
+
+			if (bBackToBaseLocation)
+			{
+				if ((NewLocation - BaseLocation).SizeSquared2D() < DistanceSquared)
+				{
+					DistanceSquared = (NewLocation - BaseLocation).SizeSquared2D();
+				}
+				else
+				{
+					CurrentVelocity = FSimVector();
+					DistanceSquared = std::numeric_limits<float>::max();
+					bBackToBaseLocation = false;
+				}
+			}
+
+			Location = NewLocation;
+		}
+	}
+};
+
+/**
+ * \brief Half of the agents chase, a quarter heads back to base and a quarter stands still.
+ */
+struct Scenario
+{
+	struct Agent
+	{
+		FSimVector Location;
+		FSimVector Base;
+		FSimVector Velocity;
+		bool bReturning;
+	};
+
+	std::vector<Agent> Agents;
+
+	explicit Scenario(int32_t Count)
+	{
+		std::mt19937 Random(42);
+		std::uniform_real_distribution<float> Coordinate(-50000.f, 50000.f);
+		std::uniform_real_distribution<float> Direction(-1.f, 1.f);
+		for (int32_t I = 0; I < Count; ++I)
+		{
+			Agent Next;
+			Next.Base = FSimVector(Coordinate(Random), Coordinate(Random), 90.f);
+			Next.Location = Next.Base + FSimVector(Coordinate(Random) / 50.f, Coordinate(Random) / 50.f, 0.f);
+			Next.bReturning = I % 4 == 1;
+			if (I % 4 == 0 || I % 4 == 2)
+			{
+				Next.Velocity = FSimVector(Direction(Random), Direction(Random), 0.f) * MovementSpeed;
+			}
+			else if (Next.bReturning)
+			{
+				const FSimVector ToBase = Next.Base - Next.Location;
+				Next.Velocity = ToBase * (MovementSpeed / std::sqrt(ToBase.SizeSquared2D()));
+			}
+			Agents.push_back(Next);
+		}
+	}
+};
+}	 // namespace
+
+/**
+ * \brief One frame of enemy movement the way AEnemy::Tick did it, one virtual call per scattered actor.
+ */
+static void BM_EnemyMovement_ActorTick(benchmark::State& state)
+{
+	const Scenario Setup(static_cast<int32_t>(state.range(0)));
+
+	std::vector<std::unique_ptr<TickedActor>> Actors;
+	for (const Scenario::Agent& Agent : Setup.Agents)
+	{
+		auto Actor = std::make_unique<TickedActor>();
+		Actor->Location = Agent.Location;
+		Actor->BaseLocation = Agent.Base;
+		Actor->CurrentVelocity = Agent.Velocity;
+		Actor->bBackToBaseLocation = Agent.bReturning;
+		Actors.push_back(std::move(Actor));
+	}
+	// Spawn order isn't tick order once enemies die and respawn
+	std::shuffle(Actors.begin(), Actors.end(), std::mt19937(7));
+
+	for (auto _ : state)
+	{
+		for (const auto& Actor : Actors)
+		{
+			Actor->Tick(DeltaTime);
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EnemyMovement_ActorTick)->Arg(1000)->Arg(10000)->Arg(100000);
+
+/**
+ * \brief One frame of enemy movement through FEnemyMovementCore::Step.
+ */
+static void BM_EnemyMovement_CoreStep(benchmark::State& state)
+{
+	const Scenario Setup(static_cast<int32_t>(state.range(0)));
+
+	FEnemyMovementCore Core;
+	Core.Reserve(static_cast<int32_t>(Setup.Agents.size()));
+	for (const Scenario::Agent& Agent : Setup.Agents)
+	{
+		const FSimAgentId Id = Core.Add(Agent.Location, Agent.Base, MovementSpeed);
+		if (Agent.bReturning)
+		{
+			Core.ReturnToBase(Id, Agent.Location);
+		}
+		else
+		{
+			Core.Move(Id, Agent.Location, Agent.Velocity);
+		}
+	}
+
+	for (auto _ : state)
+	{
+		Core.Step(DeltaTime);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EnemyMovement_CoreStep)->Arg(1000)->Arg(10000)->Arg(100000);
+
+/**
+ * \brief Step plus the pass UEnemyMovementSubsystem makes over the results to find the actors to sync.
+ */
+static void BM_EnemyMovement_CoreStepAndSync(benchmark::State& state)
+{
+	const Scenario Setup(static_cast<int32_t>(state.range(0)));
+
+	FEnemyMovementCore Core;
+	std::vector<FSimVector> Synced(Setup.Agents.size());
+	for (const Scenario::Agent& Agent : Setup.Agents)
+	{
+		const FSimAgentId Id = Core.Add(Agent.Location, Agent.Base, MovementSpeed);
+		Core.Move(Id, Agent.Location, Agent.Velocity);
+	}
+
+	for (auto _ : state)
+	{
+		Core.Step(DeltaTime);
+		for (int32_t I = 0; I < Core.Num(); ++I)
+		{
+			if (Core.FlagsAt(I) & FEnemyMovementCore::Moved)
+			{
+				Synced[Core.AgentAt(I)] = Core.LocationAt(I);
+			}
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EnemyMovement_CoreStepAndSync)->Arg(1000)->Arg(10000)->Arg(100000);
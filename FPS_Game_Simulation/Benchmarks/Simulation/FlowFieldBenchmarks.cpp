@@ -0,0 +1,174 @@
+#include "Simulation/FlowFieldCore.h"
+#include "Simulation/SimParallel.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr int32_t NumAgents = 10000;
+constexpr int32_t NumObstacles = 600;
+
+FFlowFieldConfig MakeConfig(float MaxPathLength)
+{
+	FFlowFieldConfig Config;
+	Config.MaxPathLength = MaxPathLength;
+	return Config;
+}
+
+/**
+ * \brief The default 512x512 grid with [NumObstacles] random boxes of up to 8x8 cells, [NumAgents] agents spread
+ * over it and [NumTargets] players. Paths are at most [MaxPathLength] long, 0 for the whole grid.
+ */
+struct FlowWorld
+{
+	FFlowFieldCore FlowField;
+	std::vector<FSimVector> Targets;
+	std::vector<float> AgentX;
+	std::vector<float> AgentY;
+
+	explicit FlowWorld(int32_t NumTargets, float MaxPathLength = 0.f)
+		: FlowField(MakeConfig(MaxPathLength))
+	{
+		const FFlowFieldConfig& Config = FlowField.GetConfig();
+		const float Extent = Config.Width * Config.CellSize;
+
+		std::mt19937 Random(42);
+		std::uniform_real_distribution<float> Coordinate(0.f, Extent);
+		std::uniform_real_distribution<float> Size(Config.CellSize, 8.f * Config.CellSize);
+		for (int32_t I = 0; I < NumObstacles; ++I)
+		{
+			const float MinX = Config.OriginX + Coordinate(Random);
+			const float MinY = Config.OriginY + Coordinate(Random);
+			FlowField.BlockBox(MinX, MinY, MinX + Size(Random), MinY + Size(Random));
+		}
+
+		for (int32_t I = 0; I < NumTargets; ++I)
+		{
+			Targets.emplace_back(Config.OriginX + Coordinate(Random), Config.OriginY + Coordinate(Random), 90.f);
+		}
+		for (int32_t I = 0; I < NumAgents; ++I)
+		{
+			AgentX.push_back(Config.OriginX + Coordinate(Random));
+			AgentY.push_back(Config.OriginY + Coordinate(Random));
+		}
+	}
+
+	// Moves every target into the next cell so each Update recomputes all fields
+	void MoveTargets()
+	{
+		const FFlowFieldConfig& Config = FlowField.GetConfig();
+		for (FSimVector& Target : Targets)
+		{
+			Target.X += Config.CellSize;
+			if (Target.X >= Config.OriginX + Config.Width * Config.CellSize)
+			{
+				Target.X -= Config.Width * Config.CellSize;
+			}
+		}
+	}
+};
+}	 // namespace
+
+/**
+ * \brief Every one of [range(0)] targets moves to another cell each frame, all fields are recomputed on this thread.
+ * [range(1)] is the longest path, 0 for the whole grid and 6000 for the 4 sight radii the game uses.
+ */
+static void BM_FlowField_Recompute_Serial(benchmark::State& state)
+{
+	FlowWorld World(static_cast<int32_t>(state.range(0)), static_cast<float>(state.range(1)));
+
+	for (auto _ : state)
+	{
+		World.MoveTargets();
+		World.FlowField.Update(World.Targets);
+	}
+	state.counters["FieldsPerFrame"] = static_cast<double>(World.FlowField.GetNumRecomputed()) / state.iterations();
+}
+BENCHMARK(BM_FlowField_Recompute_Serial)->Args({1, 0})->Args({4, 0})->Args({1, 6000})->Args({4, 6000})->Unit(benchmark::kMillisecond);
+
+/**
+ * \brief The same, the fields integrated on an FSimThreadPool.
+ */
+static void BM_FlowField_Recompute_Parallel(benchmark::State& state)
+{
+	FlowWorld World(static_cast<int32_t>(state.range(0)), static_cast<float>(state.range(1)));
+	FSimThreadPool Pool;
+	const FSimParallelFor ParallelFor = Pool.AsParallelFor();
+
+	for (auto _ : state)
+	{
+		World.MoveTargets();
+		World.FlowField.Update(World.Targets, ParallelFor);
+	}
+	state.counters["FieldsPerFrame"] = static_cast<double>(World.FlowField.GetNumRecomputed()) / state.iterations();
+	state.counters["Threads"] = Pool.NumWorkers() + 1;
+}
+BENCHMARK(BM_FlowField_Recompute_Parallel)->Args({4, 0})->Args({4, 6000})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+/**
+ * \brief [range(0)] targets that stay in their cells, the frames most updates see: nothing is recomputed.
+ */
+static void BM_FlowField_Update_TargetsInPlace(benchmark::State& state)
+{
+	FlowWorld World(static_cast<int32_t>(state.range(0)));
+	World.FlowField.Update(World.Targets);
+
+	for (auto _ : state)
+	{
+		World.FlowField.Update(World.Targets);
+	}
+	state.counters["Recomputed"] = static_cast<double>(World.FlowField.GetNumRecomputed() - state.range(0));
+}
+BENCHMARK(BM_FlowField_Update_TargetsInPlace)->Arg(4);
+
+/**
+ * \brief [NumAgents] agents each looking up their direction to one of [range(0)] targets.
+ */
+static void BM_FlowField_SampleAgents(benchmark::State& state)
+{
+	FlowWorld World(static_cast<int32_t>(state.range(0)));
+	World.FlowField.Update(World.Targets);
+	const int32_t NumTargets = World.FlowField.NumTargets();
+
+	for (auto _ : state)
+	{
+		float Sum = 0.f;
+		for (int32_t I = 0; I < NumAgents; ++I)
+		{
+			const FSimVector Direction = World.FlowField.Sample(I % NumTargets, World.AgentX[I], World.AgentY[I]);
+			Sum += Direction.X + Direction.Y;
+		}
+		benchmark::DoNotOptimize(Sum);
+	}
+	state.SetItemsProcessed(state.iterations() * NumAgents);
+}
+BENCHMARK(BM_FlowField_SampleAgents)->Arg(4);
+
+/**
+ * \brief Baseline: the same agents running straight at their targets, through the obstacles.
+ */
+static void BM_FlowField_SampleAgents_Straight(benchmark::State& state)
+{
+	FlowWorld World(static_cast<int32_t>(state.range(0)));
+	const int32_t NumTargets = static_cast<int32_t>(World.Targets.size());
+
+	for (auto _ : state)
+	{
+		float Sum = 0.f;
+		for (int32_t I = 0; I < NumAgents; ++I)
+		{
+			const FSimVector& Target = World.Targets[I % NumTargets];
+			const float ToX = Target.X - World.AgentX[I];
+			const float ToY = Target.Y - World.AgentY[I];
+			const float Scale = 1.f / std::sqrt(ToX * ToX + ToY * ToY);
+			Sum += ToX * Scale + ToY * Scale;
+		}
+		benchmark::DoNotOptimize(Sum);
+	}
+	state.SetItemsProcessed(state.iterations() * NumAgents);
+}
+BENCHMARK(BM_FlowField_SampleAgents_Straight)->Arg(4);
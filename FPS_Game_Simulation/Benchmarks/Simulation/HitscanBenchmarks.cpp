@@ -0,0 +1,180 @@
+#include "Simulation/HitscanCore.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr int32_t RaysPerBatch = 1024;
+constexpr float BulletRange = 2000.f;
+constexpr float LevelExtent = 20000.f;
+
+/**
+ * \brief Enemy sized capsules standing on a square level and a batch of horizontal shots at chest height from random
+ * points of the same level.
+ */
+struct HitscanScenario
+{
+	std::vector<FSimCapsule> Capsules;
+	std::vector<FHitscanRay> Rays;
+
+	HitscanScenario(int32_t NumTargets, bool bPierce)
+	{
+		std::mt19937 Random(42);
+		std::uniform_real_distribution<float> Coordinate(-LevelExtent / 2.f, LevelExtent / 2.f);
+		std::uniform_real_distribution<float> Angle(-3.14159265f, 3.14159265f);
+		for (int32_t I = 0; I < NumTargets; ++I)
+		{
+			FSimCapsule Capsule;
+			Capsule.Center = FSimVector(Coordinate(Random), Coordinate(Random), 90.f);
+			Capsule.HalfHeight = 88.f;
+			Capsule.Radius = 34.f;
+			Capsules.push_back(Capsule);
+		}
+		for (int32_t I = 0; I < RaysPerBatch; ++I)
+		{
+			const float Heading = Angle(Random);
+			FHitscanRay Ray;
+			Ray.Start = FSimVector(Coordinate(Random), Coordinate(Random), 150.f);
+			Ray.Direction = FSimVector(std::cos(Heading), std::sin(Heading), 0.f);
+			Ray.Length = BulletRange;
+			Ray.bPierce = bPierce;
+			Rays.push_back(Ray);
+		}
+	}
+};
+
+/**
+ * \brief Nearest capsule along the ray by testing every one of them, one capsule at a time.
+ */
+int32_t BruteForceFirstHit(const std::vector<FSimCapsule>& Capsules, const FHitscanRay& Ray)
+{
+	int32_t Best = -1;
+	float BestDistance = Ray.Length;
+	for (int32_t I = 0; I < static_cast<int32_t>(Capsules.size()); ++I)
+	{
+		// Closest point of the ray to the capsule segment is where the ray passes the capsule center, the shots are
+		// horizontal
+		const FSimVector ToCenter = Capsules[I].Center - Ray.Start;
+		const float Along = ToCenter.X * Ray.Direction.X + ToCenter.Y * Ray.Direction.Y + ToCenter.Z * Ray.Direction.Z;
+		const FSimVector Closest = Ray.Start + Ray.Direction * Along - Capsules[I].Center;
+		const float Segment = Capsules[I].HalfHeight - Capsules[I].Radius;
+		const float OffZ = std::fabs(Closest.Z) > Segment ? std::fabs(Closest.Z) - Segment : 0.f;
+		const float DistanceSquared = Closest.SizeSquared2D() + OffZ * OffZ;
+		const float RadiusSquared = Capsules[I].Radius * Capsules[I].Radius;
+		if (DistanceSquared > RadiusSquared)
+		{
+			continue;
+		}
+
+		const float HalfChord = std::sqrt(RadiusSquared - DistanceSquared);
+		const float Entry = std::max(Along - HalfChord, 0.f);
+		if (Along + HalfChord >= 0.f && Entry <= BestDistance)
+		{
+			Best = I;
+			BestDistance = Entry;
+		}
+	}
+	return Best;
+}
+}	 // namespace
+
+/**
+ * \brief Batch of shots against [range(0)] targets without a hierarchy.
+ */
+static void BM_Hitscan_BruteForce(benchmark::State& state)
+{
+	const HitscanScenario Setup(static_cast<int32_t>(state.range(0)), false);
+
+	for (auto _ : state)
+	{
+		for (const FHitscanRay& Ray : Setup.Rays)
+		{
+			benchmark::DoNotOptimize(BruteForceFirstHit(Setup.Capsules, Ray));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * RaysPerBatch);
+}
+BENCHMARK(BM_Hitscan_BruteForce)->Arg(100)->Arg(1000)->Arg(10000);
+
+/**
+ * \brief Batch of single hit shots against [range(0)] targets through FHitscanCore::Trace.
+ */
+static void BM_Hitscan_FirstHit(benchmark::State& state)
+{
+	const HitscanScenario Setup(static_cast<int32_t>(state.range(0)), false);
+	FHitscanCore Core;
+	Core.Build(Setup.Capsules);
+	FHitscanResults Results;
+
+	for (auto _ : state)
+	{
+		Core.Trace(Setup.Rays.data(), RaysPerBatch, Results);
+		benchmark::DoNotOptimize(Results.Hits.data());
+	}
+	state.SetItemsProcessed(state.iterations() * RaysPerBatch);
+}
+BENCHMARK(BM_Hitscan_FirstHit)->Arg(100)->Arg(1000)->Arg(10000)->Arg(100000);
+
+/**
+ * \brief Batch of piercing shots, every capsule within bullet range is reported and sorted.
+ */
+static void BM_Hitscan_Pierce(benchmark::State& state)
+{
+	const HitscanScenario Setup(static_cast<int32_t>(state.range(0)), true);
+	FHitscanCore Core;
+	Core.Build(Setup.Capsules);
+	FHitscanResults Results;
+
+	for (auto _ : state)
+	{
+		Core.Trace(Setup.Rays.data(), RaysPerBatch, Results);
+		benchmark::DoNotOptimize(Results.Hits.data());
+	}
+	state.SetItemsProcessed(state.iterations() * RaysPerBatch);
+}
+BENCHMARK(BM_Hitscan_Pierce)->Arg(100)->Arg(1000)->Arg(10000)->Arg(100000);
+
+/**
+ * \brief Hierarchy rebuild, paid once per frame in which anybody shoots.
+ */
+static void BM_Hitscan_Build(benchmark::State& state)
+{
+	const HitscanScenario Setup(static_cast<int32_t>(state.range(0)), false);
+	FHitscanCore Core;
+
+	for (auto _ : state)
+	{
+		Core.Build(Setup.Capsules);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Hitscan_Build)->Arg(100)->Arg(1000)->Arg(10000)->Arg(100000);
+
+/**
+ * \brief Moving the capsules of an existing hierarchy, what a frame costs while the enemy count doesn't change.
+ */
+static void BM_Hitscan_Refit(benchmark::State& state)
+{
+	HitscanScenario Setup(static_cast<int32_t>(state.range(0)), false);
+	FHitscanCore Core;
+	Core.Build(Setup.Capsules);
+
+	for (auto _ : state)
+	{
+		for (FSimCapsule& Capsule : Setup.Capsules)
+		{
+			Capsule.Center.X += 1.f;
+		}
+		Core.Refit(Setup.Capsules);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Hitscan_Refit)->Arg(100)->Arg(1000)->Arg(10000)->Arg(100000);
@@ -0,0 +1,166 @@
+#include "BenchmarkActors.h"
+#include "Simulation/PickupCore.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr float LevelExtent = 40000.f;
+constexpr float PickupRadius = 100.f;
+constexpr int32_t Frames = 64;
+
+/**
+ * \brief [NumPickups] pickups spread over the level and [NumPlayers] players walking across it, one location per
+ * frame.
+ */
+struct PickupScenario
+{
+	std::vector<FSimVector> Pickups;
+	std::vector<std::vector<FPickupPlayer>> PlayersByFrame;
+
+	PickupScenario(int32_t NumPickups, int32_t NumPlayers)
+	{
+		std::mt19937 Random(42);
+		std::uniform_real_distribution<float> Coordinate(-LevelExtent / 2.f, LevelExtent / 2.f);
+		for (int32_t I = 0; I < NumPickups; ++I)
+		{
+			Pickups.emplace_back(Coordinate(Random), Coordinate(Random), 50.f);
+		}
+
+		std::vector<FSimVector> Start;
+		for (int32_t P = 0; P < NumPlayers; ++P)
+		{
+			Start.emplace_back(Coordinate(Random), Coordinate(Random), 96.f);
+		}
+		for (int32_t Frame = 0; Frame < Frames; ++Frame)
+		{
+			std::vector<FPickupPlayer> Players;
+			for (const FSimVector& Each : Start)
+			{
+				FPickupPlayer Player;
+				Player.Location = FSimVector(Each.X + Frame * 10.f, Each.Y, Each.Z);
+				Player.Radius = 55.f;
+				Player.HalfHeight = 96.f;
+				Players.push_back(Player);
+			}
+			PlayersByFrame.push_back(Players);
+		}
+	}
+};
+
+// What an AAmmo with its own overlap sphere touches when it is ticked and overlap-tested on its own
+struct PickupState
+{
+	FSimVector Location;
+	float Radius = PickupRadius;
+	bool bPlayerInside = false;
+	int32_t TickCount = 0;
+
+	void Tick() { ++TickCount; }
+
+	bool Overlaps(const FPickupPlayer& Player) const
+	{
+		const float ToX = Location.X - Player.Location.X;
+		const float ToY = Location.Y - Player.Location.Y;
+		const float SegmentHalfHeight = Player.HalfHeight - Player.Radius;
+		const float ClampedZ = Location.Z < Player.Location.Z - SegmentHalfHeight ? Player.Location.Z - SegmentHalfHeight
+							   : Location.Z > Player.Location.Z + SegmentHalfHeight ? Player.Location.Z + SegmentHalfHeight
+																					  : Location.Z;
+		const float ToZ = Location.Z - ClampedZ;
+		const float Touch = Radius + Player.Radius;
+		return ToX * ToX + ToY * ToY + ToZ * ToZ <= Touch * Touch;
+	}
+};
+
+// Stand-in for an AAmmo, actor data around the sphere
+using PickupActor = TPaddedActor<PickupState, 384, 256>;
+}	 // namespace
+
+/**
+ * \brief [range(0)] pickups, [range(1)] players: every pickup ticks and tests every player itself each frame.
+ */
+static void BM_Pickups_PerActorOverlap(benchmark::State& state)
+{
+	const PickupScenario Scenario(static_cast<int32_t>(state.range(0)), static_cast<int32_t>(state.range(1)));
+	std::vector<std::unique_ptr<PickupActor>> Actors;
+	for (const FSimVector& Location : Scenario.Pickups)
+	{
+		Actors.push_back(std::make_unique<PickupActor>());
+		Actors.back()->Location = Location;
+	}
+
+	int32_t Frame = 0;
+	int64_t Reached = 0;
+	for (auto _ : state)
+	{
+		const std::vector<FPickupPlayer>& Players = Scenario.PlayersByFrame[Frame++ % Frames];
+		for (const std::unique_ptr<PickupActor>& Actor : Actors)
+		{
+			Actor->Tick();
+			bool bInside = false;
+			for (const FPickupPlayer& Player : Players)
+			{
+				bInside |= Actor->Overlaps(Player);
+			}
+			Reached += bInside & !Actor->bPlayerInside;
+			Actor->bPlayerInside = bInside;
+		}
+	}
+	benchmark::DoNotOptimize(Reached);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Pickups_PerActorOverlap)->Args({50000, 1})->Args({50000, 4});
+
+/**
+ * \brief The same frames through FPickupGridCore.
+ */
+static void BM_Pickups_Grid(benchmark::State& state)
+{
+	const PickupScenario Scenario(static_cast<int32_t>(state.range(0)), static_cast<int32_t>(state.range(1)));
+	FPickupGridCore Grid;
+	Grid.Reserve(static_cast<int32_t>(Scenario.Pickups.size()));
+	for (const FSimVector& Location : Scenario.Pickups)
+	{
+		Grid.Add(Location, PickupRadius);
+	}
+
+	int32_t Frame = 0;
+	std::vector<FPickupContact> Contacts;
+	for (auto _ : state)
+	{
+		const std::vector<FPickupPlayer>& Players = Scenario.PlayersByFrame[Frame++ % Frames];
+		Grid.Query(Players.data(), static_cast<int32_t>(Players.size()), Contacts);
+		benchmark::DoNotOptimize(Contacts.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Pickups_Grid)->Args({50000, 1})->Args({50000, 4});
+
+/**
+ * \brief Pickups of a 50k grid being picked up and spawned somewhere else, one remove and one add per item.
+ */
+static void BM_Pickups_GridRespawn(benchmark::State& state)
+{
+	const PickupScenario Scenario(50000, 0);
+	FPickupGridCore Grid;
+	std::vector<FSimAgentId> Ids;
+	for (const FSimVector& Location : Scenario.Pickups)
+	{
+		Ids.push_back(Grid.Add(Location, PickupRadius));
+	}
+
+	std::mt19937 Random(7);
+	std::uniform_int_distribution<int32_t> Pick(0, static_cast<int32_t>(Ids.size()) - 1);
+	for (auto _ : state)
+	{
+		FSimAgentId& Id = Ids[Pick(Random)];
+		Grid.Remove(Id);
+		Id = Grid.Add(Scenario.Pickups[Pick(Random)], PickupRadius);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Pickups_GridRespawn);
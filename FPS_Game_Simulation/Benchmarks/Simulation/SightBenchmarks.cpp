@@ -0,0 +1,181 @@
+#include "Simulation/EnemyMovementCore.h"
+#include "Simulation/SightQueryCore.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr float DeltaTime = 1.f / 60.f;
+constexpr float MovementSpeed = 500.f;
+
+/**
+ * \brief Observers spread over a square level of side [Extent], facing random directions, and targets spread over
+ * the same level.
+ */
+struct SightScenario
+{
+	std::vector<float> X;
+	std::vector<float> Y;
+	std::vector<float> Z;
+	std::vector<float> FacingX;
+	std::vector<float> FacingY;
+	std::vector<FSimVector> Targets;
+
+	SightScenario(int32_t NumObservers, int32_t NumTargets, float Extent)
+	{
+		std::mt19937 Random(42);
+		std::uniform_real_distribution<float> Coordinate(-Extent / 2.f, Extent / 2.f);
+		std::uniform_real_distribution<float> Angle(-3.14159265f, 3.14159265f);
+		for (int32_t I = 0; I < NumObservers; ++I)
+		{
+			const float Facing = Angle(Random);
+			X.push_back(Coordinate(Random));
+			Y.push_back(Coordinate(Random));
+			Z.push_back(90.f);
+			FacingX.push_back(std::cos(Facing));
+			FacingY.push_back(std::sin(Facing));
+		}
+		for (int32_t I = 0; I < NumTargets; ++I)
+		{
+			Targets.emplace_back(Coordinate(Random), Coordinate(Random), 90.f);
+		}
+	}
+
+	FSightObservers Observers() const
+	{
+		FSightObservers Result;
+		Result.Num = static_cast<int32_t>(X.size());
+		Result.X = X.data();
+		Result.Y = Y.data();
+		Result.Z = Z.data();
+		Result.FacingX = FacingX.data();
+		Result.FacingY = FacingY.data();
+		return Result;
+	}
+};
+
+/**
+ * \brief What per-enemy perception amounts to: every observer tests every target, with a square root and an angle
+ * per pair.
+ */
+void BruteForceQuery(const FSightConfig& Config, const FSightObservers& Observers,
+	const std::vector<FSimVector>& Targets, int32_t* VisibleTarget)
+{
+	const float CosPeripheralAngle = std::cos(Config.PeripheralVisionAngleDegrees * 3.14159265f / 180.f);
+	for (int32_t I = 0; I < Observers.Num; ++I)
+	{
+		int32_t Best = FSightQueryCore::NoTarget;
+		float BestDistance = Config.SightRadius;
+		for (int32_t T = 0; T < static_cast<int32_t>(Targets.size()); ++T)
+		{
+			const float DX = Targets[T].X - Observers.X[I];
+			const float DY = Targets[T].Y - Observers.Y[I];
+			const float DZ = Targets[T].Z - Observers.Z[I];
+			const float Distance = std::sqrt(DX * DX + DY * DY + DZ * DZ);
+			if (Distance > BestDistance)
+			{
+				continue;
+			}
+
+			const float Size2D = std::sqrt(DX * DX + DY * DY);
+			if (Size2D > 0.f && (DX * Observers.FacingX[I] + DY * Observers.FacingY[I]) / Size2D < CosPeripheralAngle)
+			{
+				continue;
+			}
+
+			Best = T;
+			BestDistance = Distance;
+		}
+		VisibleTarget[I] = Best;
+	}
+}
+}	 // namespace
+
+/**
+ * \brief Brute force sight check of 10k observers against [range(0)] targets on a 100k unit level.
+ */
+static void BM_Sight_BruteForce(benchmark::State& state)
+{
+	const SightScenario Setup(10000, static_cast<int32_t>(state.range(0)), 100000.f);
+	const FSightConfig Config;
+	std::vector<int32_t> VisibleTarget(Setup.X.size());
+
+	for (auto _ : state)
+	{
+		BruteForceQuery(Config, Setup.Observers(), Setup.Targets, VisibleTarget.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(Setup.X.size()) * state.range(0));
+}
+BENCHMARK(BM_Sight_BruteForce)->Arg(1)->Arg(100);
+
+/**
+ * \brief The same check through FSightQueryCore::Query, hash rebuild included.
+ */
+static void BM_Sight_SpatialHash(benchmark::State& state)
+{
+	const SightScenario Setup(10000, static_cast<int32_t>(state.range(0)), 100000.f);
+	FSightQueryCore Query;
+	std::vector<int32_t> VisibleTarget(Setup.X.size());
+
+	for (auto _ : state)
+	{
+		Query.Query(Setup.Observers(), Setup.Targets, VisibleTarget.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(Setup.X.size()) * state.range(0));
+}
+BENCHMARK(BM_Sight_SpatialHash)->Arg(1)->Arg(100);
+
+/**
+ * \brief Spatial hash on a 10k unit level where every target has hundreds of observers in sight range, the worst case
+ * for the vectorized candidate loop.
+ */
+static void BM_Sight_SpatialHashDense(benchmark::State& state)
+{
+	const SightScenario Setup(10000, static_cast<int32_t>(state.range(0)), 10000.f);
+	FSightQueryCore Query;
+	std::vector<int32_t> VisibleTarget(Setup.X.size());
+
+	for (auto _ : state)
+	{
+		Query.Query(Setup.Observers(), Setup.Targets, VisibleTarget.data());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(Setup.X.size()) * state.range(0));
+}
+BENCHMARK(BM_Sight_SpatialHashDense)->Arg(1)->Arg(100);
+
+/**
+ * \brief One frame of enemy AI as UEnemyMovementSubsystem runs it: movement step, sight query and ApplySight.
+ */
+static void BM_Sight_StepQueryApply(benchmark::State& state)
+{
+	const SightScenario Setup(10000, static_cast<int32_t>(state.range(0)), 100000.f);
+
+	FEnemyMovementCore Core;
+	Core.Reserve(static_cast<int32_t>(Setup.X.size()));
+	for (size_t I = 0; I < Setup.X.size(); ++I)
+	{
+		const FSimVector Location(Setup.X[I], Setup.Y[I], Setup.Z[I]);
+		const FSimAgentId Id = Core.Add(Location, Location, MovementSpeed);
+		Core.SetFacing(Id, FSimVector(Setup.FacingX[I], Setup.FacingY[I], 0.f));
+	}
+
+	FSightQueryCore Query;
+	std::vector<int32_t> VisibleTarget;
+	for (auto _ : state)
+	{
+		Core.Step(DeltaTime);
+		VisibleTarget.resize(Core.Num());
+		Query.Query(Core.GetSightObservers(), Setup.Targets, VisibleTarget.data());
+		Core.ApplySight(VisibleTarget.data(), Setup.Targets, DeltaTime, Query.GetConfig().MaxAge);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(Setup.X.size()));
+}
+BENCHMARK(BM_Sight_StepQueryApply)->Arg(100);
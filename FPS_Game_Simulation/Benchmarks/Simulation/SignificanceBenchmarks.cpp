@@ -0,0 +1,172 @@
+#include "BenchmarkActors.h"
+#include "Simulation/EnemyMovementCore.h"
+#include "Simulation/SignificanceCore.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr float DeltaTime = 1.f / 60.f;
+constexpr float LevelExtent = 20000.f;
+// Enemies turn around this often so they stay in the level
+constexpr int32_t FramesPerLeg = 256;
+
+// The engine side of moving an enemy: a sync rebuilds the transform and touches the components around it
+struct EnemySyncState
+{
+	float Transform[16] = {};
+	char ComponentData[512] = {};
+	float MeshOffset[3] = {};
+
+	void SetLocation(const FSimVector& Location, float Yaw)
+	{
+		const float Cos = std::cos(Yaw);
+		const float Sin = std::sin(Yaw);
+		const float Matrix[16] = {Cos, -Sin, 0.f, 0.f, Sin, Cos, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, Location.X, Location.Y,
+			Location.Z, 1.f};
+		for (int32_t I = 0; I < 16; ++I)
+		{
+			Transform[I] = Matrix[I];
+		}
+		for (int32_t I = 0; I < static_cast<int32_t>(sizeof(ComponentData)); I += 64)
+		{
+			ComponentData[I] = static_cast<char>(ComponentData[I] + 1);
+		}
+	}
+
+	void SetMeshOffset(const FSimVector& Offset)
+	{
+		MeshOffset[0] = Offset.X;
+		MeshOffset[1] = Offset.Y;
+		MeshOffset[2] = Offset.Z;
+	}
+};
+
+// Stand-in for an enemy actor, the transform after the rest of its data
+using EnemyActor = TPaddedActor<EnemySyncState, 256, 0>;
+
+/**
+ * \brief [Count] enemies walking back and forth in random directions over the level, and their actors. One player
+ * stands in the middle looking along X.
+ */
+struct EnemyWorld
+{
+	FEnemyMovementCore Movement;
+	std::vector<std::unique_ptr<EnemyActor>> Actors;
+	std::vector<FSignificanceViewer> Viewers;
+	int32_t Frame = 0;
+
+	explicit EnemyWorld(int32_t Count)
+	{
+		std::mt19937 Random(42);
+		std::uniform_real_distribution<float> Coordinate(-LevelExtent / 2.f, LevelExtent / 2.f);
+		std::uniform_real_distribution<float> Angle(-3.14159265f, 3.14159265f);
+		for (int32_t I = 0; I < Count; ++I)
+		{
+			const FSimVector Location(Coordinate(Random), Coordinate(Random), 90.f);
+			const float Direction = Angle(Random);
+			const FSimAgentId Agent = Movement.Add(Location, Location, 300.f);
+			Movement.Move(Agent, Location, FSimVector(std::cos(Direction) * 300.f, std::sin(Direction) * 300.f, 0.f));
+			Actors.push_back(std::make_unique<EnemyActor>());
+		}
+
+		FSignificanceViewer Viewer;
+		Viewer.Location = FSimVector(0.f, 0.f, 160.f);
+		Viewer.HalfFieldOfViewDegrees = 45.f;
+		Viewers.push_back(Viewer);
+	}
+
+	void TurnAroundEveryLeg()
+	{
+		if (++Frame % FramesPerLeg != 0)
+		{
+			return;
+		}
+		for (int32_t I = 0; I < Movement.Num(); ++I)
+		{
+			const FSimAgentId Agent = Movement.AgentAt(I);
+			Movement.Move(Agent, Movement.LocationAt(I), Movement.VelocityAt(I) * -1.f);
+		}
+	}
+};
+}	 // namespace
+
+/**
+ * \brief [range(0)] enemies all moved and synced to their actors every frame.
+ */
+static void BM_EnemyUpdate_FullRate(benchmark::State& state)
+{
+	EnemyWorld World(static_cast<int32_t>(state.range(0)));
+
+	for (auto _ : state)
+	{
+		World.TurnAroundEveryLeg();
+		World.Movement.Step(DeltaTime);
+		for (int32_t I = 0; I < World.Movement.Num(); ++I)
+		{
+			if (World.Movement.FlagsAt(I) & FEnemyMovementCore::Moved)
+			{
+				World.Actors[World.Movement.AgentAt(I)]->SetLocation(World.Movement.LocationAt(I), 0.f);
+			}
+		}
+	}
+	state.counters["UpdatedPerFrame"] = static_cast<double>(World.Movement.Num());
+}
+BENCHMARK(BM_EnemyUpdate_FullRate)->Arg(10000);
+
+/**
+ * \brief The same enemies scheduled by FSignificanceCore: buckets are updated, the scheduled enemies moved and synced,
+ * and the skipped ones in view get their mesh interpolated. [range(1)] is the budget of lower rate updates per frame.
+ */
+static void BM_EnemyUpdate_Significance(benchmark::State& state)
+{
+	EnemyWorld World(static_cast<int32_t>(state.range(0)));
+	FSignificanceConfig Config;
+	Config.MaxUpdatesPerFrame = static_cast<int32_t>(state.range(1));
+	FSignificanceCore Significance(Config);
+	for (int32_t I = 0; I < World.Movement.Num(); ++I)
+	{
+		Significance.Add();
+	}
+	std::vector<float> AgentDeltaTimes(World.Movement.Num());
+
+	int64_t Updated = 0;
+	int64_t Interpolated = 0;
+	int64_t Deferred = 0;
+	for (auto _ : state)
+	{
+		World.TurnAroundEveryLeg();
+		const FSightObservers Locations = World.Movement.GetSightObservers();
+		Significance.UpdateBuckets(Locations.X, Locations.Y, Locations.Z, World.Viewers);
+		Updated += Significance.Schedule(DeltaTime, AgentDeltaTimes.data());
+		Deferred += Significance.GetStats().NumDeferred;
+		World.Movement.Step(AgentDeltaTimes.data());
+
+		for (int32_t I = 0; I < World.Movement.Num(); ++I)
+		{
+			if (World.Movement.FlagsAt(I) & FEnemyMovementCore::Moved)
+			{
+				World.Actors[World.Movement.AgentAt(I)]->SetLocation(World.Movement.LocationAt(I), 0.f);
+			}
+			else if (Significance.IsInViewAt(I) & (Significance.PendingTimeAt(I) > 0.f))
+			{
+				World.Actors[World.Movement.AgentAt(I)]->SetMeshOffset(
+					World.Movement.VelocityAt(I) * Significance.PendingTimeAt(I));
+				++Interpolated;
+			}
+		}
+	}
+
+	const double Frames = static_cast<double>(state.iterations());
+	state.counters["UpdatedPerFrame"] = static_cast<double>(Updated) / Frames;
+	state.counters["InterpolatedPerFrame"] = static_cast<double>(Interpolated) / Frames;
+	state.counters["DeferredPerFrame"] = static_cast<double>(Deferred) / Frames;
+	const FSignificanceStats& Stats = Significance.GetStats();
+	state.counters["Dormant"] = Stats.NumInBucket[FSignificanceCore::Dormant];
+}
+BENCHMARK(BM_EnemyUpdate_Significance)->Args({10000, 512})->Args({10000, 128});
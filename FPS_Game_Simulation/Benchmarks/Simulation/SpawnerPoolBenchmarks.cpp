@@ -0,0 +1,117 @@
+#include "BenchmarkActors.h"
+#include "Simulation/SimPool.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr int32_t Churns = 10000;
+
+// A few components, each its own heap block like the subobjects SpawnActor creates
+struct SpawnedState
+{
+	std::vector<std::unique_ptr<char[]>> Components;
+	bool bHidden = false;
+
+	SpawnedState()
+	{
+		for (int32_t I = 0; I < 4; ++I)
+		{
+			Components.push_back(std::make_unique<char[]>(256));
+		}
+	}
+};
+
+// Stand-in for a spawned pickup or enemy
+using Actor = TPaddedActor<SpawnedState, 512, 0>;
+
+/**
+ * \brief Which of [Live] actors gets picked up or killed in each of the churns, the same sequence for both runs.
+ */
+std::vector<int32_t> MakeChurnOrder(int32_t Live)
+{
+	std::mt19937 Random(7);
+	std::uniform_int_distribution<int32_t> Pick(0, Live - 1);
+
+	std::vector<int32_t> Order(Churns);
+	for (int32_t& Each : Order)
+	{
+		Each = Pick(Random);
+	}
+	return Order;
+}
+}	 // namespace
+
+/**
+ * \brief [range(0)] live actors, 10k times one is destroyed and a new one spawned in its place.
+ */
+static void BM_SpawnChurn_DestroyAndSpawn(benchmark::State& state)
+{
+	const int32_t Live = static_cast<int32_t>(state.range(0));
+	const std::vector<int32_t> Order = MakeChurnOrder(Live);
+
+	std::vector<std::unique_ptr<Actor>> Actors;
+	for (int32_t I = 0; I < Live; ++I)
+	{
+		Actors.push_back(std::make_unique<Actor>());
+	}
+
+	for (auto _ : state)
+	{
+		for (int32_t Index : Order)
+		{
+			Actors[Index].reset();
+			Actors[Index] = std::make_unique<Actor>();
+			benchmark::DoNotOptimize(Actors[Index].get());
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * Churns);
+}
+BENCHMARK(BM_SpawnChurn_DestroyAndSpawn)->Arg(16)->Arg(1000);
+
+/**
+ * \brief The same churn through a prewarmed TSimPool: the actor is hidden and released, the next spawn acquires it.
+ */
+static void BM_SpawnChurn_Pool(benchmark::State& state)
+{
+	const int32_t Live = static_cast<int32_t>(state.range(0));
+	const std::vector<int32_t> Order = MakeChurnOrder(Live);
+
+	// One spare per live actor, as a spawner prewarmed with its peak would have
+	std::vector<std::unique_ptr<Actor>> Storage;
+	TSimPool<Actor> Pool;
+	Pool.Reserve(Live * 2);
+	std::vector<Actor*> Actors;
+	for (int32_t I = 0; I < Live * 2; ++I)
+	{
+		Storage.push_back(std::make_unique<Actor>());
+		Pool.Add(Storage.back().get(), I < Live);
+		if (I < Live)
+		{
+			Actors.push_back(Storage.back().get());
+		}
+		else
+		{
+			Storage.back()->bHidden = true;
+		}
+	}
+
+	for (auto _ : state)
+	{
+		for (int32_t Index : Order)
+		{
+			Actors[Index]->bHidden = true;
+			Pool.Release(Actors[Index]);
+			Actors[Index] = Pool.Acquire();
+			Actors[Index]->bHidden = false;
+			benchmark::DoNotOptimize(Actors[Index]);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * Churns);
+	state.counters["Missed"] = static_cast<double>(Pool.GetStats().NumMissed);
+}
+BENCHMARK(BM_SpawnChurn_Pool)->Arg(16)->Arg(1000);
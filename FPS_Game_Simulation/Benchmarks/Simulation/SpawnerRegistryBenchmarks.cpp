@@ -0,0 +1,119 @@
+#include "BenchmarkActors.h"
+#include "Simulation/SpawnerRegistry.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr int32_t Respawns = 10000;
+
+// Tags of the shipped level
+enum ESpawnerTag : uint64_t
+{
+	AmmoSpawner = 1,
+	HealthSpawner,
+	EnemySpawner,
+	NumTags
+};
+
+struct SpawnerTags
+{
+	std::vector<uint64_t> Tags;
+
+	bool HasTag(uint64_t Tag) const { return std::find(Tags.begin(), Tags.end(), Tag) != Tags.end(); }
+};
+
+// Stand-in for an ASpawner
+using Spawner = TPaddedActor<SpawnerTags, 256, 128>;
+
+/**
+ * \brief [Count] spawners with one of the three tags each, spread over the heap and in no particular order.
+ */
+struct SpawnerWorld
+{
+	std::vector<std::unique_ptr<Spawner>> Spawners;
+
+	explicit SpawnerWorld(int32_t Count)
+	{
+		for (int32_t I = 0; I < Count; ++I)
+		{
+			auto Next = std::make_unique<Spawner>();
+			Next->Tags.push_back(AmmoSpawner + I % (NumTags - 1));
+			Spawners.push_back(std::move(Next));
+		}
+		std::shuffle(Spawners.begin(), Spawners.end(), std::mt19937(7));
+	}
+};
+
+/**
+ * \brief What GetAllActorsOfClass(ASpawner) plus the tag loop in BeginPlay did: gather every spawner into a fresh
+ * array, then keep the last one with the tag.
+ */
+Spawner* FindByScan(const SpawnerWorld& World, uint64_t Tag)
+{
+	std::vector<Spawner*> Found;
+	for (const std::unique_ptr<Spawner>& Each : World.Spawners)
+	{
+		Found.push_back(Each.get());
+	}
+
+	Spawner* Result = nullptr;
+	for (Spawner* Each : Found)
+	{
+		if (Each->HasTag(Tag))
+		{
+			Result = Each;
+		}
+	}
+	return Result;
+}
+}	 // namespace
+
+/**
+ * \brief 10k respawns of ammo, health and enemies, each looking up its spawner by scanning [range(0)] spawners.
+ */
+static void BM_SpawnStorm_ActorScan(benchmark::State& state)
+{
+	const SpawnerWorld World(static_cast<int32_t>(state.range(0)));
+
+	for (auto _ : state)
+	{
+		for (int32_t I = 0; I < Respawns; ++I)
+		{
+			benchmark::DoNotOptimize(FindByScan(World, AmmoSpawner + I % (NumTags - 1)));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * Respawns);
+}
+BENCHMARK(BM_SpawnStorm_ActorScan)->Arg(3)->Arg(100)->Arg(1000);
+
+/**
+ * \brief The same storm through TSpawnerRegistry.
+ */
+static void BM_SpawnStorm_Registry(benchmark::State& state)
+{
+	const SpawnerWorld World(static_cast<int32_t>(state.range(0)));
+	TSpawnerRegistry<Spawner> Registry;
+	for (const std::unique_ptr<Spawner>& Each : World.Spawners)
+	{
+		for (uint64_t Tag : Each->Tags)
+		{
+			Registry.Register(Tag, Each.get());
+		}
+	}
+
+	for (auto _ : state)
+	{
+		for (int32_t I = 0; I < Respawns; ++I)
+		{
+			benchmark::DoNotOptimize(Registry.Find(AmmoSpawner + I % (NumTags - 1)));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * Respawns);
+}
+BENCHMARK(BM_SpawnStorm_Registry)->Arg(3)->Arg(100)->Arg(1000);
@@ -0,0 +1,94 @@
+#include "protocol/Buffer.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace rd;
+
+static void BM_Buffer_WriteIntegral(benchmark::State& state)
+{
+	Buffer buffer;
+	for (auto _ : state)
+	{
+		buffer.rewind();
+		for (int32_t i = 0; i < 1024; ++i)
+		{
+			buffer.write_integral(i);
+		}
+		benchmark::DoNotOptimize(buffer.data());
+	}
+	state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_Buffer_WriteIntegral);
+
+static void BM_Buffer_ReadIntegral(benchmark::State& state)
+{
+	Buffer buffer;
+	for (int32_t i = 0; i < 1024; ++i)
+	{
+		buffer.write_integral(i);
+	}
+	for (auto _ : state)
+	{
+		buffer.rewind();
+		int64_t sum = 0;
+		for (int32_t i = 0; i < 1024; ++i)
+		{
+			sum += buffer.read_integral<int32_t>();
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_Buffer_ReadIntegral);
+
+static void BM_Buffer_WriteReadWString(benchmark::State& state)
+{
+	const std::wstring value(static_cast<size_t>(state.range(0)), L'x');
+	Buffer buffer;
+	for (auto _ : state)
+	{
+		buffer.rewind();
+		buffer.write_wstring(value);
+		buffer.rewind();
+		benchmark::DoNotOptimize(buffer.read_wstring());
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(wchar_t)));
+}
+BENCHMARK(BM_Buffer_WriteReadWString)->Arg(16)->Arg(1024);
+
+static void BM_Buffer_WriteReadArray(benchmark::State& state)
+{
+	const std::vector<int32_t> value(static_cast<size_t>(state.range(0)), 42);
+	Buffer buffer;
+	for (auto _ : state)
+	{
+		buffer.rewind();
+		buffer.write_array(value);
+		buffer.rewind();
+		benchmark::DoNotOptimize(buffer.read_array<std::vector, int32_t>());
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(int32_t)));
+}
+BENCHMARK(BM_Buffer_WriteReadArray)->Arg(16)->Arg(4096)->Arg(1 << 20);
+
+/**
+ * \brief The same std::vector<int32_t> through element readers and writers, as generated code serializes arrays of
+ * non-trivial types, against the bulk copy above.
+ */
+static void BM_Buffer_WriteReadArrayPerElement(benchmark::State& state)
+{
+	const std::vector<int32_t> value(static_cast<size_t>(state.range(0)), 42);
+	Buffer buffer;
+	for (auto _ : state)
+	{
+		buffer.rewind();
+		buffer.write_array(value, [&buffer](int32_t const& it) { buffer.write_integral(it); });
+		buffer.rewind();
+		benchmark::DoNotOptimize(
+			buffer.read_array<std::vector, int32_t>([&buffer]() { return buffer.read_integral<int32_t>(); }));
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(int32_t)));
+}
+BENCHMARK(BM_Buffer_WriteReadArrayPerElement)->Arg(16)->Arg(4096)->Arg(1 << 20);
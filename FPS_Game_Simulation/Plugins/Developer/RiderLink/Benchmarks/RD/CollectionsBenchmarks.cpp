@@ -0,0 +1,179 @@
+#include "reactive/ViewableList.h"
+#include "reactive/ViewableMap.h"
+
+#include "HeapCounter.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace rd;
+
+namespace
+{
+constexpr int32_t ELEMENTS = 1000000;
+
+struct Point
+{
+	float x;
+	float y;
+	float z;
+
+	friend bool operator==(Point const& lhs, Point const& rhs)
+	{
+		return lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z;
+	}
+
+	friend bool operator!=(Point const& lhs, Point const& rhs)
+	{
+		return !(lhs == rhs);
+	}
+};
+
+template <typename T>
+T element(int32_t i);
+
+template <>
+int32_t element<int32_t>(int32_t i)
+{
+	return i;
+}
+
+template <>
+Point element<Point>(int32_t i)
+{
+	return Point{static_cast<float>(i), 0, 0};
+}
+
+int64_t weight(int32_t value)
+{
+	return value;
+}
+
+int64_t weight(Point const& value)
+{
+	return static_cast<int64_t>(value.x);
+}
+
+template <typename T, typename S>
+using List = ViewableList<T, allocator<T>, S>;
+
+template <typename V, typename S>
+using Map = ViewableMap<int32_t, V, std::allocator<int32_t>, std::allocator<V>, S>;
+
+void report_footprint(benchmark::State& state, HeapCounter const& heap)
+{
+	state.counters["bytes_per_element"] = static_cast<double>(heap.live_bytes) / ELEMENTS;
+}
+}	 // namespace
+
+/**
+ * \brief Range-for over 1M elements. bytes_per_element is the heap the filled list takes.
+ */
+template <typename T, typename S>
+static void BM_ViewableList_Iterate(benchmark::State& state)
+{
+	List<T, S> list;
+	{
+		HeapCounter heap;
+		for (int32_t i = 0; i < ELEMENTS; ++i)
+		{
+			list.add(element<T>(i));
+		}
+		report_footprint(state, heap);
+	}
+	for (auto _ : state)
+	{
+		int64_t sum = 0;
+		for (auto const& value : list)
+		{
+			sum += weight(value);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * ELEMENTS);
+}
+BENCHMARK_TEMPLATE(BM_ViewableList_Iterate, int32_t, viewable::wrapped_storage);
+BENCHMARK_TEMPLATE(BM_ViewableList_Iterate, int32_t, viewable::inline_storage);
+BENCHMARK_TEMPLATE(BM_ViewableList_Iterate, Point, viewable::wrapped_storage);
+BENCHMARK_TEMPLATE(BM_ViewableList_Iterate, Point, viewable::inline_storage);
+
+/**
+ * \brief Appends 1M elements, then removes them from the back.
+ */
+template <typename T, typename S>
+static void BM_ViewableList_AddRemove(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		List<T, S> list;
+		for (int32_t i = 0; i < ELEMENTS; ++i)
+		{
+			list.add(element<T>(i));
+		}
+		for (int32_t i = ELEMENTS; i > 0; --i)
+		{
+			benchmark::DoNotOptimize(list.removeAt(static_cast<size_t>(i - 1)));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * ELEMENTS * 2);
+}
+BENCHMARK_TEMPLATE(BM_ViewableList_AddRemove, int32_t, viewable::wrapped_storage)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ViewableList_AddRemove, int32_t, viewable::inline_storage)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ViewableList_AddRemove, Point, viewable::wrapped_storage)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ViewableList_AddRemove, Point, viewable::inline_storage)->Unit(benchmark::kMillisecond);
+
+/**
+ * \brief Iterates the values of a map with 1M int32_t keys, the keys are wrapped either way. bytes_per_element is
+ * the heap the filled map takes.
+ */
+template <typename V, typename S>
+static void BM_ViewableMap_Iterate(benchmark::State& state)
+{
+	Map<V, S> map;
+	{
+		HeapCounter heap;
+		for (int32_t i = 0; i < ELEMENTS; ++i)
+		{
+			map.set(i, element<V>(i));
+		}
+		report_footprint(state, heap);
+	}
+	for (auto _ : state)
+	{
+		int64_t sum = 0;
+		for (auto it = map.begin(); it != map.end(); ++it)
+		{
+			sum += it.key() + weight(*it);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * ELEMENTS);
+}
+BENCHMARK_TEMPLATE(BM_ViewableMap_Iterate, int32_t, viewable::wrapped_storage);
+BENCHMARK_TEMPLATE(BM_ViewableMap_Iterate, int32_t, viewable::inline_storage);
+BENCHMARK_TEMPLATE(BM_ViewableMap_Iterate, Point, viewable::wrapped_storage);
+BENCHMARK_TEMPLATE(BM_ViewableMap_Iterate, Point, viewable::inline_storage);
+
+/**
+ * \brief Sets 1M keys, then removes them newest first: ordered_map erases by shifting the later entries.
+ */
+template <typename V, typename S>
+static void BM_ViewableMap_SetRemove(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		Map<V, S> map;
+		for (int32_t i = 0; i < ELEMENTS; ++i)
+		{
+			map.set(i, element<V>(i));
+		}
+		for (int32_t i = ELEMENTS; i > 0; --i)
+		{
+			benchmark::DoNotOptimize(map.remove(i - 1));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * ELEMENTS * 2);
+}
+BENCHMARK_TEMPLATE(BM_ViewableMap_SetRemove, int32_t, viewable::wrapped_storage)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ViewableMap_SetRemove, int32_t, viewable::inline_storage)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ViewableMap_SetRemove, Point, viewable::wrapped_storage)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ViewableMap_SetRemove, Point, viewable::inline_storage)->Unit(benchmark::kMillisecond);
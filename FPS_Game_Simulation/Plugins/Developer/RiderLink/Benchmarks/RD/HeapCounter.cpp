@@ -0,0 +1,59 @@
+#include "HeapCounter.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+thread_local HeapCounter* current = nullptr;
+
+// every block carries its size in front, so frees can be accounted as well
+constexpr size_t HEADER = alignof(std::max_align_t);
+}	 // namespace
+
+HeapCounter::HeapCounter()
+{
+	current = this;
+}
+
+HeapCounter::~HeapCounter()
+{
+	current = nullptr;
+}
+
+void* operator new(size_t size)
+{
+	auto* block = static_cast<unsigned char*>(std::malloc(HEADER + size));
+	if (block == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	*reinterpret_cast<size_t*>(block) = size;
+	if (current != nullptr)
+	{
+		++current->allocations;
+		current->allocated_bytes += static_cast<int64_t>(size);
+		current->live_bytes += static_cast<int64_t>(size);
+	}
+	return block + HEADER;
+}
+
+void operator delete(void* ptr) noexcept
+{
+	if (ptr == nullptr)
+	{
+		return;
+	}
+	auto* block = static_cast<unsigned char*>(ptr) - HEADER;
+	if (current != nullptr)
+	{
+		current->live_bytes -= static_cast<int64_t>(*reinterpret_cast<size_t*>(block));
+	}
+	std::free(block);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+	operator delete(ptr);
+}
@@ -0,0 +1,27 @@
+#ifndef RD_BENCHMARKS_HEAPCOUNTER_H
+#define RD_BENCHMARKS_HEAPCOUNTER_H
+
+#include <cstdint>
+
+/**
+ * \brief Counts the heap traffic of the calling thread while alive. operator new and delete are replaced for the
+ * whole benchmark binary, threads without a live counter only pay a thread_local check. Counters don't nest.
+ */
+class HeapCounter
+{
+public:
+	int64_t allocations = 0;
+	int64_t allocated_bytes = 0;
+	// allocated minus freed, blocks freed while counting must have been allocated while counting
+	int64_t live_bytes = 0;
+
+	HeapCounter();
+
+	HeapCounter(HeapCounter const&) = delete;
+
+	HeapCounter& operator=(HeapCounter const&) = delete;
+
+	~HeapCounter();
+};
+
+#endif	  // RD_BENCHMARKS_HEAPCOUNTER_H
@@ -0,0 +1,86 @@
+#include "HeapCounter.h"
+#include "LogEventModel.h"
+
+#include "serialization/Serializers.h"
+#include "std/pool_allocator.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace rd;
+using namespace log_event_model;
+
+namespace
+{
+constexpr int32_t EVENTS = 100000;
+
+template <typename S>
+Buffer encode_events()
+{
+	Serializers serializers;
+	SerializationCtx ctx(&serializers);
+	Buffer buffer;
+	for (int32_t i = 0; i < EVENTS; ++i)
+	{
+		sample_event<S>(i).write(ctx, buffer);
+	}
+	return buffer;
+}
+}	 // namespace
+
+/**
+ * \brief Decodes 100k log events into wrappers the way RdSignal<UnrealLogEvent> delivers them, each one released
+ * before the next is read. allocations_per_event counts the general purpose heap only, pooled blocks are not in it.
+ */
+template <typename S>
+static void BM_UnrealLogEvent_Decode(benchmark::State& state)
+{
+	Buffer buffer = encode_events<S>();
+	Serializers serializers;
+	SerializationCtx ctx(&serializers);
+	const size_t slabs_before = slab_pool::slab_count();
+	int64_t allocations = 0;
+	for (auto _ : state)
+	{
+		buffer.rewind();
+		HeapCounter heap;
+		for (int32_t i = 0; i < EVENTS; ++i)
+		{
+			Wrapper<UnrealLogEvent<S>> event(UnrealLogEvent<S>::read(ctx, buffer));
+			benchmark::DoNotOptimize(event);
+		}
+		allocations += heap.allocations;
+	}
+	state.counters["allocations_per_event"] =
+		static_cast<double>(allocations) / static_cast<double>(state.iterations() * EVENTS);
+	state.counters["slabs"] = static_cast<double>(slab_pool::slab_count() - slabs_before);
+	state.SetItemsProcessed(state.iterations() * EVENTS);
+}
+BENCHMARK_TEMPLATE(BM_UnrealLogEvent_Decode, wrapper::shared_storage);
+BENCHMARK_TEMPLATE(BM_UnrealLogEvent_Decode, wrapper::pooled_storage);
+
+/**
+ * \brief Writes and reads back one log event with Arg ranges in each of its two StringRange arrays.
+ */
+static void BM_UnrealLogEvent_WriteRead(benchmark::State& state)
+{
+	using event_t = UnrealLogEvent<wrapper::shared_storage>;
+	using range_t = StringRange<wrapper::shared_storage>;
+	Serializers serializers;
+	SerializationCtx ctx(&serializers);
+	auto event = sample_event<wrapper::shared_storage>(0);
+	for (int32_t i = 1; i < state.range(0); ++i)
+	{
+		event.bpPathRanges_.emplace_back(range_t(i, i + 8));
+		event.methodRanges_.emplace_back(range_t(i + 8, i + 16));
+	}
+	Buffer buffer;
+	for (auto _ : state)
+	{
+		buffer.rewind();
+		event.write(ctx, buffer);
+		buffer.rewind();
+		benchmark::DoNotOptimize(event_t::read(ctx, buffer));
+	}
+	state.SetItemsProcessed(state.iterations() * 2 * state.range(0));
+}
+BENCHMARK(BM_UnrealLogEvent_WriteRead)->Arg(1)->Arg(64);
@@ -0,0 +1,215 @@
+#ifndef RD_BENCHMARKS_LOGEVENTMODEL_H
+#define RD_BENCHMARKS_LOGEVENTMODEL_H
+
+#include "protocol/Buffer.h"
+#include "serialization/ISerializable.h"
+#include "serialization/Polymorphic.h"
+#include "serialization/SerializationCtx.h"
+#include "types/wrapper.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Stand-ins for the generated UE4Library StringRange, LogMessageInfo and UnrealLogEvent. They have the same
+ * fields and serializers, with std::wstring in place of FString and std::vector in place of TArray, so the RiderLink
+ * log traffic can be benchmarked without the engine. [S] is the wrapper storage policy of all three types.
+ */
+namespace log_event_model
+{
+template <typename S>
+class StringRange : public rd::IPolymorphicSerializable
+{
+public:
+	int32_t first_ = 0;
+	int32_t last_ = 0;
+
+	StringRange() = default;
+
+	StringRange(int32_t first, int32_t last) : first_(first), last_(last)
+	{
+	}
+
+	static StringRange read(rd::SerializationCtx& /*ctx*/, rd::Buffer& buffer)
+	{
+		auto first = buffer.read_integral<int32_t>();
+		auto last = buffer.read_integral<int32_t>();
+		return StringRange(first, last);
+	}
+
+	void write(rd::SerializationCtx& /*ctx*/, rd::Buffer& buffer) const override
+	{
+		buffer.write_integral(first_);
+		buffer.write_integral(last_);
+	}
+
+	static std::string static_type_name()
+	{
+		return "StringRange";
+	}
+
+	std::string type_name() const override
+	{
+		return static_type_name();
+	}
+
+	std::string toString() const override
+	{
+		return static_type_name();
+	}
+
+	bool equals(rd::ISerializable const& object) const override
+	{
+		auto const& other = static_cast<StringRange const&>(object);
+		return first_ == other.first_ && last_ == other.last_;
+	}
+};
+
+template <typename S>
+class LogMessageInfo : public rd::IPolymorphicSerializable
+{
+public:
+	int32_t type_ = 0;
+	rd::Wrapper<std::wstring> category_;
+
+	LogMessageInfo() = default;
+
+	LogMessageInfo(int32_t type, rd::Wrapper<std::wstring> category) : type_(type), category_(std::move(category))
+	{
+	}
+
+	static LogMessageInfo read(rd::SerializationCtx& ctx, rd::Buffer& buffer)
+	{
+		auto type = buffer.read_integral<int32_t>();
+		auto category = rd::Polymorphic<std::wstring>::read(ctx, buffer);
+		return LogMessageInfo(type, std::move(category));
+	}
+
+	void write(rd::SerializationCtx& ctx, rd::Buffer& buffer) const override
+	{
+		buffer.write_integral(type_);
+		rd::Polymorphic<std::wstring>::write(ctx, buffer, category_);
+	}
+
+	static std::string static_type_name()
+	{
+		return "LogMessageInfo";
+	}
+
+	std::string type_name() const override
+	{
+		return static_type_name();
+	}
+
+	std::string toString() const override
+	{
+		return static_type_name();
+	}
+
+	bool equals(rd::ISerializable const& object) const override
+	{
+		auto const& other = static_cast<LogMessageInfo const&>(object);
+		return type_ == other.type_ && *category_ == *other.category_;
+	}
+};
+
+template <typename S>
+class UnrealLogEvent : public rd::IPolymorphicSerializable
+{
+public:
+	using ranges_t = std::vector<rd::Wrapper<StringRange<S>>>;
+
+	LogMessageInfo<S> info_;
+	rd::Wrapper<std::wstring> text_;
+	ranges_t bpPathRanges_;
+	ranges_t methodRanges_;
+
+	UnrealLogEvent() = default;
+
+	UnrealLogEvent(LogMessageInfo<S> info, rd::Wrapper<std::wstring> text, ranges_t bpPathRanges, ranges_t methodRanges)
+		: info_(std::move(info))
+		, text_(std::move(text))
+		, bpPathRanges_(std::move(bpPathRanges))
+		, methodRanges_(std::move(methodRanges))
+	{
+	}
+
+	static UnrealLogEvent read(rd::SerializationCtx& ctx, rd::Buffer& buffer)
+	{
+		auto info = LogMessageInfo<S>::read(ctx, buffer);
+		auto text = rd::Polymorphic<std::wstring>::read(ctx, buffer);
+		auto bpPathRanges = buffer.read_array<std::vector, StringRange<S>>(
+			[&ctx, &buffer]() mutable { return StringRange<S>::read(ctx, buffer); });
+		auto methodRanges = buffer.read_array<std::vector, StringRange<S>>(
+			[&ctx, &buffer]() mutable { return StringRange<S>::read(ctx, buffer); });
+		return UnrealLogEvent(std::move(info), std::move(text), std::move(bpPathRanges), std::move(methodRanges));
+	}
+
+	void write(rd::SerializationCtx& ctx, rd::Buffer& buffer) const override
+	{
+		info_.write(ctx, buffer);
+		rd::Polymorphic<std::wstring>::write(ctx, buffer, text_);
+		buffer.write_array(bpPathRanges_, [&ctx, &buffer](StringRange<S> const& it) mutable { it.write(ctx, buffer); });
+		buffer.write_array(methodRanges_, [&ctx, &buffer](StringRange<S> const& it) mutable { it.write(ctx, buffer); });
+	}
+
+	static std::string static_type_name()
+	{
+		return "UnrealLogEvent";
+	}
+
+	std::string type_name() const override
+	{
+		return static_type_name();
+	}
+
+	std::string toString() const override
+	{
+		return static_type_name();
+	}
+
+	bool equals(rd::ISerializable const& object) const override
+	{
+		auto const& other = static_cast<UnrealLogEvent const&>(object);
+		return info_.equals(other.info_) && *text_ == *other.text_;
+	}
+};
+
+/**
+ * \brief A typical editor log line: one blueprint path and one method reference.
+ */
+template <typename S>
+UnrealLogEvent<S> sample_event(int32_t i)
+{
+	std::wstring text = L"LogBlueprintUserMessages: [BP_Enemy_C_" + std::to_wstring(i) +
+						L"] /Game/Blueprints/BP_Enemy.BP_Enemy_C called AEnemy::ReceiveTick";
+	typename UnrealLogEvent<S>::ranges_t paths{rd::Wrapper<StringRange<S>>(StringRange<S>(32, 70))};
+	typename UnrealLogEvent<S>::ranges_t methods{rd::Wrapper<StringRange<S>>(StringRange<S>(78, 96))};
+	return UnrealLogEvent<S>(LogMessageInfo<S>(5, rd::Wrapper<std::wstring>(std::wstring(L"LogBlueprintUserMessages"))),
+		rd::Wrapper<std::wstring>(std::move(text)), std::move(paths), std::move(methods));
+}
+}	 // namespace log_event_model
+
+namespace rd
+{
+template <typename S>
+struct wrapper_storage<log_event_model::StringRange<S>>
+{
+	using type = S;
+};
+
+template <typename S>
+struct wrapper_storage<log_event_model::LogMessageInfo<S>>
+{
+	using type = S;
+};
+
+template <typename S>
+struct wrapper_storage<log_event_model::UnrealLogEvent<S>>
+{
+	using type = S;
+};
+}	 // namespace rd
+
+#endif	  // RD_BENCHMARKS_LOGEVENTMODEL_H
@@ -0,0 +1,100 @@
+#include "impl/RdProperty.h"
+#include "lifetime/LifetimeDefinition.h"
+#include "protocol/Protocol.h"
+#include "wire/WireReplay.h"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace rd;
+
+namespace
+{
+/**
+ * \brief Scheduler owned by the benchmark thread: queued actions run when the benchmark flushes it, once per "frame".
+ */
+class PumpedScheduler : public IScheduler
+{
+	std::mutex lock;
+	std::vector<std::function<void()>> actions;
+
+public:
+	void queue(std::function<void()> action) override
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		actions.push_back(std::move(action));
+	}
+
+	void flush() override
+	{
+		std::vector<std::function<void()>> batch;
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			batch.swap(actions);
+		}
+		for (auto const& action : batch)
+		{
+			action();
+		}
+	}
+
+	bool is_active() const override
+	{
+		return true;
+	}
+};
+}	 // namespace
+
+/**
+ * \brief A property set 1M times per second: 1000 sets per 1 ms turn of the protocol scheduler.
+ * Arg is the \ref PropertySendPolicy, rate limiting uses a 10 ms interval.
+ */
+static void BM_RdProperty_Set(benchmark::State& state)
+{
+	constexpr int32_t SETS_PER_TURN = 1000;
+	constexpr auto TURN = std::chrono::milliseconds(1);
+
+	spdlog::set_level(spdlog::level::err);
+	LifetimeDefinition definition(false);
+	PumpedScheduler scheduler;
+	auto wire = std::make_shared<ReplayWire>(&scheduler);
+	Protocol protocol(Identities::SERVER, &scheduler, wire, definition.lifetime);
+
+	RdProperty<int32_t> property(0);
+	property.is_master = true;
+	property.set_send_policy(static_cast<PropertySendPolicy>(state.range(0)), std::chrono::milliseconds(10));
+	statics(property, 1);
+	property.bind(definition.lifetime, &protocol, "property");
+
+	const auto sent_before = wire->get_sent_messages();
+	auto next_turn = std::chrono::steady_clock::now();
+	int32_t value = 0;
+	for (auto _ : state)
+	{
+		for (int32_t i = 0; i < SETS_PER_TURN; ++i)
+		{
+			property.set(++value);
+		}
+		scheduler.flush();
+
+		state.PauseTiming();
+		next_turn += TURN;
+		std::this_thread::sleep_until(next_turn);
+		state.ResumeTiming();
+	}
+	const auto sent = static_cast<double>(wire->get_sent_messages() - sent_before);
+	const auto seconds = std::chrono::duration<double>(TURN).count() * static_cast<double>(state.iterations());
+	state.counters["messages_per_second"] = sent / seconds;
+	state.counters["messages_per_set"] = sent / static_cast<double>(state.iterations() * SETS_PER_TURN);
+	state.SetItemsProcessed(state.iterations() * SETS_PER_TURN);
+	definition.terminate();
+}
+BENCHMARK(BM_RdProperty_Set)
+	->Arg(static_cast<int64_t>(PropertySendPolicy::Immediate))
+	->Arg(static_cast<int64_t>(PropertySendPolicy::Coalesced))
+	->Arg(static_cast<int64_t>(PropertySendPolicy::RateLimited))
+	->Iterations(1000);
@@ -0,0 +1,53 @@
+#include "lifetime/LifetimeDefinition.h"
+#include "reactive/base/SignalX.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace rd;
+
+static void BM_Signal_Fire(benchmark::State& state)
+{
+	LifetimeDefinition definition(false);
+	Signal<int32_t> signal;
+	int64_t sum = 0;
+	for (int64_t i = 0; i < state.range(0); ++i)
+	{
+		signal.advise(definition.lifetime, [&sum](int32_t const& value) { sum += value; });
+	}
+	int32_t value = 0;
+	for (auto _ : state)
+	{
+		signal.fire(++value);
+	}
+	benchmark::DoNotOptimize(sum);
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Signal_Fire)->Arg(1)->Arg(16);
+
+static void BM_Lifetime_NestedChurn(benchmark::State& state)
+{
+	LifetimeDefinition parent(false);
+	int64_t terminated = 0;
+	for (auto _ : state)
+	{
+		LifetimeDefinition nested(parent.lifetime);
+		nested.lifetime->add_action([&terminated] { ++terminated; });
+		nested.terminate();
+	}
+	benchmark::DoNotOptimize(terminated);
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Lifetime_NestedChurn);
+
+static void BM_Signal_AdviseTerminate(benchmark::State& state)
+{
+	Signal<int32_t> signal;
+	for (auto _ : state)
+	{
+		LifetimeDefinition definition(false);
+		signal.advise(definition.lifetime, [](int32_t const&) {});
+		definition.terminate();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Signal_AdviseTerminate);
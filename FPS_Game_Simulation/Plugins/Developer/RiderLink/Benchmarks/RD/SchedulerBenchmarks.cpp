@@ -0,0 +1,43 @@
+#include "lifetime/LifetimeDefinition.h"
+#include "scheduler/SingleThreadScheduler.h"
+#include "scheduler/SynchronousScheduler.h"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+
+using namespace rd;
+
+static void BM_Scheduler_SynchronousQueue(benchmark::State& state)
+{
+	int64_t executed = 0;
+	for (auto _ : state)
+	{
+		SynchronousScheduler::Instance().queue([&executed] { ++executed; });
+	}
+	benchmark::DoNotOptimize(executed);
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Scheduler_SynchronousQueue);
+
+static void BM_Scheduler_SingleThreadQueueFlush(benchmark::State& state)
+{
+	LifetimeDefinition definition(false);
+	static int32_t instance = 0;
+	// scheduler names are registered as spdlog loggers and must be unique
+	SingleThreadScheduler scheduler(definition.lifetime, "BenchmarkScheduler" + std::to_string(instance++));
+	std::atomic<int64_t> executed{0};
+	const int64_t batch = state.range(0);
+	for (auto _ : state)
+	{
+		for (int64_t i = 0; i < batch; ++i)
+		{
+			scheduler.queue([&executed] { executed.fetch_add(1, std::memory_order_relaxed); });
+		}
+		scheduler.flush();
+	}
+	state.SetItemsProcessed(state.iterations() * batch);
+	// the scheduler stops its pool on lifetime termination, which has to happen while it is still alive
+	definition.terminate();
+}
+BENCHMARK(BM_Scheduler_SingleThreadQueueFlush)->Arg(1)->Arg(256)->UseRealTime();
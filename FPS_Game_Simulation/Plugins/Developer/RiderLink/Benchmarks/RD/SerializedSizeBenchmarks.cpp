@@ -0,0 +1,199 @@
+#include "scheduler/SynchronousScheduler.h"
+#include "serialization/Polymorphic.h"
+#include "serialization/SerializationCtx.h"
+#include "serialization/Serializers.h"
+#include "wire/WireReplay.h"
+
+#include "HeapCounter.h"
+
+#include <benchmark/benchmark.h>
+
+#include <ctime>
+#include <vector>
+
+using namespace rd;
+
+namespace
+{
+enum class Verbosity
+{
+	Log = 5
+};
+
+/**
+ * \brief Stand-ins for the UE4Library log event types (FString is a std::wstring here), written the way the generated
+ * code writes them. Their sizes come from serialized_size_of specializations, as UE4TypesMarshallers.h gives them.
+ */
+struct Range : IPolymorphicSerializable
+{
+	int32_t first_;
+	int32_t last_;
+
+	Range(int32_t first, int32_t last) : first_(first), last_(last)
+	{
+	}
+
+	std::string type_name() const override
+	{
+		return "Range";
+	}
+
+	std::string toString() const override
+	{
+		return type_name();
+	}
+
+	bool equals(ISerializable const&) const override
+	{
+		return false;
+	}
+
+	void write(SerializationCtx&, Buffer& buffer) const override
+	{
+		buffer.write_integral(first_);
+		buffer.write_integral(last_);
+	}
+};
+
+struct Info : IPolymorphicSerializable
+{
+	Verbosity type_ = Verbosity::Log;
+	std::wstring category_;
+	optional<DateTime> time_;
+
+	std::string type_name() const override
+	{
+		return "Info";
+	}
+
+	std::string toString() const override
+	{
+		return type_name();
+	}
+
+	bool equals(ISerializable const&) const override
+	{
+		return false;
+	}
+
+	void write(SerializationCtx& ctx, Buffer& buffer) const override
+	{
+		Polymorphic<Verbosity>::write(ctx, buffer, type_);
+		Polymorphic<std::wstring>::write(ctx, buffer, category_);
+		Polymorphic<optional<DateTime>>::write(ctx, buffer, time_);
+	}
+};
+
+struct Event : IPolymorphicSerializable
+{
+	Wrapper<Info> info_;
+	std::wstring text_;
+	std::vector<Wrapper<Range>> bpPathRanges_;
+	std::vector<Wrapper<Range>> methodRanges_;
+
+	std::string type_name() const override
+	{
+		return "Event";
+	}
+
+	std::string toString() const override
+	{
+		return type_name();
+	}
+
+	bool equals(ISerializable const&) const override
+	{
+		return false;
+	}
+
+	void write(SerializationCtx& ctx, Buffer& buffer) const override
+	{
+		Polymorphic<Wrapper<Info>>::write(ctx, buffer, info_);
+		Polymorphic<std::wstring>::write(ctx, buffer, text_);
+		buffer.write_array<std::vector, Range>(
+			bpPathRanges_, [&ctx, &buffer](Range const& it) { Polymorphic<Range>::write(ctx, buffer, it); });
+		buffer.write_array<std::vector, Range>(
+			methodRanges_, [&ctx, &buffer](Range const& it) { Polymorphic<Range>::write(ctx, buffer, it); });
+	}
+};
+
+Event log_line()
+{
+	Info info;
+	info.category_ = L"LogBlueprintUserMessages";
+	info.time_ = DateTime(std::time(nullptr));
+
+	Event event;
+	event.info_ = wrapper::make_wrapper<Info>(std::move(info));
+	event.text_ =
+		L"[BP_FirstPersonCharacter_C_0] Blueprint Runtime Error: \"Accessed None trying to read property "
+		L"CallFunc_GetPlayerCharacter_ReturnValue\". Node: Set Health Graph: EventGraph";
+	event.bpPathRanges_.emplace_back(wrapper::make_wrapper<Range>(1, 27));
+	event.bpPathRanges_.emplace_back(wrapper::make_wrapper<Range>(129, 139));
+	event.methodRanges_.emplace_back(wrapper::make_wrapper<Range>(116, 126));
+	return event;
+}
+}	 // namespace
+
+namespace rd
+{
+template <>
+struct serialized_size_of<Range>
+{
+	static size_t get(Range const& value)
+	{
+		return sizeof(value.first_) + sizeof(value.last_);
+	}
+};
+
+template <>
+struct serialized_size_of<Info>
+{
+	static size_t get(Info const& value)
+	{
+		return rd::serialized_size<Polymorphic<Verbosity>>(value.type_) +
+			   rd::serialized_size<Polymorphic<std::wstring>>(value.category_) +
+			   rd::serialized_size<Polymorphic<optional<DateTime>>>(value.time_);
+	}
+};
+
+template <>
+struct serialized_size_of<Event>
+{
+	static size_t get(Event const& value)
+	{
+		return rd::serialized_size<Polymorphic<Wrapper<Info>>>(value.info_) +
+			   rd::serialized_size<Polymorphic<std::wstring>>(value.text_) +
+			   serialized_array_size<Polymorphic<Range>>(value.bpPathRanges_) +
+			   serialized_array_size<Polymorphic<Range>>(value.methodRanges_);
+	}
+};
+}	 // namespace rd
+
+/**
+ * \brief Sends a log event shaped like UE4Library's UnrealLogEvent through a wire, without (Arg 0) or with (Arg 1)
+ * its \ref serialized_size as size hint. Counters are per message: storage allocations of the send buffer and the
+ * bytes they took, all of which were zero-filled before Buffer switched to default_init_allocator. Where wchar_t is 4
+ * bytes each wstring also makes a temporary UTF-16 copy, FString doesn't.
+ */
+static void BM_Buffer_SendLogEvent(benchmark::State& state)
+{
+	Serializers serializers;
+	SerializationCtx ctx(&serializers);
+	ReplayWire wire(&SynchronousScheduler::Instance());
+	const Event event = log_line();
+	const bool hint = state.range(0) != 0;
+
+	HeapCounter heap;
+	for (auto _ : state)
+	{
+		wire.send(
+			RdId(1), [&](Buffer& buffer) { event.write(ctx, buffer); }, hint ? rd::serialized_size<Polymorphic<Event>>(event) : 0);
+	}
+
+	const auto messages = static_cast<double>(state.iterations());
+	state.counters["allocations_per_message"] = static_cast<double>(heap.allocations) / messages;
+	state.counters["allocated_bytes_per_message"] = static_cast<double>(heap.allocated_bytes) / messages;
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Buffer_SendLogEvent)->Arg(0)->Arg(1);
@@ -0,0 +1,136 @@
+#include "LogEventModel.h"
+
+#include "serialization/Serializers.h"
+#include "serialization/SerializationCtx.h"
+#include "protocol/Buffer.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace rd;
+
+namespace
+{
+struct BenchmarkValue : IPolymorphicSerializable
+{
+	int32_t value = 0;
+
+	explicit BenchmarkValue(int32_t value = 0) : value(value)
+	{
+	}
+
+	static std::string static_type_name()
+	{
+		return "BenchmarkValue";
+	}
+
+	std::string type_name() const override
+	{
+		return static_type_name();
+	}
+
+	std::string toString() const override
+	{
+		return static_type_name();
+	}
+
+	bool equals(ISerializable const& other) const override
+	{
+		return value == static_cast<BenchmarkValue const&>(other).value;
+	}
+
+	void write(SerializationCtx&, Buffer& buffer) const override
+	{
+		buffer.write_integral(value);
+	}
+
+	static BenchmarkValue read(SerializationCtx&, Buffer& buffer)
+	{
+		return BenchmarkValue(buffer.read_integral<int32_t>());
+	}
+};
+}	 // namespace
+
+static void BM_Serializers_ReadAnyUserType(benchmark::State& state)
+{
+	Serializers serializers;
+	serializers.registry<BenchmarkValue>();
+	SerializationCtx ctx(&serializers);
+	Buffer buffer;
+	for (int32_t i = 0; i < 256; ++i)
+	{
+		serializers.writePolymorphic(ctx, buffer, BenchmarkValue(i));
+	}
+	for (auto _ : state)
+	{
+		buffer.rewind();
+		for (int32_t i = 0; i < 256; ++i)
+		{
+			benchmark::DoNotOptimize(serializers.readAny(ctx, buffer));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * 256);
+}
+BENCHMARK(BM_Serializers_ReadAnyUserType);
+
+static void BM_Serializers_ReadAnyWString(benchmark::State& state)
+{
+	Serializers serializers;
+	SerializationCtx ctx(&serializers);
+	Buffer buffer;
+	for (int32_t i = 0; i < 256; ++i)
+	{
+		serializers.writePolymorphic(ctx, buffer, std::wstring(L"benchmark"));
+	}
+	for (auto _ : state)
+	{
+		buffer.rewind();
+		for (int32_t i = 0; i < 256; ++i)
+		{
+			benchmark::DoNotOptimize(serializers.readAny(ctx, buffer));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * 256);
+}
+BENCHMARK(BM_Serializers_ReadAnyWString);
+
+/**
+ * \brief Reads 1M polymorphic values of three registered types, the shape of UE4Library traffic: every value looks up
+ * its reader by id and wraps the result.
+ */
+static void BM_Serializers_ReadAny1M(benchmark::State& state)
+{
+	using namespace log_event_model;
+	constexpr int32_t VALUES = 1000000;
+	Serializers serializers;
+	serializers.registry<StringRange<wrapper::shared_storage>>();
+	serializers.registry<LogMessageInfo<wrapper::shared_storage>>();
+	serializers.registry<UnrealLogEvent<wrapper::shared_storage>>();
+	SerializationCtx ctx(&serializers);
+	Buffer buffer;
+	const auto event = sample_event<wrapper::shared_storage>(0);
+	for (int32_t i = 0; i < VALUES; ++i)
+	{
+		switch (i % 3)
+		{
+			case 0:
+				serializers.writePolymorphic(ctx, buffer, StringRange<wrapper::shared_storage>(i, i + 1));
+				break;
+			case 1:
+				serializers.writePolymorphic(ctx, buffer, event.info_);
+				break;
+			default:
+				serializers.writePolymorphic(ctx, buffer, event);
+				break;
+		}
+	}
+	for (auto _ : state)
+	{
+		buffer.rewind();
+		for (int32_t i = 0; i < VALUES; ++i)
+		{
+			benchmark::DoNotOptimize(serializers.readAny(ctx, buffer));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * VALUES);
+}
+BENCHMARK(BM_Serializers_ReadAny1M)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,481 @@
+#include "impl/RdSignal.h"
+#include "logging/AsyncLogBackend.h"
+#include "lifetime/LifetimeDefinition.h"
+#include "protocol/Protocol.h"
+#include "scheduler/SynchronousScheduler.h"
+#include "scheduler/TimerWheel.h"
+#include "wire/SocketWire.h"
+#include "wire/WireReplay.h"
+
+#include "spdlog/sinks/basic_file_sink.h"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+using namespace rd;
+
+namespace
+{
+IScheduler* synchronous()
+{
+	return &SynchronousScheduler::Instance();
+}
+
+void quiet_logging()
+{
+	spdlog::set_level(spdlog::level::err);
+}
+
+/**
+ * \brief Binds [signal] as a static top-level entity of [protocol]. Binding must happen on the protocol scheduler.
+ */
+template <typename T>
+void bind_static(RdSignal<T>& signal, int64_t id, Lifetime lifetime, Protocol const& protocol, std::string const& name)
+{
+	synchronous()->queue([&] {
+		statics(signal, id);
+		signal.async = true;
+		signal.bind(lifetime, &protocol, name);
+	});
+}
+
+Buffer::ByteArray signal_message(int32_t value)
+{
+	Buffer buffer;
+	buffer.write_integral<int16_t>(0);	  // context
+	buffer.write_integral(value);
+	return std::move(buffer).getRealArray();
+}
+}	 // namespace
+
+static void BM_MessageBroker_Dispatch(benchmark::State& state)
+{
+	quiet_logging();
+	LifetimeDefinition definition(false);
+	auto wire = std::make_shared<ReplayWire>(synchronous());
+	Protocol protocol(Identities::CLIENT, synchronous(), wire, definition.lifetime);
+	RdSignal<int32_t> signal;
+	bind_static(signal, 1, definition.lifetime, protocol, "signal");
+
+	int64_t received = 0;
+	signal.advise(definition.lifetime, [&received](int32_t const&) { ++received; });
+
+	const auto message = signal_message(42);
+	for (auto _ : state)
+	{
+		wire->dispatch(RdId(1), message);
+	}
+	if (received != static_cast<int64_t>(state.iterations()))
+	{
+		state.SkipWithError("not every message reached the signal");
+	}
+	state.SetItemsProcessed(state.iterations());
+	// entities and the wire advise on this lifetime, it has to be terminated while they are still alive
+	definition.terminate();
+}
+BENCHMARK(BM_MessageBroker_Dispatch);
+
+static void BM_SocketWire_RoundTrip(benchmark::State& state)
+{
+	quiet_logging();
+	LifetimeDefinition definition(false);
+	auto server_wire = std::make_shared<SocketWire::Server>(definition.lifetime, synchronous(), 0, "BenchmarkServer");
+	auto client_wire =
+		std::make_shared<SocketWire::Client>(definition.lifetime, synchronous(), server_wire->port, "BenchmarkClient");
+	Protocol server(Identities::SERVER, synchronous(), server_wire, definition.lifetime);
+	Protocol client(Identities::CLIENT, synchronous(), client_wire, definition.lifetime);
+
+	RdSignal<int32_t> server_request, server_response, client_request, client_response;
+	bind_static(server_request, 1, definition.lifetime, server, "request");
+	bind_static(server_response, 2, definition.lifetime, server, "response");
+	bind_static(client_request, 1, definition.lifetime, client, "request");
+	bind_static(client_response, 2, definition.lifetime, client, "response");
+
+	// the client echoes every request, handlers run right on the wires' receiver threads
+	client_request.advise(definition.lifetime, [&client_response](int32_t const& value) { client_response.fire(value); });
+	std::atomic<int32_t> answered{0};
+	server_response.advise(definition.lifetime, [&answered](int32_t const& value) { answered.store(value); });
+
+	while (!server_wire->connected.get() || !client_wire->connected.get())
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	int32_t sent = 0;
+	for (auto _ : state)
+	{
+		server_request.fire(++sent);
+		while (answered.load() != sent)
+		{
+		}
+	}
+	state.SetItemsProcessed(state.iterations());
+	definition.terminate();
+}
+BENCHMARK(BM_SocketWire_RoundTrip)->UseRealTime()->Iterations(20000);
+
+namespace
+{
+/**
+ * \brief Fires batches of [batch] messages from a server signal and waits until the client has seen the last one.
+ */
+void run_throughput(benchmark::State& state, int32_t batch)
+{
+	LifetimeDefinition definition(false);
+	auto server_wire = std::make_shared<SocketWire::Server>(definition.lifetime, synchronous(), 0, "BenchmarkServer");
+	auto client_wire =
+		std::make_shared<SocketWire::Client>(definition.lifetime, synchronous(), server_wire->port, "BenchmarkClient");
+	Protocol server(Identities::SERVER, synchronous(), server_wire, definition.lifetime);
+	Protocol client(Identities::CLIENT, synchronous(), client_wire, definition.lifetime);
+
+	RdSignal<int32_t> server_signal, client_signal;
+	bind_static(server_signal, 1, definition.lifetime, server, "signal");
+	bind_static(client_signal, 1, definition.lifetime, client, "signal");
+	std::atomic<int32_t> last{0};
+	client_signal.advise(definition.lifetime, [&last](int32_t const& value) { last.store(value); });
+
+	int32_t sent = 0;
+	for (auto _ : state)
+	{
+		for (int32_t i = 0; i < batch; ++i)
+		{
+			server_signal.fire(++sent);
+		}
+		while (last.load() != sent)
+		{
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * batch);
+	definition.terminate();
+}
+}	 // namespace
+
+static void BM_SocketWire_Throughput(benchmark::State& state)
+{
+	quiet_logging();
+	run_throughput(state, static_cast<int32_t>(state.range(0)));
+}
+BENCHMARK(BM_SocketWire_Throughput)->Arg(1024)->UseRealTime();
+
+/**
+ * \brief One-directional stream of 1M messages, reports socket calls per message on both sides. With cumulative
+ * acknowledges the client sends far fewer acknowledges than it receives packages.
+ */
+static void BM_SocketWire_Stream(benchmark::State& state)
+{
+	quiet_logging();
+	constexpr int32_t MESSAGES = 1000000;
+	LifetimeDefinition definition(false);
+	auto server_wire = std::make_shared<SocketWire::Server>(definition.lifetime, synchronous(), 0, "BenchmarkServer");
+	auto client_wire =
+		std::make_shared<SocketWire::Client>(definition.lifetime, synchronous(), server_wire->port, "BenchmarkClient");
+	Protocol server(Identities::SERVER, synchronous(), server_wire, definition.lifetime);
+	Protocol client(Identities::CLIENT, synchronous(), client_wire, definition.lifetime);
+
+	RdSignal<int32_t> server_signal, client_signal;
+	bind_static(server_signal, 1, definition.lifetime, server, "signal");
+	bind_static(client_signal, 1, definition.lifetime, client, "signal");
+	std::atomic<int32_t> last{0};
+	client_signal.advise(definition.lifetime, [&last](int32_t const& value) { last.store(value); });
+
+	while (!server_wire->connected.get() || !client_wire->connected.get())
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	const auto server_before = server_wire->get_metrics_snapshot();
+	const auto client_before = client_wire->get_metrics_snapshot();
+
+	int32_t sent = 0;
+	for (auto _ : state)
+	{
+		for (int32_t i = 0; i < MESSAGES; ++i)
+		{
+			server_signal.fire(++sent);
+		}
+		while (last.load() != sent)
+		{
+		}
+	}
+
+	const auto server_after = server_wire->get_metrics_snapshot();
+	const auto client_after = client_wire->get_metrics_snapshot();
+	const auto per_message = [sent](uint64_t after, uint64_t before) {
+		return static_cast<double>(after - before) / static_cast<double>(sent);
+	};
+	state.counters["server_sends_per_message"] = per_message(server_after.socket_send_calls, server_before.socket_send_calls);
+	state.counters["server_receives_per_message"] =
+		per_message(server_after.socket_receive_calls, server_before.socket_receive_calls);
+	state.counters["client_sends_per_message"] = per_message(client_after.socket_send_calls, client_before.socket_send_calls);
+	state.counters["client_receives_per_message"] =
+		per_message(client_after.socket_receive_calls, client_before.socket_receive_calls);
+	state.SetItemsProcessed(state.iterations() * MESSAGES);
+	definition.terminate();
+}
+BENCHMARK(BM_SocketWire_Stream)->Iterations(1)->UseRealTime();
+
+/**
+ * \brief Throughput with every rd logger writing trace level to a file, inline (Arg 0) or through
+ * \ref AsyncLogBackend (Arg 1).
+ */
+static void BM_SocketWire_ThroughputFileLogging(benchmark::State& state)
+{
+	const std::string path = "rd_benchmark_log.txt";
+	auto file = std::make_shared<spdlog::sinks::basic_file_sink_mt>(path, true);
+	std::vector<std::pair<std::shared_ptr<spdlog::logger>, std::vector<spdlog::sink_ptr>>> saved;
+	spdlog::apply_all([&](std::shared_ptr<spdlog::logger> logger) {
+		saved.emplace_back(logger, logger->sinks());
+		logger->sinks().assign(1, file);
+	});
+	std::shared_ptr<AsyncLogBackend> backend;
+	if (state.range(0) != 0)
+	{
+		backend = std::make_shared<AsyncLogBackend>();
+		backend->attach_all();
+	}
+	spdlog::set_level(spdlog::level::trace);
+
+	run_throughput(state, 1024);
+
+	quiet_logging();
+	if (backend)
+	{
+		backend->flush();
+		state.counters["dropped"] = static_cast<double>(backend->get_dropped());
+		backend.reset();
+	}
+	for (auto& logger : saved)
+	{
+		logger.first->sinks() = std::move(logger.second);
+	}
+	file.reset();
+	std::remove(path.c_str());
+}
+BENCHMARK(BM_SocketWire_ThroughputFileLogging)->Arg(0)->Arg(1)->UseRealTime();
+
+static void BM_WireReplay_Maximum(benchmark::State& state)
+{
+	quiet_logging();
+	std::vector<WireCapture::Record> records;
+	{
+		// synthetic capture of a single signal, one message per package as SocketWire sends them
+		const std::string path = "rd_benchmark_capture.bin";
+		{
+			WireCapture capture(path);
+			for (int32_t i = 0; i < 10000; ++i)
+			{
+				Buffer package;
+				package.write_integral<int32_t>(0);
+				RdId(1).write(package);
+				package.write_integral<int16_t>(0);
+				package.write_integral(i);
+				const auto length = static_cast<int32_t>(package.get_position());
+				package.rewind();
+				package.write_integral<int32_t>(length - 4);
+				capture.append(WireCapture::Direction::Received, i + 1, package.data(), length);
+			}
+		}
+		WireCapture::load(path, records);
+		std::remove(path.c_str());
+	}
+
+	LifetimeDefinition definition(false);
+	auto wire = std::make_shared<ReplayWire>(synchronous());
+	Protocol protocol(Identities::CLIENT, synchronous(), wire, definition.lifetime);
+	RdSignal<int32_t> signal;
+	bind_static(signal, 1, definition.lifetime, protocol, "signal");
+	int64_t received = 0;
+	signal.advise(definition.lifetime, [&received](int32_t const&) { ++received; });
+	wire->get_metrics().set_enabled(state.range(0) != 0);
+
+	for (auto _ : state)
+	{
+		auto stats = WireReplay::replay(records, *wire, WireReplay::Speed::Maximum);
+		state.counters["messages_per_second"] = stats.messages_per_second();
+	}
+	const auto snapshot = wire->get_metrics_snapshot();
+	if (!snapshot.entities.empty() && snapshot.entities.front().messages_in > 0)
+	{
+		auto const& entity = snapshot.entities.front();
+		state.counters["handler_ns_per_message"] =
+			static_cast<double>(entity.handler_total_ns) / static_cast<double>(entity.messages_in);
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(records.size()));
+	definition.terminate();
+}
+BENCHMARK(BM_WireReplay_Maximum)->Arg(0)->Arg(1);
+
+namespace
+{
+/**
+ * \brief Resident set size of the process, -1 where it isn't available.
+ */
+int64_t resident_bytes()
+{
+#if defined(__linux__)
+	std::ifstream statm("/proc/self/statm");
+	int64_t size = 0, resident = 0;
+	if (statm >> size >> resident)
+	{
+		return resident * static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+	}
+#endif
+	return -1;
+}
+}	 // namespace
+
+/**
+ * \brief Soak test of the retransmit window: streams Arg megabytes in 64 KB messages from the server to the client with
+ * the send window capped at 8 MB. Fails when the resident set keeps growing after the first tenth of the stream.
+ */
+static void BM_SocketWire_Soak(benchmark::State& state)
+{
+	quiet_logging();
+	constexpr size_t MESSAGE_CHARS = 32 * 1024;
+	constexpr size_t MAX_WINDOW_BYTES = 8u << 20;
+	constexpr int64_t MAX_RSS_GROWTH = 64 << 20;
+	const int64_t messages = state.range(0) * (1 << 20) / static_cast<int64_t>(MESSAGE_CHARS * sizeof(wchar_t));
+
+	LifetimeDefinition definition(false);
+	auto server_wire = std::make_shared<SocketWire::Server>(definition.lifetime, synchronous(), 0, "BenchmarkServer");
+	auto client_wire =
+		std::make_shared<SocketWire::Client>(definition.lifetime, synchronous(), server_wire->port, "BenchmarkClient");
+	server_wire->set_max_send_window_bytes(MAX_WINDOW_BYTES);
+	Protocol server(Identities::SERVER, synchronous(), server_wire, definition.lifetime);
+	Protocol client(Identities::CLIENT, synchronous(), client_wire, definition.lifetime);
+
+	RdSignal<std::wstring> server_signal, client_signal;
+	bind_static(server_signal, 1, definition.lifetime, server, "signal");
+	bind_static(client_signal, 1, definition.lifetime, client, "signal");
+	std::atomic<int64_t> received{0};
+	client_signal.advise(definition.lifetime, [&received](std::wstring const&) { ++received; });
+
+	const std::wstring payload(MESSAGE_CHARS, L'x');
+	int64_t baseline_rss = -1;
+	int64_t peak_rss = -1;
+	uint64_t peak_window = 0;
+	for (auto _ : state)
+	{
+		for (int64_t i = 0; i < messages; ++i)
+		{
+			server_signal.fire(payload);
+			if (i % 64 == 0)
+			{
+				peak_window = (std::max)(peak_window, server_wire->get_metrics_snapshot().send_window_bytes);
+				const int64_t rss = resident_bytes();
+				if (i >= messages / 10)
+				{
+					baseline_rss = baseline_rss < 0 ? rss : baseline_rss;
+					peak_rss = (std::max)(peak_rss, rss);
+				}
+			}
+		}
+		while (received.load() != messages)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	const auto snapshot = server_wire->get_metrics_snapshot();
+	state.counters["peak_window_mb"] = static_cast<double>(peak_window) / (1 << 20);
+	state.counters["window_overflows"] = static_cast<double>(snapshot.send_window_overflows);
+	if (baseline_rss >= 0)
+	{
+		state.counters["rss_growth_mb"] = static_cast<double>(peak_rss - baseline_rss) / (1 << 20);
+		if (peak_rss - baseline_rss > MAX_RSS_GROWTH)
+		{
+			state.SkipWithError("resident set kept growing while streaming");
+		}
+	}
+	state.SetBytesProcessed(state.iterations() * messages * static_cast<int64_t>(MESSAGE_CHARS * sizeof(wchar_t)));
+	definition.terminate();
+}
+BENCHMARK(BM_SocketWire_Soak)->Arg(10 * 1024)->Iterations(1)->UseRealTime();
+
+namespace
+{
+/**
+ * \brief Threads of the process, -1 where it isn't available.
+ */
+int64_t thread_count()
+{
+#if defined(__linux__)
+	DIR* tasks = opendir("/proc/self/task");
+	if (tasks == nullptr)
+	{
+		return -1;
+	}
+	int64_t count = 0;
+	while (dirent* entry = readdir(tasks))
+	{
+		count += entry->d_name[0] != '.';
+	}
+	closedir(tasks);
+	return count;
+#else
+	return -1;
+#endif
+}
+}	 // namespace
+
+/**
+ * \brief Arg idle loopback server/client pairs, connected and only sending heartbeats. Reports the threads the wires
+ * add to the process and how often the shared timer thread wakes up per second while they sit idle.
+ */
+static void BM_SocketWire_Idle(benchmark::State& state)
+{
+	quiet_logging();
+	constexpr auto IDLE_WINDOW = std::chrono::seconds(2);
+	const int64_t pairs = state.range(0);
+	const int64_t threads_before = thread_count();
+
+	int64_t threads = 0;
+	uint64_t wakeups = 0;
+	for (auto _ : state)
+	{
+		LifetimeDefinition definition(false);
+		std::vector<std::shared_ptr<SocketWire::Base>> wires;
+		for (int64_t i = 0; i < pairs; ++i)
+		{
+			auto server_wire = std::make_shared<SocketWire::Server>(definition.lifetime, synchronous(), 0, "IdleServer");
+			auto client_wire =
+				std::make_shared<SocketWire::Client>(definition.lifetime, synchronous(), server_wire->port, "IdleClient");
+			wires.push_back(std::move(server_wire));
+			wires.push_back(std::move(client_wire));
+		}
+		for (auto const& wire : wires)
+		{
+			while (!wire->connected.get())
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+		}
+
+		const uint64_t wakeups_before = TimerWheel::instance().get_wakeups();
+		std::this_thread::sleep_for(IDLE_WINDOW);
+		wakeups = TimerWheel::instance().get_wakeups() - wakeups_before;
+		threads = thread_count();
+
+		definition.terminate();
+	}
+
+	state.counters["wires"] = static_cast<double>(2 * pairs);
+	if (threads_before >= 0)
+	{
+		state.counters["threads"] = static_cast<double>(threads);
+		state.counters["threads_per_wire"] = static_cast<double>(threads - threads_before) / (2 * pairs);
+	}
+	state.counters["timer_wakeups_per_s"] =
+		static_cast<double>(wakeups) / std::chrono::duration_cast<std::chrono::duration<double>>(IDLE_WINDOW).count();
+}
+BENCHMARK(BM_SocketWire_Idle)->Arg(50)->Iterations(1)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,212 @@
+#include "LogRangeScanner.hpp"
+#include "RiderLogRing.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using clock_type = std::chrono::steady_clock;
+
+/**
+ * \brief FRiderLogRecord without the engine: the message and the time it was captured.
+ */
+struct FRecord
+{
+	std::string Message;
+	clock_type::time_point CaptureTime;
+};
+
+// the sizes FRiderLoggingModule uses
+constexpr int32_t LOG_BUFFER_CAPACITY = 16 * 1024;
+constexpr int32_t MAX_BATCH_SIZE = 256;
+
+/**
+ * \brief FRiderLoggingModule's side of the buffer: the ring behind a lock, and a drain which is only requested when
+ * none is pending. The drain runs on its own thread like the logging scheduler, scans every line the way the events
+ * are built and then waits DeliveryMicros per batch, standing in for FireAsyncAction.
+ */
+class FLoggingModel
+{
+public:
+	explicit FLoggingModel(int64_t InDeliveryMicros)
+		: Ring(LOG_BUFFER_CAPACITY), DeliveryMicros(InDeliveryMicros), Drainer([this] { Run(); })
+	{
+	}
+
+	~FLoggingModel()
+	{
+		{
+			std::lock_guard<std::mutex> Guard(DrainLock);
+			bStopping = true;
+		}
+		DrainRequested.notify_one();
+		Drainer.join();
+	}
+
+	void Push(std::string Message)
+	{
+		{
+			std::lock_guard<std::mutex> Guard(Lock);
+			if (!Ring.Push({std::move(Message), clock_type::now()}))
+			{
+				return;
+			}
+		}
+		if (!bDrainQueued.exchange(true))
+		{
+			std::lock_guard<std::mutex> Guard(DrainLock);
+			bDrainPending = true;
+			DrainRequested.notify_one();
+		}
+	}
+
+	/** Blocks until every record that went into the ring is delivered */
+	void Flush()
+	{
+		while (true)
+		{
+			{
+				std::lock_guard<std::mutex> Guard(Lock);
+				if (Ring.GetStats().Delivered == Ring.GetStats().Pushed)
+				{
+					return;
+				}
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	RiderLogRing::FStats GetStats() const
+	{
+		std::lock_guard<std::mutex> Guard(Lock);
+		return Ring.GetStats();
+	}
+
+private:
+	void Run()
+	{
+		std::vector<FRecord> Records;
+		std::vector<LogRangeScanner::FRange> Paths, Methods;
+		std::unique_lock<std::mutex> DrainGuard(DrainLock);
+		while (true)
+		{
+			DrainRequested.wait(DrainGuard, [this] { return bDrainPending || bStopping; });
+			if (!bDrainPending)
+			{
+				return;
+			}
+			bDrainPending = false;
+			DrainGuard.unlock();
+			Drain(Records, Paths, Methods);
+			DrainGuard.lock();
+		}
+	}
+
+	void Drain(std::vector<FRecord>& Records, std::vector<LogRangeScanner::FRange>& Paths,
+		std::vector<LogRangeScanner::FRange>& Methods)
+	{
+		bDrainQueued = false;
+		while (true)
+		{
+			{
+				std::lock_guard<std::mutex> Guard(Lock);
+				Ring.Pop(MAX_BATCH_SIZE, [&Records](FRecord&& Record) { Records.push_back(std::move(Record)); });
+				Ring.TakeDroppedSinceLastCall();
+			}
+			if (Records.empty())
+			{
+				return;
+			}
+			for (const FRecord& Record : Records)
+			{
+				Paths.clear();
+				Methods.clear();
+				LogRangeScanner::Scan(Record.Message.data(), static_cast<int32_t>(Record.Message.size()), Paths, Methods);
+				benchmark::DoNotOptimize(Paths.data());
+			}
+			if (DeliveryMicros > 0)
+			{
+				std::this_thread::sleep_for(std::chrono::microseconds(DeliveryMicros));
+			}
+			const double Latency =
+				std::chrono::duration<double>(clock_type::now() - Records.front().CaptureTime).count();
+			{
+				std::lock_guard<std::mutex> Guard(Lock);
+				Ring.ReportDelivered(static_cast<int32_t>(Records.size()), Latency);
+			}
+			Records.clear();
+		}
+	}
+
+	mutable std::mutex Lock;
+	RiderLogRing::TRing<FRecord> Ring;
+	const int64_t DeliveryMicros;
+
+	std::atomic<bool> bDrainQueued{false};
+	std::mutex DrainLock;
+	std::condition_variable DrainRequested;
+	bool bDrainPending = false;
+	bool bStopping = false;
+	std::thread Drainer;
+};
+}	 // namespace
+
+/**
+ * \brief Log storm: one thread logs Arg0 lines per second for two seconds while Rider takes Arg1 microseconds to
+ * accept each batch of 256. Reports what the bounded buffer did about it: lines dropped, the deepest the buffer got
+ * (and the memory that held), and the worst capture-to-delivery latency.
+ */
+static void BM_RiderLogBuffer_Storm(benchmark::State& state)
+{
+	constexpr int64_t STORM_SECONDS = 2;
+	constexpr int64_t LINES_PER_TICK_MS = 1;
+	const int64_t lines_per_second = state.range(0);
+	const int64_t lines_per_tick = lines_per_second * LINES_PER_TICK_MS / 1000;
+	const std::string line =
+		"LogBlueprintUserMessages: [BP_Enemy_C_3] /Game/Blueprints/BP_Enemy.BP_Enemy_C called AEnemy::ReceiveTick #";
+
+	RiderLogRing::FStats stats;
+	size_t message_bytes = 0;
+	for (auto _ : state)
+	{
+		FLoggingModel model(state.range(1));
+		auto tick = clock_type::now();
+		int64_t pushed = 0;
+		for (int64_t ms = 0; ms < STORM_SECONDS * 1000; ms += LINES_PER_TICK_MS)
+		{
+			for (int64_t i = 0; i < lines_per_tick; ++i, ++pushed)
+			{
+				std::string message = line + std::to_string(pushed);
+				message_bytes = message.capacity();
+				model.Push(std::move(message));
+			}
+			tick += std::chrono::milliseconds(LINES_PER_TICK_MS);
+			std::this_thread::sleep_until(tick);
+		}
+		model.Flush();
+		stats = model.GetStats();
+	}
+
+	state.counters["Pushed"] = static_cast<double>(stats.Pushed);
+	state.counters["Dropped"] = static_cast<double>(stats.Dropped);
+	state.counters["HighWatermark"] = static_cast<double>(stats.HighWatermark);
+	state.counters["MaxLatencyMs"] = stats.MaxLatencySeconds * 1000.0;
+	state.counters["RingKB"] = static_cast<double>(LOG_BUFFER_CAPACITY * sizeof(FRecord)) / 1024;
+	state.counters["PeakQueuedKB"] =
+		static_cast<double>(static_cast<size_t>(stats.HighWatermark) * (sizeof(FRecord) + message_bytes)) / 1024;
+	state.SetItemsProcessed(state.iterations() * lines_per_second * STORM_SECONDS);
+}
+BENCHMARK(BM_RiderLogBuffer_Storm)
+	->Args({100000, 0})
+	->Args({100000, 5000})
+	->Iterations(1)
+	->UseRealTime()
+	->Unit(benchmark::kMillisecond);
@@ -0,0 +1,398 @@
+#include "AsyncLogBackend.h"
+
+#include "spdlog/sinks/sink.h"
+
+#include <algorithm>
+#include <array>
+#include <csignal>
+#include <exception>
+
+namespace rd
+{
+constexpr size_t AsyncLogBackend::DEFAULT_CAPACITY;
+constexpr std::chrono::milliseconds AsyncLogBackend::FLUSH_INTERVAL;
+constexpr std::chrono::milliseconds AsyncLogBackend::BATCH_DELAY;
+
+namespace
+{
+constexpr auto CRASH_LOCK_TIMEOUT = std::chrono::milliseconds(100);
+
+// leaked on purpose: crash hooks may run during static destruction
+std::timed_mutex& live_backends_lock()
+{
+	static auto* lock = new std::timed_mutex();
+	return *lock;
+}
+
+std::vector<AsyncLogBackend*>& live_backends()
+{
+	static auto* backends = new std::vector<AsyncLogBackend*>();
+	return *backends;
+}
+
+size_t round_up_to_power_of_two(size_t value)
+{
+	size_t result = 2;
+	while (result < value)
+	{
+		result <<= 1;
+	}
+	return result;
+}
+
+std::terminate_handler previous_terminate = nullptr;
+
+std::array<std::pair<int, void (*)(int)>, 4> previous_signal_handlers{{
+	{SIGSEGV, SIG_DFL},
+	{SIGABRT, SIG_DFL},
+	{SIGFPE, SIG_DFL},
+	{SIGILL, SIG_DFL},
+}};
+
+void on_terminate()
+{
+	AsyncLogBackend::flush_all();
+	if (previous_terminate != nullptr)
+	{
+		previous_terminate();
+	}
+	std::abort();
+}
+
+void on_fatal_signal(int signal)
+{
+	AsyncLogBackend::flush_all();
+	for (auto const& previous : previous_signal_handlers)
+	{
+		if (previous.first == signal)
+		{
+			std::signal(signal, previous.second == SIG_ERR ? SIG_DFL : previous.second);
+		}
+	}
+	std::raise(signal);
+}
+}	 // namespace
+
+/**
+ * \brief Stands in for the original sinks of an attached logger and queues its records to the backend.
+ */
+class AsyncLogBackend::Sink : public spdlog::sinks::sink
+{
+public:
+	std::weak_ptr<AsyncLogBackend> backend;
+	std::vector<spdlog::sink_ptr> downstream;
+
+	Sink(std::weak_ptr<AsyncLogBackend> backend, std::vector<spdlog::sink_ptr> downstream)
+		: backend(std::move(backend)), downstream(std::move(downstream))
+	{
+	}
+
+	void write(spdlog::details::log_msg const& msg) const
+	{
+		for (auto const& sink : downstream)
+		{
+			if (sink->should_log(msg.level))
+			{
+				sink->log(msg);
+			}
+		}
+	}
+
+	void log(spdlog::details::log_msg const& msg) override
+	{
+		if (auto owner = backend.lock())
+		{
+			owner->push(this, msg);
+			return;
+		}
+		write(msg);
+	}
+
+	void flush() override
+	{
+		if (auto owner = backend.lock())
+		{
+			owner->flush();
+			return;
+		}
+		for (auto const& sink : downstream)
+		{
+			sink->flush();
+		}
+	}
+
+	void set_pattern(std::string const& pattern) override
+	{
+		for (auto const& sink : downstream)
+		{
+			sink->set_pattern(pattern);
+		}
+	}
+
+	void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override
+	{
+		for (auto const& sink : downstream)
+		{
+			sink->set_formatter(sink_formatter->clone());
+		}
+	}
+};
+
+AsyncLogBackend::AsyncLogBackend(size_t capacity, OverflowPolicy policy)
+	: policy(policy), mask(round_up_to_power_of_two(capacity) - 1), ring(new Slot[mask + 1])
+{
+	for (size_t i = 0; i <= mask; ++i)
+	{
+		ring[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	{
+		std::lock_guard<std::timed_mutex> guard(live_backends_lock());
+		live_backends().push_back(this);
+	}
+	writer = std::thread([this] { run(); });
+}
+
+AsyncLogBackend::~AsyncLogBackend()
+{
+	{
+		std::lock_guard<std::timed_mutex> guard(live_backends_lock());
+		auto& backends = live_backends();
+		backends.erase(std::remove(backends.begin(), backends.end(), this), backends.end());
+	}
+	{
+		std::lock_guard<std::mutex> guard(wake_lock);
+		stopping = true;
+		wake_cv.notify_one();
+	}
+	writer.join();
+}
+
+bool AsyncLogBackend::push(Sink const* target, spdlog::details::log_msg const& msg)
+{
+	size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+	Slot* slot = nullptr;
+	while (true)
+	{
+		slot = &ring[pos & mask];
+		const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+		const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+		if (diff == 0)
+		{
+			if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (diff < 0)
+		{
+			// full, the writer hasn't released this slot since the previous lap
+			if (policy == OverflowPolicy::Drop)
+			{
+				dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			wake_writer();
+			std::this_thread::yield();
+			pos = enqueue_pos.load(std::memory_order_relaxed);
+		}
+		else
+		{
+			pos = enqueue_pos.load(std::memory_order_relaxed);
+		}
+	}
+
+	slot->target = target;
+	slot->msg = spdlog::details::log_msg_buffer(msg);
+	slot->sequence.store(pos + 1, std::memory_order_release);
+
+	// pairs with the fence in run(): either the writer sees the record or we see it going to sleep
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (writer_sleeping.load(std::memory_order_relaxed))
+	{
+		wake_writer();
+	}
+	return true;
+}
+
+bool AsyncLogBackend::has_records() const
+{
+	return ring[dequeue_pos & mask].sequence.load(std::memory_order_acquire) == dequeue_pos + 1;
+}
+
+size_t AsyncLogBackend::drain()
+{
+	size_t written = 0;
+	while (has_records())
+	{
+		Slot& slot = ring[dequeue_pos & mask];
+		slot.target->write(slot.msg);
+		slot.sequence.store(dequeue_pos + mask + 1, std::memory_order_release);
+		++dequeue_pos;
+		++written;
+	}
+	return written;
+}
+
+void AsyncLogBackend::flush_sinks()
+{
+	std::lock_guard<std::mutex> guard(sinks_lock);
+	for (auto const& sink : sinks)
+	{
+		for (auto const& downstream : sink->downstream)
+		{
+			downstream->flush();
+		}
+	}
+}
+
+void AsyncLogBackend::wake_writer()
+{
+	std::lock_guard<std::mutex> guard(wake_lock);
+	wake_cv.notify_one();
+}
+
+void AsyncLogBackend::run()
+{
+	using clock = std::chrono::steady_clock;
+
+	auto last_flush = clock::now();
+	bool dirty = false;
+	while (true)
+	{
+		uint64_t requested = 0;
+		bool stop = false;
+		{
+			std::lock_guard<std::mutex> guard(wake_lock);
+			requested = flush_requests;
+			stop = stopping;
+		}
+
+		size_t written = 0;
+		{
+			std::lock_guard<std::timed_mutex> guard(drain_lock);
+			written = drain();
+		}
+		dirty = dirty || written > 0;
+
+		if (requested != flushes || (dirty && clock::now() - last_flush >= FLUSH_INTERVAL))
+		{
+			flush_sinks();
+			dirty = false;
+			last_flush = clock::now();
+			std::lock_guard<std::mutex> guard(wake_lock);
+			flushes = requested;
+			flushed_cv.notify_all();
+			continue;
+		}
+		if (written > 0)
+		{
+			// let records pile up instead of being woken up for each of them by the logging threads
+			std::this_thread::sleep_for(BATCH_DELAY);
+			continue;
+		}
+		if (stop)
+		{
+			break;
+		}
+
+		std::unique_lock<std::mutex> lock(wake_lock);
+		if (stopping || flush_requests != flushes)
+		{
+			continue;
+		}
+		writer_sleeping.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (!has_records())
+		{
+			// nothing to flush means nothing to wake up for until the next record
+			if (dirty)
+			{
+				wake_cv.wait_for(lock, FLUSH_INTERVAL);
+			}
+			else
+			{
+				wake_cv.wait(lock);
+			}
+		}
+		writer_sleeping.store(false, std::memory_order_relaxed);
+	}
+
+	if (dirty)
+	{
+		flush_sinks();
+	}
+}
+
+void AsyncLogBackend::attach(std::shared_ptr<spdlog::logger> const& logger)
+{
+	auto& logger_sinks = logger->sinks();
+	for (auto const& sink : logger_sinks)
+	{
+		if (auto attached = std::dynamic_pointer_cast<Sink>(sink))
+		{
+			if (attached->backend.lock().get() == this)
+			{
+				return;
+			}
+		}
+	}
+	auto sink = std::make_shared<Sink>(weak_from_this(), std::move(logger_sinks));
+	logger_sinks.assign(1, sink);
+
+	std::lock_guard<std::mutex> guard(sinks_lock);
+	sinks.push_back(std::move(sink));
+}
+
+void AsyncLogBackend::attach_all()
+{
+	spdlog::apply_all([this](std::shared_ptr<spdlog::logger> logger) { attach(logger); });
+}
+
+void AsyncLogBackend::flush()
+{
+	if (std::this_thread::get_id() == writer.get_id())
+	{
+		flush_sinks();
+		return;
+	}
+	std::unique_lock<std::mutex> lock(wake_lock);
+	const uint64_t ticket = ++flush_requests;
+	wake_cv.notify_one();
+	flushed_cv.wait(lock, [this, ticket] { return flushes >= ticket; });
+}
+
+uint64_t AsyncLogBackend::get_dropped() const
+{
+	return dropped.load(std::memory_order_relaxed);
+}
+
+void AsyncLogBackend::flush_all()
+{
+	std::unique_lock<std::timed_mutex> registry(live_backends_lock(), CRASH_LOCK_TIMEOUT);
+	if (!registry.owns_lock())
+	{
+		return;
+	}
+	for (auto* backend : live_backends())
+	{
+		std::unique_lock<std::timed_mutex> guard(backend->drain_lock, CRASH_LOCK_TIMEOUT);
+		if (guard.owns_lock())
+		{
+			backend->drain();
+			backend->flush_sinks();
+		}
+	}
+}
+
+void AsyncLogBackend::install_crash_handler()
+{
+	static std::once_flag installed;
+	std::call_once(installed, [] {
+		previous_terminate = std::set_terminate(on_terminate);
+		for (auto& previous : previous_signal_handlers)
+		{
+			previous.second = std::signal(previous.first, on_fatal_signal);
+		}
+	});
+}
+}	 // namespace rd
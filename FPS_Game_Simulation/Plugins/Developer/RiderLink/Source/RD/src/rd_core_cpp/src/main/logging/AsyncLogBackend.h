@@ -0,0 +1,162 @@
+#ifndef RD_CPP_ASYNCLOGBACKEND_H
+#define RD_CPP_ASYNCLOGBACKEND_H
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4251)
+#endif
+
+#include "spdlog/spdlog.h"
+#include "spdlog/details/log_msg_buffer.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <rd_core_export.h>
+
+namespace rd
+{
+/**
+ * \brief Asynchronous delivery of spdlog records to the sinks of attached loggers.
+ *
+ * Logging threads copy the record (the fmt-formatted payload, logger name, level, time and thread) into a bounded
+ * lock-free ring and return. A single writer thread runs the sinks: pattern formatting, colouring and file I/O happen
+ * there, off the wire and scheduler threads. Sinks of an attached logger must only be touched through the backend
+ * afterwards.
+ *
+ * The backend is owned through a shared_ptr, loggers which outlive it fall back to logging synchronously.
+ */
+class RD_CORE_API AsyncLogBackend : public std::enable_shared_from_this<AsyncLogBackend>
+{
+public:
+	/**
+	 * \brief What a logging thread does when the ring is full.
+	 */
+	enum class OverflowPolicy
+	{
+		/**
+		 * \brief Waits for the writer to free a slot, no record is lost.
+		 */
+		Block,
+		/**
+		 * \brief Drops the record and counts it, see \ref get_dropped.
+		 */
+		Drop
+	};
+
+	static constexpr size_t DEFAULT_CAPACITY = 8192;
+
+	/**
+	 * \brief Sinks are flushed by the writer at least this often while records keep coming.
+	 */
+	static constexpr std::chrono::milliseconds FLUSH_INTERVAL{1000};
+
+	/**
+	 * \brief Pause of the writer after a non-empty batch. Logging threads only wake the writer once it has found
+	 * the ring empty, so under steady traffic they never make a syscall.
+	 */
+	static constexpr std::chrono::milliseconds BATCH_DELAY{1};
+
+private:
+	class Sink;
+
+	struct Slot
+	{
+		std::atomic<size_t> sequence{0};
+		Sink const* target = nullptr;
+		spdlog::details::log_msg_buffer msg;
+	};
+
+	const OverflowPolicy policy;
+	const size_t mask;
+	std::unique_ptr<Slot[]> ring;
+
+	alignas(64) std::atomic<size_t> enqueue_pos{0};
+	alignas(64) size_t dequeue_pos = 0;
+	std::atomic<uint64_t> dropped{0};
+
+	std::mutex sinks_lock;
+	std::vector<std::shared_ptr<Sink>> sinks;
+
+	// serializes the writer thread with \ref flush_all draining on a crashing thread
+	std::timed_mutex drain_lock;
+
+	std::mutex wake_lock;
+	std::condition_variable wake_cv;
+	std::condition_variable flushed_cv;
+	std::atomic<bool> writer_sleeping{false};
+	uint64_t flush_requests = 0;
+	uint64_t flushes = 0;
+	bool stopping = false;
+	std::thread writer;
+
+	bool push(Sink const* target, spdlog::details::log_msg const& msg);
+
+	bool has_records() const;
+
+	size_t drain();
+
+	void flush_sinks();
+
+	void wake_writer();
+
+	void run();
+
+public:
+	// region ctor/dtor
+
+	/**
+	 * \param capacity number of records the ring holds, rounded up to a power of two
+	 */
+	explicit AsyncLogBackend(size_t capacity = DEFAULT_CAPACITY, OverflowPolicy policy = OverflowPolicy::Block);
+
+	AsyncLogBackend(AsyncLogBackend const&) = delete;
+
+	AsyncLogBackend& operator=(AsyncLogBackend const&) = delete;
+
+	/**
+	 * \brief Writes out every queued record, flushes the sinks and stops the writer.
+	 */
+	virtual ~AsyncLogBackend();
+	// endregion
+
+	/**
+	 * \brief Moves the current sinks of [logger] behind the backend.
+	 */
+	void attach(std::shared_ptr<spdlog::logger> const& logger);
+
+	/**
+	 * \brief Attaches every logger in the spdlog registry.
+	 */
+	void attach_all();
+
+	/**
+	 * \brief Blocks until every record queued before the call is written and the sinks are flushed.
+	 */
+	void flush();
+
+	uint64_t get_dropped() const;
+
+	/**
+	 * \brief Crash hook: drains every live backend on the calling thread and flushes its sinks. Best effort, it gives
+	 * up on a backend whose writer doesn't yield within a short timeout.
+	 */
+	static void flush_all();
+
+	/**
+	 * \brief Installs \ref flush_all as std::terminate handler and for fatal signals, then chains to the previous
+	 * behaviour. For standalone processes, hosts with their own crash reporting should call \ref flush_all from it.
+	 */
+	static void install_crash_handler();
+};
+}	 // namespace rd
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+#endif	  // RD_CPP_ASYNCLOGBACKEND_H
@@ -2,6 +2,7 @@
 #define RD_CPP_CORE_VIEWABLELIST_H
 
 #include "base/IViewableList.h"
+#include "base/viewable_storage.h"
 #include "reactive/base/SignalX.h"
 #include "util/core_util.h"
 
@@ -13,26 +14,31 @@ namespace rd
 {
 /**
  * \brief complete class which has @code IViewableList<T>'s properties
+ * \tparam S storage policy of the elements, see \ref viewable_storage
  */
-template <typename T, typename A = allocator<T>>
+template <typename T, typename A = allocator<T>, typename S = viewable_storage_t<T>>
 class ViewableList : public IViewableList<T>
 {
 public:
 	using Event = typename IViewableList<T>::Event;
 
 private:
-	using WA = typename std::allocator_traits<A>::template rebind_alloc<Wrapper<T>>;
+	using E = typename S::template element_t<T>;
+	using EA = typename std::allocator_traits<A>::template rebind_alloc<E>;
 
-	using data_t = std::vector<Wrapper<T>, WA>;
+	using data_t = std::vector<E, EA>;
 	mutable data_t list;
 	Signal<Event> change;
 
+	// Wrapped copies of inline elements handed out by getList
+	mutable std::vector<Wrapper<T>> wrapped_copies;
+
 protected:
 	using WT = typename IViewableList<T>::WT;
 
 	const std::vector<Wrapper<T>>& getList() const override
 	{
-		return list;
+		return S::wrappers(list, wrapped_copies);
 	}
 
 public:
@@ -52,7 +58,7 @@ public:
 public:
 	class iterator
 	{
-		friend class ViewableList<T>;
+		friend class ViewableList;
 
 		typename data_t::iterator it_;
 
@@ -162,22 +168,22 @@ public:
 
 		reference operator*() noexcept
 		{
-			return **it_;
+			return S::get(*it_);
 		}
 
 		reference operator*() const noexcept
 		{
-			return **it_;
+			return S::get(*it_);
 		}
 
 		pointer operator->() noexcept
 		{
-			return (*it_).get();
+			return &S::get(*it_);
 		}
 
 		pointer operator->() const noexcept
 		{
-			return (*it_).get();
+			return &S::get(*it_);
 		}
 	};
 
@@ -211,21 +217,21 @@ public:
 		change.advise(lifetime, handler);
 		for (int32_t i = 0; i < static_cast<int32_t>(size()); ++i)
 		{
-			handler(typename Event::Add(i, &(*list[i])));
+			handler(typename Event::Add(i, &S::get(list[i])));
 		}
 	}
 
 	bool add(WT element) const override
 	{
 		list.emplace_back(std::move(element));
-		change.fire(typename Event::Add(static_cast<int32_t>(size()) - 1, &(*list.back())));
+		change.fire(typename Event::Add(static_cast<int32_t>(size()) - 1, &S::get(list.back())));
 		return true;
 	}
 
 	bool add(size_t index, WT element) const override
 	{
 		list.emplace(list.begin() + index, std::move(element));
-		change.fire(typename Event::Add(static_cast<int32_t>(index), &(*list[index])));
+		change.fire(typename Event::Add(static_cast<int32_t>(index), &S::get(list[index])));
 		return true;
 	}
 
@@ -234,13 +240,13 @@ public:
 		auto res = std::move(list[index]);
 		list.erase(list.begin() + index);
 
-		change.fire(typename Event::Remove(static_cast<int32_t>(index), &(*res)));
-		return wrapper::unwrap<T>(std::move(res));
+		change.fire(typename Event::Remove(static_cast<int32_t>(index), &S::get(res)));
+		return S::release(std::move(res));
 	}
 
 	bool remove(T const& element) const override
 	{
-		auto it = std::find_if(list.begin(), list.end(), [&element](auto const& p) { return *p == element; });
+		auto it = std::find_if(list.begin(), list.end(), [&element](E const& e) { return S::get(e) == element; });
 		if (it == list.end())
 		{
 			return false;
@@ -251,15 +257,15 @@ public:
 
 	T const& get(size_t index) const override
 	{
-		return *list[index];
+		return S::get(list[index]);
 	}
 
 	WT set(size_t index, WT element) const override
 	{
 		auto old_value = std::move(list[index]);
-		list[index] = Wrapper<T>(std::move(element));
-		change.fire(typename Event::Update(static_cast<int32_t>(index), &(*old_value), &(*list[index])));	   //???
-		return wrapper::unwrap<T>(std::move(old_value));
+		list[index] = S::template make<T>(std::move(element));
+		change.fire(typename Event::Update(static_cast<int32_t>(index), &S::get(old_value), &S::get(list[index])));	   //???
+		return S::release(std::move(old_value));
 	}
 
 	bool addAll(size_t index, std::vector<WT> elements) const override
@@ -286,7 +292,7 @@ public:
 		std::vector<Event> changes;
 		for (size_t i = size(); i > 0; --i)
 		{
-			changes.push_back(typename Event::Remove(static_cast<int32_t>(i - 1), &(*list[i - 1])));
+			changes.push_back(typename Event::Remove(static_cast<int32_t>(i - 1), &S::get(list[i - 1])));
 		}
 		for (auto const& e : changes)
 		{
@@ -303,9 +309,9 @@ public:
 		bool res = false;
 		for (size_t i = list.size(); i > 0; --i)
 		{
-			auto const& x = list[i - 1];
+			auto const& x = S::get(list[i - 1]);
 			if (std::count_if(elements.begin(), elements.end(),
-					[&x](auto const& elem) { return wrapper::TransparentKeyEqual<T>()(elem, x); }) > 0)
+					[&x](auto const& elem) { return wrapper::TransparentKeyEqual<T>()(wrapper::get<T>(elem), x); }) > 0)
 			{
 				removeAt(i - 1);
 				res = true;
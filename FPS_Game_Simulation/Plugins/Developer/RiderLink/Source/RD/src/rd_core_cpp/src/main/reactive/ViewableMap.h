@@ -2,6 +2,7 @@
 #define RD_CPP_CORE_VIEWABLE_MAP_H
 
 #include "base/IViewableMap.h"
+#include "base/viewable_storage.h"
 #include "reactive/base/SignalX.h"
 
 #include <util/core_util.h>
@@ -16,8 +17,10 @@ namespace rd
 {
 /**
  * \brief complete class which has @code IViewableMap<K, V>'s properties
+ * \tparam VS storage policy of the values, see \ref viewable_storage
  */
-template <typename K, typename V, typename KA = std::allocator<K>, typename VA = std::allocator<V>>
+template <typename K, typename V, typename KA = std::allocator<K>, typename VA = std::allocator<V>,
+	typename VS = viewable_storage_t<V>>
 class ViewableMap : public IViewableMap<K, V>
 {
 public:
@@ -27,11 +30,16 @@ private:
 	using WK = typename IViewableMap<K, V>::WK;
 	using WV = typename IViewableMap<K, V>::WV;
 	using OV = typename IViewableMap<K, V>::OV;
-	using PA = typename std::allocator_traits<VA>::template rebind_alloc<std::pair<Wrapper<K>, Wrapper<V>>>;
+	// Keys keep their address while in the map: ordered_map shifts its entries on erase and IViewableMap::view keys
+	// its lifetimes by key address
+	using KS = viewable::wrapped_storage;
+	using EK = typename KS::template element_t<K>;
+	using EV = typename VS::template element_t<V>;
+	using PA = typename std::allocator_traits<VA>::template rebind_alloc<std::pair<EK, EV>>;
 
 	Signal<Event> change;
 
-	using data_t = ordered_map<Wrapper<K>, Wrapper<V>, wrapper::TransparentHash<K>, wrapper::TransparentKeyEqual<K>, PA>;
+	using data_t = ordered_map<EK, EV, wrapper::TransparentHash<K>, wrapper::TransparentKeyEqual<K>, PA>;
 	mutable data_t map;
 
 public:
@@ -51,7 +59,7 @@ public:
 public:
 	class iterator
 	{
-		friend class ViewableMap<K, V>;
+		friend class ViewableMap;
 
 		mutable typename data_t::iterator it_;
 
@@ -162,22 +170,22 @@ public:
 
 		reference operator*() const noexcept
 		{
-			return *it_.value();
+			return VS::get(it_.value());
 		}
 
 		pointer operator->() const noexcept
 		{
-			return it_.value().get();
+			return &VS::get(it_.value());
 		}
 
 		key_type const& key() const
 		{
-			return *it_.key();
+			return KS::get(it_.key());
 		}
 
 		value_type const& value() const
 		{
-			return *it_.value();
+			return VS::get(it_.value());
 		}
 	};
 
@@ -247,7 +255,7 @@ public:
 		{
 			auto& key = it.first;
 			auto& value = it.second;
-			handler(Event(typename Event::Add(&(*key), &(*value))));
+			handler(Event(typename Event::Add(&KS::get(key), &VS::get(value))));
 			;
 		}
 	}
@@ -259,7 +267,7 @@ public:
 		{
 			return nullptr;
 		}
-		return &(*it->second);
+		return &VS::get(it->second);
 	}
 
 	const V* set(WK key, WV value) const override
@@ -271,7 +279,7 @@ public:
 			auto& it = node.first;
 			auto const& key_ptr = it->first;
 			auto const& value_ptr = it->second;
-			change.fire(typename Event::Add(&(*key_ptr), &(*value_ptr)));
+			change.fire(typename Event::Add(&KS::get(key_ptr), &VS::get(value_ptr)));
 			return nullptr;
 		}
 		else
@@ -280,14 +288,14 @@ public:
 			auto const& key_ptr = it->first;
 			auto const& value_ptr = it->second;
 
-			if (*value_ptr != wrapper::get<V>(value))
+			if (VS::get(value_ptr) != wrapper::get<V>(value))
 			{	 // TO-DO more effective
-				Wrapper<V> old_value = std::move(map.at(key));
+				EV old_value = std::move(map.at(key));
 
-				map.at(key_ptr) = Wrapper<V>(std::move(value));
-				change.fire(typename Event::Update(&(*key_ptr), &(*old_value), &(*value_ptr)));
+				map.at(key_ptr) = VS::template make<V>(std::move(value));
+				change.fire(typename Event::Update(&KS::get(key_ptr), &VS::get(old_value), &VS::get(value_ptr)));
 			}
-			return &*(value_ptr);
+			return &VS::get(value_ptr);
 		}
 	}
 
@@ -295,10 +303,10 @@ public:
 	{
 		if (map.count(key) > 0)
 		{
-			Wrapper<V> old_value = std::move(map.at(key));
-			change.fire(typename Event::Remove(&key, &(*old_value)));
+			EV old_value = std::move(map.at(key));
+			change.fire(typename Event::Remove(&key, &VS::get(old_value)));
 			map.erase(key);
-			return wrapper::unwrap<V>(std::move(old_value));
+			return VS::release(std::move(old_value));
 		}
 		return nullopt;
 	}
@@ -309,7 +317,7 @@ public:
 		/*for (auto const &[key, value] : map) {*/
 		for (auto const& it : map)
 		{
-			changes.push_back(typename Event::Remove(&(*it.first), &(*it.second)));
+			changes.push_back(typename Event::Remove(&KS::get(it.first), &VS::get(it.second)));
 		}
 		for (auto const& it : changes)
 		{
@@ -234,19 +234,24 @@ public:
 		return set(index, WT{std::forward<Args>(args)...});
 	}
 
-	template <typename U>
-	friend typename std::enable_if<(!std::is_abstract<U>::value), std::vector<U>>::type convert_to_list(
-		IViewableList<U> const& list);
-
 protected:
+	/**
+	 * \brief Elements of the list as wrappers. Implementations storing their elements inline return wrapped copies,
+	 * see viewable_storage.
+	 */
 	virtual const std::vector<Wrapper<T>>& getList() const = 0;
 };
 
 template <typename T>
 typename std::enable_if<(!std::is_abstract<T>::value), std::vector<T>>::type convert_to_list(IViewableList<T> const& list)
 {
-	std::vector<T> res(list.size());
-	std::transform(list.getList().begin(), list.getList().end(), res.begin(), [](Wrapper<T> const& ptr) { return *ptr; });
+	// implementations store their elements differently, see viewable_storage
+	std::vector<T> res;
+	res.reserve(list.size());
+	for (size_t i = 0; i < list.size(); ++i)
+	{
+		res.push_back(list.get(i));
+	}
 	return res;
 }
 }	 // namespace rd
@@ -0,0 +1,111 @@
+#ifndef RD_CPP_VIEWABLE_STORAGE_H
+#define RD_CPP_VIEWABLE_STORAGE_H
+
+#include <types/wrapper.h>
+#include <util/core_traits.h>
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rd
+{
+namespace viewable
+{
+/**
+ * \brief Storage policy of the viewable collections: every element is a \ref Wrapper, so it has a heap block of its
+ * own and its address never changes while it stays in the collection.
+ */
+struct wrapped_storage
+{
+	template <typename T>
+	using element_t = Wrapper<T>;
+
+	template <typename T, typename W>
+	static Wrapper<T> make(W&& value)
+	{
+		return Wrapper<T>(std::forward<W>(value));
+	}
+
+	template <typename T>
+	static T const& get(Wrapper<T> const& element)
+	{
+		return *element;
+	}
+
+	template <typename T>
+	static value_or_wrapper<T> release(Wrapper<T>&& element)
+	{
+		return wrapper::unwrap<T>(std::move(element));
+	}
+
+	template <typename T>
+	static std::vector<Wrapper<T>> const& wrappers(std::vector<Wrapper<T>> const& elements, std::vector<Wrapper<T>>&)
+	{
+		return elements;
+	}
+};
+
+/**
+ * \brief Storage policy for trivially copyable elements: they are stored by value, contiguously where the container
+ * allows it. Pointers in events stay valid for the duration of the handler call only, a later change of the
+ * collection may move the element.
+ */
+struct inline_storage
+{
+	template <typename T>
+	using element_t = T;
+
+	template <typename T, typename W>
+	static T make(W&& value)
+	{
+		return T(std::forward<W>(value));
+	}
+
+	template <typename T>
+	static T const& get(T const& element)
+	{
+		return element;
+	}
+
+	template <typename T>
+	static T release(T&& element)
+	{
+		return std::move(element);
+	}
+
+	/**
+	 * \brief Wraps copies of the elements into [copies], for callers of IViewableList::getList. The copies don't
+	 * follow later changes of the collection.
+	 */
+	template <typename T, typename EA>
+	static std::vector<Wrapper<T>> const& wrappers(std::vector<T, EA> const& elements, std::vector<Wrapper<T>>& copies)
+	{
+		copies.clear();
+		copies.reserve(elements.size());
+		for (auto const& element : elements)
+		{
+			copies.emplace_back(element);
+		}
+		return copies;
+	}
+};
+}	 // namespace viewable
+
+/**
+ * \brief Selects how ViewableList and ViewableMap store elements of type [T]. Trivially copyable values are stored
+ * inline, specialise with type = viewable::wrapped_storage for a type whose element addresses must stay stable.
+ * Keys of ViewableMap are always wrapped: IViewableMap::view keeps its lifetimes by key address.
+ */
+template <typename T>
+struct viewable_storage
+{
+	using type = std::conditional_t<std::is_trivially_copyable<T>::value && !util::in_heap_v<T>, viewable::inline_storage,
+		viewable::wrapped_storage>;
+};
+
+template <typename T>
+using viewable_storage_t = typename viewable_storage<std::remove_cv_t<T>>::type;
+}	 // namespace rd
+
+#endif	  // RD_CPP_VIEWABLE_STORAGE_H
@@ -0,0 +1,285 @@
+#ifndef RD_CPP_FLAT_HASH_MAP_H
+#define RD_CPP_FLAT_HASH_MAP_H
+
+#include "hash.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace rd
+{
+/**
+ * \brief Open-addressing hash map with linear probing over a single contiguous slot array.
+ * Intended for small lookup tables that are filled once and then read on hot paths (serializer readers, intern roots):
+ * a lookup is one hash and a short scan over adjacent slots. Erasure is not supported.
+ * \tparam K key type, must be default constructible
+ * \tparam V value type, must be default constructible
+ */
+template <typename K, typename V, typename Hash = hash<K>, typename KeyEqual = std::equal_to<K>>
+class flat_hash_map
+{
+public:
+	using key_type = K;
+	using mapped_type = V;
+	using value_type = std::pair<K, V>;
+	using size_type = size_t;
+
+private:
+	struct slot
+	{
+		value_type value{};
+		bool occupied = false;
+	};
+
+	using slots_t = std::vector<slot>;
+
+	static constexpr size_type MIN_CAPACITY = 8;
+
+	slots_t slots;
+	size_type count_ = 0;
+
+	Hash hasher{};
+	KeyEqual key_equal{};
+
+	size_type index_for(K const& key) const noexcept
+	{
+		// Fibonacci hashing spreads identity-like hashes (ints, precomputed RdId hashes) over the whole table
+		uint64_t h = static_cast<uint64_t>(hasher(key)) * 0x9E3779B97F4A7C15ull;
+		return static_cast<size_type>(h >> 32) & (slots.size() - 1);
+	}
+
+	size_type find_index(K const& key) const noexcept
+	{
+		if (slots.empty())
+		{
+			return slots.size();
+		}
+		size_type mask = slots.size() - 1;
+		for (size_type i = index_for(key);; i = (i + 1) & mask)
+		{
+			slot const& s = slots[i];
+			if (!s.occupied)
+			{
+				return slots.size();
+			}
+			if (key_equal(s.value.first, key))
+			{
+				return i;
+			}
+		}
+	}
+
+	void rehash(size_type new_capacity)
+	{
+		slots_t old = std::move(slots);
+		slots = slots_t(new_capacity);
+		size_type mask = new_capacity - 1;
+		for (auto& s : old)
+		{
+			if (s.occupied)
+			{
+				size_type i = index_for(s.value.first);
+				while (slots[i].occupied)
+				{
+					i = (i + 1) & mask;
+				}
+				slots[i].value = std::move(s.value);
+				slots[i].occupied = true;
+			}
+		}
+	}
+
+	void grow_if_needed()
+	{
+		// keep load factor under 1/2 so that probe sequences stay short
+		if (slots.empty())
+		{
+			rehash(MIN_CAPACITY);
+		}
+		else if ((count_ + 1) * 2 > slots.size())
+		{
+			rehash(slots.size() * 2);
+		}
+	}
+
+public:
+	template <typename S, typename R>
+	class iterator_base
+	{
+		friend class flat_hash_map;
+
+		S* slots_ = nullptr;
+		size_type index = 0;
+
+		iterator_base(S* slots, size_type index) : slots_(slots), index(index)
+		{
+			skip_empty();
+		}
+
+		void skip_empty()
+		{
+			while (index < slots_->size() && !(*slots_)[index].occupied)
+			{
+				++index;
+			}
+		}
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = flat_hash_map::value_type;
+		using difference_type = std::ptrdiff_t;
+		using pointer = R*;
+		using reference = R&;
+
+		iterator_base() = default;
+
+		reference operator*() const
+		{
+			return (*slots_)[index].value;
+		}
+
+		pointer operator->() const
+		{
+			return &(*slots_)[index].value;
+		}
+
+		iterator_base& operator++()
+		{
+			++index;
+			skip_empty();
+			return *this;
+		}
+
+		iterator_base operator++(int)
+		{
+			iterator_base it = *this;
+			++*this;
+			return it;
+		}
+
+		friend bool operator==(iterator_base const& lhs, iterator_base const& rhs)
+		{
+			return lhs.index == rhs.index;
+		}
+
+		friend bool operator!=(iterator_base const& lhs, iterator_base const& rhs)
+		{
+			return !(lhs == rhs);
+		}
+	};
+
+	using iterator = iterator_base<slots_t, value_type>;
+	using const_iterator = iterator_base<slots_t const, value_type const>;
+
+	// region ctor/dtor
+
+	flat_hash_map() = default;
+
+	flat_hash_map(std::initializer_list<value_type> init)
+	{
+		for (auto const& item : init)
+		{
+			emplace(item.first, item.second);
+		}
+	}
+
+	flat_hash_map(flat_hash_map const&) = default;
+
+	flat_hash_map& operator=(flat_hash_map const&) = default;
+
+	flat_hash_map(flat_hash_map&&) noexcept = default;
+
+	flat_hash_map& operator=(flat_hash_map&&) noexcept = default;
+	// endregion
+
+	size_type size() const noexcept
+	{
+		return count_;
+	}
+
+	bool empty() const noexcept
+	{
+		return count_ == 0;
+	}
+
+	void reserve(size_type n)
+	{
+		size_type capacity = MIN_CAPACITY;
+		while (capacity < n * 2)
+		{
+			capacity *= 2;
+		}
+		if (capacity > slots.size())
+		{
+			rehash(capacity);
+		}
+	}
+
+	iterator begin() noexcept
+	{
+		return iterator(&slots, 0);
+	}
+
+	iterator end() noexcept
+	{
+		return iterator(&slots, slots.size());
+	}
+
+	const_iterator begin() const noexcept
+	{
+		return const_iterator(&slots, 0);
+	}
+
+	const_iterator end() const noexcept
+	{
+		return const_iterator(&slots, slots.size());
+	}
+
+	iterator find(K const& key) noexcept
+	{
+		return iterator(&slots, find_index(key));
+	}
+
+	const_iterator find(K const& key) const noexcept
+	{
+		return const_iterator(&slots, find_index(key));
+	}
+
+	size_type count(K const& key) const noexcept
+	{
+		return find_index(key) != slots.size() ? 1 : 0;
+	}
+
+	template <typename... Args>
+	std::pair<iterator, bool> emplace(K const& key, Args&&... args)
+	{
+		size_type found = find_index(key);
+		if (found != slots.size())
+		{
+			return {iterator(&slots, found), false};
+		}
+		grow_if_needed();
+		size_type mask = slots.size() - 1;
+		size_type i = index_for(key);
+		while (slots[i].occupied)
+		{
+			i = (i + 1) & mask;
+		}
+		slots[i].value = value_type(key, V(std::forward<Args>(args)...));
+		slots[i].occupied = true;
+		++count_;
+		return {iterator(&slots, i), true};
+	}
+
+	V& operator[](K const& key)
+	{
+		return emplace(key).first->second;
+	}
+};
+}	 // namespace rd
+
+#endif	  // RD_CPP_FLAT_HASH_MAP_H
@@ -0,0 +1,178 @@
+#include "pool_allocator.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace rd
+{
+namespace
+{
+struct free_block
+{
+	free_block* next;
+};
+
+/**
+ * \brief Blocks owned by one thread, taken and returned without locking.
+ */
+struct local_list
+{
+	free_block* head = nullptr;
+	size_t count = 0;
+
+	void push(free_block* block) noexcept
+	{
+		block->next = head;
+		head = block;
+		++count;
+	}
+
+	free_block* pop() noexcept
+	{
+		free_block* block = head;
+		head = block->next;
+		--count;
+		return block;
+	}
+};
+
+/**
+ * \brief Blocks move between a thread's cache and the shared list in batches, so the lock is taken once per batch.
+ */
+constexpr size_t BATCH_SIZE = 64;
+
+class size_class
+{
+	std::mutex lock;
+	local_list free_list;
+	std::vector<std::unique_ptr<unsigned char[]>> slabs;
+
+public:
+	void refill(local_list& local, size_t block_size, std::atomic<size_t>& slab_counter)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		if (free_list.count == 0)
+		{
+			slabs.emplace_back(new unsigned char[slab_pool::SLAB_SIZE]);
+			unsigned char* slab = slabs.back().get();
+			for (size_t offset = 0; offset + block_size <= slab_pool::SLAB_SIZE; offset += block_size)
+			{
+				free_list.push(reinterpret_cast<free_block*>(slab + offset));
+			}
+			++slab_counter;
+		}
+		for (size_t i = 0; i < BATCH_SIZE && free_list.count > 0; ++i)
+		{
+			local.push(free_list.pop());
+		}
+	}
+
+	void release(local_list& local, size_t keep) noexcept
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		while (local.count > keep)
+		{
+			free_list.push(local.pop());
+		}
+	}
+};
+
+constexpr size_t CLASS_COUNT = slab_pool::MAX_BLOCK_SIZE / slab_pool::BLOCK_ALIGNMENT;
+
+struct pool_state
+{
+	std::array<size_class, CLASS_COUNT> classes;
+	std::atomic<size_t> slabs{0};
+};
+
+pool_state& state()
+{
+	// intentionally leaked: blocks may be released by static destructors after this function's statics are gone
+	static pool_state* instance = new pool_state();
+	return *instance;
+}
+
+/**
+ * \brief Set once the calling thread's cache is destroyed, later calls on that thread lock the shared lists directly.
+ */
+thread_local bool cache_released = false;
+
+struct thread_cache
+{
+	std::array<local_list, CLASS_COUNT> lists;
+
+	~thread_cache()
+	{
+		for (size_t i = 0; i < CLASS_COUNT; ++i)
+		{
+			state().classes[i].release(lists[i], 0);
+		}
+		cache_released = true;
+	}
+};
+
+thread_local thread_cache cache;
+
+size_t class_index(size_t size)
+{
+	return (size + slab_pool::BLOCK_ALIGNMENT - 1) / slab_pool::BLOCK_ALIGNMENT - 1;
+}
+}	 // namespace
+
+void* slab_pool::allocate(size_t size)
+{
+	if (size == 0 || size > MAX_BLOCK_SIZE)
+	{
+		return ::operator new(size);
+	}
+	size_t index = class_index(size);
+	pool_state& s = state();
+	size_class& sc = s.classes[index];
+	if (cache_released)
+	{
+		local_list local;
+		sc.refill(local, (index + 1) * BLOCK_ALIGNMENT, s.slabs);
+		free_block* block = local.pop();
+		sc.release(local, 0);
+		return block;
+	}
+	local_list& local = cache.lists[index];
+	if (local.count == 0)
+	{
+		sc.refill(local, (index + 1) * BLOCK_ALIGNMENT, s.slabs);
+	}
+	return local.pop();
+}
+
+void slab_pool::deallocate(void* ptr, size_t size) noexcept
+{
+	if (size == 0 || size > MAX_BLOCK_SIZE)
+	{
+		::operator delete(ptr);
+		return;
+	}
+	size_class& sc = state().classes[class_index(size)];
+	if (cache_released)
+	{
+		local_list local;
+		local.push(static_cast<free_block*>(ptr));
+		sc.release(local, 0);
+		return;
+	}
+	// blocks freed by a consumer thread pile up in its cache, the surplus goes back for the producer to reuse
+	local_list& local = cache.lists[class_index(size)];
+	local.push(static_cast<free_block*>(ptr));
+	if (local.count > 2 * BATCH_SIZE)
+	{
+		sc.release(local, BATCH_SIZE);
+	}
+}
+
+size_t slab_pool::slab_count() noexcept
+{
+	return state().slabs.load(std::memory_order_relaxed);
+}
+}	 // namespace rd
@@ -0,0 +1,80 @@
+#ifndef RD_CPP_POOL_ALLOCATOR_H
+#define RD_CPP_POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include <rd_core_export.h>
+
+namespace rd
+{
+/**
+ * \brief Process-wide fixed-size block pool. Blocks are carved out of large slabs and recycled through per-size free
+ * lists, slabs are never returned to the system. Requests larger than \ref MAX_BLOCK_SIZE go to operator new.
+ * Every thread caches blocks of each size and exchanges them with the shared lists in batches, so the common
+ * allocation and release take no lock.
+ */
+class RD_CORE_API slab_pool
+{
+public:
+	static constexpr size_t BLOCK_ALIGNMENT = 16;
+
+	static constexpr size_t MAX_BLOCK_SIZE = 256;
+
+	static constexpr size_t SLAB_SIZE = 64 * 1024;
+
+	static void* allocate(size_t size);
+
+	static void deallocate(void* ptr, size_t size) noexcept;
+
+	/**
+	 * \return number of slabs requested from the system so far.
+	 */
+	static size_t slab_count() noexcept;
+};
+
+/**
+ * \brief Stateless allocator over \ref slab_pool. Meant for allocate_shared, where the value and its reference
+ * counters share one block.
+ */
+template <typename T>
+class pool_allocator
+{
+	static_assert(alignof(T) <= slab_pool::BLOCK_ALIGNMENT, "over-aligned types are not supported by pool_allocator");
+
+public:
+	using value_type = T;
+
+	pool_allocator() noexcept = default;
+
+	template <typename U>
+	pool_allocator(pool_allocator<U> const&) noexcept
+	{
+	}
+
+	T* allocate(size_t n)
+	{
+		return static_cast<T*>(slab_pool::allocate(n * sizeof(T)));
+	}
+
+	void deallocate(T* ptr, size_t n) noexcept
+	{
+		slab_pool::deallocate(ptr, n * sizeof(T));
+	}
+
+	template <typename U>
+	friend bool operator==(pool_allocator const&, pool_allocator<U> const&) noexcept
+	{
+		return true;
+	}
+
+	template <typename U>
+	friend bool operator!=(pool_allocator const&, pool_allocator<U> const&) noexcept
+	{
+		return false;
+	}
+};
+}	 // namespace rd
+
+#endif	  // RD_CPP_POOL_ALLOCATOR_H
@@ -4,6 +4,7 @@
 #include <util/core_traits.h>
 #include <std/allocator.h>
 #include <std/hash.h>
+#include <std/pool_allocator.h>
 #include <std/to_string.h>
 
 #include <thirdparty.hpp>
@@ -64,6 +65,48 @@ using property_storage = typename helper<T>::property_storage;
 template <typename T>
 using raw_type = typename helper<T>::raw_type;
 
+namespace wrapper
+{
+/**
+ * \brief Default storage policy: the value and its reference counters live in one allocation made by the wrapper's
+ * allocator.
+ */
+struct shared_storage
+{
+	template <typename T, typename A, typename... Args>
+	static std::shared_ptr<T> allocate(A const& alloc, Args&&... args)
+	{
+		return std::allocate_shared<T>(alloc, std::forward<Args>(args)...);
+	}
+};
+
+/**
+ * \brief Storage policy for small, frequently created values: the shared block is taken from \ref slab_pool instead
+ * of the general purpose heap.
+ */
+struct pooled_storage
+{
+	template <typename T, typename A, typename... Args>
+	static std::shared_ptr<T> allocate(A const& /*alloc*/, Args&&... args)
+	{
+		return std::allocate_shared<T>(pool_allocator<T>(), std::forward<Args>(args)...);
+	}
+};
+}	 // namespace wrapper
+
+/**
+ * \brief Selects how \ref Wrapper allocates values of type [T]. Specialise with type = wrapper::pooled_storage to
+ * opt a type into pooled allocation.
+ */
+template <typename T>
+struct wrapper_storage
+{
+	using type = wrapper::shared_storage;
+};
+
+template <typename T>
+using wrapper_storage_t = typename wrapper_storage<std::remove_cv_t<T>>::type;
+
 template <typename>
 struct is_wrapper : std::false_type
 {
@@ -136,7 +179,7 @@ public:
 			>::value*/
 			util::conjunction<std::is_constructible<std::shared_ptr<T>, std::shared_ptr<G>>,
 				util::negation<std::is_abstract<G>>>::value>>
-	Wrapper(F&& value) : Base(std::allocate_shared<G>(alloc, std::forward<F>(value)))
+	Wrapper(F&& value) : Base(wrapper_storage_t<G>::template allocate<G>(alloc, std::forward<F>(value)))
 	{
 	}
 
@@ -155,7 +198,7 @@ public:
 	{
 		if (opt)
 		{
-			*this = std::allocate_shared<U>(alloc, *std::move(opt));
+			*this = wrapper_storage_t<U>::template allocate<U>(alloc, *std::move(opt));
 		}
 	}
 
@@ -286,7 +329,7 @@ typename std::enable_if_t<util::in_heap_v<T>, Wrapper<T>> unwrap(Wrapper<T>&& pt
 template <typename T, typename... Args>
 Wrapper<T> make_wrapper(Args&&... args)
 {
-	return Wrapper<T>(std::make_shared<T>(std::forward<Args>(args)...));
+	return Wrapper<T>(wrapper_storage_t<T>::template allocate<T>(std::allocator<T>(), std::forward<Args>(args)...));
 }
 
 template <typename T, typename A, typename... Args>
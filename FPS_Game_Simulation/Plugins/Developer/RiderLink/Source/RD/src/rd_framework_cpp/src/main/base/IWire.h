@@ -37,8 +37,10 @@ public:
 	 * \brief Sends a data block with the given [id] and the given [writer] function that can write the data.
 	 * \param id of recipient.
 	 * \param writer is used to serialise data before send.
+	 * \param size_hint number of bytes [writer] is expected to write, lets the wire allocate the message once. 0 if
+	 * unknown.
 	 */
-	virtual void send(RdId const& id, std::function<void(Buffer& buffer)> writer) const = 0;
+	virtual void send(RdId const& id, std::function<void(Buffer& buffer)> writer, size_t size_hint = 0) const = 0;
 
 	/**
 	 * \brief Adds a [handler] for receiving updated values of the object with the given [id]. The handler is removed
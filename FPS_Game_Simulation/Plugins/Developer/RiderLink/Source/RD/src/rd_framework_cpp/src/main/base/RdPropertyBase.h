@@ -4,6 +4,7 @@
 #include "base/RdReactiveBase.h"
 #include "serialization/Polymorphic.h"
 #include "reactive/Property.h"
+#include "scheduler/TimerWheel.h"
 
 #if defined(_MSC_VER)
 #pragma warning(push)
@@ -12,6 +13,26 @@
 
 namespace rd
 {
+/**
+ * \brief How \ref RdPropertyBase sends its local changes to the other side.
+ */
+enum class PropertySendPolicy
+{
+	/**
+	 * \brief Every change is sent right away.
+	 */
+	Immediate,
+	/**
+	 * \brief Changes are sent once per turn of the protocol scheduler, with the last value.
+	 */
+	Coalesced,
+	/**
+	 * \brief At most one send per interval. A change after a quiet interval is sent right away, the following ones
+	 * are sent once, with the last value, when the interval ends.
+	 */
+	RateLimited
+};
+
 template <typename T, typename S = Polymorphic<T>>
 class RdPropertyBase : public RdReactiveBase, public Property<T>
 {
@@ -21,6 +42,73 @@ protected:
 	mutable int32_t master_version = 0;
 	mutable bool default_value_changed = false;
 
+	// sending
+	PropertySendPolicy send_policy = PropertySendPolicy::Immediate;
+	TimerWheel::duration_t send_interval{0};
+	mutable bool send_pending = false;
+	mutable TimerWheel::clock_t::time_point last_send{};
+
+	void send_value(T const& v) const
+	{
+		get_wire()->send(
+			rdid,
+			[this, &v](Buffer& buffer) {
+				buffer.write_integral<int32_t>(master_version);
+				S::write(this->get_serialization_context(), buffer, v);
+				spdlog::get("logSend")->trace("SEND property {} + {}:: ver = {}, value = {}", to_string(location),
+					to_string(rdid), std::to_string(master_version), to_string(v));
+			},
+			sizeof(int32_t) + rd::serialized_size<S>(v));
+		if (send_policy == PropertySendPolicy::RateLimited)
+		{
+			last_send = TimerWheel::clock_t::now();
+		}
+	}
+
+	void flush_pending() const
+	{
+		if (!send_pending)
+		{
+			return;
+		}
+		send_pending = false;
+		if (this->has_value())
+		{
+			send_value(this->get());
+		}
+	}
+
+	void schedule_send(Lifetime lifetime) const
+	{
+		if (send_pending)
+		{
+			// the pending send picks up the latest value and version
+			return;
+		}
+		auto flush = [this, lifetime] {
+			if (!lifetime->is_terminated())
+			{
+				flush_pending();
+			}
+		};
+		if (send_policy == PropertySendPolicy::Coalesced)
+		{
+			send_pending = true;
+			get_default_scheduler()->queue(std::move(flush));
+			return;
+		}
+		const auto now = TimerWheel::clock_t::now();
+		const auto next_send = last_send + send_interval;
+		if (now >= next_send)
+		{
+			send_value(this->get());
+			return;
+		}
+		send_pending = true;
+		TimerWheel::instance().schedule(std::chrono::duration_cast<TimerWheel::duration_t>(next_send - now) + TimerWheel::duration_t(1),
+			get_default_scheduler(), std::move(flush));
+	}
+
 	// init
 public:
 	mutable bool optimize_nested = false;
@@ -50,9 +138,27 @@ public:
 		return default_value_changed;
 	}
 
+	/**
+	 * \brief Sets how local changes are sent, must be called before bind. Version numbers are kept per change, so the
+	 * other side converges to the last value either way. Deferred sends run on the protocol scheduler.
+	 * \param interval minimal time between two sends for \ref PropertySendPolicy::RateLimited, rounded up to
+	 * \ref TimerWheel::TICK
+	 */
+	void set_send_policy(PropertySendPolicy policy, TimerWheel::duration_t interval = TimerWheel::duration_t(0))
+	{
+		send_policy = policy;
+		send_interval = interval;
+	}
+
+	PropertySendPolicy get_send_policy() const
+	{
+		return send_policy;
+	}
+
 	void init(Lifetime lifetime) const override
 	{
 		RdReactiveBase::init(lifetime);
+		send_pending = false;
 
 		if (!optimize_nested)
 		{
@@ -69,7 +175,7 @@ public:
 			});
 		}
 
-		advise(lifetime, [this](T const& v) {
+		advise(lifetime, [this, lifetime](T const& v) {
 			if (!is_local_change)
 			{
 				return;
@@ -78,12 +184,14 @@ public:
 			{
 				master_version++;
 			}
-			get_wire()->send(rdid, [this, &v](Buffer& buffer) {
-				buffer.write_integral<int32_t>(master_version);
-				S::write(this->get_serialization_context(), buffer, v);
-				spdlog::get("logSend")->trace("SEND property {} + {}:: ver = {}, value = {}", to_string(location), to_string(rdid),
-					std::to_string(master_version), to_string(v));
-			});
+			if (send_policy == PropertySendPolicy::Immediate)
+			{
+				send_value(v);
+			}
+			else
+			{
+				schedule_send(lifetime);
+			}
 		});
 
 		get_wire()->advise(lifetime, this);
@@ -112,6 +220,8 @@ public:
 			return;
 		}
 		master_version = version;
+		// an unsent local change is superseded by the accepted one
+		send_pending = false;
 
 		Property<T>::set(std::move(v));
 	}
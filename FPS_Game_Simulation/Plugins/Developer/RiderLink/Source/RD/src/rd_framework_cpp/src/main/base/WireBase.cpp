@@ -1,9 +1,20 @@
 #include "WireBase.h"
 
+#include "base/RdReactiveBase.h"
+
 namespace rd
 {
 void WireBase::advise(Lifetime lifetime, const RdReactiveBase* entity) const
 {
 	message_broker.advise_on(lifetime, entity);
+	if (metrics.is_enabled())
+	{
+		metrics.register_location(entity->get_id(), to_string(entity->get_location()));
+	}
+}
+
+WireMetricsSnapshot WireBase::get_metrics_snapshot() const
+{
+	return metrics.snapshot();
 }
 }	 // namespace rd
@@ -4,6 +4,7 @@
 #include "reactive/Property.h"
 #include "base/IWire.h"
 #include "protocol/MessageBroker.h"
+#include "wire/WireMetrics.h"
 
 #include <rd_framework_export.h>
 
@@ -14,11 +15,13 @@ class RD_FRAMEWORK_API WireBase : public IWire
 protected:
 	IScheduler* scheduler = nullptr;
 
+	mutable WireMetrics metrics;
+
 	MessageBroker message_broker;
 
 public:
 	// region ctor/dtor
-	explicit WireBase(IScheduler* scheduler) : scheduler(scheduler), message_broker(scheduler)
+	explicit WireBase(IScheduler* scheduler) : scheduler(scheduler), message_broker(scheduler, &metrics)
 	{
 	}
 
@@ -26,6 +29,16 @@ public:
 	// endregion
 
 	virtual void advise(Lifetime lifetime, RdReactiveBase const* entity) const override;
+
+	/**
+	 * \brief Traffic counters of this wire, disabled until \ref WireMetrics::set_enabled is called.
+	 */
+	WireMetrics& get_metrics() const
+	{
+		return metrics;
+	}
+
+	virtual WireMetricsSnapshot get_metrics_snapshot() const;
 };
 }	 // namespace rd
 
@@ -33,18 +33,18 @@ void ExtWire::advise(Lifetime lifetime, RdReactiveBase const* entity) const
 	realWire->advise(lifetime, entity);
 }
 
-void ExtWire::send(RdId const& id, std::function<void(Buffer& buffer)> writer) const
+void ExtWire::send(RdId const& id, std::function<void(Buffer& buffer)> writer, size_t size_hint) const
 {
 	{
 		std::lock_guard<decltype(lock)> guard(lock);
 		if (!sendQ.empty() || !connected.get())
 		{
-			Buffer buffer;
+			auto buffer = Buffer::with_capacity(size_hint);
 			writer(buffer);
 			sendQ.emplace(id, buffer.getRealArray());
 			return;
 		}
 	}
-	realWire->send(id, std::move(writer));
+	realWire->send(id, std::move(writer), size_hint);
 }
 }	 // namespace rd
@@ -31,7 +31,7 @@ public:
 
 	void advise(Lifetime lifetime, RdReactiveBase const* entity) const override;
 
-	void send(RdId const& id, std::function<void(Buffer& buffer)> writer) const override;
+	void send(RdId const& id, std::function<void(Buffer& buffer)> writer, size_t size_hint = 0) const override;
 };
 }	 // namespace rd
 #if defined(_MSC_VER)
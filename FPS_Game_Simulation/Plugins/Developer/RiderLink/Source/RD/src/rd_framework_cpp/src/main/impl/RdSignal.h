@@ -102,10 +102,13 @@ public:
 
 		if (async && !is_bound()) return;
 
-		get_wire()->send(rdid, [this, &value](Buffer& buffer) {
-			spdlog::get("logSend")->trace("SEND{}", logmsg(value));
-			S::write(get_serialization_context(), buffer, value);
-		});
+		get_wire()->send(
+			rdid,
+			[this, &value](Buffer& buffer) {
+				spdlog::get("logSend")->trace("SEND{}", logmsg(value));
+				S::write(get_serialization_context(), buffer, value);
+			},
+			rd::serialized_size<S>(value));
 		signal.fire(value);
 	}
 
@@ -7,7 +7,9 @@
 
 namespace rd
 {
-Buffer::Buffer() : Buffer(16)
+constexpr size_t Buffer::DEFAULT_SIZE;
+
+Buffer::Buffer() : Buffer(DEFAULT_SIZE)
 {
 }
 
@@ -19,6 +21,12 @@ Buffer::Buffer(ByteArray array, size_t offset) : data_(std::move(array)), offset
 {
 }
 
+Buffer Buffer::with_capacity(size_t size_hint)
+{
+	// +1: the storage grows once its last byte is taken
+	return Buffer(size_hint == 0 ? DEFAULT_SIZE : size_hint + 1);
+}
+
 size_t Buffer::get_position() const
 {
 	return offset;
@@ -31,10 +31,13 @@ public:
 
 	using word_t = uint8_t;
 
-	using Allocator = std::allocator<word_t>;
+	// grown storage is overwritten right away, don't zero-fill it
+	using Allocator = default_init_allocator<word_t>;
 
 	using ByteArray = std::vector<word_t, Allocator>;
 
+	static constexpr size_t DEFAULT_SIZE = 16;
+
 private:
 	template <int>
 	friend std::wstring read_wstring_spec(Buffer&);
@@ -61,6 +64,11 @@ public:
 
 	explicit Buffer(size_t initial_size);
 
+	/**
+	 * \brief Buffer which takes [size_hint] bytes without growing, see \ref serialized_size. Default sized if 0.
+	 */
+	static Buffer with_capacity(size_t size_hint);
+
 	explicit Buffer(ByteArray array, size_t offset = 0);
 
 	Buffer(Buffer const&) = delete;
@@ -112,7 +120,7 @@ public:
 	}
 
 	template <template <class, class> class C, typename T, typename A = allocator<T>,
-		typename = typename std::enable_if_t<util::is_pod_v<T>>>
+		typename = typename std::enable_if_t<util::is_trivially_serializable_v<T>>>
 	C<T, A> read_array()
 	{
 		int32_t len = read_integral<int32_t>();
@@ -127,8 +135,9 @@ public:
 		return result;
 	}
 
-	template <template <class, class> class C, typename T, typename A = allocator<value_or_wrapper<T>>>
-	C<value_or_wrapper<T>, A> read_array(std::function<value_or_wrapper<T>()> reader)
+	template <template <class, class> class C, typename T, typename A = allocator<value_or_wrapper<T>>, typename F,
+		typename = typename std::enable_if_t<util::is_invocable_v<F>>>
+	C<value_or_wrapper<T>, A> read_array(F&& reader)
 	{
 		int32_t len = read_integral<int32_t>();
 		C<value_or_wrapper<T>, A> result;
@@ -142,7 +151,7 @@ public:
 	}
 
 	template <template <class, class> class C, typename T, typename A = allocator<T>,
-		typename = typename std::enable_if_t<util::is_pod_v<T>>>
+		typename = typename std::enable_if_t<util::is_trivially_serializable_v<T>>>
 	void write_array(C<T, A> const& container)
 	{
 		using rd::size;
@@ -155,8 +164,8 @@ public:
 	}
 
 	template <template <class, class> class C, typename T, typename A = allocator<T>,
-		typename = typename std::enable_if_t<!rd::util::in_heap_v<T>>>
-	void write_array(C<T, A> const& container, std::function<void(T const&)> writer)
+		typename F, typename = typename std::enable_if_t<!rd::util::in_heap_v<T>>>
+	void write_array(C<T, A> const& container, F&& writer)
 	{
 		using rd::size;
 		write_integral<int32_t>(size(container));
@@ -166,8 +175,8 @@ public:
 		}
 	}
 
-	template <template <class, class> class C, typename T, typename A = allocator<Wrapper<T>>>
-	void write_array(C<Wrapper<T>, A> const& container, std::function<void(T const&)> writer)
+	template <template <class, class> class C, typename T, typename A = allocator<Wrapper<T>>, typename F>
+	void write_array(C<Wrapper<T>, A> const& container, F&& writer)
 	{
 		using rd::size;
 		write_integral<int32_t>(size(container));
@@ -260,9 +269,8 @@ public:
 		return reader();
 	}
 
-	template <typename T>
-	typename std::enable_if_t<!std::is_abstract<T>::value> write_nullable(
-		optional<T> const& value, std::function<void(T const&)> writer)
+	template <typename T, typename F>
+	typename std::enable_if_t<!std::is_abstract<T>::value> write_nullable(optional<T> const& value, F&& writer)
 	{
 		if (!value)
 		{
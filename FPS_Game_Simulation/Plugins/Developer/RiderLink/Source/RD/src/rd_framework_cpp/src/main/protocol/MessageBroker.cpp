@@ -1,6 +1,7 @@
 #include "protocol/MessageBroker.h"
 
 #include "base/RdReactiveBase.h"
+#include "wire/WireMetrics.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
 
 namespace rd
@@ -8,21 +9,29 @@ namespace rd
 std::shared_ptr<spdlog::logger> MessageBroker::logger =
 	spdlog::stderr_color_mt<spdlog::synchronous_factory>("logger", spdlog::color_mode::automatic);
 
-static void execute(const IRdReactive* that, Buffer msg)
+void MessageBroker::execute(const RdReactiveBase* that, Buffer msg, int64_t received_ns) const
 {
 	msg.read_integral<int16_t>();	   // skip context
+	if (received_ns == 0)
+	{
+		that->on_wire_received(std::move(msg));
+		return;
+	}
+	RdId id = that->get_id();
+	int64_t started_ns = WireMetrics::now_ns();
 	that->on_wire_received(std::move(msg));
+	metrics->record_dispatch(id, received_ns, started_ns, WireMetrics::now_ns());
 }
 
-void MessageBroker::invoke(const RdReactiveBase* that, Buffer msg, bool sync) const
+void MessageBroker::invoke(const RdReactiveBase* that, Buffer msg, int64_t received_ns, bool sync) const
 {
 	if (sync)
 	{
-		execute(that, std::move(msg));
+		execute(that, std::move(msg), received_ns);
 	}
 	else
 	{
-		auto action = [this, that, message = std::move(msg)]() mutable {
+		auto action = [this, that, message = std::move(msg), received_ns]() mutable {
 			bool exists_id = false;
 			{
 				std::lock_guard<decltype(lock)> guard(lock);
@@ -30,7 +39,7 @@ void MessageBroker::invoke(const RdReactiveBase* that, Buffer msg, bool sync) co
 			}
 			if (exists_id)
 			{
-				execute(that, std::move(message));
+				execute(that, std::move(message), received_ns);
 			}
 			else
 			{
@@ -42,7 +51,8 @@ void MessageBroker::invoke(const RdReactiveBase* that, Buffer msg, bool sync) co
 	}
 }
 
-MessageBroker::MessageBroker(IScheduler* defaultScheduler) : default_scheduler(defaultScheduler)
+MessageBroker::MessageBroker(IScheduler* defaultScheduler, WireMetrics* metrics)
+	: default_scheduler(defaultScheduler), metrics(metrics)
 {
 }
 
@@ -50,6 +60,9 @@ void MessageBroker::dispatch(RdId id, Buffer message) const
 {
 	RD_ASSERT_MSG(!id.isNull(), "id mustn't be null")
 
+	// zero means the message isn't measured
+	const int64_t received_ns = metrics != nullptr && metrics->is_enabled() ? WireMetrics::now_ns() : 0;
+
 	{	 // synchronized recursively
 		std::lock_guard<decltype(lock)> guard(lock);
 		RdReactiveBase const* s = subscriptions[id];
@@ -63,7 +76,7 @@ void MessageBroker::dispatch(RdId id, Buffer message) const
 
 			broker[id].default_scheduler_messages.emplace(std::move(message));
 
-			auto action = [this, it, id]() mutable {
+			auto action = [this, it, id, received_ns]() mutable {
 				auto& current = it->second;
 				RdReactiveBase const* subscription = subscriptions[id];
 
@@ -80,7 +93,8 @@ void MessageBroker::dispatch(RdId id, Buffer message) const
 				{
 					if (message)
 					{
-						invoke(subscription, *std::move(message), subscription->get_wire_scheduler() == default_scheduler);
+						invoke(subscription, *std::move(message), received_ns,
+							subscription->get_wire_scheduler() == default_scheduler);
 					}
 				}
 				else
@@ -96,7 +110,7 @@ void MessageBroker::dispatch(RdId id, Buffer message) const
 					{
 						RD_ASSERT_MSG(subscription->get_wire_scheduler() != default_scheduler,
 							"require equals of wire and default schedulers")
-						invoke(subscription, std::move(it));
+						invoke(subscription, std::move(it), 0);
 					}
 				}
 			};
@@ -107,14 +121,14 @@ void MessageBroker::dispatch(RdId id, Buffer message) const
 		{
 			if (s->get_wire_scheduler() == default_scheduler || s->get_wire_scheduler()->out_of_order_execution)
 			{
-				invoke(s, std::move(message));
+				invoke(s, std::move(message), received_ns);
 			}
 			else
 			{
 				auto it = broker.find(id);
 				if (it == broker.end())
 				{
-					invoke(s, std::move(message));
+					invoke(s, std::move(message), received_ns);
 				}
 				else
 				{
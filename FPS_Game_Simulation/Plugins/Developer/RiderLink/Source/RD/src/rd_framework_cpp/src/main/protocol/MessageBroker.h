@@ -19,6 +19,7 @@
 namespace rd
 {
 class RdReactiveBase;
+class WireMetrics;
 
 class RD_FRAMEWORK_API Mq
 {
@@ -44,6 +45,7 @@ class RD_FRAMEWORK_API MessageBroker final
 {
 private:
 	IScheduler* default_scheduler = nullptr;
+	WireMetrics* metrics = nullptr;
 	mutable rd::unordered_map<RdId, RdReactiveBase const*> subscriptions;
 	mutable rd::unordered_map<RdId, Mq> broker;
 
@@ -51,12 +53,14 @@ private:
 
 	static std::shared_ptr<spdlog::logger> logger;
 
-	void invoke(const RdReactiveBase* that, Buffer msg, bool sync = false) const;
+	void invoke(const RdReactiveBase* that, Buffer msg, int64_t received_ns, bool sync = false) const;
+
+	void execute(const RdReactiveBase* that, Buffer msg, int64_t received_ns) const;
 
 public:
 	// region ctor/dtor
 
-	explicit MessageBroker(IScheduler* defaultScheduler);
+	explicit MessageBroker(IScheduler* defaultScheduler, WireMetrics* metrics = nullptr);
 	// endregion
 
 	void dispatch(RdId id, Buffer message) const;
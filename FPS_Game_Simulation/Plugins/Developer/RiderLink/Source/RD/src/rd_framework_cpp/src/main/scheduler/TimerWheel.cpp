@@ -0,0 +1,233 @@
+#include "TimerWheel.h"
+
+#include "util/thread_util.h"
+
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+
+namespace rd
+{
+constexpr TimerWheel::duration_t TimerWheel::TICK;
+constexpr size_t TimerWheel::WHEEL_SIZE;
+
+TimerWheel::TimerWheel()
+{
+	worker = std::thread([this] {
+		rd::util::set_thread_name("rd TimerWheel");
+		run();
+	});
+}
+
+TimerWheel::~TimerWheel()
+{
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		stopping = true;
+	}
+	cv.notify_all();
+	if (worker.joinable())
+	{
+		worker.join();
+	}
+}
+
+TimerWheel& TimerWheel::instance()
+{
+	static TimerWheel wheel;
+	return wheel;
+}
+
+uint64_t TimerWheel::now_tick() const
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<duration_t>(clock_t::now() - start) / TICK);
+}
+
+uint64_t TimerWheel::to_ticks(duration_t delay) const
+{
+	auto ticks = (delay.count() + TICK.count() - 1) / TICK.count();
+	return static_cast<uint64_t>((std::max)(ticks, static_cast<decltype(ticks)>(1)));
+}
+
+uint64_t TimerWheel::next_deadline() const
+{
+	// the first slot holding a timer due within the current revolution gives the next deadline,
+	// timers further away only need the worker to wake up once per revolution
+	for (uint64_t tick = current_tick + 1; tick <= current_tick + WHEEL_SIZE; ++tick)
+	{
+		uint64_t nearest = UINT64_MAX;
+		for (auto const& timer : slots[tick % WHEEL_SIZE])
+		{
+			if (timer.deadline <= tick && live.count(timer.id) > 0)
+			{
+				nearest = (std::min)(nearest, timer.deadline);
+			}
+		}
+		if (nearest != UINT64_MAX)
+		{
+			return nearest;
+		}
+	}
+	return current_tick + WHEEL_SIZE;
+}
+
+void TimerWheel::insert(Timer timer)
+{
+	auto& slot = slots[timer.deadline % WHEEL_SIZE];
+	slot.push_back(std::move(timer));
+}
+
+TimerWheel::timer_id_t TimerWheel::schedule(duration_t delay, IScheduler* scheduler, std::function<void()> action)
+{
+	timer_id_t id;
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		id = next_id++;
+		live.insert(id);
+		insert(Timer{id, now_tick() + to_ticks(delay), 0, scheduler, std::move(action)});
+	}
+	cv.notify_all();
+	return id;
+}
+
+TimerWheel::timer_id_t TimerWheel::schedule_periodic(duration_t period, IScheduler* scheduler, std::function<void()> action)
+{
+	timer_id_t id;
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		id = next_id++;
+		live.insert(id);
+		uint64_t period_ticks = to_ticks(period);
+		insert(Timer{id, now_tick() + period_ticks, period_ticks, scheduler, std::move(action)});
+	}
+	cv.notify_all();
+	return id;
+}
+
+void TimerWheel::schedule_periodic(Lifetime lifetime, duration_t period, IScheduler* scheduler, std::function<void()> action)
+{
+	if (lifetime->is_terminated())
+	{
+		return;
+	}
+	timer_id_t id = schedule_periodic(period, scheduler, std::move(action));
+	try
+	{
+		lifetime->add_action([this, id] { cancel(id); });
+	}
+	catch (std::invalid_argument const&)
+	{
+		// terminated concurrently
+		cancel(id);
+	}
+}
+
+bool TimerWheel::cancel(timer_id_t id, duration_t timeout)
+{
+	std::unique_lock<decltype(lock)> guard(lock);
+	bool removed = live.erase(id) > 0;
+	if (std::this_thread::get_id() != worker.get_id())
+	{
+		if (!finished_cv.wait_for(guard, timeout, [this, id] { return running != id; }))
+		{
+			spdlog::error("TimerWheel: timer {} action is still running after {} ms", id, timeout.count());
+		}
+	}
+	return removed;
+}
+
+size_t TimerWheel::size() const
+{
+	std::lock_guard<decltype(lock)> guard(lock);
+	return live.size();
+}
+
+uint64_t TimerWheel::get_wakeups() const
+{
+	return wakeups.load(std::memory_order_relaxed);
+}
+
+void TimerWheel::run()
+{
+	std::unique_lock<decltype(lock)> guard(lock);
+	std::vector<Timer> due;
+	while (!stopping)
+	{
+		if (live.empty())
+		{
+			// idle: drop cancelled leftovers and sleep until something is scheduled
+			for (auto& slot : slots)
+			{
+				slot.clear();
+			}
+			cv.wait(guard, [this] { return stopping || !live.empty(); });
+			wakeups.fetch_add(1, std::memory_order_relaxed);
+			continue;
+		}
+
+		uint64_t deadline = next_deadline();
+		if (deadline > now_tick())
+		{
+			cv.wait_until(guard, start + TICK * deadline);
+			wakeups.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		uint64_t now = now_tick();
+		uint64_t steps = (std::min)(now - current_tick, static_cast<uint64_t>(WHEEL_SIZE));
+		for (uint64_t i = 1; i <= steps; ++i)
+		{
+			auto& slot = slots[(current_tick + i) % WHEEL_SIZE];
+			auto it = std::partition(slot.begin(), slot.end(), [this, now](Timer const& timer) {
+				return timer.deadline > now && live.count(timer.id) > 0;
+			});
+			for (auto fired = it; fired != slot.end(); ++fired)
+			{
+				if (live.count(fired->id) > 0)
+				{
+					due.push_back(std::move(*fired));
+				}
+			}
+			slot.erase(it, slot.end());
+		}
+		current_tick = now;
+
+		for (auto& timer : due)
+		{
+			if (live.count(timer.id) == 0)
+			{
+				continue;
+			}
+			if (timer.period == 0)
+			{
+				live.erase(timer.id);
+			}
+			running = timer.id;
+			guard.unlock();
+			try
+			{
+				if (timer.scheduler != nullptr)
+				{
+					timer.scheduler->queue(timer.action);
+				}
+				else
+				{
+					timer.action();
+				}
+			}
+			catch (std::exception const& e)
+			{
+				spdlog::error("TimerWheel: timer action failed | {}", e.what());
+			}
+			guard.lock();
+			running = 0;
+			finished_cv.notify_all();
+			if (timer.period != 0 && live.count(timer.id) > 0)
+			{
+				timer.deadline = now_tick() + timer.period;
+				insert(std::move(timer));
+			}
+		}
+		due.clear();
+	}
+}
+}	 // namespace rd
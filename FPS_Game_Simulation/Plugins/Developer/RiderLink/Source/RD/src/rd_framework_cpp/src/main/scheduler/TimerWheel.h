@@ -0,0 +1,132 @@
+#ifndef RD_CPP_TIMERWHEEL_H
+#define RD_CPP_TIMERWHEEL_H
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4251)
+#endif
+
+#include "scheduler/base/IScheduler.h"
+#include "lifetime/Lifetime.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <rd_framework_export.h>
+
+namespace rd
+{
+/**
+ * \brief Process-wide hashed timer wheel.
+ * All timers share one worker thread which sleeps until the nearest deadline and does not wake up at all while
+ * no timer is registered. Fired actions are queued to the given [IScheduler], or run on the worker thread when
+ * the scheduler is null, in which case they must be short and non-blocking.
+ */
+class RD_FRAMEWORK_API TimerWheel
+{
+public:
+	using clock_t = std::chrono::steady_clock;
+	using duration_t = std::chrono::milliseconds;
+	using timer_id_t = uint64_t;
+
+	/**
+	 * \brief Resolution of the wheel, deadlines are rounded up to a whole tick.
+	 */
+	static constexpr duration_t TICK = duration_t(10);
+
+	static constexpr size_t WHEEL_SIZE = 512;
+
+private:
+	struct Timer
+	{
+		timer_id_t id;
+		uint64_t deadline;
+		uint64_t period;	// in ticks, 0 for one-shot timers
+		IScheduler* scheduler;
+		std::function<void()> action;
+	};
+
+	mutable std::mutex lock;
+	std::condition_variable cv;
+	std::condition_variable finished_cv;
+
+	std::array<std::vector<Timer>, WHEEL_SIZE> slots;
+	std::unordered_set<timer_id_t> live;
+
+	clock_t::time_point start = clock_t::now();
+	uint64_t current_tick = 0;
+	timer_id_t next_id = 1;
+	timer_id_t running = 0;
+	bool stopping = false;
+
+	std::atomic<uint64_t> wakeups{0};
+
+	std::thread worker;
+
+	uint64_t now_tick() const;
+
+	uint64_t to_ticks(duration_t delay) const;
+
+	uint64_t next_deadline() const;
+
+	void insert(Timer timer);
+
+	void run();
+
+public:
+	// region ctor/dtor
+
+	TimerWheel();
+
+	TimerWheel(TimerWheel const&) = delete;
+
+	TimerWheel& operator=(TimerWheel const&) = delete;
+
+	virtual ~TimerWheel();
+	// endregion
+
+	static TimerWheel& instance();
+
+	/**
+	 * \brief Runs [action] once after [delay].
+	 * \return id to pass to [cancel]
+	 */
+	timer_id_t schedule(duration_t delay, IScheduler* scheduler, std::function<void()> action);
+
+	/**
+	 * \brief Runs [action] every [period] until cancelled.
+	 */
+	timer_id_t schedule_periodic(duration_t period, IScheduler* scheduler, std::function<void()> action);
+
+	/**
+	 * \brief Runs [action] every [period] while [lifetime] is alive.
+	 */
+	void schedule_periodic(Lifetime lifetime, duration_t period, IScheduler* scheduler, std::function<void()> action);
+
+	/**
+	 * \brief Removes the timer. If its action is executing on the worker thread right now, waits up to [timeout]
+	 * for it to finish, so that after return the action is never invoked again unless the wait timed out.
+	 * \return true if the timer was still registered
+	 */
+	bool cancel(timer_id_t id, duration_t timeout = duration_t(500));
+
+	size_t size() const;
+
+	/**
+	 * \brief Number of times the worker thread has woken up, for diagnostics.
+	 */
+	uint64_t get_wakeups() const;
+};
+}	 // namespace rd
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+#endif	  // RD_CPP_TIMERWHEEL_H
@@ -25,6 +25,17 @@ public:
 	{
 		ctx.get_serializers().writePolymorphicNullable(ctx, buffer, *value);
 	}
+
+	static size_t serialized_size(T const& value)
+	{
+		// type id and length prefix of the polymorphic header
+		return sizeof(RdId::hash_t) + sizeof(int32_t) + rd::serialized_size<Polymorphic<T>>(value);
+	}
+
+	static size_t serialized_size(Wrapper<T> const& value)
+	{
+		return serialized_size(*value);
+	}
 };
 }	 // namespace rd
 
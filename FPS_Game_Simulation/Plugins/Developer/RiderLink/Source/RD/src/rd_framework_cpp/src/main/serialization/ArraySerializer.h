@@ -8,19 +8,76 @@
 
 namespace rd
 {
+namespace detail
+{
+/**
+ * \brief True when [S] writes [T] as its raw in-memory representation, so a whole array may be copied at once.
+ * bool and wchar_t have their own wire format and are excluded.
+ */
+template <typename S, typename T>
+struct is_bulk_serializer : std::false_type
+{
+};
+
+template <typename T>
+struct is_bulk_serializer<Polymorphic<T>, T>
+	: std::integral_constant<bool, (std::is_integral<T>::value && !util::is_same_v<T, bool> && !util::is_same_v<T, wchar_t>) ||
+									   std::is_floating_point<T>::value>
+{
+};
+}	 // namespace detail
+
 template <typename S, template <class, class> class C, typename T = typename util::read_t<S>,
 	typename A = allocator<value_or_wrapper<T>>>
 class ArraySerializer
 {
+	using bulk = detail::is_bulk_serializer<S, T>;
+
+	static C<value_or_wrapper<T>, A> read(SerializationCtx& /*ctx*/, Buffer& buffer, std::true_type)
+	{
+		return buffer.read_array<C, T, A>();
+	}
+
+	static C<value_or_wrapper<T>, A> read(SerializationCtx& ctx, Buffer& buffer, std::false_type)
+	{
+		return buffer.read_array<C, T, A>([&] { return S::read(ctx, buffer); });
+	}
+
+	static void write(SerializationCtx& /*ctx*/, Buffer& buffer, C<value_or_wrapper<T>, A> const& value, std::true_type)
+	{
+		buffer.write_array<C, T, A>(value);
+	}
+
+	static void write(SerializationCtx& ctx, Buffer& buffer, C<value_or_wrapper<T>, A> const& value, std::false_type)
+	{
+		buffer.write_array<C, T, A>(value, [&](T const& inner_value) { S::write(ctx, buffer, inner_value); });
+	}
+
+	static size_t serialized_size(C<value_or_wrapper<T>, A> const& value, std::true_type)
+	{
+		using rd::size;
+		return sizeof(int32_t) + sizeof(T) * static_cast<size_t>(size(value));
+	}
+
+	static size_t serialized_size(C<value_or_wrapper<T>, A> const& value, std::false_type)
+	{
+		return serialized_array_size<S>(value);
+	}
+
 public:
 	static C<value_or_wrapper<T>, A> read(SerializationCtx& ctx, Buffer& buffer)
 	{
-		return buffer.read_array<C, T, A>([&] { return S::read(ctx, buffer); });
+		return read(ctx, buffer, bulk{});
 	}
 
 	static void write(SerializationCtx& ctx, Buffer& buffer, C<value_or_wrapper<T>, A> const& value)
 	{
-		buffer.write_array<C, T, A>(value, [&](T const& inner_value) { S::write(ctx, buffer, inner_value); });
+		write(ctx, buffer, value, bulk{});
+	}
+
+	static size_t serialized_size(C<value_or_wrapper<T>, A> const& value)
+	{
+		return serialized_size(value, bulk{});
 	}
 };
 }	 // namespace rd
@@ -4,6 +4,11 @@
 
 namespace rd
 {
+size_t ISerializable::serialized_size() const
+{
+	return 0;
+}
+
 size_t IPolymorphicSerializable::hashCode() const noexcept
 {
 	return rd::hash<void const*>()(static_cast<void const*>(this));
@@ -1,6 +1,7 @@
 #ifndef RD_CPP_ISERIALIZABLE_H
 #define RD_CPP_ISERIALIZABLE_H
 
+#include <cstddef>
 #include <string>
 
 #include <rd_framework_export.h>
@@ -24,6 +25,14 @@ public:
 	virtual ~ISerializable() = default;
 
 	virtual void write(SerializationCtx& ctx, Buffer& buffer) const = 0;
+
+	/**
+	 * \brief Best-effort hint of the number of bytes \ref write produces, used to size the send buffer once. It may
+	 * be short of the real size, see rd::serialized_size. Types which can't override it, e.g. generated ones,
+	 * specialize rd::serialized_size_of instead.
+	 * \return 0 if unknown
+	 */
+	virtual size_t serialized_size() const;
 };
 
 /**
@@ -30,6 +30,16 @@ public:
 	{
 		buffer.write_nullable<T>(value, [&](T const& inner_value) { S::write(ctx, buffer, inner_value); });
 	}
+
+	static size_t serialized_size(optional<T> const& value)
+	{
+		return sizeof(uint8_t) + (value ? rd::serialized_size<S>(*value) : 0);
+	}
+
+	static size_t serialized_size(Wrapper<T> const& value)
+	{
+		return sizeof(uint8_t) + (value ? rd::serialized_size<S>(*value) : 0);
+	}
 };
 
 template <typename S>
@@ -48,6 +58,11 @@ public:
 	{
 		buffer.write_nullable<T>(value, [&](T const& inner_value) { S::write(ctx, buffer, inner_value); });
 	}
+
+	static size_t serialized_size(Wrapper<T> const& value)
+	{
+		return sizeof(uint8_t) + (value ? rd::serialized_size<S>(value) : 0);
+	}
 };
 }	 // namespace rd
 
@@ -3,6 +3,7 @@
 
 #include "protocol/Buffer.h"
 #include "base/RdReactiveBase.h"
+#include "util/core_traits.h"
 
 #include <type_traits>
 
@@ -13,6 +14,21 @@ namespace rd
 class SerializationCtx;
 // endregion
 
+/**
+ * \brief Tells \ref serialized_size of [T] without touching [T], for types whose class can't declare it, e.g. the
+ * ones RdGen generates. Specialize with a static "size_t get(T const&)"; by default it asks
+ * ISerializable::serialized_size.
+ */
+template <typename T, typename = void>
+struct serialized_size_of
+{
+	template <typename U = T>
+	static auto get(U const& value) -> decltype(value.serialized_size())
+	{
+		return value.serialized_size();
+	}
+};
+
 /**
  * \brief Maintains "SerDes" for statically polymorphic type [T].
  * Requires static "read" and "write" methods as in common case below.
@@ -37,6 +53,18 @@ public:
 	{
 		value->write(ctx, buffer);
 	}
+
+	template <typename U = T>
+	inline static auto serialized_size(U const& value) -> decltype(serialized_size_of<U>::get(value))
+	{
+		return serialized_size_of<U>::get(value);
+	}
+
+	template <typename U, typename A>
+	inline static auto serialized_size(Wrapper<U, A> const& value) -> decltype(serialized_size_of<U>::get(*value))
+	{
+		return serialized_size_of<U>::get(*value);
+	}
 };
 
 template <typename T>
@@ -52,6 +80,11 @@ public:
 	{
 		buffer.write_integral<T>(value);
 	}
+
+	inline static size_t serialized_size(T const& /*value*/)
+	{
+		return sizeof(T);
+	}
 };
 
 template <typename T>
@@ -67,6 +100,11 @@ public:
 	{
 		buffer.write_floating_point<T>(value);
 	}
+
+	inline static size_t serialized_size(T const& /*value*/)
+	{
+		return sizeof(T);
+	}
 };
 
 // class Polymorphic<int, void>;
@@ -85,6 +123,12 @@ public:
 	{
 		buffer.write_array<C, T, A>(value);
 	}
+
+	inline static size_t serialized_size(C<T, A> const& value)
+	{
+		using rd::size;
+		return sizeof(int32_t) + sizeof(T) * static_cast<size_t>(size(value));
+	}
 };
 
 template <>
@@ -100,6 +144,11 @@ public:
 	{
 		buffer.write_bool(value);
 	}
+
+	inline static size_t serialized_size(bool const& /*value*/)
+	{
+		return sizeof(uint8_t);
+	}
 };
 
 template <>
@@ -115,6 +164,11 @@ public:
 	{
 		buffer.write_char(value);
 	}
+
+	inline static size_t serialized_size(wchar_t const& /*value*/)
+	{
+		return sizeof(uint16_t);
+	}
 };
 
 template <>
@@ -135,6 +189,16 @@ public:
 	{
 		buffer.write_wstring(*value);
 	}
+
+	inline static size_t serialized_size(std::wstring const& value)
+	{
+		return sizeof(int32_t) + sizeof(uint16_t) * value.size();
+	}
+
+	inline static size_t serialized_size(Wrapper<std::wstring> const& value)
+	{
+		return serialized_size(*value);
+	}
 };
 
 template <>
@@ -150,6 +214,11 @@ public:
 	{
 		buffer.write_date_time(value);
 	}
+
+	inline static size_t serialized_size(DateTime const& /*value*/)
+	{
+		return sizeof(int64_t);
+	}
 };
 
 template <>
@@ -164,6 +233,11 @@ public:
 	inline static void write(SerializationCtx& /*ctx*/, Buffer& /*buffer*/, Void const& /*value*/)
 	{
 	}
+
+	inline static size_t serialized_size(Void const& /*value*/)
+	{
+		return 0;
+	}
 };
 
 template <typename T>
@@ -194,6 +268,11 @@ public:
 	{
 		buffer.write_enum<T>(value);
 	}
+
+	inline static size_t serialized_size(T const& /*value*/)
+	{
+		return sizeof(int32_t);
+	}
 };
 
 template <typename T>
@@ -209,6 +288,8 @@ public:
 	{
 		buffer.write_nullable<T>(value, [&ctx, &buffer](T const& v) { Polymorphic<T>::write(ctx, buffer, v); });
 	}
+
+	inline static size_t serialized_size(optional<T> const& value);
 };
 
 template <typename T, typename A>
@@ -219,7 +300,69 @@ public:
 	{
 		value->write(ctx, buffer);
 	}
+
+	template <typename U = T>
+	inline static auto serialized_size(Wrapper<U, A> const& value) -> decltype(serialized_size_of<U>::get(*value))
+	{
+		return serialized_size_of<U>::get(*value);
+	}
+};
+
+namespace detail
+{
+template <typename S, typename T, typename = void>
+struct has_serialized_size : std::false_type
+{
+};
+
+template <typename S, typename T>
+struct has_serialized_size<S, T, util::void_t<decltype(S::serialized_size(std::declval<T const&>()))>> : std::true_type
+{
 };
+
+template <typename S, typename T>
+size_t serialized_size(T const& value, std::true_type)
+{
+	return S::serialized_size(value);
+}
+
+template <typename S, typename T>
+size_t serialized_size(T const& /*value*/, std::false_type)
+{
+	return 0;
+}
+}	 // namespace detail
+
+/**
+ * \brief Best-effort hint of the number of bytes "SerDes" [S] writes for [value], 0 when [S] can't tell cheaply.
+ * Not a bound: an aggregate counts its unknown parts as 0, and a wstring with characters outside the BMP writes
+ * surrogate pairs. Getting it wrong only costs the send buffer growing on demand.
+ */
+template <typename S, typename T>
+size_t serialized_size(T const& value)
+{
+	return detail::serialized_size<S>(value, detail::has_serialized_size<S, T>{});
+}
+
+/**
+ * \brief \ref serialized_size of an array written element by element with [S].
+ */
+template <typename S, typename C>
+size_t serialized_array_size(C const& container)
+{
+	size_t result = sizeof(int32_t);
+	for (auto const& element : container)
+	{
+		result += serialized_size<S>(element);
+	}
+	return result;
+}
+
+template <typename T>
+size_t Polymorphic<optional<T>>::serialized_size(optional<T> const& value)
+{
+	return sizeof(uint8_t) + (value ? rd::serialized_size<Polymorphic<T>>(*value) : 0);
+}
 }	 // namespace rd
 
 #endif	  // RD_CPP_POLYMORPHIC_H
@@ -9,7 +9,7 @@
 #include "protocol/Buffer.h"
 #include "protocol/RdId.h"
 
-#include "std/unordered_map.h"
+#include "std/flat_hash_map.h"
 
 #include <functional>
 #include <string>
@@ -36,7 +36,7 @@ class RD_FRAMEWORK_API SerializationCtx
 	Serializers const* serializers = nullptr;
 
 public:
-	using roots_t = rd::unordered_map<util::hash_t, InternRoot const*>;
+	using roots_t = rd::flat_hash_map<util::hash_t, InternRoot const*>;
 
 	roots_t intern_roots{};
 
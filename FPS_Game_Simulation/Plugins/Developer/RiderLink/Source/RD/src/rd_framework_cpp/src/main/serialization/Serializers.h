@@ -14,7 +14,7 @@
 #include "serialization/RdAny.h"
 #include "DefaultAbstractDeclaration.h"
 
-#include "std/unordered_map.h"
+#include "std/flat_hash_map.h"
 
 #include <utility>
 #include <iostream>
@@ -46,7 +46,9 @@ private:
 
 	void register_in();
 
-	mutable rd::unordered_map<RdId, std::function<InternedAny(SerializationCtx&, Buffer&)>> readers;
+	using reader_t = InternedAny (*)(SerializationCtx&, Buffer&);
+
+	mutable rd::flat_hash_map<RdId, reader_t> readers;
 
 public:
 	Serializers();
@@ -83,11 +85,11 @@ void Serializers::registry() const
 	util::hash_t h = util::getPlatformIndependentHash(type_name);
 	RdId id(h);
 
-	RD_ASSERT_MSG(readers.count(id) == 0, "Can't register " + type_name + " with id: " + to_string(id));
-
-	readers[id] = [](SerializationCtx& ctx, Buffer& buffer) -> Wrapper<IPolymorphicSerializable> {
-		return wrapper::make_wrapper<T>(T::read(ctx, buffer));
+	reader_t reader = [](SerializationCtx& ctx, Buffer& buffer) -> InternedAny {
+		return any::make_interned_any<T>(wrapper::make_wrapper<T>(T::read(ctx, buffer)));
 	};
+	bool inserted = readers.emplace(id, reader).second;
+	RD_ASSERT_MSG(inserted, "Can't register " + type_name + " with id: " + to_string(id));
 }
 
 template <typename T>
@@ -101,12 +103,12 @@ optional<InternedAny> Serializers::readAny(SerializationCtx& ctx, Buffer& buffer
 	int32_t size = buffer.read_integral<int32_t>();
 	buffer.check_available(static_cast<size_t>(size));
 
-	if (readers.count(id) == 0)
+	auto it = readers.find(id);
+	if (it == readers.end())
 	{
 		return any::make_interned_any<T>(T::readUnknownInstance(ctx, buffer, id, size));
 	}
-	auto const& reader = readers.at(id);
-	return reader(ctx, buffer);
+	return it->second(ctx, buffer);
 }
 
 template <typename T>
@@ -7,6 +7,8 @@
 #include "scheduler/SynchronousScheduler.h"
 #include "WiredRdTask.h"
 
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 
 #if defined(_MSC_VER)
@@ -32,6 +34,13 @@ class RdCall : public virtual RdReactiveBase, public ISerializable
 
 	mutable optional<RdId> sync_task_id;
 
+	struct SyncWaiter
+	{
+		std::mutex lock;
+		std::condition_variable var;
+		bool done = false;
+	};
+
 public:
 	// region ctor/dtor
 	RdCall() = default;
@@ -73,10 +82,18 @@ public:
 	{
 		auto task = start_internal(request, true, &SynchronousScheduler::Instance());
 		auto time_at_start = std::chrono::system_clock::now();
-		while (!task.has_value() && !(*bind_lifetime)->is_terminated() &&
-			   ((std::chrono::system_clock::now() - time_at_start) < timeout))
 		{
-			std::this_thread::yield();
+			// the result arrives on the wire's receiver thread (or as Cancelled when bind_lifetime terminates),
+			// so sleep until it is set instead of spinning
+			auto waiter = std::make_shared<SyncWaiter>();
+			LifetimeDefinition wait_definition(false);
+			task.advise(wait_definition.lifetime, [waiter](typename WiredRdTask<TRes, ResSer>::result_type const&) {
+				std::lock_guard<std::mutex> guard(waiter->lock);
+				waiter->done = true;
+				waiter->var.notify_all();
+			});
+			std::unique_lock<std::mutex> guard(waiter->lock);
+			waiter->var.wait_for(guard, timeout, [&] { return waiter->done || (*bind_lifetime)->is_terminated(); });
 		}
 		spdlog::debug("Time elapsed: {}, has_value={}", to_string(std::chrono::system_clock::now() - time_at_start),
 			to_string(task.has_value()));
@@ -129,12 +146,15 @@ private:
 			sync_task_id = task_id;
 		}
 
-		get_wire()->send(rdid, [&](Buffer& buffer) {
-			spdlog::get("logSend")->trace("call {}::{} send {} request {} : {}", to_string(location), to_string(rdid), (sync ? "SYNC" : "ASYNC"),
-				to_string(task_id), to_string(request));
-			task_id.write(buffer);
-			ReqSer::write(get_serialization_context(), buffer, request);
-		});
+		get_wire()->send(
+			rdid,
+			[&](Buffer& buffer) {
+				spdlog::get("logSend")->trace("call {}::{} send {} request {} : {}", to_string(location), to_string(rdid),
+					(sync ? "SYNC" : "ASYNC"), to_string(task_id), to_string(request));
+				task_id.write(buffer);
+				ReqSer::write(get_serialization_context(), buffer, request);
+			},
+			sizeof(RdId::hash_t) + rd::serialized_size<ReqSer>(request));
 
 		return task;
 	}
@@ -29,6 +29,38 @@ void ByteBufferAsyncProcessor::cleanup0()
 	// TO-DO clean data
 
 	cv.notify_all();
+	close_window();
+}
+
+void ByteBufferAsyncProcessor::close_window()
+{
+	{
+		std::lock_guard<decltype(pending_lock)> guard(pending_lock);
+		window_closed = true;
+	}
+	window_cv.notify_all();
+}
+
+void ByteBufferAsyncProcessor::release_acknowledged()
+{
+	// pending_lock must be held
+	if (in_reprocessing)
+	{
+		return;
+	}
+	size_t released = 0;
+	while (current_seqn <= acknowledged_seqn && !pending_queue.empty())
+	{
+		released += pending_queue.front().size();
+		pending_queue.pop_front();
+		++current_seqn;
+	}
+	if (released > 0)
+	{
+		window_bytes -= (std::min)(released, window_bytes);
+		window_stalled = false;
+		window_cv.notify_all();
+	}
 }
 
 bool ByteBufferAsyncProcessor::terminate0(time_t timeout, StateKind state_to_set, string_view action)
@@ -51,6 +83,7 @@ bool ByteBufferAsyncProcessor::terminate0(time_t timeout, StateKind state_to_set
 		state = state_to_set;
 	}
 	cv.notify_all();
+	close_window();
 
 	std::future_status status = async_future.wait_for(timeout);
 
@@ -88,21 +121,29 @@ bool ByteBufferAsyncProcessor::reprocess()
 
 		logger->debug("{}: reprocessing waited for main processing", id);
 
-		while (current_seqn <= acknowledged_seqn)
+		size_t count = 0;
+		sequence_number_t first_seqn = 0;
 		{
-			pending_queue.pop_front();
-			++current_seqn;
+			std::lock_guard<decltype(pending_lock)> pending_guard(pending_lock);
+			release_acknowledged();
+			// process() is excluded by queue_lock and acknowledge() doesn't release while this flag is set,
+			// so the pending packages stay in place while they are resent without holding pending_lock
+			in_reprocessing = true;
+			count = pending_queue.size();
+			first_seqn = current_seqn;
 		}
-		for (int i = 0; i < pending_queue.size(); ++i)
+
+		bool success = true;
+		for (size_t i = 0; i < count && success; ++i)
 		{
-			auto const& item = pending_queue[i];
-			if (!processor(item, current_seqn + i))
-			{
-				return false;
-			}
+			success = processor(pending_queue[i], first_seqn + static_cast<sequence_number_t>(i));
 		}
+
+		std::lock_guard<decltype(pending_lock)> pending_guard(pending_lock);
+		in_reprocessing = false;
+		release_acknowledged();
+		return success;
 	}
-	return true;
 }
 
 void ByteBufferAsyncProcessor::process()
@@ -117,7 +158,11 @@ void ByteBufferAsyncProcessor::process()
 		while (!queue.empty() && processor(queue.front(), max_sent_seqn + 1))
 		{
 			++max_sent_seqn;
-			pending_queue.push_back(std::move(queue.front()));
+			{
+				std::lock_guard<decltype(pending_lock)> pending_guard(pending_lock);
+				pending_queue.push_back(std::move(queue.front()));
+				release_acknowledged();
+			}
 			queue.pop_front();
 		}
 	}
@@ -200,6 +245,36 @@ bool ByteBufferAsyncProcessor::terminate(time_t timeout)
 
 void ByteBufferAsyncProcessor::put(Buffer::ByteArray new_data)
 {
+	const size_t size = new_data.size();
+	{
+		std::unique_lock<decltype(pending_lock)> ul(pending_lock);
+		const auto fits = [this, size]() -> bool {
+			// a single package larger than the window still goes through once the window is empty
+			return window_closed || max_window_bytes == 0 || window_bytes == 0 || window_bytes + size <= max_window_bytes;
+		};
+		if (!fits())
+		{
+			// no acknowledgement arrives while disconnected or while the acknowledging thread itself waits here,
+			// so the wait is bounded and the package is kept past the limit: dropping it would desync the counterpart
+			const auto current_thread_id = std::this_thread::get_id();
+			const bool may_wait =
+				!window_stalled && current_thread_id != acknowledging_thread_id && current_thread_id != async_thread_id;
+			if (!may_wait || !window_cv.wait_for(ul, max_window_wait, fits))
+			{
+				if (!window_stalled)
+				{
+					logger->warn("{}: retransmit window of {} bytes is full, queueing past it", id, max_window_bytes);
+				}
+				window_stalled = true;
+				++window_overflows;
+			}
+		}
+		if (window_closed)
+		{
+			return;
+		}
+		window_bytes += size;
+	}
 	{
 		std::lock_guard<decltype(lock)> guard(lock);
 
@@ -247,12 +322,13 @@ void ByteBufferAsyncProcessor::resume()
 
 void ByteBufferAsyncProcessor::acknowledge(sequence_number_t seqn)
 {
-	std::lock_guard<decltype(lock)> guard(lock);
+	std::lock_guard<decltype(pending_lock)> guard(pending_lock);
 
 	if (seqn > acknowledged_seqn)
 	{
 		logger->trace("{}: new acknowledged seqn: {}", this->id, seqn);
 		acknowledged_seqn = seqn;
+		release_acknowledged();
 	}
 	else
 	{
@@ -260,6 +336,40 @@ void ByteBufferAsyncProcessor::acknowledge(sequence_number_t seqn)
 	}
 }
 
+void ByteBufferAsyncProcessor::set_max_window_bytes(size_t bytes, time_t max_wait)
+{
+	{
+		std::lock_guard<decltype(pending_lock)> guard(pending_lock);
+		max_window_bytes = bytes;
+		max_window_wait = max_wait;
+	}
+	window_cv.notify_all();
+}
+
+void ByteBufferAsyncProcessor::set_acknowledging_thread(std::thread::id thread_id)
+{
+	std::lock_guard<decltype(pending_lock)> guard(pending_lock);
+	acknowledging_thread_id = thread_id;
+}
+
+size_t ByteBufferAsyncProcessor::get_window_bytes()
+{
+	std::lock_guard<decltype(pending_lock)> guard(pending_lock);
+	return window_bytes;
+}
+
+size_t ByteBufferAsyncProcessor::get_window_overflows()
+{
+	std::lock_guard<decltype(pending_lock)> guard(pending_lock);
+	return window_overflows;
+}
+
+size_t ByteBufferAsyncProcessor::get_pending_packages()
+{
+	std::lock_guard<decltype(pending_lock)> guard(pending_lock);
+	return pending_queue.size();
+}
+
 std::string to_string(ByteBufferAsyncProcessor::StateKind state)
 {
 	switch (state)
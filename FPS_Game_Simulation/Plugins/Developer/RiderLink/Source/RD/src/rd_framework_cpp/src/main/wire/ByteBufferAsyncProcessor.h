@@ -15,6 +15,7 @@
 #include <condition_variable>
 #include <future>
 #include <list>
+#include <thread>
 
 #include <rd_framework_export.h>
 
@@ -55,11 +56,40 @@ private:
 	std::vector<Buffer::ByteArray> data;
 	std::mutex queue_lock;
 	std::deque<Buffer::ByteArray> queue{};
-	std::deque<Buffer::ByteArray> pending_queue{};
 
 	sequence_number_t max_sent_seqn = 0;
+
+	// region retransmit window
+	/**
+	 * \brief Guards sent but not yet acknowledged packages. Held only for short bookkeeping, never while sending, so
+	 * acknowledgements from the receiver thread are never blocked by a slow socket.
+	 */
+	std::mutex pending_lock;
+	std::condition_variable window_cv;
+	std::deque<Buffer::ByteArray> pending_queue{};
 	sequence_number_t current_seqn = 1;
 	sequence_number_t acknowledged_seqn = 0;
+	/**
+	 * \brief While set, pending packages are being resent from another thread and mustn't be released.
+	 */
+	bool in_reprocessing = false;
+	bool window_closed = false;
+	/**
+	 * \brief Bytes accepted by \ref put and not yet acknowledged by the counterpart.
+	 */
+	size_t window_bytes = 0;
+	size_t max_window_bytes = 0;
+	time_t max_window_wait{100};
+	/**
+	 * \brief Set when a \ref put gave up waiting, later puts don't wait until an acknowledgement releases space.
+	 */
+	bool window_stalled = false;
+	size_t window_overflows = 0;
+	/**
+	 * \brief Acknowledgements are delivered on this thread, so it never waits for the window.
+	 */
+	std::thread::id acknowledging_thread_id;
+	// endregion
 
 	int32_t interrupt_balance = 0;
 	bool in_processing = false;
@@ -79,6 +109,10 @@ private:
 
 	void add_data(std::vector<Buffer::ByteArray>&& new_data);
 
+	void release_acknowledged();
+
+	void close_window();
+
 	bool reprocess();
 
 	void process();
@@ -99,6 +133,25 @@ public:
 	void resume();
 
 	void acknowledge(int64_t seqn);
+
+	/**
+	 * \brief Limits the amount of bytes which may be put but not yet acknowledged. When the limit is reached \ref put
+	 * blocks until acknowledgements free enough space, the processor stops or [max_wait] passes. A package which
+	 * couldn't wait is queued past the limit and counted by \ref get_window_overflows, it is never dropped.
+	 * Zero means no limit.
+	 */
+	void set_max_window_bytes(size_t bytes, time_t max_wait = time_t(100));
+
+	/**
+	 * \brief Marks the thread which calls \ref acknowledge, puts from it never wait for the window.
+	 */
+	void set_acknowledging_thread(std::thread::id thread_id);
+
+	size_t get_window_bytes();
+
+	size_t get_window_overflows();
+
+	size_t get_pending_packages();
 };
 
 std::string to_string(ByteBufferAsyncProcessor::StateKind state);
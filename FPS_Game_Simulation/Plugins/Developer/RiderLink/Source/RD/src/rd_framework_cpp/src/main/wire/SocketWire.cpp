@@ -1,5 +1,7 @@
 #include "wire/SocketWire.h"
 
+#include "scheduler/TimerWheel.h"
+
 #include <util/thread_util.h>
 
 #include "spdlog/sinks/stdout_color_sinks.h"
@@ -77,20 +79,33 @@ bool SocketWire::Base::send0(Buffer::ByteArray const& msg, sequence_number_t seq
 		int32_t msglen = static_cast<int32_t>(msg.size());
 
 		send_package_header.rewind();
+		if (has_pending_ack)
+		{
+			send_package_header.write_integral(ACK_MESSAGE_LENGTH);
+			send_package_header.write_integral(pending_ack_seqn);
+		}
 		send_package_header.write_integral(msglen);
 		send_package_header.write_integral(seqn);
 
+		const int32_t header_length = static_cast<int32_t>(send_package_header.get_position());
+		socket_send_calls.fetch_add(2, std::memory_order_relaxed);
 		RD_ASSERT_THROW_MSG(
-			socket_provider->Send(send_package_header.data(), send_package_header.get_position()) == PACKAGE_HEADER_LENGTH,
+			socket_provider->Send(send_package_header.data(), header_length) == header_length,
 			this->id +
 				": failed to send header over the network"
 				", reason: " +
 				socket_provider->DescribeError())
+		has_pending_ack = false;
+		unacknowledged_packages = 0;
 
 		RD_ASSERT_THROW_MSG(socket_provider->Send(msg.data(), msglen) == msglen, this->id +
 																					 ": failed to send package over the network"
 																					 ", reason: " +
 																					 socket_provider->DescribeError());
+		if (auto recorder = std::atomic_load(&capture))
+		{
+			recorder->append(WireCapture::Direction::Sent, seqn, msg.data(), msglen);
+		}
 		logger->info("{}: were sent {} bytes", this->id, msglen);
 		//        RD_ASSERT_MSG(socketProvider->Flush(), "{}: failed to flush");
 		return true;
@@ -103,11 +118,13 @@ bool SocketWire::Base::send0(Buffer::ByteArray const& msg, sequence_number_t seq
 	}
 }
 
-void SocketWire::Base::send(RdId const& rd_id, std::function<void(Buffer& buffer)> writer) const
+void SocketWire::Base::send(RdId const& rd_id, std::function<void(Buffer& buffer)> writer, size_t size_hint) const
 {
 	RD_ASSERT_MSG(!rd_id.isNull(), "{}: id mustn't be null");
 
-	Buffer local_send_buffer;
+	// length, id and context precede the body
+	auto local_send_buffer = Buffer::with_capacity(
+		size_hint == 0 ? 0 : sizeof(int32_t) + sizeof(RdId::hash_t) + sizeof(int16_t) + size_hint);
 	local_send_buffer.write_integral<int32_t>(0);	 // placeholder for length
 	rd_id.write(local_send_buffer);					 // write id
 	local_send_buffer.write_integral<int16_t>(0);	 // placeholder for context
@@ -118,6 +135,7 @@ void SocketWire::Base::send(RdId const& rd_id, std::function<void(Buffer& buffer
 	local_send_buffer.rewind();
 	local_send_buffer.write_integral<int32_t>(len - 4);
 	local_send_buffer.set_position(len);
+	metrics.record_sent(rd_id, len - 4);
 	async_send_buffer.put(std::move(local_send_buffer).getRealArray());
 }
 
@@ -136,8 +154,11 @@ void SocketWire::Base::set_socket_provider(std::shared_ptr<CActiveSocket> new_so
 		}
 	}
 
-	auto heartbeat = LifetimeDefinition::use([this](Lifetime heartbeatLifetime) {
-		const auto heartbeat = start_heartbeat(heartbeatLifetime).share();
+	// acknowledgements are read on this thread, so a handler sending from it mustn't wait for them
+	async_send_buffer.set_acknowledging_thread(std::this_thread::get_id());
+
+	LifetimeDefinition::use([this](Lifetime heartbeatLifetime) {
+		start_heartbeat(heartbeatLifetime);
 
 		async_send_buffer.resume();
 
@@ -148,12 +169,9 @@ void SocketWire::Base::set_socket_provider(std::shared_ptr<CActiveSocket> new_so
 		connected.set(false);
 
 		async_send_buffer.pause("Disconnected");
-
-		return heartbeat;
 	});
-	const auto status = heartbeat.wait_for(timeout);
 
-	logger->debug("{}: waited for heartbeat to stop with status: {}", this->id, static_cast<uint32_t>(status));
+	logger->debug("{}: heartbeat stopped", this->id);
 
 	if (!socket_provider->IsSocketValid())
 	{
@@ -171,12 +189,12 @@ bool SocketWire::Base::connection_established(int32_t timestamp, int32_t notion_
 	return timestamp - notion_timestamp <= MaximumHeartbeatDelay;
 }
 
-std::future<void> SocketWire::Base::start_heartbeat(Lifetime lifetime)
+void SocketWire::Base::start_heartbeat(Lifetime lifetime)
 {
-	return std::async([this, lifetime] {
-		while (!lifetime->is_terminated())
+	// the ping sends on the socket and may block, so it runs on the wire's scheduler rather than the shared timer thread
+	TimerWheel::instance().schedule_periodic(lifetime, heartBeatInterval, scheduler, [this, lifetime] {
+		if (!lifetime->is_terminated())
 		{
-			std::this_thread::sleep_for(heartBeatInterval);
 			ping();
 		}
 	});
@@ -205,7 +223,10 @@ bool SocketWire::Base::read_from_socket(Buffer::word_t* res, int32_t msglen) con
 			{
 				hi = lo = receiver_buffer.begin();
 			}
+			// nothing buffered: acknowledge what has been read so far before possibly blocking
+			flush_ack();
 			logger->info("{}: receive started", this->id);
+			socket_receive_calls.fetch_add(1, std::memory_order_relaxed);
 			int32_t read = socket_provider->Receive(static_cast<int32_t>(receiver_buffer.end() - hi), &*hi);
 			if (read == -1)
 			{
@@ -319,7 +340,11 @@ int32_t SocketWire::Base::read_package() const
 		logger->debug("{}: failed to read package", this->id);
 		return -1;
 	}
-	send_ack(seqn);
+	if (auto recorder = std::atomic_load(&capture))
+	{
+		recorder->append(WireCapture::Direction::Received, seqn, receive_pkg.data(), len);
+	}
+	queue_ack(seqn);
 	if (seqn <= max_received_seqn && seqn != 1)
 	{
 		return true;
@@ -346,6 +371,7 @@ bool SocketWire::Base::read_and_dispatch_message() const
 	}
 	logger->trace("{}: message info: sz={}, id={}", this->id, sz, id_);
 	const RdId rd_id{id_};
+	metrics.record_received(rd_id, sz);
 	sz -= 8;	// RdId
 	message.require_available(sz);
 
@@ -366,6 +392,22 @@ bool SocketWire::Base::read_and_dispatch_message() const
 	//		RD_ASSERT_MSG(summary_size == sz, "Broken message, read:%d bytes, expected:%d bytes", summary_size, sz)
 }
 
+WireMetricsSnapshot SocketWire::Base::get_metrics_snapshot() const
+{
+	auto snapshot = WireBase::get_metrics_snapshot();
+	snapshot.send_window_bytes = async_send_buffer.get_window_bytes();
+	snapshot.send_pending_packages = async_send_buffer.get_pending_packages();
+	snapshot.send_window_overflows = async_send_buffer.get_window_overflows();
+	snapshot.socket_send_calls = socket_send_calls.load(std::memory_order_relaxed);
+	snapshot.socket_receive_calls = socket_receive_calls.load(std::memory_order_relaxed);
+	return snapshot;
+}
+
+void SocketWire::Base::set_max_send_window_bytes(size_t bytes) const
+{
+	async_send_buffer.set_max_window_bytes(bytes);
+}
+
 CSimpleSocket* SocketWire::Base::get_socket_provider() const
 {
 	return socket_provider.get();
@@ -393,6 +435,7 @@ void SocketWire::Base::ping() const
 		ping_pkg_header.write_integral(counterpart_timestamp);
 		{
 			std::lock_guard<decltype(socket_send_lock)> guard(socket_send_lock);
+			socket_send_calls.fetch_add(1, std::memory_order_relaxed);
 			int32_t sent = socket_provider->Send(ping_pkg_header.data(), ping_pkg_header.get_position());
 			if (sent == 0 && !socket_provider->IsSocketValid())
 			{
@@ -421,6 +464,7 @@ bool SocketWire::Base::send_ack(sequence_number_t seqn) const
 		ack_buffer.write_integral(seqn);
 		{
 			std::lock_guard<decltype(socket_send_lock)> guard(socket_send_lock);
+			socket_send_calls.fetch_add(1, std::memory_order_relaxed);
 			RD_ASSERT_THROW_MSG(socket_provider->Send(ack_buffer.data(), ack_buffer.get_position()) == PACKAGE_HEADER_LENGTH,
 				this->id +
 					": failed to send ack over the network"
@@ -436,6 +480,43 @@ bool SocketWire::Base::send_ack(sequence_number_t seqn) const
 	}
 }
 
+void SocketWire::Base::queue_ack(sequence_number_t seqn) const
+{
+	bool flush = false;
+	{
+		std::lock_guard<decltype(socket_send_lock)> guard(socket_send_lock);
+		// acknowledges are cumulative, a resent package mustn't pull them back unless the counterpart restarted
+		pending_ack_seqn = seqn == 1 ? seqn : (std::max)(pending_ack_seqn, seqn);
+		has_pending_ack = true;
+		flush = ++unacknowledged_packages >= MAX_UNACKNOWLEDGED_PACKAGES;
+	}
+	if (flush)
+	{
+		flush_ack();
+	}
+}
+
+bool SocketWire::Base::flush_ack() const
+{
+	sequence_number_t seqn = 0;
+	{
+		std::lock_guard<decltype(socket_send_lock)> guard(socket_send_lock);
+		if (!has_pending_ack)
+		{
+			return true;
+		}
+		seqn = pending_ack_seqn;
+		has_pending_ack = false;
+		unacknowledged_packages = 0;
+	}
+	return send_ack(seqn);
+}
+
+void SocketWire::Base::set_capture(std::shared_ptr<WireCapture> new_capture)
+{
+	std::atomic_store(&capture, std::move(new_capture));
+}
+
 bool SocketWire::Base::try_shutdown_connection() const
 {
 	auto s = get_socket_provider();
@@ -10,9 +10,11 @@
 #include "base/WireBase.h"
 #include "ByteBufferAsyncProcessor.h"
 #include "PkgInputStream.h"
+#include "WireCapture.h"
 
 #include <string>
 #include <array>
+#include <atomic>
 #include <condition_variable>
 
 #include <rd_framework_export.h>
@@ -76,7 +78,24 @@ public:
 		mutable Buffer ping_pkg_header{PACKAGE_HEADER_LENGTH};
 
 		mutable sequence_number_t max_received_seqn = 0;
-		mutable Buffer send_package_header{PACKAGE_HEADER_LENGTH};
+		/**
+		 * \brief Room for a pending acknowledge followed by the package header, so both go out in one Send.
+		 */
+		mutable Buffer send_package_header{2 * PACKAGE_HEADER_LENGTH};
+
+		// region delayed acknowledge
+		/**
+		 * \brief Acknowledges are cumulative: only the latest received seqn is sent, either together with the next
+		 * outgoing package, before the receiver blocks on the socket, or after this many packages.
+		 */
+		static constexpr int32_t MAX_UNACKNOWLEDGED_PACKAGES = 32;
+		mutable sequence_number_t pending_ack_seqn = 0;
+		mutable bool has_pending_ack = false;
+		mutable int32_t unacknowledged_packages = 0;
+		// endregion
+
+		mutable std::atomic<uint64_t> socket_send_calls{0};
+		mutable std::atomic<uint64_t> socket_receive_calls{0};
 
 		static constexpr int32_t CHUNK_SIZE = 16370;
 		mutable int32_t sz = -1;
@@ -85,6 +104,11 @@ public:
 
 		mutable Buffer message{CHUNK_SIZE};
 
+		/**
+		 * \brief Accessed only through std::atomic_load/std::atomic_store, set from any thread.
+		 */
+		std::shared_ptr<WireCapture> capture;
+
 		bool read_from_socket(Buffer::word_t* res, int32_t msglen) const;
 
 		template <typename T>
@@ -124,17 +148,33 @@ public:
 
 		bool send0(Buffer::ByteArray const& msg, sequence_number_t seqn) const;
 
-		void send(RdId const& rd_id, std::function<void(Buffer& buffer)> writer) const override;
+		void send(RdId const& rd_id, std::function<void(Buffer& buffer)> writer, size_t size_hint = 0) const override;
+
+		WireMetricsSnapshot get_metrics_snapshot() const override;
 
 		static bool connection_established(int32_t timestamp, int32_t acknowledged_timestamp);
 
-		std::future<void> start_heartbeat(Lifetime lifetime);
+		void start_heartbeat(Lifetime lifetime);
 
 		void ping() const;
 
 		bool send_ack(sequence_number_t seqn) const;
 
+		void queue_ack(sequence_number_t seqn) const;
+
+		bool flush_ack() const;
+
 		bool try_shutdown_connection() const;
+
+		/**
+		 * \brief Caps the bytes sent but not yet acknowledged, see \ref ByteBufferAsyncProcessor::set_max_window_bytes.
+		 */
+		void set_max_send_window_bytes(size_t bytes) const;
+
+		/**
+		 * \brief Starts recording every sent and received package to [new_capture], nullptr stops recording.
+		 */
+		void set_capture(std::shared_ptr<WireCapture> new_capture);
 		
 	private:		
 		LifetimeDefinition lifetimeDef;
@@ -0,0 +1,270 @@
+#include "WireCapture.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace rd
+{
+constexpr char WireCapture::MAGIC[8];
+constexpr size_t WireCapture::RECORD_HEADER_LENGTH;
+constexpr size_t WireCapture::INITIAL_FILE_SIZE;
+
+namespace
+{
+int64_t steady_now_ns()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+template <typename T>
+void put(Buffer::word_t*& to, T value)
+{
+	memcpy(to, &value, sizeof(T));
+	to += sizeof(T);
+}
+}	 // namespace
+
+/**
+ * \brief Writable mapping of a file which can be grown by remapping.
+ */
+class WireCapture::MappedFile
+{
+#ifdef _WIN32
+	HANDLE file = INVALID_HANDLE_VALUE;
+	HANDLE mapping = nullptr;
+#else
+	int fd = -1;
+#endif
+	Buffer::word_t* view = nullptr;
+	size_t capacity = 0;
+
+	void unmap()
+	{
+		if (view == nullptr)
+		{
+			return;
+		}
+#ifdef _WIN32
+		UnmapViewOfFile(view);
+		CloseHandle(mapping);
+		mapping = nullptr;
+#else
+		munmap(view, capacity);
+#endif
+		view = nullptr;
+	}
+
+	bool map(size_t new_capacity)
+	{
+#ifdef _WIN32
+		const auto high = static_cast<DWORD>(static_cast<uint64_t>(new_capacity) >> 32);
+		const auto low = static_cast<DWORD>(new_capacity & 0xFFFFFFFFu);
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, high, low, nullptr);
+		if (mapping == nullptr)
+		{
+			return false;
+		}
+		view = static_cast<Buffer::word_t*>(MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, new_capacity));
+		if (view == nullptr)
+		{
+			CloseHandle(mapping);
+			mapping = nullptr;
+			return false;
+		}
+#else
+		if (ftruncate(fd, static_cast<off_t>(new_capacity)) != 0)
+		{
+			return false;
+		}
+		void* mapped = mmap(nullptr, new_capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (mapped == MAP_FAILED)
+		{
+			return false;
+		}
+		view = static_cast<Buffer::word_t*>(mapped);
+#endif
+		capacity = new_capacity;
+		return true;
+	}
+
+public:
+	MappedFile(std::string const& path, size_t initial_size)
+	{
+#ifdef _WIN32
+		file = CreateFileA(
+			path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return;
+		}
+#else
+		fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (fd < 0)
+		{
+			return;
+		}
+#endif
+		map(initial_size);
+	}
+
+	~MappedFile()
+	{
+		close(0);
+	}
+
+	bool is_open() const
+	{
+		return view != nullptr;
+	}
+
+	Buffer::word_t* data() const
+	{
+		return view;
+	}
+
+	bool reserve(size_t required)
+	{
+		if (required <= capacity)
+		{
+			return true;
+		}
+		size_t new_capacity = capacity * 2;
+		while (new_capacity < required)
+		{
+			new_capacity *= 2;
+		}
+		unmap();
+		return map(new_capacity);
+	}
+
+	/**
+	 * \brief Unmaps and closes the file, trimming it to [size] bytes.
+	 */
+	void close(size_t size)
+	{
+		unmap();
+#ifdef _WIN32
+		if (file != INVALID_HANDLE_VALUE)
+		{
+			LARGE_INTEGER position;
+			position.QuadPart = static_cast<LONGLONG>(size);
+			if (SetFilePointerEx(file, position, nullptr, FILE_BEGIN))
+			{
+				SetEndOfFile(file);
+			}
+			CloseHandle(file);
+			file = INVALID_HANDLE_VALUE;
+		}
+#else
+		if (fd >= 0)
+		{
+			if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+			{
+				// keep the zero tail, the reader stops at it
+			}
+			::close(fd);
+			fd = -1;
+		}
+#endif
+	}
+};
+
+WireCapture::WireCapture(std::string const& path, size_t initial_size)
+	: file(std::make_unique<MappedFile>(path, (std::max)(initial_size, sizeof(MAGIC) + RECORD_HEADER_LENGTH)))
+	, start_ns(steady_now_ns())
+{
+	if (file->is_open())
+	{
+		memcpy(file->data(), MAGIC, sizeof(MAGIC));
+		size = sizeof(MAGIC);
+	}
+}
+
+WireCapture::~WireCapture()
+{
+	std::lock_guard<decltype(lock)> guard(lock);
+	file->close(size);
+}
+
+bool WireCapture::is_open() const
+{
+	return file->is_open();
+}
+
+void WireCapture::append(Direction direction, sequence_number_t seqn, Buffer::word_t const* data, int32_t length)
+{
+	const int64_t timestamp = steady_now_ns() - start_ns;
+
+	std::lock_guard<decltype(lock)> guard(lock);
+	if (!file->is_open() || !file->reserve(size + RECORD_HEADER_LENGTH + length))
+	{
+		return;
+	}
+	Buffer::word_t* to = file->data() + size;
+	put(to, static_cast<uint8_t>(direction));
+	put(to, length);
+	put(to, seqn);
+	put(to, timestamp);
+	memcpy(to, data, length);
+	size += RECORD_HEADER_LENGTH + length;
+}
+
+size_t WireCapture::get_size()
+{
+	std::lock_guard<decltype(lock)> guard(lock);
+	return size;
+}
+
+bool WireCapture::load(std::string const& path, std::vector<Record>& records)
+{
+	std::ifstream in(path, std::ios::binary);
+	if (!in)
+	{
+		return false;
+	}
+	char magic[sizeof(MAGIC)];
+	if (!in.read(magic, sizeof(magic)) || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+	{
+		return false;
+	}
+	while (true)
+	{
+		uint8_t direction = 0;
+		int32_t length = 0;
+		Record record;
+		if (!in.read(reinterpret_cast<char*>(&direction), sizeof(direction)) ||
+			!in.read(reinterpret_cast<char*>(&length), sizeof(length)) ||
+			!in.read(reinterpret_cast<char*>(&record.seqn), sizeof(record.seqn)) ||
+			!in.read(reinterpret_cast<char*>(&record.timestamp_ns), sizeof(record.timestamp_ns)))
+		{
+			break;
+		}
+		if (length <= 0 || direction > static_cast<uint8_t>(Direction::Received))
+		{
+			// zero-filled tail of a capture which wasn't closed properly
+			break;
+		}
+		record.direction = static_cast<Direction>(direction);
+		record.payload.resize(static_cast<size_t>(length));
+		if (!in.read(reinterpret_cast<char*>(record.payload.data()), length))
+		{
+			break;
+		}
+		records.push_back(std::move(record));
+	}
+	return true;
+}
+}	 // namespace rd
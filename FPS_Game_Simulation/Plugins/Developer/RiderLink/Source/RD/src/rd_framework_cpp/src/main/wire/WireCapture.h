@@ -0,0 +1,93 @@
+#ifndef RD_CPP_WIRECAPTURE_H
+#define RD_CPP_WIRECAPTURE_H
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4251)
+#endif
+
+#include "protocol/Buffer.h"
+#include "ByteBufferAsyncProcessor.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <rd_framework_export.h>
+
+namespace rd
+{
+/**
+ * \brief Append-only recording of the packages passing through a wire, backed by a memory-mapped file.
+ *
+ * File layout: 8 bytes of \ref MAGIC followed by records of
+ * [direction: uint8][length: int32][seqn: int64][timestamp: int64, ns since capture start][payload: length bytes].
+ * Payload is the package body exactly as it goes over the socket, without the length and seqn header.
+ */
+class RD_FRAMEWORK_API WireCapture
+{
+public:
+	enum class Direction : uint8_t
+	{
+		Sent = 0,
+		Received = 1
+	};
+
+	struct Record
+	{
+		Direction direction;
+		sequence_number_t seqn;
+		int64_t timestamp_ns;
+		Buffer::ByteArray payload;
+	};
+
+	static constexpr char MAGIC[8] = {'R', 'D', 'W', 'C', 'A', 'P', '0', '1'};
+	static constexpr size_t RECORD_HEADER_LENGTH = sizeof(uint8_t) + sizeof(int32_t) + sizeof(sequence_number_t) + sizeof(int64_t);
+	static constexpr size_t INITIAL_FILE_SIZE = 16u << 20;
+
+private:
+	class MappedFile;
+
+	std::mutex lock;
+	std::unique_ptr<MappedFile> file;
+	size_t size = 0;
+	int64_t start_ns = 0;
+
+public:
+	// region ctor/dtor
+
+	/**
+	 * \brief Creates (or truncates) the capture file at [path]. Check \ref is_open for success.
+	 */
+	explicit WireCapture(std::string const& path, size_t initial_size = INITIAL_FILE_SIZE);
+
+	WireCapture(WireCapture const&) = delete;
+
+	WireCapture& operator=(WireCapture const&) = delete;
+
+	/**
+	 * \brief Unmaps the file and trims it to the written size.
+	 */
+	virtual ~WireCapture();
+	// endregion
+
+	bool is_open() const;
+
+	void append(Direction direction, sequence_number_t seqn, Buffer::word_t const* data, int32_t length);
+
+	size_t get_size();
+
+	/**
+	 * \brief Reads all records of the capture file at [path].
+	 * \return false if the file can't be read or isn't a capture, records read before a truncated tail are kept
+	 */
+	static bool load(std::string const& path, std::vector<Record>& records);
+};
+}	 // namespace rd
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+#endif	  // RD_CPP_WIRECAPTURE_H
@@ -0,0 +1,391 @@
+#include "WireMetrics.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+
+namespace rd
+{
+constexpr int32_t LatencyHistogram::SUB_BUCKET_BITS;
+constexpr uint64_t LatencyHistogram::SUB_BUCKETS;
+constexpr size_t LatencyHistogram::BUCKETS;
+constexpr size_t WireMetrics::CAPACITY;
+constexpr size_t WireMetrics::MAX_PROBES;
+
+namespace
+{
+int32_t highest_bit(uint64_t value) noexcept
+{
+	int32_t bit = 0;
+	for (int32_t shift = 32; shift > 0; shift >>= 1)
+	{
+		if (value >> shift)
+		{
+			value >>= shift;
+			bit += shift;
+		}
+	}
+	return bit;
+}
+
+void update_max(std::atomic<uint64_t>& to, uint64_t value) noexcept
+{
+	uint64_t current = to.load(std::memory_order_relaxed);
+	while (current < value && !to.compare_exchange_weak(current, value, std::memory_order_relaxed))
+	{
+	}
+}
+
+uint64_t elapsed(int64_t from, int64_t to) noexcept
+{
+	return to > from ? static_cast<uint64_t>(to - from) : 0;
+}
+
+void append_escaped(std::string& out, std::string const& value)
+{
+	out += '"';
+	for (char c : value)
+	{
+		switch (c)
+		{
+			case '"':
+				out += "\\\"";
+				break;
+			case '\\':
+				out += "\\\\";
+				break;
+			case '\n':
+				out += "\\n";
+				break;
+			case '\r':
+				out += "\\r";
+				break;
+			case '\t':
+				out += "\\t";
+				break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20)
+				{
+					char buf[8];
+					snprintf(buf, sizeof(buf), "\\u%04x", c);
+					out += buf;
+				}
+				else
+				{
+					out += c;
+				}
+		}
+	}
+	out += '"';
+}
+
+void append_entity(std::string& out, WireEntityMetrics const& it, bool with_id)
+{
+	out += '{';
+	if (with_id)
+	{
+		out += "\"id\":" + std::to_string(it.id.get_hash()) + ",";
+	}
+	out += "\"location\":";
+	append_escaped(out, it.location);
+	out += ",\"messages_in\":" + std::to_string(it.messages_in);
+	out += ",\"bytes_in\":" + std::to_string(it.bytes_in);
+	out += ",\"messages_out\":" + std::to_string(it.messages_out);
+	out += ",\"bytes_out\":" + std::to_string(it.bytes_out);
+	out += ",\"queue_wait_total_ns\":" + std::to_string(it.queue_wait_total_ns);
+	out += ",\"queue_wait_max_ns\":" + std::to_string(it.queue_wait_max_ns);
+	out += ",\"handler_total_ns\":" + std::to_string(it.handler_total_ns);
+	out += ",\"handler_max_ns\":" + std::to_string(it.handler_max_ns);
+	out += '}';
+}
+
+void append_histogram(std::string& out, LatencyHistogram::Snapshot const& it)
+{
+	out += "{\"count\":" + std::to_string(it.count);
+	out += ",\"total_ns\":" + std::to_string(it.total);
+	out += ",\"max_ns\":" + std::to_string(it.max);
+	out += ",\"p50_ns\":" + std::to_string(it.percentile(0.5));
+	out += ",\"p90_ns\":" + std::to_string(it.percentile(0.9));
+	out += ",\"p99_ns\":" + std::to_string(it.percentile(0.99));
+	out += ",\"p999_ns\":" + std::to_string(it.percentile(0.999));
+	out += ",\"buckets\":[";
+	for (size_t i = 0; i < it.buckets.size(); ++i)
+	{
+		if (i > 0)
+		{
+			out += ',';
+		}
+		out += '[' + std::to_string(it.buckets[i].first) + ',' + std::to_string(it.buckets[i].second) + ']';
+	}
+	out += "]}";
+}
+}	 // namespace
+
+// region LatencyHistogram
+
+size_t LatencyHistogram::bucket_of(uint64_t value) noexcept
+{
+	if (value < SUB_BUCKETS)
+	{
+		return static_cast<size_t>(value);
+	}
+	int32_t bit = highest_bit(value);
+	uint64_t sub = (value >> (bit - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+	return static_cast<size_t>((bit - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub);
+}
+
+uint64_t LatencyHistogram::upper_bound_of(size_t bucket) noexcept
+{
+	if (bucket < SUB_BUCKETS)
+	{
+		return bucket;
+	}
+	int32_t shift = static_cast<int32_t>(bucket / SUB_BUCKETS) - 1;
+	uint64_t sub = bucket % SUB_BUCKETS;
+	uint64_t lower = (SUB_BUCKETS + sub) << shift;
+	return lower + ((uint64_t(1) << shift) - 1);
+}
+
+void LatencyHistogram::record(uint64_t value) noexcept
+{
+	counts[bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+	total.fetch_add(value, std::memory_order_relaxed);
+	update_max(max, value);
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const
+{
+	Snapshot result;
+	for (size_t i = 0; i < BUCKETS; ++i)
+	{
+		uint64_t count = counts[i].load(std::memory_order_relaxed);
+		if (count > 0)
+		{
+			result.buckets.emplace_back(upper_bound_of(i), count);
+			result.count += count;
+		}
+	}
+	result.total = total.load(std::memory_order_relaxed);
+	result.max = max.load(std::memory_order_relaxed);
+	return result;
+}
+
+uint64_t LatencyHistogram::Snapshot::percentile(double quantile) const
+{
+	if (count == 0)
+	{
+		return 0;
+	}
+	auto rank = static_cast<uint64_t>(quantile * static_cast<double>(count - 1)) + 1;
+	uint64_t seen = 0;
+	for (auto const& bucket : buckets)
+	{
+		seen += bucket.second;
+		if (seen >= rank)
+		{
+			return (std::min)(bucket.first, max);
+		}
+	}
+	return max;
+}
+
+// endregion
+
+// region WireMetrics
+
+WireMetrics::~WireMetrics()
+{
+	delete storage.load();
+}
+
+void WireMetrics::set_enabled(bool value)
+{
+	if (value && storage.load(std::memory_order_acquire) == nullptr)
+	{
+		// storage is never freed before destruction, so concurrent hooks never observe a dangling table
+		auto created = new Storage();
+		Storage* expected = nullptr;
+		if (!storage.compare_exchange_strong(expected, created, std::memory_order_acq_rel))
+		{
+			delete created;
+		}
+	}
+	enabled.store(value, std::memory_order_release);
+}
+
+void WireMetrics::register_location(RdId const& id, std::string location)
+{
+	std::lock_guard<decltype(locations_lock)> guard(locations_lock);
+	locations[id] = std::move(location);
+}
+
+WireMetrics::Entry& WireMetrics::entry_for(RdId const& id) const noexcept
+{
+	Storage& s = *storage.load(std::memory_order_acquire);
+	RdId::hash_t key = id.get_hash();
+	if (key == 0)
+	{
+		return s.overflow;
+	}
+	auto mixed = static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ull;
+	size_t index = static_cast<size_t>(mixed >> 32) & (CAPACITY - 1);
+	for (size_t probe = 0; probe < MAX_PROBES; ++probe, index = (index + 1) & (CAPACITY - 1))
+	{
+		Entry& e = s.entries[index];
+		RdId::hash_t current = e.key.load(std::memory_order_acquire);
+		if (current == key)
+		{
+			return e;
+		}
+		if (current == 0)
+		{
+			if (e.key.compare_exchange_strong(current, key, std::memory_order_acq_rel) || current == key)
+			{
+				return e;
+			}
+		}
+	}
+	return s.overflow;
+}
+
+void WireMetrics::record_sent(RdId const& id, size_t bytes) noexcept
+{
+	if (!is_enabled())
+	{
+		return;
+	}
+	Entry& e = entry_for(id);
+	e.messages_out.fetch_add(1, std::memory_order_relaxed);
+	e.bytes_out.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void WireMetrics::record_received(RdId const& id, size_t bytes) noexcept
+{
+	if (!is_enabled())
+	{
+		return;
+	}
+	Entry& e = entry_for(id);
+	e.messages_in.fetch_add(1, std::memory_order_relaxed);
+	e.bytes_in.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void WireMetrics::record_dispatch(RdId const& id, int64_t enqueued_ns, int64_t started_ns, int64_t finished_ns) noexcept
+{
+	if (!is_enabled())
+	{
+		return;
+	}
+	Storage& s = *storage.load(std::memory_order_acquire);
+	Entry& e = entry_for(id);
+	uint64_t queue_wait = elapsed(enqueued_ns, started_ns);
+	uint64_t handler = elapsed(started_ns, finished_ns);
+	e.queue_wait_total_ns.fetch_add(queue_wait, std::memory_order_relaxed);
+	update_max(e.queue_wait_max_ns, queue_wait);
+	e.handler_total_ns.fetch_add(handler, std::memory_order_relaxed);
+	update_max(e.handler_max_ns, handler);
+	s.queue_wait.record(queue_wait);
+	s.handler.record(handler);
+}
+
+void WireMetrics::fill(WireEntityMetrics& to, Entry const& from) const
+{
+	to.messages_in += from.messages_in.load(std::memory_order_relaxed);
+	to.bytes_in += from.bytes_in.load(std::memory_order_relaxed);
+	to.messages_out += from.messages_out.load(std::memory_order_relaxed);
+	to.bytes_out += from.bytes_out.load(std::memory_order_relaxed);
+	to.queue_wait_total_ns += from.queue_wait_total_ns.load(std::memory_order_relaxed);
+	to.queue_wait_max_ns = (std::max)(to.queue_wait_max_ns, from.queue_wait_max_ns.load(std::memory_order_relaxed));
+	to.handler_total_ns += from.handler_total_ns.load(std::memory_order_relaxed);
+	to.handler_max_ns = (std::max)(to.handler_max_ns, from.handler_max_ns.load(std::memory_order_relaxed));
+}
+
+WireMetricsSnapshot WireMetrics::snapshot() const
+{
+	WireMetricsSnapshot result;
+	result.enabled = is_enabled();
+	Storage const* s = storage.load(std::memory_order_acquire);
+	if (s == nullptr)
+	{
+		return result;
+	}
+
+	std::lock_guard<decltype(locations_lock)> guard(locations_lock);
+	std::map<std::string, WireEntityMetrics> by_location;
+	for (auto const& e : s->entries)
+	{
+		RdId::hash_t key = e.key.load(std::memory_order_acquire);
+		if (key == 0)
+		{
+			continue;
+		}
+		WireEntityMetrics item;
+		item.id = RdId(key);
+		auto location = locations.find(item.id);
+		item.location = location != locations.end() ? location->second : "<unknown>";
+		fill(item, e);
+
+		auto& aggregated = by_location[item.location];
+		aggregated.location = item.location;
+		fill(aggregated, e);
+
+		result.entities.push_back(std::move(item));
+	}
+	result.overflow.location = "<overflow>";
+	fill(result.overflow, s->overflow);
+
+	for (auto& it : by_location)
+	{
+		result.locations.push_back(std::move(it.second));
+	}
+	auto by_traffic = [](WireEntityMetrics const& l, WireEntityMetrics const& r) {
+		return l.bytes_in + l.bytes_out > r.bytes_in + r.bytes_out;
+	};
+	std::sort(result.entities.begin(), result.entities.end(), by_traffic);
+	std::sort(result.locations.begin(), result.locations.end(), by_traffic);
+
+	result.queue_wait = s->queue_wait.snapshot();
+	result.handler = s->handler.snapshot();
+	return result;
+}
+
+// endregion
+
+std::string WireMetricsSnapshot::to_json() const
+{
+	std::string out;
+	out += "{\"enabled\":";
+	out += enabled ? "true" : "false";
+	out += ",\"send_window_bytes\":" + std::to_string(send_window_bytes);
+	out += ",\"send_pending_packages\":" + std::to_string(send_pending_packages);
+	out += ",\"send_window_overflows\":" + std::to_string(send_window_overflows);
+	out += ",\"socket_send_calls\":" + std::to_string(socket_send_calls);
+	out += ",\"socket_receive_calls\":" + std::to_string(socket_receive_calls);
+	out += ",\"queue_wait\":";
+	append_histogram(out, queue_wait);
+	out += ",\"handler\":";
+	append_histogram(out, handler);
+	out += ",\"overflow\":";
+	append_entity(out, overflow, false);
+	out += ",\"entities\":[";
+	for (size_t i = 0; i < entities.size(); ++i)
+	{
+		if (i > 0)
+		{
+			out += ',';
+		}
+		append_entity(out, entities[i], true);
+	}
+	out += "],\"locations\":[";
+	for (size_t i = 0; i < locations.size(); ++i)
+	{
+		if (i > 0)
+		{
+			out += ',';
+		}
+		append_entity(out, locations[i], false);
+	}
+	out += "]}";
+	return out;
+}
+}	 // namespace rd
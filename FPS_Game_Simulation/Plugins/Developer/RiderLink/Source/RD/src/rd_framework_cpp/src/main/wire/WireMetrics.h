@@ -0,0 +1,222 @@
+#ifndef RD_CPP_WIREMETRICS_H
+#define RD_CPP_WIREMETRICS_H
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4251)
+#endif
+
+#include "protocol/RdId.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "std/unordered_map.h"
+
+#include <rd_framework_export.h>
+
+namespace rd
+{
+/**
+ * \brief Log-linear latency histogram in the spirit of HdrHistogram: every power of two is split into
+ * [SUB_BUCKETS] linear buckets, so the relative error of a recorded value is at most 1/SUB_BUCKETS.
+ * Recording is a couple of relaxed atomic increments.
+ */
+class RD_FRAMEWORK_API LatencyHistogram
+{
+public:
+	static constexpr int32_t SUB_BUCKET_BITS = 3;
+	static constexpr uint64_t SUB_BUCKETS = uint64_t(1) << SUB_BUCKET_BITS;
+	static constexpr size_t BUCKETS = 64 * SUB_BUCKETS;
+
+private:
+	std::array<std::atomic<uint64_t>, BUCKETS> counts{};
+	std::atomic<uint64_t> total{0};
+	std::atomic<uint64_t> max{0};
+
+public:
+	static size_t bucket_of(uint64_t value) noexcept;
+
+	/**
+	 * \brief Largest value which falls into the [bucket].
+	 */
+	static uint64_t upper_bound_of(size_t bucket) noexcept;
+
+	void record(uint64_t value) noexcept;
+
+	struct Snapshot
+	{
+		uint64_t count = 0;
+		uint64_t total = 0;
+		uint64_t max = 0;
+		/**
+		 * \brief Non-empty buckets as (upper bound, count), ordered by upper bound.
+		 */
+		std::vector<std::pair<uint64_t, uint64_t>> buckets;
+
+		/**
+		 * \param quantile in [0, 1]
+		 * \return upper bound of the bucket holding the [quantile]
+		 */
+		uint64_t percentile(double quantile) const;
+	};
+
+	Snapshot snapshot() const;
+};
+
+/**
+ * \brief Traffic of a single RdId, or of all ids sharing a location.
+ */
+struct RD_FRAMEWORK_API WireEntityMetrics
+{
+	RdId id;
+	std::string location;
+	uint64_t messages_in = 0;
+	uint64_t bytes_in = 0;
+	uint64_t messages_out = 0;
+	uint64_t bytes_out = 0;
+	/**
+	 * \brief Time between the message being handed to MessageBroker and its handler starting, i.e. the wait in
+	 * the scheduler queue.
+	 */
+	uint64_t queue_wait_total_ns = 0;
+	uint64_t queue_wait_max_ns = 0;
+	/**
+	 * \brief Time spent in on_wire_received.
+	 */
+	uint64_t handler_total_ns = 0;
+	uint64_t handler_max_ns = 0;
+};
+
+struct RD_FRAMEWORK_API WireMetricsSnapshot
+{
+	bool enabled = false;
+	std::vector<WireEntityMetrics> entities;
+	std::vector<WireEntityMetrics> locations;
+	/**
+	 * \brief Messages from ids which didn't fit into the table are accounted here.
+	 */
+	WireEntityMetrics overflow;
+	LatencyHistogram::Snapshot queue_wait;
+	LatencyHistogram::Snapshot handler;
+	/**
+	 * \brief Sent but not yet acknowledged bytes and packages, if the wire has a send queue.
+	 */
+	uint64_t send_window_bytes = 0;
+	uint64_t send_pending_packages = 0;
+	/**
+	 * \brief Packages queued past a full send window instead of waiting for it.
+	 */
+	uint64_t send_window_overflows = 0;
+	/**
+	 * \brief Send and receive calls on the socket, if the wire has one. Acknowledges and pings are sends too.
+	 */
+	uint64_t socket_send_calls = 0;
+	uint64_t socket_receive_calls = 0;
+
+	std::string to_json() const;
+};
+
+/**
+ * \brief Per-RdId wire traffic counters and latency histograms.
+ * Disabled by default, then every hook costs a single atomic load. Once enabled, updates are lock-free: ids are
+ * placed into a fixed-size open-addressing table with CAS, ids beyond its capacity are accumulated in one
+ * overflow entry. Locations are remembered when entities are advised, which happens rarely.
+ */
+class RD_FRAMEWORK_API WireMetrics
+{
+public:
+	using clock_t = std::chrono::steady_clock;
+
+	static constexpr size_t CAPACITY = 1024;
+
+private:
+	static constexpr size_t MAX_PROBES = 32;
+
+	struct Entry
+	{
+		std::atomic<RdId::hash_t> key{0};
+		std::atomic<uint64_t> messages_in{0};
+		std::atomic<uint64_t> bytes_in{0};
+		std::atomic<uint64_t> messages_out{0};
+		std::atomic<uint64_t> bytes_out{0};
+		std::atomic<uint64_t> queue_wait_total_ns{0};
+		std::atomic<uint64_t> queue_wait_max_ns{0};
+		std::atomic<uint64_t> handler_total_ns{0};
+		std::atomic<uint64_t> handler_max_ns{0};
+	};
+
+	struct Storage
+	{
+		std::array<Entry, CAPACITY> entries;
+		Entry overflow;
+		LatencyHistogram queue_wait;
+		LatencyHistogram handler;
+	};
+
+	std::atomic<bool> enabled{false};
+	std::atomic<Storage*> storage{nullptr};
+
+	mutable std::mutex locations_lock;
+	rd::unordered_map<RdId, std::string> locations;
+
+	Entry& entry_for(RdId const& id) const noexcept;
+
+	void fill(WireEntityMetrics& to, Entry const& from) const;
+
+public:
+	// region ctor/dtor
+
+	WireMetrics() = default;
+
+	WireMetrics(WireMetrics const&) = delete;
+
+	WireMetrics& operator=(WireMetrics const&) = delete;
+
+	virtual ~WireMetrics();
+	// endregion
+
+	static int64_t now_ns() noexcept
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_t::now().time_since_epoch()).count();
+	}
+
+	bool is_enabled() const noexcept
+	{
+		return enabled.load(std::memory_order_acquire);
+	}
+
+	void set_enabled(bool value);
+
+	void register_location(RdId const& id, std::string location);
+
+	/**
+	 * \param bytes size of the message without its length prefix, i.e. RdId, context and payload
+	 */
+	void record_sent(RdId const& id, size_t bytes) noexcept;
+
+	/**
+	 * \param bytes size of the message without its length prefix, i.e. RdId, context and payload
+	 */
+	void record_received(RdId const& id, size_t bytes) noexcept;
+
+	/**
+	 * \param enqueued_ns timestamp taken by \ref now_ns when the message was received
+	 * \param started_ns timestamp taken right before the handler was invoked
+	 * \param finished_ns timestamp taken right after the handler returned
+	 */
+	void record_dispatch(RdId const& id, int64_t enqueued_ns, int64_t started_ns, int64_t finished_ns) noexcept;
+
+	WireMetricsSnapshot snapshot() const;
+};
+}	 // namespace rd
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+#endif	  // RD_CPP_WIREMETRICS_H
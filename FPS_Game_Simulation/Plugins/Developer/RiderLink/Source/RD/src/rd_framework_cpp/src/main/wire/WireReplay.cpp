@@ -0,0 +1,108 @@
+#include "WireReplay.h"
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+namespace rd
+{
+ReplayWire::ReplayWire(IScheduler* scheduler) : WireBase(scheduler)
+{
+	connected.set(true);
+}
+
+void ReplayWire::send(RdId const& rd_id, std::function<void(Buffer& buffer)> writer, size_t size_hint) const
+{
+	auto buffer = Buffer::with_capacity(size_hint);
+	writer(buffer);
+	metrics.record_sent(rd_id, buffer.get_position());
+	++sent_messages;
+}
+
+void ReplayWire::dispatch(RdId const& rd_id, Buffer::ByteArray body) const
+{
+	metrics.record_received(rd_id, sizeof(RdId::hash_t) + body.size());
+	message_broker.dispatch(rd_id, Buffer(std::move(body)));
+}
+
+uint64_t ReplayWire::get_sent_messages() const
+{
+	return sent_messages;
+}
+
+double WireReplay::Stats::messages_per_second() const
+{
+	return elapsed_ns > 0 ? static_cast<double>(messages) * 1e9 / static_cast<double>(elapsed_ns) : 0;
+}
+
+WireReplay::Stats WireReplay::replay(
+	std::vector<WireCapture::Record> const& records, ReplayWire const& wire, Speed speed, WireCapture::Direction direction)
+{
+	using clock = std::chrono::steady_clock;
+
+	Stats stats;
+	Buffer::ByteArray stream;
+	size_t consumed = 0;
+	sequence_number_t max_seqn = 0;
+	int64_t first_timestamp = -1;
+
+	const auto start = clock::now();
+	for (auto const& record : records)
+	{
+		if (record.direction != direction)
+		{
+			continue;
+		}
+		// same rule as SocketWire::Base::read_package: seqn 1 starts a new connection, anything else not above
+		// the maximum is a resent package
+		if (record.seqn <= max_seqn && record.seqn != 1)
+		{
+			continue;
+		}
+		max_seqn = record.seqn;
+
+		if (speed == Speed::Original)
+		{
+			if (first_timestamp < 0)
+			{
+				first_timestamp = record.timestamp_ns;
+			}
+			std::this_thread::sleep_until(start + std::chrono::nanoseconds(record.timestamp_ns - first_timestamp));
+		}
+
+		++stats.packages;
+		stream.erase(stream.begin(), stream.begin() + consumed);
+		consumed = 0;
+		stream.insert(stream.end(), record.payload.begin(), record.payload.end());
+
+		// every message is [length: int32][RdId: int64][context and payload: length - 8 bytes]
+		while (stream.size() - consumed >= sizeof(int32_t) + sizeof(RdId::hash_t))
+		{
+			int32_t length = 0;
+			RdId::hash_t id = 0;
+			memcpy(&length, stream.data() + consumed, sizeof(length));
+			if (length < static_cast<int32_t>(sizeof(RdId::hash_t)))
+			{
+				// corrupted stream, drop what is buffered and resync on the next package
+				consumed = stream.size();
+				break;
+			}
+			if (stream.size() - consumed - sizeof(length) < static_cast<size_t>(length))
+			{
+				break;
+			}
+			memcpy(&id, stream.data() + consumed + sizeof(length), sizeof(id));
+			auto body = stream.begin() + consumed + sizeof(length) + sizeof(id);
+			auto body_length = static_cast<size_t>(length) - sizeof(id);
+
+			wire.dispatch(RdId(id), Buffer::ByteArray(body, body + body_length));
+
+			consumed += sizeof(length) + static_cast<size_t>(length);
+			++stats.messages;
+			stats.bytes += static_cast<uint64_t>(length);
+		}
+	}
+	stats.elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+	return stats;
+}
+}	 // namespace rd
@@ -0,0 +1,81 @@
+#ifndef RD_CPP_WIREREPLAY_H
+#define RD_CPP_WIREREPLAY_H
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4251)
+#endif
+
+#include "base/WireBase.h"
+#include "WireCapture.h"
+
+#include <atomic>
+
+#include <rd_framework_export.h>
+
+namespace rd
+{
+/**
+ * \brief Local stand-in wire for replaying captures: incoming messages are injected with \ref dispatch,
+ * outgoing ones are counted and dropped.
+ */
+class RD_FRAMEWORK_API ReplayWire : public WireBase
+{
+	mutable std::atomic<uint64_t> sent_messages{0};
+
+public:
+	// region ctor/dtor
+
+	explicit ReplayWire(IScheduler* scheduler);
+
+	virtual ~ReplayWire() = default;
+	// endregion
+
+	void send(RdId const& rd_id, std::function<void(Buffer& buffer)> writer, size_t size_hint = 0) const override;
+
+	/**
+	 * \param body context and payload of the message, as it follows the RdId on the socket
+	 */
+	void dispatch(RdId const& rd_id, Buffer::ByteArray body) const;
+
+	uint64_t get_sent_messages() const;
+};
+
+/**
+ * \brief Feeds recorded packages of one direction back into a \ref ReplayWire, reassembling messages the same way
+ * SocketWire does and skipping resent packages by their seqn.
+ */
+class RD_FRAMEWORK_API WireReplay
+{
+public:
+	enum class Speed
+	{
+		/**
+		 * \brief Keeps the recorded gaps between packages.
+		 */
+		Original,
+		Maximum
+	};
+
+	struct Stats
+	{
+		uint64_t packages = 0;
+		uint64_t messages = 0;
+		uint64_t bytes = 0;
+		int64_t elapsed_ns = 0;
+
+		double messages_per_second() const;
+	};
+
+	/**
+	 * \param direction which side of the capture is dispatched, received packages by default
+	 */
+	static Stats replay(std::vector<WireCapture::Record> const& records, ReplayWire const& wire, Speed speed,
+		WireCapture::Direction direction = WireCapture::Direction::Received);
+};
+}	 // namespace rd
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+#endif	  // RD_CPP_WIREREPLAY_H
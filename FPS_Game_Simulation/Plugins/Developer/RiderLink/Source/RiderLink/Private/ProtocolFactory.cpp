@@ -11,6 +11,7 @@
 #include "HAL/PlatformFilemanager.h"
 #endif
 #include "Misc/App.h"
+#include "Misc/CoreDelegates.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 
@@ -26,6 +27,7 @@
 #include "Windows/HideWindowsPlatformTypes.h"
 #endif
 
+#include "logging/AsyncLogBackend.h"
 #include "spdlog/sinks/daily_file_sink.h"
 
 static FString GetLocalAppdataFolder()
@@ -77,6 +79,14 @@ ProtocolFactory::ProtocolFactory(const FString& ProjectName): ProjectName(Projec
     InitRdLogging();
 }
 
+ProtocolFactory::~ProtocolFactory()
+{
+    if (SystemErrorHandle.IsValid())
+    {
+        FCoreDelegates::OnHandleSystemError.Remove(SystemErrorHandle);
+    }
+}
+
 void ProtocolFactory::InitRdLogging()
 {
     spdlog::set_level(spdlog::level::err);
@@ -89,6 +99,12 @@ void ProtocolFactory::InitRdLogging()
     {
         Logger->sinks().push_back(FileLogger);
     });
+#if defined(ENABLE_ASYNC_LOG) && ENABLE_ASYNC_LOG == 1
+    // formatting and file I/O move to one writer thread, wire threads only copy records into a ring
+    LogBackend = std::make_shared<rd::AsyncLogBackend>();
+    LogBackend->attach_all();
+    SystemErrorHandle = FCoreDelegates::OnHandleSystemError.AddStatic(&rd::AsyncLogBackend::flush_all);
+#endif
 #endif
 }
 
@@ -4,12 +4,21 @@
 #include "wire/SocketWire.h"
 
 #include "Containers/UnrealString.h"
+#include "Delegates/IDelegateInstance.h"
 #include "Templates/UniquePtr.h"
 
+#include <memory>
+
+namespace rd
+{
+class AsyncLogBackend;
+}
+
 class ProtocolFactory
 {
 public:
 	explicit ProtocolFactory(const FString& ProjectName);
+	~ProtocolFactory();
 
 	std::shared_ptr<rd::SocketWire::Server> CreateWire(rd::IScheduler* Scheduler, rd::Lifetime SocketLifetime);
 	TUniquePtr<rd::Protocol> CreateProtocol(rd::IScheduler* Scheduler, rd::Lifetime SocketLifetime,
@@ -20,4 +29,6 @@ private:
 
 private:
 	FString ProjectName;
+	std::shared_ptr<rd::AsyncLogBackend> LogBackend;
+	FDelegateHandle SystemErrorHandle;
 };
@@ -3,6 +3,19 @@
 #include "Containers/StringConv.h"
 #include "serialization/ArraySerializer.h"
 #include "Templates/UniquePtr.h"
+#include "UE4Library/BlueprintFunction.Generated.h"
+#include "UE4Library/BlueprintHighlighter.Generated.h"
+#include "UE4Library/BlueprintReference.Generated.h"
+#include "UE4Library/ConnectionInfo.Generated.h"
+#include "UE4Library/LogMessageInfo.Generated.h"
+#include "UE4Library/RequestFailed.Generated.h"
+#include "UE4Library/RequestSucceed.Generated.h"
+#include "UE4Library/ScriptCallStack.Generated.h"
+#include "UE4Library/ScriptCallStackFrame.Generated.h"
+#include "UE4Library/ScriptMsgException.Generated.h"
+#include "UE4Library/StringRange.Generated.h"
+#include "UE4Library/UClass.Generated.h"
+#include "UE4Library/UnrealLogEvent.Generated.h"
 
 //region FString
 
@@ -33,3 +46,77 @@ template struct rd::hash<FString>;
 // template class rd::Polymorphic<TArray<FString>, void>;
 
 //endregion
+
+//region Serialized size
+
+namespace rd {
+    // the engine has a UClass of its own
+    namespace Model = JetBrains::EditorPlugin;
+
+    // each sums what the generated write() puts in the buffer, field by field
+
+    size_t serialized_size_of<Model::BlueprintFunction>::get(Model::BlueprintFunction const& value) {
+        return rd::serialized_size<Polymorphic<Model::UClass>>(value.get_class()) +
+            Polymorphic<FString>::serialized_size(value.get_name());
+    }
+
+    size_t serialized_size_of<Model::BlueprintHighlighter>::get(Model::BlueprintHighlighter const& value) {
+        return sizeof(value.get_begin()) + sizeof(value.get_end());
+    }
+
+    size_t serialized_size_of<Model::BlueprintReference>::get(Model::BlueprintReference const& value) {
+        return Polymorphic<FString>::serialized_size(value.get_pathName()) +
+            Polymorphic<FString>::serialized_size(value.get_guid());
+    }
+
+    size_t serialized_size_of<Model::ConnectionInfo>::get(Model::ConnectionInfo const& value) {
+        return Polymorphic<std::wstring>::serialized_size(value.get_projectName()) +
+            Polymorphic<std::wstring>::serialized_size(value.get_executableName()) +
+            sizeof(value.get_processId());
+    }
+
+    size_t serialized_size_of<Model::LogMessageInfo>::get(Model::LogMessageInfo const& value) {
+        return rd::serialized_size<Polymorphic<ELogVerbosity::Type>>(value.get_type()) +
+            Polymorphic<FString>::serialized_size(value.get_category()) +
+            rd::serialized_size<Polymorphic<optional<DateTime>>>(value.get_time());
+    }
+
+    size_t serialized_size_of<Model::RequestFailed>::get(Model::RequestFailed const& value) {
+        return sizeof(value.get_requestID()) +
+            rd::serialized_size<Polymorphic<Model::NotificationType>>(value.get_type()) +
+            Polymorphic<FString>::serialized_size(value.get_message());
+    }
+
+    size_t serialized_size_of<Model::RequestSucceed>::get(Model::RequestSucceed const& value) {
+        return sizeof(value.get_requestID());
+    }
+
+    size_t serialized_size_of<Model::ScriptCallStack>::get(Model::ScriptCallStack const& value) {
+        return serialized_array_size<Polymorphic<Model::ScriptCallStackFrame>>(value.get_frames());
+    }
+
+    size_t serialized_size_of<Model::ScriptCallStackFrame>::get(Model::ScriptCallStackFrame const& value) {
+        return Polymorphic<FString>::serialized_size(value.get_entry());
+    }
+
+    size_t serialized_size_of<Model::ScriptMsgException>::get(Model::ScriptMsgException const& value) {
+        return Polymorphic<FString>::serialized_size(value.get_message());
+    }
+
+    size_t serialized_size_of<Model::StringRange>::get(Model::StringRange const& value) {
+        return sizeof(value.get_first()) + sizeof(value.get_last());
+    }
+
+    size_t serialized_size_of<Model::UClass>::get(Model::UClass const& value) {
+        return Polymorphic<FString>::serialized_size(value.get_name());
+    }
+
+    size_t serialized_size_of<Model::UnrealLogEvent>::get(Model::UnrealLogEvent const& value) {
+        return rd::serialized_size<Polymorphic<Model::LogMessageInfo>>(value.get_info()) +
+            Polymorphic<FString>::serialized_size(value.get_text()) +
+            serialized_array_size<Polymorphic<Model::StringRange>>(value.get_bpPathRanges()) +
+            serialized_array_size<Polymorphic<Model::StringRange>>(value.get_methodRanges());
+    }
+}
+
+//endregion
@@ -31,12 +31,20 @@ namespace rd {
         static FString read(SerializationCtx& ctx, Buffer& buffer);
 
         static void write(SerializationCtx& ctx, Buffer& buffer, FString const& value);
+
+        static size_t serialized_size(FString const& value) {
+            return sizeof(int32_t) + sizeof(uint16_t) * static_cast<size_t>(value.Len());
+        }
     };
 
     template <>
     class Polymorphic<Wrapper<FString>> {
     public:
         static void write(SerializationCtx& ctx, Buffer& buffer, Wrapper<FString> const& value);
+
+        static size_t serialized_size(Wrapper<FString> const& value) {
+            return Polymorphic<FString>::serialized_size(*value);
+        }
     };
 
     template <>
@@ -60,6 +68,81 @@ namespace rd {
     }
 }
 
+//region Wrapper storage
+
+namespace JetBrains {
+namespace EditorPlugin {
+    class StringRange;
+    class LogMessageInfo;
+    class UnrealLogEvent;
+}
+}
+
+// Every received log line wraps its info, its event and each path/method range; keep those blocks pooled.
+namespace rd {
+    template <>
+    struct wrapper_storage<JetBrains::EditorPlugin::StringRange> {
+        using type = wrapper::pooled_storage;
+    };
+
+    template <>
+    struct wrapper_storage<JetBrains::EditorPlugin::LogMessageInfo> {
+        using type = wrapper::pooled_storage;
+    };
+
+    template <>
+    struct wrapper_storage<JetBrains::EditorPlugin::UnrealLogEvent> {
+        using type = wrapper::pooled_storage;
+    };
+}
+
+//endregion
+
+//region Serialized size
+
+namespace JetBrains {
+namespace EditorPlugin {
+    class BlueprintFunction;
+    class BlueprintHighlighter;
+    class BlueprintReference;
+    class ConnectionInfo;
+    class RequestFailed;
+    class RequestSucceed;
+    class ScriptCallStack;
+    class ScriptCallStackFrame;
+    class ScriptMsgException;
+    class UClass;
+}
+}
+
+// Send buffer size hints of the model types, kept out of the generated code so that regenerating it doesn't drop them.
+// Types behind an abstract field (ScriptMsgCallStack) and the *_Unknown ones keep the default.
+#define RIDERLINK_SERIALIZED_SIZE_OF(Type) \
+    template <> \
+    struct RIDERLINK_API serialized_size_of<JetBrains::EditorPlugin::Type> { \
+        static size_t get(JetBrains::EditorPlugin::Type const& value); \
+    };
+
+namespace rd {
+    RIDERLINK_SERIALIZED_SIZE_OF(BlueprintFunction)
+    RIDERLINK_SERIALIZED_SIZE_OF(BlueprintHighlighter)
+    RIDERLINK_SERIALIZED_SIZE_OF(BlueprintReference)
+    RIDERLINK_SERIALIZED_SIZE_OF(ConnectionInfo)
+    RIDERLINK_SERIALIZED_SIZE_OF(LogMessageInfo)
+    RIDERLINK_SERIALIZED_SIZE_OF(RequestFailed)
+    RIDERLINK_SERIALIZED_SIZE_OF(RequestSucceed)
+    RIDERLINK_SERIALIZED_SIZE_OF(ScriptCallStack)
+    RIDERLINK_SERIALIZED_SIZE_OF(ScriptCallStackFrame)
+    RIDERLINK_SERIALIZED_SIZE_OF(ScriptMsgException)
+    RIDERLINK_SERIALIZED_SIZE_OF(StringRange)
+    RIDERLINK_SERIALIZED_SIZE_OF(UClass)
+    RIDERLINK_SERIALIZED_SIZE_OF(UnrealLogEvent)
+}
+
+#undef RIDERLINK_SERIALIZED_SIZE_OF
+
+//endregion
+
 extern template class rd::Polymorphic<FString>;
 extern template class rd::Polymorphic<rd::Wrapper<FString>>;
 extern template struct rd::hash<FString>;
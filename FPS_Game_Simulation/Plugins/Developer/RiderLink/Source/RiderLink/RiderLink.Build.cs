@@ -21,6 +21,7 @@ public class RiderLink : ModuleRules
 		};
 		
 		PrivateDefinitions.Add("ENABLE_LOG_FILE=0");
+		PrivateDefinitions.Add("ENABLE_ASYNC_LOG=1");
 
 		foreach(var Item in Paths)
 		{
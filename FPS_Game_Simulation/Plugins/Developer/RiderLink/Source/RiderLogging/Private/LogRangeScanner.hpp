@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Single pass replacement for the two regexes RiderLogging used to run over every log chunk:
+ *   path:   (/[\w\.]+)+
+ *   method: [0-9a-z_A-Z]+::~?[0-9a-z_A-Z]+
+ * Matches are reported with the same leftmost, non-overlapping semantics as FRegexMatcher::FindNext, as
+ * [Start, End) offsets in code units. For \w every non-ASCII code unit counts as a word character.
+ * Has no engine dependencies so it can be exercised outside of the editor.
+ */
+namespace LogRangeScanner
+{
+struct FRange
+{
+	int32_t Start;
+	int32_t End;
+};
+
+namespace Detail
+{
+template <typename CharT>
+inline bool IsIdentifier(CharT C)
+{
+	return (C >= '0' && C <= '9') || (C >= 'a' && C <= 'z') || (C >= 'A' && C <= 'Z') || C == '_';
+}
+
+template <typename CharT>
+inline bool IsPathSegment(CharT C)
+{
+	return IsIdentifier(C) || C == '.' || static_cast<uint32_t>(C) >= 0x80;
+}
+
+template <typename CharT>
+inline bool StartsPathSegment(const CharT* Str, int32_t Len, int32_t Index)
+{
+	return Str[Index] == '/' && Index + 1 < Len && IsPathSegment(Str[Index + 1]);
+}
+
+template <typename CharT>
+inline int32_t SkipIdentifier(const CharT* Str, int32_t Len, int32_t Index)
+{
+	while (Index < Len && IsIdentifier(Str[Index]))
+	{
+		++Index;
+	}
+	return Index;
+}
+}
+
+template <typename CharT>
+void Scan(const CharT* Str, int32_t Len, std::vector<FRange>& PathRanges, std::vector<FRange>& MethodRanges)
+{
+	using namespace Detail;
+
+	// each pattern resumes its search after its own previous match, exactly like two independent matchers
+	int32_t PathCursor = 0;
+	int32_t MethodCursor = 0;
+	for (int32_t Index = 0; Index < Len; ++Index)
+	{
+		const CharT C = Str[Index];
+		if (C == '/' && Index >= PathCursor && StartsPathSegment(Str, Len, Index))
+		{
+			int32_t End = Index;
+			while (End < Len && StartsPathSegment(Str, Len, End))
+			{
+				++End;
+				while (End < Len && IsPathSegment(Str[End]))
+				{
+					++End;
+				}
+			}
+			PathRanges.push_back({Index, End});
+			PathCursor = End;
+		}
+		else if (Index >= MethodCursor && IsIdentifier(C) && (Index == 0 || !IsIdentifier(Str[Index - 1])))
+		{
+			// a greedy identifier can only be followed by "::" at the end of its run
+			const int32_t ClassEnd = SkipIdentifier(Str, Len, Index);
+			int32_t Next = ClassEnd;
+			if (Next + 1 < Len && Str[Next] == ':' && Str[Next + 1] == ':')
+			{
+				Next += 2;
+				if (Next < Len && Str[Next] == '~')
+				{
+					++Next;
+				}
+				if (Next < Len && IsIdentifier(Str[Next]))
+				{
+					const int32_t End = SkipIdentifier(Str, Len, Next);
+					MethodRanges.push_back({Index, End});
+					MethodCursor = End;
+				}
+			}
+		}
+	}
+}
+}
@@ -0,0 +1,45 @@
+#include "RiderLogBuffer.hpp"
+
+#include "Misc/ScopeLock.h"
+
+FRiderLogBuffer::FRiderLogBuffer(int32 InCapacity) : Ring(InCapacity)
+{
+	check(InCapacity > 0);
+}
+
+bool FRiderLogBuffer::Push(FRiderLogRecord&& Record)
+{
+	FScopeLock ScopeLock(&Lock);
+	return Ring.Push(MoveTemp(Record));
+}
+
+int32 FRiderLogBuffer::Pop(TArray<FRiderLogRecord>& Out, int32 MaxCount)
+{
+	FScopeLock ScopeLock(&Lock);
+	Out.Reserve(Out.Num() + FMath::Min(MaxCount, Ring.Num()));
+	return Ring.Pop(MaxCount, [&Out](FRiderLogRecord&& Record) { Out.Add(MoveTemp(Record)); });
+}
+
+uint64 FRiderLogBuffer::TakeDroppedSinceLastCall()
+{
+	FScopeLock ScopeLock(&Lock);
+	return Ring.TakeDroppedSinceLastCall();
+}
+
+void FRiderLogBuffer::ReportDelivered(int32 Count, double LatencySeconds)
+{
+	FScopeLock ScopeLock(&Lock);
+	Ring.ReportDelivered(Count, LatencySeconds);
+}
+
+void FRiderLogBuffer::ReportUndelivered(int32 Count, uint64 ReturnedDrops)
+{
+	FScopeLock ScopeLock(&Lock);
+	Ring.ReportUndelivered(Count, ReturnedDrops);
+}
+
+FRiderLogBufferStats FRiderLogBuffer::GetStats() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Ring.GetStats();
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "RiderLogRing.hpp"
+
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "HAL/CriticalSection.h"
+#include "Logging/LogVerbosity.h"
+#include "Misc/Optional.h"
+#include "UObject/NameTypes.h"
+
+struct FRiderLogRecord
+{
+	FString Message;
+	FName Category;
+	ELogVerbosity::Type Verbosity = ELogVerbosity::Log;
+	TOptional<double> Time;
+	/** FPlatformTime::Seconds() when the record was captured, used to report delivery latency */
+	double CaptureTime = 0.0;
+};
+
+using FRiderLogBufferStats = RiderLogRing::FStats;
+
+/**
+ * Bounded FIFO of log records between the output device (any thread) and the logging scheduler.
+ * When full, new records are dropped and counted instead of growing the queue.
+ */
+class FRiderLogBuffer
+{
+public:
+	explicit FRiderLogBuffer(int32 InCapacity);
+
+	/** @return false if the record was dropped because the buffer is full */
+	bool Push(FRiderLogRecord&& Record);
+
+	/** Moves up to MaxCount oldest records to the end of Out. @return number of records moved */
+	int32 Pop(TArray<FRiderLogRecord>& Out, int32 MaxCount);
+
+	/** @return records dropped since the previous call */
+	uint64 TakeDroppedSinceLastCall();
+
+	void ReportDelivered(int32 Count, double LatencySeconds);
+
+	/** See RiderLogRing::TRing::ReportUndelivered */
+	void ReportUndelivered(int32 Count, uint64 ReturnedDrops);
+
+	FRiderLogBufferStats GetStats() const;
+
+private:
+	mutable FCriticalSection Lock;
+	RiderLogRing::TRing<FRiderLogRecord> Ring;
+};
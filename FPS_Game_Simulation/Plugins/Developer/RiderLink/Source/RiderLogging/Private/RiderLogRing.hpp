@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * Fixed-capacity FIFO behind FRiderLogBuffer: the ring itself, drop counting, the high watermark and the delivery
+ * latency. Not synchronized, the owner locks around every call. Has no engine dependencies so the log storm can be
+ * benchmarked outside of the editor.
+ */
+namespace RiderLogRing
+{
+struct FStats
+{
+	uint64_t Pushed = 0;
+	uint64_t Delivered = 0;
+	uint64_t Dropped = 0;
+	int32_t HighWatermark = 0;
+	double MaxLatencySeconds = 0.0;
+};
+
+template <typename RecordT>
+class TRing
+{
+public:
+	explicit TRing(int32_t Capacity) : Records(static_cast<size_t>(Capacity))
+	{
+	}
+
+	int32_t Capacity() const
+	{
+		return static_cast<int32_t>(Records.size());
+	}
+
+	int32_t Num() const
+	{
+		return Count;
+	}
+
+	/** @return false if the record was dropped because the ring is full */
+	bool Push(RecordT&& Record)
+	{
+		if (Count == Capacity())
+		{
+			++UnreportedDrops;
+			++Stats.Dropped;
+			return false;
+		}
+		Records[(Head + Count) % Capacity()] = std::move(Record);
+		++Count;
+		++Stats.Pushed;
+		Stats.HighWatermark = std::max(Stats.HighWatermark, Count);
+		return true;
+	}
+
+	/** Hands up to MaxCount oldest records to Consume, oldest first. @return number of records popped */
+	template <typename ConsumeT>
+	int32_t Pop(int32_t MaxCount, ConsumeT&& Consume)
+	{
+		const int32_t Popped = std::min(MaxCount, Count);
+		for (int32_t Index = 0; Index < Popped; ++Index)
+		{
+			Consume(std::move(Records[Head]));
+			Head = (Head + 1) % Capacity();
+		}
+		Count -= Popped;
+		return Popped;
+	}
+
+	/** @return records dropped since the previous call */
+	uint64_t TakeDroppedSinceLastCall()
+	{
+		const uint64_t Result = UnreportedDrops;
+		UnreportedDrops = 0;
+		return Result;
+	}
+
+	void ReportDelivered(int32_t Delivered, double LatencySeconds)
+	{
+		Stats.Delivered += static_cast<uint64_t>(Delivered);
+		Stats.MaxLatencySeconds = std::max(Stats.MaxLatencySeconds, LatencySeconds);
+	}
+
+	/**
+	 * Counts Undelivered popped records as dropped. ReturnedDrops, taken by TakeDroppedSinceLastCall for the failed
+	 * batch, is handed back so the next delivered batch reports it.
+	 */
+	void ReportUndelivered(int32_t Undelivered, uint64_t ReturnedDrops)
+	{
+		Stats.Dropped += static_cast<uint64_t>(Undelivered);
+		UnreportedDrops += static_cast<uint64_t>(Undelivered) + ReturnedDrops;
+	}
+
+	const FStats& GetStats() const
+	{
+		return Stats;
+	}
+
+private:
+	std::vector<RecordT> Records;
+	int32_t Head = 0;
+	int32_t Count = 0;
+	uint64_t UnreportedDrops = 0;
+	FStats Stats;
+};
+}	 // namespace RiderLogRing
@@ -2,14 +2,18 @@
 
 #include "BlueprintProvider.hpp"
 #include "IRiderLink.hpp"
+#include "LogRangeScanner.hpp"
 #include "Model/Library/UE4Library/LogMessageInfo.Generated.h"
 #include "Model/Library/UE4Library/StringRange.Generated.h"
 #include "Model/Library/UE4Library/UnrealLogEvent.Generated.h"
 
-#include "Internationalization/Regex.h"
+#include "Containers/Map.h"
+#include "HAL/PlatformTime.h"
 #include "Misc/DateTime.h"
 #include "Modules/ModuleManager.h"
 
+#include <vector>
+
 #define LOCTEXT_NAMESPACE "RiderLink"
 
 DEFINE_LOG_CATEGORY(FLogRiderLoggingModule);
@@ -18,88 +22,157 @@ IMPLEMENT_MODULE(FRiderLoggingModule, RiderLogging);
 
 namespace LoggingExtensionImpl
 {
-static TArray<rd::Wrapper<JetBrains::EditorPlugin::StringRange>> GetPathRanges(
-	const FRegexPattern& Pattern,
-	const FString& Str)
+// IsBlueprint parses the whole object path, and the same paths tend to repeat across log lines
+class FBlueprintPathCache
 {
-	using JetBrains::EditorPlugin::StringRange;
-	FRegexMatcher Matcher(Pattern, Str);
-	TArray<rd::Wrapper<StringRange>> Ranges;
-	while (Matcher.FindNext())
+public:
+	bool IsBlueprint(const TCHAR* Str, int32 Len)
 	{
-		const int Start = Matcher.GetMatchBeginning();
-		const int End = Matcher.GetMatchEnding();
-		FString PathName = Str.Mid(Start, End - Start);
-		if (BluePrintProvider::IsBlueprint(PathName))
-			Ranges.Emplace(StringRange(Start, End));
+		// the key is built in a reused buffer, so a hit doesn't allocate, only a miss copies it into the map
+		LookupKey.Reset();
+		LookupKey.AppendChars(Str, Len);
+		if (const bool* Cached = Results.Find(LookupKey))
+		{
+			return *Cached;
+		}
+		if (Results.Num() >= MAX_ENTRIES)
+		{
+			Results.Reset();
+		}
+		const bool bIsBlueprint = BluePrintProvider::IsBlueprint(LookupKey);
+		Results.Add(LookupKey, bIsBlueprint);
+		return bIsBlueprint;
 	}
-	return Ranges;
-}
 
-static TArray<rd::Wrapper<JetBrains::EditorPlugin::StringRange>> GetMethodRanges(
-	const FRegexPattern& Pattern,
-	const FString& Str)
+private:
+	static constexpr int32 MAX_ENTRIES = 4096;
+
+	TMap<FString, bool> Results;
+	FString LookupKey;
+};
+
+static void AddEvent(TArray<JetBrains::EditorPlugin::UnrealLogEvent>& Events,
+                     const rd::Wrapper<JetBrains::EditorPlugin::LogMessageInfo>& MessageInfo,
+                     FString&& Message)
 {
 	using JetBrains::EditorPlugin::StringRange;
-	FRegexMatcher Matcher(Pattern, Str);
-	TArray<rd::Wrapper<StringRange>> Ranges;
-	while (Matcher.FindNext())
+
+	// only touched from the logging scheduler
+	static FBlueprintPathCache BlueprintPathCache;
+	static std::vector<LogRangeScanner::FRange> PathMatches;
+	static std::vector<LogRangeScanner::FRange> MethodMatches;
+
+	PathMatches.clear();
+	MethodMatches.clear();
+	const TCHAR* Str = *Message;
+	LogRangeScanner::Scan(Str, Message.Len(), PathMatches, MethodMatches);
+
+	TArray<rd::Wrapper<StringRange>> PathRanges;
+	for (const LogRangeScanner::FRange& Match : PathMatches)
 	{
-		Ranges.Emplace(StringRange(Matcher.GetMatchBeginning(), Matcher.GetMatchEnding()));
+		if (BlueprintPathCache.IsBlueprint(Str + Match.Start, Match.End - Match.Start))
+			PathRanges.Emplace(StringRange(Match.Start, Match.End));
 	}
-	return Ranges;
-}
-
-static bool SendMessageToRider(const JetBrains::EditorPlugin::LogMessageInfo& MessageInfo, const FString& Message)
-{
-	static const FRegexPattern PathPattern = FRegexPattern(TEXT("(/[\\w\\.]+)+"));
-	static const FRegexPattern MethodPattern = FRegexPattern(TEXT("[0-9a-z_A-Z]+::~?[0-9a-z_A-Z]+"));
-	
-	return IRiderLinkModule::Get().FireAsyncAction(
-	[&MessageInfo, &Message] (JetBrains::EditorPlugin::RdEditorModel const& RdEditorModel)
+	TArray<rd::Wrapper<StringRange>> MethodRanges;
+	MethodRanges.Reserve(static_cast<int32>(MethodMatches.size()));
+	for (const LogRangeScanner::FRange& Match : MethodMatches)
 	{
-		rd::ISignal<JetBrains::EditorPlugin::UnrealLogEvent> const& UnrealLog = RdEditorModel.get_unrealLog();
-		UnrealLog.fire({
-			MessageInfo,
-			Message,
-			GetPathRanges(PathPattern, Message),
-			GetMethodRanges(MethodPattern, Message)
-		});
-	});
+		MethodRanges.Emplace(StringRange(Match.Start, Match.End));
+	}
+	Events.Emplace(MessageInfo, MoveTemp(Message), MoveTemp(PathRanges), MoveTemp(MethodRanges));
 }
 
-void SendMessageInChunks(FString* Msg, const JetBrains::EditorPlugin::LogMessageInfo& MessageInfo)
+// Splits the record on new lines and into chunks of at most CHUNK_SIZE characters, without reallocating the remainder
+static void AddRecordEvents(TArray<JetBrains::EditorPlugin::UnrealLogEvent>& Events, const FRiderLogRecord& Record,
+                            int64 StartTime)
 {
-	static int NUMBER_OF_CHUNKS = 1024;
-	while (!Msg->IsEmpty())
+	static constexpr int32 CHUNK_SIZE = 1024;
+
+	rd::optional<rd::DateTime> DateTime;
+	if (Record.Time)
 	{
-		SendMessageToRider(MessageInfo, Msg->Left(NUMBER_OF_CHUNKS));
-		*Msg = Msg->RightChop(NUMBER_OF_CHUNKS);
+		DateTime = rd::DateTime(StartTime + static_cast<int64>(Record.Time.GetValue()));
 	}
-}
+	const rd::Wrapper<JetBrains::EditorPlugin::LogMessageInfo> MessageInfo{
+		JetBrains::EditorPlugin::LogMessageInfo{Record.Verbosity, Record.Category.GetPlainNameString(), DateTime}
+	};
 
-void ScheduledSendMessage(FString* Msg, const JetBrains::EditorPlugin::LogMessageInfo& MessageInfo)
-{
-	FString ToSend;
-	while (Msg->Split("\n", &ToSend, Msg))
+	const FString& Message = Record.Message;
+	const int32 Length = Message.Len();
+	int32 LineStart = 0;
+	while (LineStart < Length)
 	{
-		SendMessageInChunks(&ToSend, MessageInfo);
+		int32 LineEnd = Message.Find(TEXT("\n"), ESearchCase::CaseSensitive, ESearchDir::FromStart, LineStart);
+		if (LineEnd == INDEX_NONE)
+		{
+			LineEnd = Length;
+		}
+		for (int32 ChunkStart = LineStart; ChunkStart < LineEnd; ChunkStart += CHUNK_SIZE)
+		{
+			AddEvent(Events, MessageInfo, Message.Mid(ChunkStart, FMath::Min(CHUNK_SIZE, LineEnd - ChunkStart)));
+		}
+		LineStart = LineEnd + 1;
 	}
+}
 
-	SendMessageInChunks(Msg, MessageInfo);
+static void AddDropSummary(TArray<JetBrains::EditorPlugin::UnrealLogEvent>& Events, uint64 Dropped)
+{
+	const rd::Wrapper<JetBrains::EditorPlugin::LogMessageInfo> MessageInfo{
+		JetBrains::EditorPlugin::LogMessageInfo{ELogVerbosity::Warning, TEXT("LogRiderLogging"), {}}
+	};
+	AddEvent(Events, MessageInfo,
+	         FString::Printf(TEXT("%llu log messages were dropped, Rider was disconnected or couldn't keep up"), Dropped));
 }
 }
 
 
+void FRiderLoggingModule::DrainLogBuffer()
+{
+	bDrainQueued = false;
+
+	TArray<FRiderLogRecord> Records;
+	TArray<JetBrains::EditorPlugin::UnrealLogEvent> Events;
+	while (LogBuffer.Pop(Records, MAX_BATCH_SIZE) > 0)
+	{
+		const uint64 Dropped = LogBuffer.TakeDroppedSinceLastCall();
+		if (Dropped > 0)
+		{
+			LoggingExtensionImpl::AddDropSummary(Events, Dropped);
+		}
+		for (const FRiderLogRecord& Record : Records)
+		{
+			LoggingExtensionImpl::AddRecordEvents(Events, Record, StartTime);
+		}
+
+		const bool bDelivered = IRiderLinkModule::Get().FireAsyncAction(
+		[&Events] (JetBrains::EditorPlugin::RdEditorModel const& RdEditorModel)
+		{
+			rd::ISignal<JetBrains::EditorPlugin::UnrealLogEvent> const& UnrealLog = RdEditorModel.get_unrealLog();
+			for (const JetBrains::EditorPlugin::UnrealLogEvent& Event : Events)
+			{
+				UnrealLog.fire(Event);
+			}
+		});
+		if (bDelivered)
+		{
+			LogBuffer.ReportDelivered(Records.Num(), FPlatformTime::Seconds() - Records[0].CaptureTime);
+		}
+		else
+		{
+			// no model while Rider is disconnected: the lines are lost, the next delivered batch says how many
+			LogBuffer.ReportUndelivered(Records.Num(), Dropped);
+		}
+
+		Records.Reset();
+		Events.Reset();
+	}
+}
+
 void FRiderLoggingModule::StartupModule()
 {
 	UE_LOG(FLogRiderLoggingModule, Verbose, TEXT("STARTUP START"));
 
-	static const auto START_TIME = FDateTime::UtcNow().ToUnixTimestamp();
-	static const auto GetTimeNow = [](double Time) -> rd::DateTime
-	{
-		return rd::DateTime(START_TIME + static_cast<int64>(Time));
-	};
+	StartTime = FDateTime::UtcNow().ToUnixTimestamp();
 
 	ModuleLifetimeDef = IRiderLinkModule::Get().CreateNestedLifetimeDefinition();
 	LoggingScheduler = MakeUnique<rd::SingleThreadScheduler>(ModuleLifetimeDef.lifetime, "LoggingScheduler");
@@ -111,17 +184,14 @@ void FRiderLoggingModule::StartupModule()
 		{
 			if (Type > ELogVerbosity::All) return;
 
-			rd::optional<rd::DateTime> DateTime;
-			if (Time)
+			if (!LogBuffer.Push({FString(msg), Name, Type, Time, FPlatformTime::Seconds()})) return;
+			if (!bDrainQueued.exchange(true))
 			{
-				DateTime = GetTimeNow(Time.GetValue());
+				LoggingScheduler->queue([this]()
+				{
+					DrainLogBuffer();
+				});
 			}
-			const FString PlainName = Name.GetPlainNameString();
-			const JetBrains::EditorPlugin::LogMessageInfo MessageInfo{Type, PlainName, DateTime};
-			LoggingScheduler->queue([Msg = FString(msg), MessageInfo]() mutable
-			{
-				LoggingExtensionImpl::ScheduledSendMessage(&Msg, MessageInfo);
-			});
 		});
 	},
 	[this]()
@@ -137,5 +207,10 @@ void FRiderLoggingModule::ShutdownModule()
 {
 	UE_LOG(FLogRiderLoggingModule, Verbose, TEXT("SHUTDOWN START"));
 	ModuleLifetimeDef.terminate();
+	const FRiderLogBufferStats Stats = LogBuffer.GetStats();
+	UE_LOG(FLogRiderLoggingModule, Log,
+	       TEXT("Log lines pushed: %llu, delivered: %llu, dropped: %llu, buffer high watermark: %d, max latency: %.3fs"),
+	       static_cast<uint64>(Stats.Pushed), static_cast<uint64>(Stats.Delivered), static_cast<uint64>(Stats.Dropped),
+	       Stats.HighWatermark, Stats.MaxLatencySeconds);
 	UE_LOG(FLogRiderLoggingModule, Verbose, TEXT("SHUTDOWN FINISH"));
 }
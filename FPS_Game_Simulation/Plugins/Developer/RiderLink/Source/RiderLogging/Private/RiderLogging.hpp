@@ -1,5 +1,6 @@
 #pragma once
 
+#include "RiderLogBuffer.hpp"
 #include "RiderOutputDevice.hpp"
 
 #include "Templates/UniquePtr.h"
@@ -11,6 +12,8 @@
 #include "Modules/ModuleInterface.h"
 #include "scheduler/SingleThreadScheduler.h"
 
+#include <atomic>
+
 DECLARE_LOG_CATEGORY_EXTERN(FLogRiderLoggingModule, Log, All);
 
 class FRiderLoggingModule : public IModuleInterface
@@ -25,7 +28,17 @@ public:
     virtual bool SupportsDynamicReloading() override { return true; }
 
 private:
+    /** Records kept while Rider is slower than the log; beyond that lines are dropped and reported */
+    static constexpr int32 LOG_BUFFER_CAPACITY = 16 * 1024;
+    /** Records turned into events per FireAsyncAction */
+    static constexpr int32 MAX_BATCH_SIZE = 256;
+
+    void DrainLogBuffer();
+
     TUniquePtr<rd::SingleThreadScheduler> LoggingScheduler;
+    FRiderLogBuffer LogBuffer{LOG_BUFFER_CAPACITY};
+    std::atomic<bool> bDrainQueued{false};
+    int64 StartTime = 0;
     FRiderOutputDevice OutputDevice;
     rd::LifetimeDefinition ModuleLifetimeDef;
 };
@@ -0,0 +1,227 @@
+#include "lifetime/LifetimeDefinition.h"
+#include "scheduler/TimerWheel.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+using namespace rd;
+
+namespace
+{
+using clock_type = std::chrono::steady_clock;
+using std::chrono::milliseconds;
+
+/**
+ * \brief Polls [condition] until it holds or [timeout] passes.
+ */
+template <typename F>
+bool wait_for(F condition, milliseconds timeout = milliseconds(2000))
+{
+	const auto deadline = clock_type::now() + timeout;
+	while (!condition())
+	{
+		if (clock_type::now() > deadline)
+		{
+			return false;
+		}
+		std::this_thread::sleep_for(milliseconds(1));
+	}
+	return true;
+}
+
+/**
+ * \brief Runs queued actions right away and counts them.
+ */
+class counting_scheduler : public IScheduler
+{
+public:
+	std::atomic<int32_t> queued{0};
+
+	void queue(std::function<void()> action) override
+	{
+		++queued;
+		action();
+	}
+
+	void flush() override
+	{
+	}
+
+	bool is_active() const override
+	{
+		return true;
+	}
+};
+}	 // namespace
+
+TEST(timer_wheel, one_shot_fires_once_after_its_delay)
+{
+	TimerWheel wheel;
+	std::atomic<int32_t> fired{0};
+	const auto scheduled = clock_type::now();
+	wheel.schedule(milliseconds(50), nullptr, [&fired] { ++fired; });
+	EXPECT_EQ(wheel.size(), 1u);
+
+	ASSERT_TRUE(wait_for([&fired] { return fired.load() > 0; }));
+	// deadlines are counted in whole ticks from the tick the timer was scheduled in
+	EXPECT_GE(clock_type::now() - scheduled, milliseconds(50) - TimerWheel::TICK);
+
+	std::this_thread::sleep_for(milliseconds(100));
+	EXPECT_EQ(fired.load(), 1);
+	EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(timer_wheel, cancel_before_the_deadline_keeps_it_from_firing)
+{
+	TimerWheel wheel;
+	std::atomic<int32_t> fired{0};
+	const auto id = wheel.schedule(milliseconds(100), nullptr, [&fired] { ++fired; });
+
+	EXPECT_TRUE(wheel.cancel(id));
+	EXPECT_FALSE(wheel.cancel(id));
+	std::this_thread::sleep_for(milliseconds(200));
+	EXPECT_EQ(fired.load(), 0);
+	EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(timer_wheel, delay_beyond_one_revolution_waits_for_its_own_turn)
+{
+	TimerWheel wheel;
+	std::atomic<int32_t> fired{0};
+	// a revolution is 512 ticks, this one shares its slot with tick 12 but is due a revolution later
+	const auto delay = TimerWheel::TICK * (TimerWheel::WHEEL_SIZE + 12);
+	const auto scheduled = clock_type::now();
+	wheel.schedule(delay, nullptr, [&fired] { ++fired; });
+
+	std::this_thread::sleep_for(milliseconds(300));
+	EXPECT_EQ(fired.load(), 0);
+	ASSERT_TRUE(wait_for([&fired] { return fired.load() > 0; }, milliseconds(10000)));
+	EXPECT_GE(clock_type::now() - scheduled, delay - TimerWheel::TICK);
+}
+
+TEST(timer_wheel, periodic_fires_until_cancelled)
+{
+	TimerWheel wheel;
+	std::atomic<int32_t> fired{0};
+	const auto id = wheel.schedule_periodic(milliseconds(10), nullptr, [&fired] { ++fired; });
+
+	ASSERT_TRUE(wait_for([&fired] { return fired.load() >= 3; }));
+	EXPECT_TRUE(wheel.cancel(id));
+	const int32_t after_cancel = fired.load();
+	std::this_thread::sleep_for(milliseconds(100));
+	EXPECT_EQ(fired.load(), after_cancel);
+	EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(timer_wheel, lifetime_bound_timer_stops_with_the_lifetime)
+{
+	TimerWheel wheel;
+	std::atomic<int32_t> fired{0};
+	LifetimeDefinition definition(false);
+	wheel.schedule_periodic(definition.lifetime, milliseconds(10), nullptr, [&fired] { ++fired; });
+	ASSERT_TRUE(wait_for([&fired] { return fired.load() >= 2; }));
+
+	definition.terminate();
+	EXPECT_EQ(wheel.size(), 0u);
+	const int32_t after_terminate = fired.load();
+	std::this_thread::sleep_for(milliseconds(100));
+	EXPECT_EQ(fired.load(), after_terminate);
+
+	// a terminated lifetime doesn't register anything
+	wheel.schedule_periodic(definition.lifetime, milliseconds(10), nullptr, [&fired] { ++fired; });
+	EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(timer_wheel, action_is_queued_to_the_scheduler)
+{
+	TimerWheel wheel;
+	counting_scheduler scheduler;
+	std::atomic<int32_t> fired{0};
+	wheel.schedule(milliseconds(10), &scheduler, [&fired] { ++fired; });
+
+	ASSERT_TRUE(wait_for([&fired] { return fired.load() > 0; }));
+	EXPECT_EQ(scheduler.queued.load(), 1);
+}
+
+TEST(timer_wheel, cancel_waits_for_a_running_action)
+{
+	TimerWheel wheel;
+	std::atomic<bool> started{false};
+	std::atomic<bool> finished{false};
+	const auto id = wheel.schedule_periodic(milliseconds(10), nullptr, [&started, &finished] {
+		if (!started.exchange(true))
+		{
+			std::this_thread::sleep_for(milliseconds(200));
+			finished = true;
+		}
+	});
+	ASSERT_TRUE(wait_for([&started] { return started.load(); }));
+
+	EXPECT_TRUE(wheel.cancel(id));
+	EXPECT_TRUE(finished.load());
+}
+
+TEST(timer_wheel, cancel_gives_up_on_a_stuck_action_after_500_ms)
+{
+	TimerWheel wheel;
+	std::atomic<int32_t> fired{0};
+	std::promise<void> release;
+	std::shared_future<void> released = release.get_future().share();
+	const auto id = wheel.schedule_periodic(milliseconds(10), nullptr, [&fired, released] {
+		++fired;
+		released.wait();
+	});
+	ASSERT_TRUE(wait_for([&fired] { return fired.load() > 0; }));
+
+	const auto cancelled = clock_type::now();
+	EXPECT_TRUE(wheel.cancel(id));
+	const auto waited = clock_type::now() - cancelled;
+	EXPECT_GE(waited, milliseconds(500) - TimerWheel::TICK);
+	EXPECT_LT(waited, milliseconds(5000));
+
+	// once the action returns the timer isn't rescheduled
+	release.set_value();
+	std::this_thread::sleep_for(milliseconds(100));
+	EXPECT_EQ(fired.load(), 1);
+	EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(timer_wheel, cancel_from_the_action_does_not_wait_for_itself)
+{
+	TimerWheel wheel;
+	std::atomic<TimerWheel::timer_id_t> id{0};
+	std::atomic<int32_t> fired{0};
+	std::atomic<bool> cancelled_quickly{false};
+	id = wheel.schedule_periodic(milliseconds(10), nullptr, [&] {
+		++fired;
+		while (id.load() == 0)
+		{
+		}
+		const auto cancelling = clock_type::now();
+		wheel.cancel(id.load());
+		cancelled_quickly = clock_type::now() - cancelling < milliseconds(400);
+	});
+
+	ASSERT_TRUE(wait_for([&fired] { return fired.load() > 0; }));
+	std::this_thread::sleep_for(milliseconds(100));
+	EXPECT_EQ(fired.load(), 1);
+	EXPECT_TRUE(cancelled_quickly.load());
+	EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(timer_wheel, idle_wheel_does_not_wake_up)
+{
+	TimerWheel wheel;
+	std::atomic<int32_t> fired{0};
+	wheel.schedule(milliseconds(10), nullptr, [&fired] { ++fired; });
+	ASSERT_TRUE(wait_for([&fired] { return fired.load() > 0; }));
+	std::this_thread::sleep_for(milliseconds(50));
+
+	const uint64_t wakeups = wheel.get_wakeups();
+	std::this_thread::sleep_for(milliseconds(300));
+	EXPECT_EQ(wheel.get_wakeups(), wakeups);
+}
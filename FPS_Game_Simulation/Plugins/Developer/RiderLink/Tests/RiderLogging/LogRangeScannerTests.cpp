@@ -0,0 +1,134 @@
+#include "LogRangeScanner.hpp"
+
+#include <gtest/gtest.h>
+
+#include <ostream>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace
+{
+using LogRangeScanner::FRange;
+
+struct FScanResult
+{
+	std::vector<FRange> Paths;
+	std::vector<FRange> Methods;
+};
+
+template <typename CharT>
+FScanResult Scan(const std::basic_string<CharT>& Str)
+{
+	FScanResult Result;
+	LogRangeScanner::Scan(Str.data(), static_cast<int32_t>(Str.size()), Result.Paths, Result.Methods);
+	return Result;
+}
+
+std::vector<FRange> RegexRanges(const std::string& Str, const std::regex& Pattern)
+{
+	std::vector<FRange> Ranges;
+	for (auto It = std::sregex_iterator(Str.begin(), Str.end(), Pattern); It != std::sregex_iterator(); ++It)
+	{
+		const auto Start = static_cast<int32_t>(It->position());
+		Ranges.push_back({Start, Start + static_cast<int32_t>(It->length())});
+	}
+	return Ranges;
+}
+}	 // namespace
+
+// found by argument-dependent lookup from gtest's assertions
+namespace LogRangeScanner
+{
+bool operator==(const FRange& A, const FRange& B)
+{
+	return A.Start == B.Start && A.End == B.End;
+}
+
+std::ostream& operator<<(std::ostream& Out, const FRange& Range)
+{
+	return Out << '[' << Range.Start << ", " << Range.End << ')';
+}
+}	 // namespace LogRangeScanner
+
+TEST(LogRangeScanner, FindsObjectPath)
+{
+	const auto Result = Scan(std::string("Loading /Game/Maps/Arena.Arena took 2s"));
+
+	ASSERT_EQ(Result.Paths.size(), 1u);
+	EXPECT_EQ(Result.Paths[0], (FRange{8, 30}));
+	EXPECT_TRUE(Result.Methods.empty());
+}
+
+TEST(LogRangeScanner, SlashWithoutSegmentIsNoPath)
+{
+	EXPECT_TRUE(Scan(std::string("a / b")).Paths.empty());
+	EXPECT_TRUE(Scan(std::string("trailing/")).Paths.empty());
+
+	const auto Result = Scan(std::string("//Game"));
+	ASSERT_EQ(Result.Paths.size(), 1u);
+	EXPECT_EQ(Result.Paths[0], (FRange{1, 6}));
+}
+
+TEST(LogRangeScanner, PathStopsAtNonSegmentCharacter)
+{
+	const auto Result = Scan(std::string("'/Game/A.B_C' /Engine/X"));
+
+	ASSERT_EQ(Result.Paths.size(), 2u);
+	EXPECT_EQ(Result.Paths[0], (FRange{1, 12}));
+	EXPECT_EQ(Result.Paths[1], (FRange{14, 23}));
+}
+
+TEST(LogRangeScanner, NonAsciiCountsAsWordCharacter)
+{
+	const auto Result = Scan(std::wstring(L"/Gäme/Kärte"));
+
+	ASSERT_EQ(Result.Paths.size(), 1u);
+	EXPECT_EQ(Result.Paths[0], (FRange{0, 11}));
+}
+
+TEST(LogRangeScanner, FindsMethodsAndDestructors)
+{
+	const auto Result = Scan(std::string("in AEnemy::ReceiveTick from UObject::~UObject"));
+
+	ASSERT_EQ(Result.Methods.size(), 2u);
+	EXPECT_EQ(Result.Methods[0], (FRange{3, 22}));
+	EXPECT_EQ(Result.Methods[1], (FRange{28, 45}));
+}
+
+TEST(LogRangeScanner, IncompleteMethodIsIgnored)
+{
+	EXPECT_TRUE(Scan(std::string("AEnemy::")).Methods.empty());
+	EXPECT_TRUE(Scan(std::string("::Tick")).Methods.empty());
+	EXPECT_TRUE(Scan(std::string("AEnemy ::Tick")).Methods.empty());
+	EXPECT_TRUE(Scan(std::string("AEnemy:Tick")).Methods.empty());
+}
+
+TEST(LogRangeScanner, MethodDoesNotResumeInsideMatch)
+{
+	const auto Result = Scan(std::string("A::B::C"));
+
+	ASSERT_EQ(Result.Methods.size(), 1u);
+	EXPECT_EQ(Result.Methods[0], (FRange{0, 4}));
+}
+
+TEST(LogRangeScanner, MatchesRegexesOnLogLines)
+{
+	const std::regex PathPattern(R"((/[\w\.]+)+)");
+	const std::regex MethodPattern(R"([0-9a-z_A-Z]+::~?[0-9a-z_A-Z]+)");
+	const std::vector<std::string> Lines = {
+		"LogBlueprintUserMessages: [BP_Enemy_C_3] /Game/Blueprints/BP_Enemy.BP_Enemy_C called AEnemy::ReceiveTick",
+		"LogTemp: Warning: UEnemyMovementSubsystem::Tick took 3.2ms for 512 enemies",
+		"LogStreaming: Display: Flushing async loaders. /Game/Maps/Arena /Game/Maps/Arena_BuiltData.Arena_BuiltData",
+		"LogShaderCompilers: Display: Compiling shader /Engine/Private/BasePassPixelShader.usf:: FBasePassPS::Main",
+		"Assertion failed: Index >= 0 [File:D:/Build/Source/Runtime/Core/Public/Containers/Array.h] [Line: 771]",
+		"a::b::c::d /x/y/z.w//v std::vector<int>::push_back ~::x x::~ ::",
+		"LogPlayLevel: Error: UEditorEngine::CreatePIEWorldByDuplication: /Game/Maps/UEDPIE_0_Arena.Arena",
+	};
+	for (const std::string& Line : Lines)
+	{
+		const auto Result = Scan(Line);
+		EXPECT_EQ(Result.Paths, RegexRanges(Line, PathPattern)) << Line;
+		EXPECT_EQ(Result.Methods, RegexRanges(Line, MethodPattern)) << Line;
+	}
+}
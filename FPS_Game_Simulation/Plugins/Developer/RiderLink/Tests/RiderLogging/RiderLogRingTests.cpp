@@ -0,0 +1,86 @@
+#include "RiderLogRing.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+using FRing = RiderLogRing::TRing<int>;
+
+std::vector<int> PopAll(FRing& Ring, int32_t MaxCount)
+{
+	std::vector<int> Out;
+	Ring.Pop(MaxCount, [&Out](int&& Record) { Out.push_back(Record); });
+	return Out;
+}
+}	 // namespace
+
+TEST(RiderLogRing, PopsOldestFirstAcrossWrap)
+{
+	FRing Ring(3);
+	ASSERT_TRUE(Ring.Push(1));
+	ASSERT_TRUE(Ring.Push(2));
+	EXPECT_EQ(PopAll(Ring, 1), std::vector<int>({1}));
+	ASSERT_TRUE(Ring.Push(3));
+	ASSERT_TRUE(Ring.Push(4));
+
+	EXPECT_EQ(PopAll(Ring, 8), std::vector<int>({2, 3, 4}));
+	EXPECT_EQ(Ring.Num(), 0);
+}
+
+TEST(RiderLogRing, DropsWhenFullAndReportsOnce)
+{
+	FRing Ring(2);
+	EXPECT_TRUE(Ring.Push(1));
+	EXPECT_TRUE(Ring.Push(2));
+	EXPECT_FALSE(Ring.Push(3));
+	EXPECT_FALSE(Ring.Push(4));
+
+	EXPECT_EQ(Ring.TakeDroppedSinceLastCall(), 2u);
+	EXPECT_EQ(Ring.TakeDroppedSinceLastCall(), 0u);
+	EXPECT_EQ(Ring.GetStats().Pushed, 2u);
+	EXPECT_EQ(Ring.GetStats().Dropped, 2u);
+	EXPECT_EQ(PopAll(Ring, 8), std::vector<int>({1, 2}));
+}
+
+TEST(RiderLogRing, HighWatermarkKeepsTheDeepestFill)
+{
+	FRing Ring(8);
+	for (int Index = 0; Index < 5; ++Index)
+	{
+		Ring.Push(int(Index));
+	}
+	PopAll(Ring, 4);
+	Ring.Push(5);
+
+	EXPECT_EQ(Ring.Num(), 2);
+	EXPECT_EQ(Ring.GetStats().HighWatermark, 5);
+}
+
+TEST(RiderLogRing, UndeliveredBatchIsDroppedAndReportedWithItsDrops)
+{
+	FRing Ring(2);
+	Ring.Push(1);
+	Ring.Push(2);
+	Ring.Push(3);
+
+	const auto Batch = PopAll(Ring, 2);
+	const uint64_t Dropped = Ring.TakeDroppedSinceLastCall();
+	Ring.ReportUndelivered(static_cast<int32_t>(Batch.size()), Dropped);
+
+	EXPECT_EQ(Ring.GetStats().Dropped, 3u);
+	EXPECT_EQ(Ring.GetStats().Delivered, 0u);
+	EXPECT_EQ(Ring.TakeDroppedSinceLastCall(), 3u);
+}
+
+TEST(RiderLogRing, DeliveredKeepsTheWorstLatency)
+{
+	FRing Ring(4);
+	Ring.ReportDelivered(3, 0.25);
+	Ring.ReportDelivered(1, 0.5);
+	Ring.ReportDelivered(2, 0.125);
+
+	EXPECT_EQ(Ring.GetStats().Delivered, 6u);
+	EXPECT_DOUBLE_EQ(Ring.GetStats().MaxLatencySeconds, 0.5);
+}
@@ -1,6 +1,8 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "FPS_Game_SimulationCharacter.h"
+#include "DamageSubsystem.h"
+#include "EffectSubsystem.h"
 #include "FPS_Game_SimulationProjectile.h"
 #include "Animation/AnimInstance.h"
 #include "Camera/CameraComponent.h"
@@ -57,6 +59,56 @@ void AFPS_Game_SimulationCharacter::BeginPlay()
 	// Assign level passing values
 	AssignLevels();
 
+	// Take damage in the batch of the frame
+	DamageSubsystem = GetWorld()->GetSubsystem<UDamageSubsystem>();
+	if (DamageSubsystem)
+	{
+		DamageTarget = DamageSubsystem->RegisterTarget(this);
+	}
+
+	// Sprinting stops at the walk speed the character starts with
+	WalkSpeed = GetCharacterMovement()->MaxWalkSpeed;
+
+	// Time the talents with all other effects of the world
+	EffectSubsystem = GetWorld()->GetSubsystem<UEffectSubsystem>();
+	if (EffectSubsystem)
+	{
+		float BaseStats[static_cast<int32>(EEffectStat::Num)] = {};
+		BaseStats[static_cast<int32>(EEffectStat::MoveSpeed)] = WalkSpeed;
+		BaseStats[static_cast<int32>(EEffectStat::JumpVelocity)] = MaxJumpOnZ;
+		EffectOwner = EffectSubsystem->RegisterOwner(this, BaseStats);
+
+		FEffectSpec Spec;
+		Spec.Modifier = EEffectModifier::Override;
+		Spec.Stacking = EEffectStacking::Refresh;
+
+		Spec.Stat = static_cast<int32>(EEffectStat::MoveSpeed);
+		Spec.Magnitude = TalentSuperSprintAmount;
+		Spec.Duration = TalentSuperSprintDuration;
+		TalentSuperSprintEffect = EffectSubsystem->FindOrAddSpec(Spec);
+
+		Spec.Stat = static_cast<int32>(EEffectStat::JumpVelocity);
+		Spec.Magnitude = TalentHighJumpAmount;
+		Spec.Duration = TalentHighJumpDuration;
+		TalentHighJumpEffect = EffectSubsystem->FindOrAddSpec(Spec);
+	}
+}
+
+void AFPS_Game_SimulationCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (DamageSubsystem && DamageTarget != InvalidSimAgent)
+	{
+		DamageSubsystem->UnregisterTarget(DamageTarget);
+		DamageTarget = InvalidSimAgent;
+	}
+
+	if (EffectSubsystem && EffectOwner != InvalidSimAgent)
+	{
+		EffectSubsystem->UnregisterOwner(EffectOwner);
+		EffectOwner = InvalidSimAgent;
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 //////////////////////////////////////////////////////////////////////////// Input
@@ -90,7 +142,14 @@ void AFPS_Game_SimulationCharacter::SetupPlayerInputComponent(class UInputCompon
 void AFPS_Game_SimulationCharacter::DealDamage(float DamageAmount)
 {
 	if (DamageAmount <= 0.f) return;
-	
+
+	if (DamageSubsystem && DamageTarget != InvalidSimAgent)
+	{
+		DamageSubsystem->QueueDamage(DamageTarget, DamageAmount);
+		return;
+	}
+
+	// Not registered, take it at once
 	CurrentHealth -= DamageAmount;
 
 	if(CurrentHealth <= 0.f)
@@ -103,12 +162,12 @@ void AFPS_Game_SimulationCharacter::DealDamage(float DamageAmount)
 	}
 }
 
-void AFPS_Game_SimulationCharacter::TrigToGainXP()
+void AFPS_Game_SimulationCharacter::GainKillRewards(int Kills)
 {
-	// Gain XP & Check if leveled up
-	CurrentExperiencePoints += ExperiencePointsAmount;
+	// Gain XP for all kills & check for level ups once
+	CurrentExperiencePoints += ExperiencePointsAmount * Kills;
+	KillScore += Kills;
 	CheckIfLeveledUp();
-	
 }
 
 void AFPS_Game_SimulationCharacter::AssignLevels()
@@ -183,12 +242,23 @@ void AFPS_Game_SimulationCharacter::Look(const FInputActionValue& Value)
 
 void AFPS_Game_SimulationCharacter::Sprint()
 {
+	// Super Sprint overrides the walk speed while it lasts
+	if (EffectSubsystem && EffectOwner != InvalidSimAgent)
+	{
+		EffectSubsystem->SetBaseStat(EffectOwner, EEffectStat::MoveSpeed, MaxSprintSpeed);
+		return;
+	}
 	GetCharacterMovement()->MaxWalkSpeed = MaxSprintSpeed;
 }
 
 void AFPS_Game_SimulationCharacter::StopSprinting()
 {
-	GetCharacterMovement()->MaxWalkSpeed = 600.f;
+	if (EffectSubsystem && EffectOwner != InvalidSimAgent)
+	{
+		EffectSubsystem->SetBaseStat(EffectOwner, EEffectStat::MoveSpeed, WalkSpeed);
+		return;
+	}
+	GetCharacterMovement()->MaxWalkSpeed = WalkSpeed;
 }
 
 void AFPS_Game_SimulationCharacter::SetHasRifle(bool bNewHasRifle)
@@ -204,7 +274,7 @@ bool AFPS_Game_SimulationCharacter::GetHasRifle()
 bool AFPS_Game_SimulationCharacter::CanUseTalentSuperSprint()
 {
 	// Ok, player can use the talent
-	if(CurrentLevel >= 5 && CurrentTalentPoints >= 1)
+	if(CurrentLevel >= 5 && CurrentTalentPoints >= 1 && EffectOwner != InvalidSimAgent)
 	{
 		return true;
 	}
@@ -214,7 +284,7 @@ bool AFPS_Game_SimulationCharacter::CanUseTalentSuperSprint()
 bool AFPS_Game_SimulationCharacter::CanUseTalentHighJump()
 {
 	// Ok, player can use the talent
-	if(CurrentLevel >= 5 && CurrentTalentPoints >= 1)
+	if(CurrentLevel >= 5 && CurrentTalentPoints >= 1 && EffectOwner != InvalidSimAgent)
 	{
 		return true;
 	}
@@ -236,12 +306,9 @@ void AFPS_Game_SimulationCharacter::UseTalent(Talents Talent)
 	switch (Talent)
 	{
 	case SuperSprint:
-		if(CanUseTalentSuperSprint())
+		if(CanUseTalentSuperSprint() && EffectSubsystem->ApplyEffect(EffectOwner, TalentSuperSprintEffect))
 		{
-			GetCharacterMovement()->MaxWalkSpeed = TalentSuperSprintAmount;
 			TalentInfo = "SuperSprint Activated...";
-			GetWorld()->GetTimerManager().SetTimer(TalentSuperSprintTimerHandle, this,
-				&AFPS_Game_SimulationCharacter::ResetTalentSuperSprint, TalentSuperSprintDuration, false);
 			CurrentTalentPoints--;
 		}else
 		{
@@ -251,12 +318,9 @@ void AFPS_Game_SimulationCharacter::UseTalent(Talents Talent)
 		}
 		break;
 	case HighJump:
-		if(CanUseTalentHighJump())
+		if(CanUseTalentHighJump() && EffectSubsystem->ApplyEffect(EffectOwner, TalentHighJumpEffect))
 		{
-			GetCharacterMovement()->JumpZVelocity = TalentHighJumpAmount;
 			TalentInfo = "HighJump Activated...";
-			GetWorld()->GetTimerManager().SetTimer(TalentHighJumpTimerHandle, this,
-				&AFPS_Game_SimulationCharacter::ResetTalentHighJump, TalentHighJumpDuration, false);
 			CurrentTalentPoints--;
 		}else
 		{
@@ -281,16 +345,15 @@ void AFPS_Game_SimulationCharacter::UseTalent(Talents Talent)
 	}
 }
 
-void AFPS_Game_SimulationCharacter::ResetTalentSuperSprint()
+void AFPS_Game_SimulationCharacter::OnEffectStatsChanged()
 {
-	TalentInfo = "";
-	StopSprinting();
+	GetCharacterMovement()->MaxWalkSpeed = EffectSubsystem->GetStat(EffectOwner, EEffectStat::MoveSpeed);
+	GetCharacterMovement()->JumpZVelocity = EffectSubsystem->GetStat(EffectOwner, EEffectStat::JumpVelocity);
 }
 
-void AFPS_Game_SimulationCharacter::ResetTalentHighJump()
+void AFPS_Game_SimulationCharacter::OnEffectExpired(FEffectSpecId Spec)
 {
 	TalentInfo = "";
-	GetCharacterMovement()->JumpZVelocity = MaxJumpOnZ;
 }
 
 
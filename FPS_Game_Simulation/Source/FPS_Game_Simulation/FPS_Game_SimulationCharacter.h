@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "InputActionValue.h"
+#include "Simulation/EffectCore.h"
+#include "Simulation/SimulationTypes.h"
 #include "TP_WeaponComponent.h"
 #include "FPS_Game_SimulationCharacter.generated.h"
 
@@ -65,6 +67,9 @@ public:
 protected:
 	virtual void BeginPlay();
 
+	// Called when the character is destroyed or the level ends
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:
 		
 	/** Bool for AnimBP to switch to another animation set */
@@ -120,6 +125,9 @@ private:
 	UPROPERTY(EditAnywhere, Category="Character")
 	float MaxJumpOnZ = 420.f;
 
+	// Walk speed of the movement component at BeginPlay, restored when sprinting stops
+	float WalkSpeed = 600.f;
+
 	// Current Health
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character", meta=(AllowPrivateAccess))
 	float CurrentHealth = 100.f;
@@ -155,12 +163,13 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Talents")
 	float TalentMaxiHealthAmount = 100.f;
 
-	// The durations and timers of the character's talent
+	// The durations of the character's talent
 	float TalentSuperSprintDuration = 5.f;
 	float TalentHighJumpDuration = 5.f;
-	
-	FTimerHandle TalentSuperSprintTimerHandle;
-	FTimerHandle TalentHighJumpTimerHandle;
+
+	// The timed talents are effects of the effect subsystem, registered in BeginPlay
+	FEffectSpecId TalentSuperSprintEffect = 0;
+	FEffectSpecId TalentHighJumpEffect = 0;
 
 	// Determines whether the character can use the talent
 	bool CanUseTalentSuperSprint();
@@ -172,8 +181,20 @@ protected:
 	void TriggerTalentSuperSprint();
 	void TriggerTalentHighJump();
 	void TriggerTalentMaxiHealth();
-	void ResetTalentSuperSprint();
-	void ResetTalentHighJump();
+
+public:
+	// Movement takes the stats the talents changed, called by the effect subsystem
+	void OnEffectStatsChanged();
+
+	// Called by the effect subsystem when a talent ran out
+	void OnEffectExpired(FEffectSpecId Spec);
+
+private:
+	// Times the talents of this character
+	UPROPERTY()
+	class UEffectSubsystem* EffectSubsystem;
+
+	FSimAgentId EffectOwner = InvalidSimAgent;
 
 public:
 	// It will trigger left white colored text in CharacterHUD to inform player whether s/he used talent or not
@@ -185,10 +206,21 @@ public:
 	FTimerHandle TalentInfoTimerHandle;
 
 public:
-	// Getting damage by enemy
+	// Getting damage by enemy, applied with all other damage at the end of the frame
 	UFUNCTION(BlueprintCallable)
 	void DealDamage(float DamageAmount);
 
+	// Id of this character in the damage subsystem, also tells whose shots killed an enemy
+	FORCEINLINE FSimAgentId GetDamageTarget() const { return DamageTarget; }
+
+private:
+	// Applies the damage this character takes together with all other damage
+	UPROPERTY()
+	class UDamageSubsystem* DamageSubsystem;
+
+	FSimAgentId DamageTarget = InvalidSimAgent;
+
+public:
 	UFUNCTION(BlueprintImplementableEvent)
 	void TriggerGameOverScreen();
 
@@ -198,8 +230,6 @@ private:
 	int KillScore = 0;
 
 public:
-	// Set kill score
-	FORCEINLINE void IncrementKillScore(){ KillScore++; }
 	// Get kill score
 	FORCEINLINE int GetKillScore() const { return KillScore; }
 	
@@ -233,8 +263,9 @@ public:
 	int CurrentTalentPoints = 0;
 
 public:
-	// Character gains experience points (enemy class triggers this function)
-	void TrigToGainXP();
+	// Character gains experience points and kill score for Kills enemies (the damage subsystem triggers this function
+	// once per frame with all kills of the frame)
+	void GainKillRewards(int Kills);
 
 private:
 	// Level pass power assigning
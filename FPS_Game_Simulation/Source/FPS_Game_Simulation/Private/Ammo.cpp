@@ -3,17 +3,19 @@
 
 #include "Ammo.h"
 
+#include "PickupSubsystem.h"
 #include "Spawner.h"
+#include "SpawnerRegistrySubsystem.h"
 #include "Components/BoxComponent.h"
 #include "Components/SphereComponent.h"
+#include "Engine/CollisionProfile.h"
 #include "FPS_Game_Simulation/FPS_Game_SimulationCharacter.h"
-#include "Kismet/GameplayStatics.h"
 
 // Sets default values
 AAmmo::AAmmo()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+ 	// Players are checked against all pickups at once by UPickupSubsystem, nothing to tick
+	PrimaryActorTick.bCanEverTick = false;
 
 	Mesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Ammo Mesh"));
 	SetRootComponent(Mesh);
@@ -23,7 +25,8 @@ AAmmo::AAmmo()
 
 	InteractSphereComponent = CreateDefaultSubobject<USphereComponent>(TEXT("Sphere Comp"));
 	InteractSphereComponent->SetupAttachment(Mesh);
-	InteractSphereComponent->OnComponentBeginOverlap.AddDynamic(this, &AAmmo::OnSphereBeginOverlap);
+	InteractSphereComponent->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+	InteractSphereComponent->SetGenerateOverlapEvents(false);
 
 }
 
@@ -33,64 +36,82 @@ void AAmmo::BeginPlay()
 	Super::BeginPlay();
 
 	// Setting ammo spawner
-	TArray<AActor*> FoundSpawners;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), ASpawner::StaticClass(), FoundSpawners);
-	for (AActor* FoundSpawner : FoundSpawners)
-	{
-		if(FoundSpawner && FoundSpawner->ActorHasTag(TEXT("AmmoSpawner")))
-		{
-			Spawner = Cast<ASpawner>(FoundSpawner);
-		}
-	}
+	Spawner = USpawnerRegistrySubsystem::FindSpawnerOf(this, TEXT("AmmoSpawner"));
+
+	// Let players reach this ammo
+	PickupSubsystem = GetWorld()->GetSubsystem<UPickupSubsystem>();
+	RegisterPickup();
 }
 
-// Called every frame
-void AAmmo::Tick(float DeltaTime)
+void AAmmo::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
+	UnregisterPickup();
 
+	Super::EndPlay(EndPlayReason);
 }
 
-void AAmmo::OnSphereBeginOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
-	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void AAmmo::OnTakenFromPool()
 {
+	AmmoAmount = GetClass()->GetDefaultObject<AAmmo>()->AmmoAmount;
+	TriggerAmmoAmount();
+
+	RegisterPickup();
+}
+
+void AAmmo::OnReturnedToPool()
+{
+	UnregisterPickup();
+}
+
+void AAmmo::RegisterPickup()
+{
+	if(PickupSubsystem && PickupId == InvalidSimAgent)
+	{
+		PickupId = PickupSubsystem->RegisterPickup(this, InteractSphereComponent->GetScaledSphereRadius());
+	}
+}
 
-	Character = Cast<AFPS_Game_SimulationCharacter>(OtherActor);
+void AAmmo::UnregisterPickup()
+{
+	if(PickupSubsystem && PickupId != InvalidSimAgent)
+	{
+		PickupSubsystem->UnregisterPickup(PickupId);
+		PickupId = InvalidSimAgent;
+	}
+}
 
+void AAmmo::OnReachedBy(AFPS_Game_SimulationCharacter* Character)
+{
 	// If character is valid and got the rifle
 	if(Character && Character->bHasRifle)
 	{
-		Weapon = Character->GetRifle();
+		UTP_WeaponComponent* Weapon = Character->GetRifle();
 		// If weapon is valid
 		if(Weapon)
 		{
-			// If the gun needs ammo
-			if(Weapon->CurrentAmmoLimit > Weapon->CurrentAmmo)
+			//  If you collect an ammo item and the amount of collectible bullets exceeds the
+			//  current maximum amount of ammo, the character must collect needed amount of bullets from the ground.
+			//  The remaining amount of bullets will stay on the ground. A full gun takes nothing.
+			const FAmmoPickupResult Result = ResolveAmmoPickup(Weapon->CurrentAmmo, Weapon->CurrentAmmoLimit, AmmoAmount);
+			if(Result.Taken > 0)
 			{
-				//  If you collect an ammo item and the amount of collectible bullets exceeds the
-				//  current maximum amount of ammo, the character must collect needed amount of bullets from the ground.
-				//  The remaining amount of bullets will stay on the ground.
-				if(Weapon->CurrentAmmoLimit - Weapon->CurrentAmmo >= AmmoAmount)
+				Weapon->AddAmmo(Result.Taken);
+			}
+
+			if(Result.bConsumed)
+			{
+				// Once you collect an ammo item, there must be a certain amount of time interval before spawning next ammo item
+				if(Spawner)
+					Spawner->TrigSpawnerWithTimer(SpawnRate);
+				if(!Spawner || !Spawner->ReturnToPool(this))
 				{
-					Weapon->AddAmmo(AmmoAmount);
-					// Once you collect an ammo item, there must be a certain amount of time interval before spawning next ammo item
-					if(Spawner)
-						Spawner->TrigSpawnerWithTimer(SpawnRate);
 					Destroy();
-				}else
-				{
-					// Taking the needed bullets
-					AmmoAmount -= Weapon->CurrentAmmoLimit - Weapon->CurrentAmmo;
-					// Fulling the ammo
-					Weapon->CurrentAmmo += Weapon->CurrentAmmoLimit - Weapon->CurrentAmmo;
-
-					TriggerAmmoAmount();
 				}
-			}else
+			}else if(Result.Taken > 0)
 			{
-				// Dont take the ammo, you dont got the right!!!
+				AmmoAmount = Result.Remaining;
+				TriggerAmmoAmount();
 			}
 		}
 	}
 }
-
@@ -0,0 +1,114 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DamageSubsystem.h"
+
+#include "Enemy.h"
+#include "Engine/World.h"
+#include "FPS_Game_Simulation/FPS_Game_SimulationCharacter.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_CYCLE_STAT(TEXT("Damage"), STAT_Damage, STATGROUP_Game);
+
+void UDamageSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (DamageQueue.NumPending() == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_Damage);
+
+	const int32 NumHits = DamageQueue.Resolve();
+
+	// Health stays on the actors, blueprints change it too. Only the hit ones are copied in and out.
+	float* Health = DamageQueue.GetHitHealth();
+	for (int32 Hit = 0; Hit < NumHits; ++Hit)
+	{
+		AActor* Target = Targets[DamageQueue.HitTargetAt(Hit)];
+		if (const AEnemy* Enemy = Cast<AEnemy>(Target))
+		{
+			Health[Hit] = Enemy->Health;
+		}
+		else if (const AFPS_Game_SimulationCharacter* Player = Cast<AFPS_Game_SimulationCharacter>(Target))
+		{
+			Health[Hit] = Player->GetCurrentHealth();
+		}
+	}
+
+	DamageQueue.ApplyHits();
+
+	for (int32 Hit = 0; Hit < NumHits; ++Hit)
+	{
+		AActor* Target = Targets[DamageQueue.HitTargetAt(Hit)];
+		if (AEnemy* Enemy = Cast<AEnemy>(Target))
+		{
+			Enemy->Health = Health[Hit];
+		}
+		else if (AFPS_Game_SimulationCharacter* Player = Cast<AFPS_Game_SimulationCharacter>(Target))
+		{
+			Player->SetCurrentHealth(Health[Hit]);
+		}
+	}
+
+	// Killed enemies may unregister while handled, e.g. when returned to their spawner's pool
+	KillsByPlayer.Reset();
+	for (const int32 Hit : DamageQueue.GetKills())
+	{
+		AActor* Target = Targets[DamageQueue.HitTargetAt(Hit)];
+		if (AEnemy* Enemy = Cast<AEnemy>(Target))
+		{
+			// Damage nobody in particular dealt rewards the first player, as it always did
+			const FSimAgentId Instigator = DamageQueue.HitInstigatorAt(Hit);
+			AFPS_Game_SimulationCharacter* Killer = Targets.IsValidIndex(Instigator)
+				? Cast<AFPS_Game_SimulationCharacter>(Targets[Instigator])
+				: Cast<AFPS_Game_SimulationCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
+			if (Killer)
+			{
+				++KillsByPlayer.FindOrAdd(Killer);
+			}
+
+			Enemy->OnKilled();
+		}
+		else if (AFPS_Game_SimulationCharacter* Player = Cast<AFPS_Game_SimulationCharacter>(Target))
+		{
+			Player->TriggerGameOverScreen();
+		}
+	}
+
+	for (const TPair<AFPS_Game_SimulationCharacter*, int32>& Kills : KillsByPlayer)
+	{
+		Kills.Key->GainKillRewards(Kills.Value);
+	}
+}
+
+TStatId UDamageSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDamageSubsystem, STATGROUP_Tickables);
+}
+
+FSimAgentId UDamageSubsystem::RegisterTarget(AActor* Target)
+{
+	const FSimAgentId Id = DamageQueue.AddTarget();
+
+	if (Targets.Num() <= Id)
+	{
+		Targets.SetNum(Id + 1);
+	}
+	Targets[Id] = Target;
+
+	return Id;
+}
+
+void UDamageSubsystem::UnregisterTarget(FSimAgentId Target)
+{
+	DamageQueue.RemoveTarget(Target);
+	Targets[Target] = nullptr;
+}
+
+bool UDamageSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EffectSubsystem.h"
+
+#include "Engine/World.h"
+#include "FPS_Game_Simulation/FPS_Game_SimulationCharacter.h"
+#include "FPS_Game_Simulation/TP_WeaponComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("Effects"), STAT_Effects, STATGROUP_Game);
+
+void UEffectSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// A character and its weapon have a few talents each
+	FEffectConfig Config;
+	Config.NumStats = static_cast<int32>(EEffectStat::Num);
+	Config.EffectsPerOwner = 8;
+	Effects = FEffectCore(Config);
+}
+
+void UEffectSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_Effects);
+
+	Effects.Update(DeltaTime);
+
+	for (const FSimAgentId Owner : Effects.GetChangedOwners())
+	{
+		if (AFPS_Game_SimulationCharacter* Character = Cast<AFPS_Game_SimulationCharacter>(Owners[Owner]))
+		{
+			Character->OnEffectStatsChanged();
+		}
+		else if (UTP_WeaponComponent* Weapon = Cast<UTP_WeaponComponent>(Owners[Owner]))
+		{
+			Weapon->OnEffectStatsChanged();
+		}
+	}
+
+	// Owners may unregister while handled
+	for (const FExpiredEffect& Expired : Effects.GetExpired())
+	{
+		if (AFPS_Game_SimulationCharacter* Character = Cast<AFPS_Game_SimulationCharacter>(Owners[Expired.Owner]))
+		{
+			Character->OnEffectExpired(Expired.Spec);
+		}
+		else if (UTP_WeaponComponent* Weapon = Cast<UTP_WeaponComponent>(Owners[Expired.Owner]))
+		{
+			Weapon->OnEffectExpired(Expired.Spec);
+		}
+	}
+}
+
+TStatId UEffectSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEffectSubsystem, STATGROUP_Tickables);
+}
+
+FEffectSpecId UEffectSubsystem::FindOrAddSpec(const FEffectSpec& Spec)
+{
+	// A handful of talents, looked up when owners register
+	for (FEffectSpecId Id = 0; Id < Effects.NumSpecs(); ++Id)
+	{
+		if (Effects.GetSpec(Id) == Spec)
+		{
+			return Id;
+		}
+	}
+	return Effects.AddSpec(Spec);
+}
+
+FSimAgentId UEffectSubsystem::RegisterOwner(UObject* Owner, const float* BaseStats)
+{
+	const FSimAgentId Id = Effects.AddOwner(BaseStats);
+
+	if (Owners.Num() <= Id)
+	{
+		Owners.SetNum(Id + 1);
+	}
+	Owners[Id] = Owner;
+
+	return Id;
+}
+
+void UEffectSubsystem::UnregisterOwner(FSimAgentId Owner)
+{
+	Effects.RemoveOwner(Owner);
+	Owners[Owner] = nullptr;
+}
+
+bool UEffectSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
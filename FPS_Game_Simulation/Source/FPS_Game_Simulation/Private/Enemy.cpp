@@ -3,18 +3,21 @@
 
 #include "Enemy.h"
 
+#include "DamageSubsystem.h"
+#include "EnemyMovementSubsystem.h"
 #include "Spawner.h"
+#include "SpawnerRegistrySubsystem.h"
 #include "Components/BoxComponent.h"
+#include "Components/SkeletalMeshComponent.h"
 #include "FPS_Game_Simulation/FPS_Game_SimulationCharacter.h"
 #include "Kismet/GameplayStatics.h"
-#include "Perception/AIPerceptionComponent.h"
-#include "Perception/AISenseConfig_Sight.h"
 
 // Sets default values
 AEnemy::AEnemy()
 {
- 	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+ 	// Enemies are moved in a batch by UEnemyMovementSubsystem instead of ticking one by one. Blueprint subclasses with an
+	// Event Tick get ticking turned back on when compiled, see ChildCanTick on the class.
+	PrimaryActorTick.bCanEverTick = false;
 
 	TriggerBox = CreateDefaultSubobject<UBoxComponent>(TEXT("Trigger Box"));
 	TriggerBox->SetupAttachment(RootComponent);
@@ -22,25 +25,9 @@ AEnemy::AEnemy()
 	TriggerBox->OnComponentEndOverlap.AddDynamic(this, &AEnemy::OnHitEnd);
 	TriggerBox->SetVisibility(true);
 
-	AIPerceptionComponent = CreateDefaultSubobject<UAIPerceptionComponent>(TEXT("AI Perception Component"));
-	SightConfig = CreateDefaultSubobject<UAISenseConfig_Sight>(TEXT("Sight Config"));
-
-	SightConfig->SightRadius = 1500.f;
-	SightConfig->LoseSightRadius = 1500.f;
-	SightConfig->PeripheralVisionAngleDegrees = 100.f;
-	SightConfig->DetectionByAffiliation.bDetectEnemies = true;
-	SightConfig->DetectionByAffiliation.bDetectFriendlies = true;
-	SightConfig->DetectionByAffiliation.bDetectNeutrals = true;
-	// How much time AI will forget player
-	SightConfig->SetMaxAge(.1f);
-
-	AIPerceptionComponent->ConfigureSense(*SightConfig);
-	AIPerceptionComponent->SetDominantSense(SightConfig->GetSenseImplementation());
-	AIPerceptionComponent->OnPerceptionUpdated.AddDynamic(this, &AEnemy::OnSensed);
+	// Sight is checked for all enemies at once by UEnemyMovementSubsystem
 
 	CurrentVelocity = FVector::ZeroVector;
-	
-	DistanceSquared = BIG_NUMBER;
 }
 
 // Called when the game starts or when spawned
@@ -53,49 +40,82 @@ void AEnemy::BeginPlay()
 
 	
 	// Setting enemy spawner
-	TArray<AActor*> FoundSpawners;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), ASpawner::StaticClass(), FoundSpawners);
-	for (AActor* FoundSpawner : FoundSpawners)
-	{
-		if(FoundSpawner && FoundSpawner->ActorHasTag(TEXT("EnemySpawner")))
-		{
-			Spawner = Cast<ASpawner>(FoundSpawner);
-		}
-	}
+	Spawner = USpawnerRegistrySubsystem::FindSpawnerOf(this, TEXT("EnemySpawner"));
 
 	// Setting character
 	Character = Cast<AFPS_Game_SimulationCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
+
+	// Join the batched enemy movement
+	MovementSubsystem = GetWorld()->GetSubsystem<UEnemyMovementSubsystem>();
+	if(MovementSubsystem)
+	{
+		MovementAgent = MovementSubsystem->RegisterEnemy(this);
+	}
+
+	// Take damage in the batch of the frame
+	DamageSubsystem = GetWorld()->GetSubsystem<UDamageSubsystem>();
+	if(DamageSubsystem)
+	{
+		DamageTarget = DamageSubsystem->RegisterTarget(this);
+	}
 	
 }
 
-// Called every frame
-void AEnemy::Tick(float DeltaTime)
+void AEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
+	if(MovementSubsystem && MovementAgent != InvalidSimAgent)
+	{
+		MovementSubsystem->UnregisterEnemy(MovementAgent);
+		MovementAgent = InvalidSimAgent;
+	}
 
-	// Getting back to base location in a smooth way
-	if(!CurrentVelocity.IsZero())
+	if(DamageSubsystem && DamageTarget != InvalidSimAgent)
 	{
-		NewLocation = GetActorLocation() + CurrentVelocity * DeltaTime;
+		DamageSubsystem->UnregisterTarget(DamageTarget);
+		DamageTarget = InvalidSimAgent;
+	}
 
-		if(bBackToBaseLocation)
-		{
-			if((NewLocation - BaseLocation).SizeSquared2D() < DistanceSquared)
-			{
-				DistanceSquared = (NewLocation - BaseLocation).SizeSquared2D();
-			}else
-			{
-				CurrentVelocity = FVector::ZeroVector;
-				DistanceSquared = BIG_NUMBER;
-				bBackToBaseLocation = false;
-
-				SetNewRotation(GetActorForwardVector(), GetActorLocation());
-			}
-		}
+	Super::EndPlay(EndPlayReason);
+}
 
-		SetActorLocation(NewLocation);
+void AEnemy::OnTakenFromPool()
+{
+	Health = GetClass()->GetDefaultObject<AEnemy>()->Health;
+	BaseLocation = GetActorLocation();
+	bCanAttackPlayer = false;
+	CurrentVelocity = FVector::ZeroVector;
+
+	// Join the batched enemy movement again
+	if(MovementSubsystem && MovementAgent == InvalidSimAgent)
+	{
+		MovementAgent = MovementSubsystem->RegisterEnemy(this);
 	}
+	if(DamageSubsystem && DamageTarget == InvalidSimAgent)
+	{
+		DamageTarget = DamageSubsystem->RegisterTarget(this);
+	}
+}
 
+void AEnemy::OnReturnedToPool()
+{
+	// Hidden enemies neither move nor see nor take damage
+	if(MovementSubsystem && MovementAgent != InvalidSimAgent)
+	{
+		MovementSubsystem->UnregisterEnemy(MovementAgent);
+		MovementAgent = InvalidSimAgent;
+	}
+	if(DamageSubsystem && DamageTarget != InvalidSimAgent)
+	{
+		DamageSubsystem->UnregisterTarget(DamageTarget);
+		DamageTarget = InvalidSimAgent;
+	}
+
+	// Come back with the mesh on the capsule
+	if(bMeshInterpolated)
+	{
+		GetMesh()->SetRelativeLocation(GetBaseTranslationOffset());
+		bMeshInterpolated = false;
+	}
 }
 
 // Called to bind functionality to input
@@ -113,6 +133,11 @@ void AEnemy::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveC
 	{
 		bCanAttackPlayer = true;
 		CurrentVelocity = FVector::ZeroVector;
+		if(MovementSubsystem && MovementAgent != InvalidSimAgent)
+		{
+			MovementSubsystem->StopEnemy(MovementAgent);
+			MovementSubsystem->SetEnemyAttacking(MovementAgent, true);
+		}
 	}
 }
 
@@ -123,52 +148,42 @@ void AEnemy::OnHitEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherAct
 	if(Cast<AFPS_Game_SimulationCharacter>(OtherActor))
 	{
 		bCanAttackPlayer = false;
+		if(MovementSubsystem && MovementAgent != InvalidSimAgent)
+		{
+			MovementSubsystem->SetEnemyAttacking(MovementAgent, false);
+		}
 	}
 	
 }
 
-void AEnemy::OnSensed(const TArray<AActor*>& UpdatedActors)
+void AEnemy::OnSightGained(const FVector& TargetLocation, const FVector& NewVelocity)
 {
-	for(int i=0; i<UpdatedActors.Num(); ++i)
-	{
-		// Get info about sensed actor
-		FActorPerceptionBlueprintInfo Info;
-		AIPerceptionComponent->GetActorsPerception(UpdatedActors[i], Info);
+	// Chasing unless attacking, the movement core already decided
+	CurrentVelocity = NewVelocity;
 
-		if (Info.LastSensedStimuli[0].WasSuccessfullySensed())
-		{
-			if(Cast<AFPS_Game_SimulationCharacter>(UpdatedActors[i]))
-			{
-				// Getting the direction between enemy and player
-				FVector Direction = UpdatedActors[i]->GetActorLocation() - GetActorLocation(); // Found actor location - enemy location
-				Direction.Z = 0.f;
-				
-				if(!bCanAttackPlayer)
-				{
-					CurrentVelocity = Direction.GetSafeNormal() * MovementSpeed;
-				}
-
-				// Turn to the player
-				SetNewRotation(UpdatedActors[i]->GetActorLocation(), GetActorLocation());
-			}
-		}else
-		{
-			// Get back to base location
-			FVector Direction = BaseLocation - GetActorLocation();
-			Direction.Z = 0.f;
+	// Turn to the player
+	SetNewRotation(TargetLocation, GetActorLocation());
+}
 
-			if(Direction.SizeSquared2D() > 1.f)
-			{
-				CurrentVelocity = Direction.GetSafeNormal() * MovementSpeed;
-				bBackToBaseLocation = true;
+void AEnemy::OnSightLost(const FVector& NewVelocity)
+{
+	// Get back to base location, zero if already there
+	CurrentVelocity = NewVelocity;
 
-				SetNewRotation(BaseLocation, GetActorLocation());
-			}
-		}
-		
+	if(!CurrentVelocity.IsZero())
+	{
+		SetNewRotation(BaseLocation, GetActorLocation());
 	}
 }
 
+void AEnemy::OnTurned(const FVector& NewVelocity)
+{
+	CurrentVelocity = NewVelocity;
+
+	// Look where the path goes
+	SetNewRotation(GetActorLocation() + NewVelocity, GetActorLocation());
+}
+
 void AEnemy::SetNewRotation(FVector TargetPosition, FVector CurrentPosition)
 {
 	FVector NewDirection = TargetPosition - CurrentPosition;
@@ -177,25 +192,83 @@ void AEnemy::SetNewRotation(FVector TargetPosition, FVector CurrentPosition)
 	EnemyRotation = NewDirection.Rotation();
 
 	SetActorRotation(EnemyRotation);
+
+	// Sight checks look where enemy looks
+	if(MovementSubsystem && MovementAgent != InvalidSimAgent)
+	{
+		MovementSubsystem->SetEnemyFacing(MovementAgent, EnemyRotation.Vector());
+	}
+}
+
+void AEnemy::OnReturnedToBaseLocation()
+{
+	CurrentVelocity = FVector::ZeroVector;
+
+	SetNewRotation(GetActorForwardVector(), GetActorLocation());
+}
+
+void AEnemy::SetSimulatedLocation(const FVector& Location)
+{
+	SetActorLocation(Location);
+
+	if(bMeshInterpolated)
+	{
+		GetMesh()->SetRelativeLocation(GetBaseTranslationOffset());
+		bMeshInterpolated = false;
+	}
+}
+
+void AEnemy::SetInterpolatedLocation(const FVector& Location)
+{
+	const FVector Offset = Location - GetActorLocation();
+
+	// Standing where the capsule is, nothing to interpolate
+	if(Offset.IsNearlyZero())
+	{
+		if(bMeshInterpolated)
+		{
+			GetMesh()->SetRelativeLocation(GetBaseTranslationOffset());
+			bMeshInterpolated = false;
+		}
+		return;
+	}
+
+	GetMesh()->SetRelativeLocation(GetBaseTranslationOffset() + GetActorQuat().UnrotateVector(Offset));
+	bMeshInterpolated = true;
 }
 
 void AEnemy::DealDamage(float DamageAmount)
 {
+	if(DamageSubsystem && DamageTarget != InvalidSimAgent)
+	{
+		DamageSubsystem->QueueDamage(DamageTarget, DamageAmount);
+		return;
+	}
+
+	// Not registered, take it at once
 	Health -= DamageAmount;
 
 	if(Health <= 0.f)
 	{
-		// Spawn next enemy
-		if(Spawner)
-			Spawner->TrigSpawnerWithTimer(SpawnRate);
-
 		// Make character gain XP
 		if(Character)
 		{
-			Character->TrigToGainXP();
-			Character->IncrementKillScore();
+			Character->GainKillRewards(1);
 		}
-		
+
+		OnKilled();
+	}
+}
+
+void AEnemy::OnKilled()
+{
+	// Spawn next enemy
+	if(Spawner)
+		Spawner->TrigSpawnerWithTimer(SpawnRate);
+
+	// Pooling spawners hide the enemy for the next spawn
+	if(!Spawner || !Spawner->ReturnToPool(this))
+	{
 		Destroy();
 	}
 }
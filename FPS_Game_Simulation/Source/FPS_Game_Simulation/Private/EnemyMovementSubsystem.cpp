@@ -0,0 +1,273 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemyMovementSubsystem.h"
+
+#include "Enemy.h"
+#include "Async/ParallelFor.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "FPS_Game_Simulation/FPS_Game_SimulationCharacter.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Movement"), STAT_EnemyMovement, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Enemy Sight"), STAT_EnemySight, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Enemy Flow Field"), STAT_EnemyFlowField, STATGROUP_Game);
+
+void UEnemyMovementSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Enemies only chase players they see, paths much longer than the sight radius are never walked
+	FFlowFieldConfig FlowFieldConfig;
+	FlowFieldConfig.MaxPathLength = 4.f * SightConfig.SightRadius;
+	FlowField.SetConfig(FlowFieldConfig);
+}
+
+void UEnemyMovementSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_EnemyMovement);
+
+	GatherPlayers();
+	UpdateFlowField();
+
+	// Move every enemy due this frame at once
+	StepMovement(DeltaTime);
+
+	// Then see where they are now
+	UpdateSight(DeltaTime);
+
+	// Chasers go around obstacles instead of straight at the player
+	MovementCore.FollowFlowField(FlowField);
+
+	// Sync transforms and state of the ones something happened to
+	for (int32 Index = 0; Index < MovementCore.Num(); ++Index)
+	{
+		const uint32 Flags = MovementCore.FlagsAt(Index);
+		const bool bInterpolate = !(Flags & FEnemyMovementCore::Moved) && Significance.IsInViewAt(Index)
+			&& Significance.PendingTimeAt(Index) > 0.f;
+		if (!(Flags & FEnemyMovementCore::EventFlags) && !bInterpolate)
+		{
+			continue;
+		}
+
+		AEnemy* Enemy = Enemies[MovementCore.AgentAt(Index)];
+		if (!Enemy)
+		{
+			continue;
+		}
+
+		if (Flags & FEnemyMovementCore::Moved)
+		{
+			Enemy->SetSimulatedLocation(ToVector(MovementCore.LocationAt(Index)));
+		}
+		else if (bInterpolate)
+		{
+			// Skipped this frame, show it where it would be by now
+			const FSimVector Velocity = MovementCore.VelocityAt(Index);
+			Enemy->SetInterpolatedLocation(
+				ToVector(MovementCore.LocationAt(Index) + Velocity * Significance.PendingTimeAt(Index)));
+		}
+
+		if (Flags & FEnemyMovementCore::ReturnedToBase)
+		{
+			Enemy->OnReturnedToBaseLocation();
+		}
+
+		if (Flags & FEnemyMovementCore::SightGained)
+		{
+			const AActor* Target = SightTargets[MovementCore.SightTargetAt(Index)];
+			Enemy->OnSightGained(Target->GetActorLocation(), ToVector(MovementCore.VelocityAt(Index)));
+		}
+		else if (Flags & FEnemyMovementCore::SightLost)
+		{
+			Enemy->OnSightLost(ToVector(MovementCore.VelocityAt(Index)));
+		}
+		else if (Flags & FEnemyMovementCore::Turned)
+		{
+			Enemy->OnTurned(ToVector(MovementCore.VelocityAt(Index)));
+		}
+	}
+}
+
+TStatId UEnemyMovementSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyMovementSubsystem, STATGROUP_Tickables);
+}
+
+FSimAgentId UEnemyMovementSubsystem::RegisterEnemy(AEnemy* Enemy)
+{
+	const FSimAgentId Agent = MovementCore.Add(ToSimVector(Enemy->GetActorLocation()), ToSimVector(Enemy->BaseLocation),
+		Enemy->MovementSpeed);
+	MovementCore.SetFacing(Agent, ToSimVector(Enemy->GetActorForwardVector()));
+	Significance.Add();
+
+	if (Enemies.Num() <= Agent)
+	{
+		Enemies.SetNum(Agent + 1);
+	}
+	Enemies[Agent] = Enemy;
+
+	return Agent;
+}
+
+void UEnemyMovementSubsystem::UnregisterEnemy(FSimAgentId Agent)
+{
+	Significance.RemoveAtSwap(MovementCore.IndexOf(Agent));
+	MovementCore.Remove(Agent);
+	Enemies[Agent] = nullptr;
+}
+
+void UEnemyMovementSubsystem::MoveEnemy(FSimAgentId Agent, const FVector& Location, const FVector& Velocity)
+{
+	MovementCore.Move(Agent, ToSimVector(Location), ToSimVector(Velocity));
+}
+
+void UEnemyMovementSubsystem::StopEnemy(FSimAgentId Agent)
+{
+	MovementCore.Stop(Agent);
+}
+
+bool UEnemyMovementSubsystem::ReturnEnemyToBase(FSimAgentId Agent, const FVector& Location)
+{
+	return MovementCore.ReturnToBase(Agent, ToSimVector(Location));
+}
+
+void UEnemyMovementSubsystem::SetEnemyAttacking(FSimAgentId Agent, bool bAttacking)
+{
+	MovementCore.SetAttacking(Agent, bAttacking);
+}
+
+void UEnemyMovementSubsystem::SetEnemyFacing(FSimAgentId Agent, const FVector& Direction)
+{
+	MovementCore.SetFacing(Agent, ToSimVector(Direction));
+}
+
+void UEnemyMovementSubsystem::AddObstacle(const FBox& Box)
+{
+	FlowField.BlockBox(Box.Min.X, Box.Min.Y, Box.Max.X, Box.Max.Y);
+}
+
+void UEnemyMovementSubsystem::RemoveObstacle(const FBox& Box)
+{
+	FlowField.UnblockBox(Box.Min.X, Box.Min.Y, Box.Max.X, Box.Max.Y);
+}
+
+bool UEnemyMovementSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEnemyMovementSubsystem::GatherPlayers()
+{
+	// Enemies only care about player characters
+	SightTargets.Reset();
+	SightTargetLocations.clear();
+	Viewers.clear();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		AActor* Player = PlayerController ? Cast<AFPS_Game_SimulationCharacter>(PlayerController->GetPawn()) : nullptr;
+		if (Player)
+		{
+			SightTargets.Add(Player);
+			SightTargetLocations.push_back(ToSimVector(Player->GetActorLocation()));
+
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+			FSignificanceViewer Viewer;
+			Viewer.Location = ToSimVector(ViewLocation);
+			Viewer.Forward = ToSimVector(ViewRotation.Vector());
+			if (PlayerController->PlayerCameraManager)
+			{
+				Viewer.HalfFieldOfViewDegrees = PlayerController->PlayerCameraManager->GetFOVAngle() / 2.f;
+			}
+			Viewers.push_back(Viewer);
+		}
+	}
+}
+
+void UEnemyMovementSubsystem::UpdateFlowField()
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyFlowField);
+
+	FlowField.Update(SightTargetLocations, [](int32_t NumTasks, const std::function<void(int32_t)>& Body)
+	{
+		ParallelFor(NumTasks, [&Body](int32 Task)
+		{
+			Body(Task);
+		});
+	});
+}
+
+void UEnemyMovementSubsystem::StepMovement(float DeltaTime)
+{
+	// The observer columns are the enemy locations
+	const FSightObservers Locations = MovementCore.GetSightObservers();
+	Significance.UpdateBuckets(Locations.X, Locations.Y, Locations.Z, Viewers);
+
+	AgentDeltaTimes.resize(MovementCore.Num());
+	Significance.Schedule(DeltaTime, AgentDeltaTimes.data());
+	MovementCore.Step(AgentDeltaTimes.data());
+}
+
+void UEnemyMovementSubsystem::UpdateSight(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemySight);
+
+	VisibleTargets.resize(MovementCore.Num());
+	SightQuery.Query(MovementCore.GetSightObservers(), SightTargetLocations, VisibleTargets.data());
+
+	// New sightings are traced at once. A player who is already seen is traced again once the last trace is older than
+	// the sight max age, a wall between them then loses the player like leaving the sight cone does.
+	for (int32 Index = 0; Index < MovementCore.Num(); ++Index)
+	{
+		const int32 Target = VisibleTargets[Index];
+		if (Target == FSightQueryCore::NoTarget)
+		{
+			continue;
+		}
+
+		const bool bSeen = Target == MovementCore.SightTargetAt(Index);
+		if (bSeen && MovementCore.SightConfirmedAgeAt(Index) <= SightConfig.MaxAge)
+		{
+			continue;
+		}
+
+		const AEnemy* Enemy = Enemies[MovementCore.AgentAt(Index)];
+		if (!Enemy || !HasLineOfSight(Enemy, SightTargets[Target]))
+		{
+			VisibleTargets[Index] = FSightQueryCore::NoTarget;
+		}
+		else if (bSeen)
+		{
+			MovementCore.ConfirmSightAt(Index);
+		}
+	}
+
+	MovementCore.ApplySight(VisibleTargets.data(), SightTargetLocations, DeltaTime, SightConfig.MaxAge);
+}
+
+bool UEnemyMovementSubsystem::HasLineOfSight(const AEnemy* Enemy, const AActor* Target) const
+{
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(EnemySight), true, Enemy);
+	FHitResult HitResult;
+	const bool bHit = GetWorld()->LineTraceSingleByChannel(HitResult, Enemy->GetPawnViewLocation(),
+		Target->GetActorLocation(), ECC_Visibility, QueryParams);
+
+	return !bHit || HitResult.GetActor() == Target;
+}
+
+FSimVector UEnemyMovementSubsystem::ToSimVector(const FVector& Vector)
+{
+	return FSimVector(static_cast<float>(Vector.X), static_cast<float>(Vector.Y), static_cast<float>(Vector.Z));
+}
+
+FVector UEnemyMovementSubsystem::ToVector(const FSimVector& Vector)
+{
+	return FVector(Vector.X, Vector.Y, Vector.Z);
+}
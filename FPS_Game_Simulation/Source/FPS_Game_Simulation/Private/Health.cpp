@@ -3,17 +3,19 @@
 
 #include "Health.h"
 
+#include "PickupSubsystem.h"
 #include "Spawner.h"
+#include "SpawnerRegistrySubsystem.h"
 #include "Components/BoxComponent.h"
 #include "Components/SphereComponent.h"
+#include "Engine/CollisionProfile.h"
 #include "FPS_Game_Simulation/FPS_Game_SimulationCharacter.h"
-#include "Kismet/GameplayStatics.h"
 
 // Sets default values
 AHealth::AHealth()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+ 	// Players are checked against all pickups at once by UPickupSubsystem, nothing to tick
+	PrimaryActorTick.bCanEverTick = false;
 
 	Mesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Health Mesh"));
 	SetRootComponent(Mesh);
@@ -23,7 +25,8 @@ AHealth::AHealth()
 
 	InteractSphereComponent = CreateDefaultSubobject<USphereComponent>(TEXT("Sphere Comp"));
 	InteractSphereComponent->SetupAttachment(Mesh);
-	InteractSphereComponent->OnComponentBeginOverlap.AddDynamic(this, &AHealth::OnSphereBeginOverlap);
+	InteractSphereComponent->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+	InteractSphereComponent->SetGenerateOverlapEvents(false);
 
 	
 }
@@ -34,48 +37,69 @@ void AHealth::BeginPlay()
 	Super::BeginPlay();
 
 	// Setting health spawner
-	TArray<AActor*> FoundSpawners;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), ASpawner::StaticClass(), FoundSpawners);
-	for (AActor* FoundSpawner : FoundSpawners)
-	{
-		if(FoundSpawner && FoundSpawner->ActorHasTag(TEXT("HealthSpawner")))
-		{
-			Spawner = Cast<ASpawner>(FoundSpawner);
-		}
-	}
+	Spawner = USpawnerRegistrySubsystem::FindSpawnerOf(this, TEXT("HealthSpawner"));
+
+	// Let players reach this health
+	PickupSubsystem = GetWorld()->GetSubsystem<UPickupSubsystem>();
+	RegisterPickup();
 	
 }
 
-// Called every frame
-void AHealth::Tick(float DeltaTime)
+void AHealth::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
+	UnregisterPickup();
 
+	Super::EndPlay(EndPlayReason);
 }
 
-void AHealth::OnSphereBeginOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
-	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void AHealth::OnTakenFromPool()
 {
-	Character = Cast<AFPS_Game_SimulationCharacter>(OtherActor);
-	
-	// If character is valid & health is under 100
-	if(Character && Character->GetCurrentHealth() <= 100)
+	RegisterPickup();
+}
+
+void AHealth::OnReturnedToPool()
+{
+	UnregisterPickup();
+}
+
+void AHealth::RegisterPickup()
+{
+	if(PickupSubsystem && PickupId == InvalidSimAgent)
 	{
-		// Checking if character needs the health or not
-		float CharacterHealth = Character->GetCurrentHealth();
-		if(CharacterHealth + HealthAmount > 100)
-		{
-			Character->SetCurrentHealth(Character->GetMaxHealth());
-		}else
-		{
-			Character->SetCurrentHealth(CharacterHealth+HealthAmount);
-		}
+		PickupId = PickupSubsystem->RegisterPickup(this, InteractSphereComponent->GetScaledSphereRadius());
+	}
+}
+
+void AHealth::UnregisterPickup()
+{
+	if(PickupSubsystem && PickupId != InvalidSimAgent)
+	{
+		PickupSubsystem->UnregisterPickup(PickupId);
+		PickupId = InvalidSimAgent;
+	}
+}
+
+void AHealth::OnReachedBy(AFPS_Game_SimulationCharacter* Character)
+{
+	if(!Character)
+	{
+		return;
+	}
+
+	// Heal up to max health
+	const FHealthPickupResult Result = ResolveHealthPickup(Character->GetCurrentHealth(), Character->GetMaxHealth(),
+		HealthAmount);
+	if(Result.bConsumed)
+	{
+		Character->SetCurrentHealth(Result.NewHealth);
 
 		// Spawn again
 		if (Spawner)
 			Spawner->TrigSpawnerWithTimer(SpawnRate);
 		
-		Destroy();
+		if(!Spawner || !Spawner->ReturnToPool(this))
+		{
+			Destroy();
+		}
 	}
 }
-
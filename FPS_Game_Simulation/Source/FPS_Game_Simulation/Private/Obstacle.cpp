@@ -3,14 +3,15 @@
 
 #include "Obstacle.h"
 
+#include "EnemyMovementSubsystem.h"
 #include "Engine/DamageEvents.h"
 #include "Kismet/GameplayStatics.h"
 
 // Sets default values
 AObstacle::AObstacle()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+ 	// Obstacles only react to hits, nothing to tick
+	PrimaryActorTick.bCanEverTick = false;
 
 	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
 
@@ -22,9 +23,32 @@ void AObstacle::BeginPlay()
 	Super::BeginPlay();
 
 	FPSCharacter = Cast<AFPS_Game_SimulationCharacter>(UGameplayStatics::GetPlayerCharacter(this, 0));
+
+	// Chasing enemies walk around obstacles
+	if(UEnemyMovementSubsystem* MovementSubsystem = GetWorld()->GetSubsystem<UEnemyMovementSubsystem>())
+	{
+		BlockedBox = GetComponentsBoundingBox();
+		MovementSubsystem->AddObstacle(BlockedBox);
+		bBlocksFlowField = true;
+	}
 	
 }
 
+void AObstacle::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// A destroyed obstacle no longer stands in the way
+	if(bBlocksFlowField)
+	{
+		if(UEnemyMovementSubsystem* MovementSubsystem = GetWorld()->GetSubsystem<UEnemyMovementSubsystem>())
+		{
+			MovementSubsystem->RemoveObstacle(BlockedBox);
+		}
+		bBlocksFlowField = false;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AObstacle::NotifyHit(UPrimitiveComponent* MyComp, AActor* Other, UPrimitiveComponent* OtherComp, bool bSelfMoved,
 	FVector HitLocation, FVector HitNormal, FVector NormalImpulse, const FHitResult& Hit)
 {
@@ -37,10 +61,3 @@ void AObstacle::NotifyHit(UPrimitiveComponent* MyComp, AActor* Other, UPrimitive
 	}
 }
 
-// Called every frame
-void AObstacle::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-
-}
-
@@ -0,0 +1,89 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PickupSubsystem.h"
+
+#include "Ammo.h"
+#include "Health.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "FPS_Game_Simulation/FPS_Game_SimulationCharacter.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Pickups"), STAT_Pickups, STATGROUP_Game);
+
+void UPickupSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_Pickups);
+
+	// Only player characters pick things up
+	Players.Reset();
+	PlayerCapsules.clear();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		AFPS_Game_SimulationCharacter* Player =
+			PlayerController ? Cast<AFPS_Game_SimulationCharacter>(PlayerController->GetPawn()) : nullptr;
+		if (Player)
+		{
+			const FVector Location = Player->GetActorLocation();
+			FPickupPlayer Capsule;
+			Capsule.Location = FSimVector(static_cast<float>(Location.X), static_cast<float>(Location.Y),
+				static_cast<float>(Location.Z));
+			Capsule.Radius = Player->GetCapsuleComponent()->GetScaledCapsuleRadius();
+			Capsule.HalfHeight = Player->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+
+			Players.Add(Player);
+			PlayerCapsules.push_back(Capsule);
+		}
+	}
+
+	PickupGrid.Query(PlayerCapsules.data(), static_cast<int32>(PlayerCapsules.size()), Contacts);
+
+	// Pickups may unregister while handled, e.g. when picked up for good
+	for (const FPickupContact& Contact : Contacts)
+	{
+		AActor* Pickup = Pickups[Contact.Pickup];
+		if (AAmmo* Ammo = Cast<AAmmo>(Pickup))
+		{
+			Ammo->OnReachedBy(Players[Contact.Player]);
+		}
+		else if (AHealth* Health = Cast<AHealth>(Pickup))
+		{
+			Health->OnReachedBy(Players[Contact.Player]);
+		}
+	}
+}
+
+TStatId UPickupSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPickupSubsystem, STATGROUP_Tickables);
+}
+
+FSimAgentId UPickupSubsystem::RegisterPickup(AActor* Pickup, float Radius)
+{
+	const FVector Location = Pickup->GetActorLocation();
+	const FSimAgentId Id = PickupGrid.Add(FSimVector(static_cast<float>(Location.X), static_cast<float>(Location.Y),
+		static_cast<float>(Location.Z)), Radius);
+
+	if (Pickups.Num() <= Id)
+	{
+		Pickups.SetNum(Id + 1);
+	}
+	Pickups[Id] = Pickup;
+
+	return Id;
+}
+
+void UPickupSubsystem::UnregisterPickup(FSimAgentId Pickup)
+{
+	PickupGrid.Remove(Pickup);
+	Pickups[Pickup] = nullptr;
+}
+
+bool UPickupSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Simulation/DamageQueueCore.h"
+
+namespace
+{
+	// Subtracts each target's damage of the frame and flags the ones it took to zero. Health is written while Damage is
+	// read, only __restrict tells the compiler the two don't overlap so it processes several targets per instruction.
+	void TakeDamage(int32_t Count, const float* __restrict Damage, float* __restrict Health,
+		uint8_t* __restrict KillMask)
+	{
+		for (int32_t I = 0; I < Count; ++I)
+		{
+			const float Before = Health[I];
+			const float After = Before - Damage[I];
+			Health[I] = After;
+			KillMask[I] = static_cast<uint8_t>((Before > 0.f) & (After <= 0.f));
+		}
+	}
+}
+
+FSimAgentId FDamageQueueCore::AddTarget()
+{
+	const FSimAgentId Target = Index.Add();
+	if (static_cast<int32_t>(Pending.size()) <= Target)
+	{
+		Pending.resize(Target + 1);
+	}
+	return Target;
+}
+
+void FDamageQueueCore::RemoveTarget(FSimAgentId Target)
+{
+	Index.Remove(Target);
+
+	// The id may be reused before the next Resolve, the damage queued so far isn't for the new target
+	PendingStats.NumDropped += Pending[Target].NumEvents;
+	Pending[Target] = FPending();
+}
+
+void FDamageQueueCore::Reserve(int32_t NumTargetsToReserve)
+{
+	Index.Reserve(NumTargetsToReserve);
+	Pending.reserve(NumTargetsToReserve);
+}
+
+uint32_t FDamageQueueCore::NewShot()
+{
+	// Skips NoShot when wrapping around
+	++LastShot;
+	if (LastShot == NoShot)
+	{
+		++LastShot;
+	}
+	return LastShot;
+}
+
+int32_t FDamageQueueCore::Resolve()
+{
+	const int32_t NumIds = static_cast<int32_t>(Pending.size());
+
+	// Every target with damage is hit, branch-free compaction as in FSignificanceCore::Schedule
+	HitTarget.resize(NumIds);
+	int32_t NumHitTargets = 0;
+	for (int32_t Target = 0; Target < NumIds; ++Target)
+	{
+		HitTarget[NumHitTargets] = Target;
+		NumHitTargets += Pending[Target].NumEvents != 0;
+	}
+	HitTarget.resize(NumHitTargets);
+
+	HitDamage.resize(NumHitTargets);
+	HitInstigator.resize(NumHitTargets);
+	HitHealth.assign(NumHitTargets, 0.f);
+	for (int32_t Hit = 0; Hit < NumHitTargets; ++Hit)
+	{
+		FPending& TargetPending = Pending[HitTarget[Hit]];
+		HitDamage[Hit] = TargetPending.Damage;
+		HitInstigator[Hit] = TargetPending.Instigator;
+		TargetPending = FPending();
+	}
+
+	// The queue starts over
+	Stats = PendingStats;
+	Stats.NumHits = NumHitTargets;
+	PendingStats = FDamageQueueStats();
+
+	return NumHitTargets;
+}
+
+int32_t FDamageQueueCore::ApplyHits()
+{
+	const int32_t Count = NumHits();
+
+	KillMask.resize(Count);
+	TakeDamage(Count, HitDamage.data(), HitHealth.data(), KillMask.data());
+
+	Kills.resize(Count);
+	int32_t NumKills = 0;
+	for (int32_t Hit = 0; Hit < Count; ++Hit)
+	{
+		Kills[NumKills] = Hit;
+		NumKills += KillMask[Hit];
+	}
+	Kills.resize(NumKills);
+
+	Stats.NumKills = NumKills;
+	return NumKills;
+}
@@ -0,0 +1,312 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Simulation/EffectCore.h"
+
+#include <algorithm>
+#include <cmath>
+
+FEffectCore::FEffectCore(const FEffectConfig& InConfig)
+	: Config(InConfig)
+	, Sum(InConfig.NumStats)
+	, Product(InConfig.NumStats)
+	, OverrideValue(InConfig.NumStats)
+	, OverrideApplied(InConfig.NumStats)
+{
+}
+
+FEffectSpecId FEffectCore::AddSpec(const FEffectSpec& Spec)
+{
+	Specs.push_back(Spec);
+	SpecTicks.push_back(Spec.Duration > 0.f
+		? std::max(1u, static_cast<uint32_t>(std::ceil(Spec.Duration / Config.TickSeconds)))
+		: 0u);
+	return static_cast<FEffectSpecId>(Specs.size()) - 1;
+}
+
+FSimAgentId FEffectCore::AddOwner(const float* InBaseStats)
+{
+	const FSimAgentId Owner = Index.Add();
+	if (static_cast<int32_t>(NumEffectsOf.size()) <= Owner)
+	{
+		BaseStats.resize((Owner + 1) * Config.NumStats);
+		Stats.resize((Owner + 1) * Config.NumStats);
+		Slots.resize((Owner + 1) * Config.EffectsPerOwner);
+		NumEffectsOf.resize(Owner + 1, 0);
+		DirtyMask.resize(Owner + 1, 0);
+		Wheel.Reserve((Owner + 1) * Config.EffectsPerOwner);
+	}
+
+	std::copy(InBaseStats, InBaseStats + Config.NumStats, BaseStats.begin() + Owner * Config.NumStats);
+	std::copy(InBaseStats, InBaseStats + Config.NumStats, Stats.begin() + Owner * Config.NumStats);
+	return Owner;
+}
+
+void FEffectCore::RemoveOwner(FSimAgentId Owner)
+{
+	const int32_t First = Owner * Config.EffectsPerOwner;
+	for (int32_t Slot = First; Slot < First + Config.EffectsPerOwner; ++Slot)
+	{
+		if (Slots[Slot].Spec != NoSpec)
+		{
+			FreeSlot(Slot);
+		}
+	}
+
+	// Left in DirtyOwners if it is, Update skips it or recomputes the owner that reuses the id
+	Index.Remove(Owner);
+}
+
+void FEffectCore::Reserve(int32_t NumOwnersToReserve)
+{
+	Index.Reserve(NumOwnersToReserve);
+	BaseStats.reserve(NumOwnersToReserve * Config.NumStats);
+	Stats.reserve(NumOwnersToReserve * Config.NumStats);
+	Slots.reserve(NumOwnersToReserve * Config.EffectsPerOwner);
+	NumEffectsOf.reserve(NumOwnersToReserve);
+	DirtyMask.reserve(NumOwnersToReserve);
+	Wheel.Reserve(NumOwnersToReserve * Config.EffectsPerOwner);
+}
+
+void FEffectCore::SetBaseStat(FSimAgentId Owner, int32_t Stat, float Value)
+{
+	float& BaseStat = BaseStats[Owner * Config.NumStats + Stat];
+	if (BaseStat != Value)
+	{
+		BaseStat = Value;
+		MarkDirty(Owner);
+	}
+}
+
+bool FEffectCore::Apply(FSimAgentId Owner, FEffectSpecId Spec)
+{
+	if (!Index.IsValid(Owner))
+	{
+		return false;
+	}
+
+	const FEffectSpec& EffectSpec = Specs[Spec];
+	const uint32_t Ticks = SpecTicks[Spec];
+	const int32_t First = Owner * Config.EffectsPerOwner;
+
+	// The owner's instances of the spec, the one expiring first, and a free slot
+	int32_t NumFound = 0;
+	int32_t Earliest = -1;
+	uint32_t EarliestDelay = 0;
+	int32_t Free = -1;
+	for (int32_t Slot = First; Slot < First + Config.EffectsPerOwner; ++Slot)
+	{
+		if (Slots[Slot].Spec == Spec)
+		{
+			++NumFound;
+			const uint32_t Delay = Ticks > 0 ? Wheel.DueTickOf(Slot) - Wheel.Now() : 0u;
+			if (Earliest < 0 || Delay < EarliestDelay)
+			{
+				Earliest = Slot;
+				EarliestDelay = Delay;
+			}
+		}
+		else if (Slots[Slot].Spec == NoSpec && Free < 0)
+		{
+			Free = Slot;
+		}
+	}
+
+	const int32_t MaxInstances = EffectSpec.Stacking == EEffectStacking::Stack ? std::max(1, EffectSpec.MaxStacks) : 1;
+	if (NumFound >= MaxInstances)
+	{
+		if (Ticks > 0)
+		{
+			Wheel.Schedule(Earliest, Wheel.Now() + Ticks);
+		}
+
+		// Restarting an override makes it the most recent one
+		Slots[Earliest].Applied = ++NumApplications;
+		if (EffectSpec.Modifier == EEffectModifier::Override)
+		{
+			MarkDirty(Owner);
+		}
+		++PendingStats.NumRefreshed;
+		return true;
+	}
+
+	if (Free < 0)
+	{
+		++PendingStats.NumRefused;
+		return false;
+	}
+
+	Slots[Free].Spec = Spec;
+	Slots[Free].Applied = ++NumApplications;
+	if (Ticks > 0)
+	{
+		Wheel.Schedule(Free, Wheel.Now() + Ticks);
+	}
+	++NumEffectsOf[Owner];
+	++NumActive;
+	MarkDirty(Owner);
+	++PendingStats.NumApplied;
+	return true;
+}
+
+int32_t FEffectCore::Remove(FSimAgentId Owner, FEffectSpecId Spec)
+{
+	if (!Index.IsValid(Owner))
+	{
+		return 0;
+	}
+
+	int32_t NumRemoved = 0;
+	const int32_t First = Owner * Config.EffectsPerOwner;
+	for (int32_t Slot = First; Slot < First + Config.EffectsPerOwner; ++Slot)
+	{
+		if (Slots[Slot].Spec == Spec)
+		{
+			FreeSlot(Slot);
+			++NumRemoved;
+		}
+	}
+
+	if (NumRemoved > 0)
+	{
+		MarkDirty(Owner);
+	}
+	return NumRemoved;
+}
+
+int32_t FEffectCore::NumInstances(FSimAgentId Owner, FEffectSpecId Spec) const
+{
+	const int32_t First = Owner * Config.EffectsPerOwner;
+	return static_cast<int32_t>(std::count_if(Slots.begin() + First, Slots.begin() + First + Config.EffectsPerOwner,
+		[Spec](const FSlot& Slot) { return Slot.Spec == Spec; }));
+}
+
+float FEffectCore::GetRemainingTime(FSimAgentId Owner, FEffectSpecId Spec) const
+{
+	uint32_t Remaining = 0;
+	const int32_t First = Owner * Config.EffectsPerOwner;
+	for (int32_t Slot = First; Slot < First + Config.EffectsPerOwner; ++Slot)
+	{
+		if (Slots[Slot].Spec == Spec && Wheel.IsScheduled(Slot))
+		{
+			const uint32_t Ticks = Wheel.DueTickOf(Slot) - Wheel.Now();
+			Remaining = Remaining == 0 ? Ticks : std::min(Remaining, Ticks);
+		}
+	}
+
+	return Remaining == 0 ? 0.f : std::max(0.f, Remaining * Config.TickSeconds - PendingTime);
+}
+
+int32_t FEffectCore::Update(float DeltaTime)
+{
+	PendingTime += DeltaTime;
+	const uint32_t Ticks = static_cast<uint32_t>(PendingTime / Config.TickSeconds);
+	PendingTime -= Ticks * Config.TickSeconds;
+
+	ExpiredTimers.clear();
+	Expired.clear();
+	PendingStats.NumCascaded += Wheel.Advance(Ticks, ExpiredTimers);
+
+	// A timer is the slot of its instance
+	for (const int32_t Slot : ExpiredTimers)
+	{
+		const FSimAgentId Owner = Slot / Config.EffectsPerOwner;
+		Expired.push_back({Owner, Slots[Slot].Spec});
+		Slots[Slot].Spec = NoSpec;
+		--NumEffectsOf[Owner];
+		--NumActive;
+		MarkDirty(Owner);
+	}
+
+	ChangedOwners.clear();
+	for (const FSimAgentId Owner : DirtyOwners)
+	{
+		DirtyMask[Owner] = 0;
+		if (!Index.IsValid(Owner))
+		{
+			continue;
+		}
+
+		++PendingStats.NumRecomputed;
+		if (Recompute(Owner))
+		{
+			ChangedOwners.push_back(Owner);
+		}
+	}
+	DirtyOwners.clear();
+
+	UpdateStats = PendingStats;
+	UpdateStats.NumActive = NumActive;
+	UpdateStats.NumExpired = static_cast<int32_t>(Expired.size());
+	UpdateStats.NumChanged = static_cast<int32_t>(ChangedOwners.size());
+	PendingStats = FEffectStats();
+
+	return static_cast<int32_t>(ChangedOwners.size());
+}
+
+void FEffectCore::MarkDirty(FSimAgentId Owner)
+{
+	if (!DirtyMask[Owner])
+	{
+		DirtyMask[Owner] = 1;
+		DirtyOwners.push_back(Owner);
+	}
+}
+
+void FEffectCore::FreeSlot(int32_t Slot)
+{
+	Wheel.Cancel(Slot);
+	Slots[Slot].Spec = NoSpec;
+	--NumEffectsOf[Slot / Config.EffectsPerOwner];
+	--NumActive;
+}
+
+bool FEffectCore::Recompute(FSimAgentId Owner)
+{
+	std::fill(Sum.begin(), Sum.end(), 0.f);
+	std::fill(Product.begin(), Product.end(), 1.f);
+	std::fill(OverrideApplied.begin(), OverrideApplied.end(), 0u);
+
+	if (NumEffectsOf[Owner] > 0)
+	{
+		const int32_t First = Owner * Config.EffectsPerOwner;
+		for (int32_t Slot = First; Slot < First + Config.EffectsPerOwner; ++Slot)
+		{
+			if (Slots[Slot].Spec == NoSpec)
+			{
+				continue;
+			}
+
+			const FEffectSpec& Spec = Specs[Slots[Slot].Spec];
+			switch (Spec.Modifier)
+			{
+			case EEffectModifier::Add:
+				Sum[Spec.Stat] += Spec.Magnitude;
+				break;
+			case EEffectModifier::Multiply:
+				Product[Spec.Stat] *= Spec.Magnitude;
+				break;
+			case EEffectModifier::Override:
+				if (Slots[Slot].Applied > OverrideApplied[Spec.Stat])
+				{
+					OverrideApplied[Spec.Stat] = Slots[Slot].Applied;
+					OverrideValue[Spec.Stat] = Spec.Magnitude;
+				}
+				break;
+			}
+		}
+	}
+
+	bool bChanged = false;
+	const float* OwnerBaseStats = BaseStats.data() + Owner * Config.NumStats;
+	float* OwnerStats = Stats.data() + Owner * Config.NumStats;
+	for (int32_t Stat = 0; Stat < Config.NumStats; ++Stat)
+	{
+		const float Value = OverrideApplied[Stat] != 0
+			? OverrideValue[Stat]
+			: (OwnerBaseStats[Stat] + Sum[Stat]) * Product[Stat];
+		bChanged |= Value != OwnerStats[Stat];
+		OwnerStats[Stat] = Value;
+	}
+	return bChanged;
+}
@@ -0,0 +1,338 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Simulation/EnemyMovementCore.h"
+
+#include "Simulation/FlowFieldCore.h"
+
+#include <cmath>
+#include <initializer_list>
+#include <limits>
+
+namespace
+{
+	constexpr float FarFromBase = std::numeric_limits<float>::max();
+
+	// Restrict-qualified parameters rather than locals, compilers only take them into account there. Without them the
+	// columns might alias and the loop isn't vectorized.
+	void Integrate(int32_t Count, float DeltaTime, float* __restrict PX, float* __restrict PY, float* __restrict PZ,
+		const float* __restrict VX, const float* __restrict VY, const float* __restrict VZ, uint32_t* __restrict F)
+	{
+		constexpr uint32_t EventFlags = FEnemyMovementCore::EventFlags;
+		constexpr uint32_t Moved = FEnemyMovementCore::Moved;
+
+		// A stationary agent "moves" by zero, so every agent takes the same path
+		for (int32_t I = 0; I < Count; ++I)
+		{
+			PX[I] += VX[I] * DeltaTime;
+			PY[I] += VY[I] * DeltaTime;
+			PZ[I] += VZ[I] * DeltaTime;
+
+			const float Speed = std::fabs(VX[I]) + std::fabs(VY[I]) + std::fabs(VZ[I]);
+			F[I] = (F[I] & ~EventFlags) | (Speed != 0.f ? Moved : 0u);
+		}
+	}
+
+	// Same as above with a time step per agent
+	void IntegrateEach(int32_t Count, const float* __restrict DeltaTime, float* __restrict PX, float* __restrict PY,
+		float* __restrict PZ, const float* __restrict VX, const float* __restrict VY, const float* __restrict VZ,
+		uint32_t* __restrict F)
+	{
+		constexpr uint32_t EventFlags = FEnemyMovementCore::EventFlags;
+		constexpr uint32_t Moved = FEnemyMovementCore::Moved;
+
+		for (int32_t I = 0; I < Count; ++I)
+		{
+			PX[I] += VX[I] * DeltaTime[I];
+			PY[I] += VY[I] * DeltaTime[I];
+			PZ[I] += VZ[I] * DeltaTime[I];
+
+			const float Distance = (std::fabs(VX[I]) + std::fabs(VY[I]) + std::fabs(VZ[I])) * DeltaTime[I];
+			F[I] = (F[I] & ~EventFlags) | (Distance != 0.f ? Moved : 0u);
+		}
+	}
+}
+
+FSimAgentId FEnemyMovementCore::Add(const FSimVector& Location, const FSimVector& BaseLocation, float AgentSpeed)
+{
+	const FSimAgentId Agent = Index.Add();
+
+	LocationX.push_back(Location.X);
+	LocationY.push_back(Location.Y);
+	LocationZ.push_back(Location.Z);
+	VelocityX.push_back(0.f);
+	VelocityY.push_back(0.f);
+	VelocityZ.push_back(0.f);
+	BaseX.push_back(BaseLocation.X);
+	BaseY.push_back(BaseLocation.Y);
+	ClosestToBase.push_back(FarFromBase);
+	Speed.push_back(AgentSpeed);
+	FacingX.push_back(1.f);
+	FacingY.push_back(0.f);
+	SightTarget.push_back(FSightQueryCore::NoTarget);
+	SightAge.push_back(0.f);
+	SightConfirmedAge.push_back(0.f);
+	Flags.push_back(0);
+
+	return Agent;
+}
+
+void FEnemyMovementCore::Remove(FSimAgentId Agent)
+{
+	const int32_t Removed = Index.Remove(Agent);
+
+	SimRemoveAtSwap(LocationX, Removed);
+	SimRemoveAtSwap(LocationY, Removed);
+	SimRemoveAtSwap(LocationZ, Removed);
+	SimRemoveAtSwap(VelocityX, Removed);
+	SimRemoveAtSwap(VelocityY, Removed);
+	SimRemoveAtSwap(VelocityZ, Removed);
+	SimRemoveAtSwap(BaseX, Removed);
+	SimRemoveAtSwap(BaseY, Removed);
+	SimRemoveAtSwap(ClosestToBase, Removed);
+	SimRemoveAtSwap(Speed, Removed);
+	SimRemoveAtSwap(FacingX, Removed);
+	SimRemoveAtSwap(FacingY, Removed);
+	SimRemoveAtSwap(SightTarget, Removed);
+	SimRemoveAtSwap(SightAge, Removed);
+	SimRemoveAtSwap(SightConfirmedAge, Removed);
+	SimRemoveAtSwap(Flags, Removed);
+}
+
+void FEnemyMovementCore::Reserve(int32_t Count)
+{
+	Index.Reserve(Count);
+	for (std::vector<float>* Column : {&LocationX, &LocationY, &LocationZ, &VelocityX, &VelocityY, &VelocityZ, &BaseX,
+		&BaseY, &ClosestToBase, &Speed, &FacingX, &FacingY, &SightAge,
+		&SightConfirmedAge})
+	{
+		Column->reserve(Count);
+	}
+	SightTarget.reserve(Count);
+	Flags.reserve(Count);
+}
+
+void FEnemyMovementCore::Move(FSimAgentId Agent, const FSimVector& Location, const FSimVector& Velocity)
+{
+	MoveAt(Index.IndexOf(Agent), Location, Velocity);
+}
+
+void FEnemyMovementCore::Stop(FSimAgentId Agent)
+{
+	const int32_t I = Index.IndexOf(Agent);
+
+	VelocityX[I] = 0.f;
+	VelocityY[I] = 0.f;
+	VelocityZ[I] = 0.f;
+	ClosestToBase[I] = FarFromBase;
+	Flags[I] &= ~Returning;
+}
+
+bool FEnemyMovementCore::ReturnToBase(FSimAgentId Agent, const FSimVector& Location)
+{
+	return ReturnToBaseAt(Index.IndexOf(Agent), Location);
+}
+
+void FEnemyMovementCore::SetAttacking(FSimAgentId Agent, bool bAttacking)
+{
+	const int32_t I = Index.IndexOf(Agent);
+
+	Flags[I] = bAttacking ? Flags[I] | Attacking : Flags[I] & ~Attacking;
+}
+
+void FEnemyMovementCore::SetFacing(FSimAgentId Agent, const FSimVector& Direction)
+{
+	FaceAt(Index.IndexOf(Agent), Direction.X, Direction.Y);
+}
+
+void FEnemyMovementCore::Step(float DeltaTime)
+{
+	Integrate(Num(), DeltaTime, LocationX.data(), LocationY.data(), LocationZ.data(), VelocityX.data(),
+		VelocityY.data(), VelocityZ.data(), Flags.data());
+	StopAtBase();
+}
+
+void FEnemyMovementCore::Step(const float* AgentDeltaTime)
+{
+	IntegrateEach(Num(), AgentDeltaTime, LocationX.data(), LocationY.data(), LocationZ.data(), VelocityX.data(),
+		VelocityY.data(), VelocityZ.data(), Flags.data());
+	StopAtBase();
+}
+
+void FEnemyMovementCore::StopAtBase()
+{
+	const int32_t Count = Num();
+
+	// Only the few agents heading back to base check their distance, a scan of the flags column is cheap next to
+	// the integration above
+	for (int32_t I = 0; I < Count; ++I)
+	{
+		if ((Flags[I] & (Returning | Moved)) != (Returning | Moved))
+		{
+			continue;
+		}
+
+		const float ToBaseX = LocationX[I] - BaseX[I];
+		const float ToBaseY = LocationY[I] - BaseY[I];
+		const float DistanceSquared = ToBaseX * ToBaseX + ToBaseY * ToBaseY;
+		if (DistanceSquared < ClosestToBase[I])
+		{
+			ClosestToBase[I] = DistanceSquared;
+		}
+		else
+		{
+			// Went past the base location, stop there
+			VelocityX[I] = 0.f;
+			VelocityY[I] = 0.f;
+			VelocityZ[I] = 0.f;
+			ClosestToBase[I] = FarFromBase;
+			Flags[I] = (Flags[I] & ~Returning) | ReturnedToBase;
+		}
+	}
+}
+
+FSightObservers FEnemyMovementCore::GetSightObservers() const
+{
+	FSightObservers Observers;
+	Observers.Num = Num();
+	Observers.X = LocationX.data();
+	Observers.Y = LocationY.data();
+	Observers.Z = LocationZ.data();
+	Observers.FacingX = FacingX.data();
+	Observers.FacingY = FacingY.data();
+	return Observers;
+}
+
+void FEnemyMovementCore::ApplySight(const int32_t* VisibleTarget, const std::vector<FSimVector>& Targets, float Elapsed,
+	float MaxAge)
+{
+	for (int32_t I = 0; I < Num(); ++I)
+	{
+		const int32_t Target = VisibleTarget[I];
+		SightConfirmedAge[I] += Elapsed;
+		if (Target != FSightQueryCore::NoTarget)
+		{
+			SightAge[I] = 0.f;
+			if (Target == SightTarget[I])
+			{
+				continue;
+			}
+
+			// Turn to the new target and run straight at it
+			SightTarget[I] = Target;
+			SightConfirmedAge[I] = 0.f;
+			Flags[I] |= SightGained;
+
+			const FSimVector Location = LocationAt(I);
+			const float DirectionX = Targets[Target].X - Location.X;
+			const float DirectionY = Targets[Target].Y - Location.Y;
+			FaceAt(I, DirectionX, DirectionY);
+
+			if (!(Flags[I] & Attacking))
+			{
+				const float Size = std::sqrt(DirectionX * DirectionX + DirectionY * DirectionY);
+				const float Scale = Size > 0.f ? Speed[I] / Size : 0.f;
+				MoveAt(I, Location, FSimVector(DirectionX * Scale, DirectionY * Scale, 0.f));
+			}
+		}
+		else if (SightTarget[I] != FSightQueryCore::NoTarget)
+		{
+			SightAge[I] += Elapsed;
+			if (SightAge[I] <= MaxAge)
+			{
+				continue;
+			}
+
+			// Forget the target and get back to base location
+			SightTarget[I] = FSightQueryCore::NoTarget;
+			Flags[I] |= SightLost;
+			ReturnToBaseAt(I, LocationAt(I));
+		}
+	}
+}
+
+void FEnemyMovementCore::FollowFlowField(const FFlowFieldCore& FlowField)
+{
+	// Directions change once per cell, a velocity within this of the new one stays as it is
+	constexpr float Tolerance = 1.f;
+
+	for (int32_t I = 0; I < Num(); ++I)
+	{
+		const int32_t Target = SightTarget[I];
+		if (Target == FSightQueryCore::NoTarget || Target >= FlowField.NumTargets() || (Flags[I] & (Attacking | Returning)))
+		{
+			continue;
+		}
+
+		const FSimVector Direction = FlowField.Sample(Target, LocationX[I], LocationY[I]);
+		const float NewX = Direction.X * Speed[I];
+		const float NewY = Direction.Y * Speed[I];
+		if (std::fabs(NewX - VelocityX[I]) + std::fabs(NewY - VelocityY[I]) + std::fabs(VelocityZ[I]) <= Tolerance)
+		{
+			continue;
+		}
+
+		VelocityX[I] = NewX;
+		VelocityY[I] = NewY;
+		VelocityZ[I] = 0.f;
+		FaceAt(I, Direction.X, Direction.Y);
+		Flags[I] |= Turned;
+	}
+}
+
+FSimVector FEnemyMovementCore::GetVelocity(FSimAgentId Agent) const
+{
+	return VelocityAt(Index.IndexOf(Agent));
+}
+
+FSimVector FEnemyMovementCore::LocationAt(int32_t DenseIndex) const
+{
+	return FSimVector(LocationX[DenseIndex], LocationY[DenseIndex], LocationZ[DenseIndex]);
+}
+
+FSimVector FEnemyMovementCore::VelocityAt(int32_t DenseIndex) const
+{
+	return FSimVector(VelocityX[DenseIndex], VelocityY[DenseIndex], VelocityZ[DenseIndex]);
+}
+
+void FEnemyMovementCore::MoveAt(int32_t I, const FSimVector& Location, const FSimVector& Velocity)
+{
+	LocationX[I] = Location.X;
+	LocationY[I] = Location.Y;
+	LocationZ[I] = Location.Z;
+	VelocityX[I] = Velocity.X;
+	VelocityY[I] = Velocity.Y;
+	VelocityZ[I] = Velocity.Z;
+	ClosestToBase[I] = FarFromBase;
+	Flags[I] &= ~Returning;
+}
+
+bool FEnemyMovementCore::ReturnToBaseAt(int32_t I, const FSimVector& Location)
+{
+	const float DirectionX = BaseX[I] - Location.X;
+	const float DirectionY = BaseY[I] - Location.Y;
+	const float SizeSquared = DirectionX * DirectionX + DirectionY * DirectionY;
+	if (SizeSquared <= 1.f)
+	{
+		return false;
+	}
+
+	const float Scale = Speed[I] / std::sqrt(SizeSquared);
+	MoveAt(I, Location, FSimVector(DirectionX * Scale, DirectionY * Scale, 0.f));
+	FaceAt(I, DirectionX, DirectionY);
+	Flags[I] |= Returning;
+	return true;
+}
+
+void FEnemyMovementCore::FaceAt(int32_t I, float DirectionX, float DirectionY)
+{
+	const float SizeSquared = DirectionX * DirectionX + DirectionY * DirectionY;
+	if (SizeSquared <= 0.f)
+	{
+		return;
+	}
+
+	const float Scale = 1.f / std::sqrt(SizeSquared);
+	FacingX[I] = DirectionX * Scale;
+	FacingY[I] = DirectionY * Scale;
+}
@@ -0,0 +1,342 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Simulation/FlowFieldCore.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+	constexpr uint32_t Unreachable = std::numeric_limits<uint32_t>::max();
+
+	// Step costs, diagonal is about sqrt(2) times straight
+	constexpr uint32_t StraightStep = 10;
+	constexpr uint32_t DiagonalStep = 14;
+
+	// Longest edge is a diagonal step into the most expensive cell, the bucket queue wraps around after that many
+	constexpr int32_t NumBuckets = DiagonalStep * (FFlowFieldCore::Blocked - 1) + 1;
+
+	// Directions counter-clockwise from +X, odd ones are diagonal
+	constexpr int32_t OffsetX[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+	constexpr int32_t OffsetY[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+	constexpr float Diagonal = 0.70710678f;
+	constexpr float StepDirectionX[8] = {1.f, Diagonal, 0.f, -Diagonal, -1.f, -Diagonal, 0.f, Diagonal};
+	constexpr float StepDirectionY[8] = {0.f, Diagonal, 1.f, Diagonal, 0.f, -Diagonal, -1.f, -Diagonal};
+
+	FSimVector StraightAt(const FSimVector& Target, float X, float Y)
+	{
+		const float ToX = Target.X - X;
+		const float ToY = Target.Y - Y;
+		const float SizeSquared = ToX * ToX + ToY * ToY;
+		if (SizeSquared <= 0.f)
+		{
+			return FSimVector();
+		}
+
+		const float Scale = 1.f / std::sqrt(SizeSquared);
+		return FSimVector(ToX * Scale, ToY * Scale, 0.f);
+	}
+}
+
+FFlowFieldCore::FFlowFieldCore(const FFlowFieldConfig& InConfig)
+{
+	SetConfig(InConfig);
+}
+
+void FFlowFieldCore::SetConfig(const FFlowFieldConfig& InConfig)
+{
+	Config = InConfig;
+	Config.Width = std::max(Config.Width, 1);
+	Config.Height = std::max(Config.Height, 1);
+	Config.CellSize = std::max(Config.CellSize, 1.f);
+
+	Costs.assign(static_cast<size_t>(Config.Width) * Config.Height, 1);
+	CellCosts.assign(Costs.size(), 1);
+	NumBlockers.assign(Costs.size(), 0);
+	bCostsChanged = true;
+}
+
+void FFlowFieldCore::SetCost(int32_t CellX, int32_t CellY, uint8_t Cost)
+{
+	const int32_t Cell = CellY * Config.Width + CellX;
+	CellCosts[Cell] = std::max<uint8_t>(Cost, 1);
+	if (NumBlockers[Cell] == 0 && Costs[Cell] != CellCosts[Cell])
+	{
+		Costs[Cell] = CellCosts[Cell];
+		bCostsChanged = true;
+	}
+}
+
+template <typename FVisit>
+void FFlowFieldCore::ForEachCellIn(float MinX, float MinY, float MaxX, float MaxY, FVisit Visit) const
+{
+	const int32_t FirstX = std::max(static_cast<int32_t>(std::floor((MinX - Config.OriginX) / Config.CellSize)), 0);
+	const int32_t FirstY = std::max(static_cast<int32_t>(std::floor((MinY - Config.OriginY) / Config.CellSize)), 0);
+	const int32_t LastX = std::min(static_cast<int32_t>(std::floor((MaxX - Config.OriginX) / Config.CellSize)),
+		Config.Width - 1);
+	const int32_t LastY = std::min(static_cast<int32_t>(std::floor((MaxY - Config.OriginY) / Config.CellSize)),
+		Config.Height - 1);
+
+	for (int32_t CellY = FirstY; CellY <= LastY; ++CellY)
+	{
+		for (int32_t CellX = FirstX; CellX <= LastX; ++CellX)
+		{
+			Visit(CellY * Config.Width + CellX);
+		}
+	}
+}
+
+void FFlowFieldCore::BlockBox(float MinX, float MinY, float MaxX, float MaxY)
+{
+	ForEachCellIn(MinX, MinY, MaxX, MaxY, [this](int32_t Cell)
+	{
+		++NumBlockers[Cell];
+		if (Costs[Cell] != Blocked)
+		{
+			Costs[Cell] = Blocked;
+			bCostsChanged = true;
+		}
+	});
+}
+
+void FFlowFieldCore::UnblockBox(float MinX, float MinY, float MaxX, float MaxY)
+{
+	ForEachCellIn(MinX, MinY, MaxX, MaxY, [this](int32_t Cell)
+	{
+		if (NumBlockers[Cell] == 0 || --NumBlockers[Cell] > 0)
+		{
+			return;
+		}
+		if (Costs[Cell] != CellCosts[Cell])
+		{
+			Costs[Cell] = CellCosts[Cell];
+			bCostsChanged = true;
+		}
+	});
+}
+
+bool FFlowFieldCore::CellOf(float X, float Y, int32_t& OutCellX, int32_t& OutCellY) const
+{
+	const float GridX = (X - Config.OriginX) / Config.CellSize;
+	const float GridY = (Y - Config.OriginY) / Config.CellSize;
+	if (!(GridX >= 0.f && GridY >= 0.f && GridX < Config.Width && GridY < Config.Height))
+	{
+		return false;
+	}
+
+	OutCellX = static_cast<int32_t>(GridX);
+	OutCellY = static_cast<int32_t>(GridY);
+	return true;
+}
+
+void FFlowFieldCore::Update(const std::vector<FSimVector>& Targets, const FSimParallelFor& ParallelFor)
+{
+	Fields.resize(Targets.size());
+
+	Changed.clear();
+	for (int32_t Target = 0; Target < static_cast<int32_t>(Targets.size()); ++Target)
+	{
+		FField& Field = Fields[Target];
+		Field.Target = Targets[Target];
+
+		int32_t CellX, CellY;
+		const int32_t Cell = CellOf(Field.Target.X, Field.Target.Y, CellX, CellY) ? CellY * Config.Width + CellX : NoCell;
+		if (bCostsChanged || Cell != Field.TargetCell || Field.Distance.empty())
+		{
+			Field.TargetCell = Cell;
+			Changed.push_back(Target);
+		}
+	}
+	bCostsChanged = false;
+
+	if (Changed.empty())
+	{
+		return;
+	}
+
+	// Each integration is sequential, but fields of different targets don't share anything
+	SimParallelFor(ParallelFor, static_cast<int32_t>(Changed.size()), [this](int32_t Task)
+	{
+		Integrate(Fields[Changed[Task]]);
+	});
+
+	NumRecomputed += static_cast<int64_t>(Changed.size());
+}
+
+void FFlowFieldCore::Integrate(FField& Field) const
+{
+	const int32_t Width = Config.Width;
+	const int32_t Height = Config.Height;
+
+	if (Field.Distance.size() != Costs.size())
+	{
+		Field.Distance.assign(Costs.size(), Unreachable);
+		Field.Direction.assign(Costs.size(), NoDirection);
+	}
+	else
+	{
+		for (int32_t Cell : Field.Reached)
+		{
+			Field.Distance[Cell] = Unreachable;
+			Field.Direction[Cell] = NoDirection;
+		}
+	}
+	Field.Reached.clear();
+
+	if (Field.TargetCell == NoCell)
+	{
+		return;
+	}
+
+	// Dial's algorithm: all edges cost at most NumBuckets - 1, so a ring of buckets indexed by distance holds every
+	// open cell and the lowest non-empty bucket always comes next
+	std::vector<std::vector<int32_t>>& Buckets = Field.Buckets;
+	Buckets.resize(NumBuckets);
+	for (std::vector<int32_t>& Bucket : Buckets)
+	{
+		Bucket.clear();
+	}
+
+	int32_t NeighbourOffset[8];
+	for (int32_t Direction = 0; Direction < 8; ++Direction)
+	{
+		NeighbourOffset[Direction] = OffsetY[Direction] * Width + OffsetX[Direction];
+	}
+
+	const uint32_t MaxDistance = Config.MaxPathLength > 0.f
+		? static_cast<uint32_t>(Config.MaxPathLength / Config.CellSize * StraightStep)
+		: Unreachable - 1;
+
+	uint32_t* Distance = Field.Distance.data();
+	uint8_t* Direction = Field.Direction.data();
+	const uint8_t* Cost = Costs.data();
+
+	Distance[Field.TargetCell] = 0;
+	Field.Reached.push_back(Field.TargetCell);
+	Buckets[0].push_back(Field.TargetCell);
+	int64_t NumOpen = 1;
+
+	for (uint32_t Current = 0, BucketIndex = 0; NumOpen > 0; ++Current, BucketIndex = BucketIndex + 1 == NumBuckets ? 0 : BucketIndex + 1)
+	{
+		std::vector<int32_t>& Bucket = Buckets[BucketIndex];
+		for (size_t Next = 0; Next < Bucket.size(); ++Next)
+		{
+			const int32_t Cell = Bucket[Next];
+			--NumOpen;
+
+			// A cheaper path reached this cell after it was queued
+			if (Distance[Cell] != Current)
+			{
+				continue;
+			}
+
+			// Walking from a neighbour into this cell costs this cell's cost, the target is free to enter
+			const uint32_t EnterCost = Cell == Field.TargetCell ? 1u : Cost[Cell];
+			if (EnterCost == Blocked)
+			{
+				continue;
+			}
+
+			// Only cells on the border check for neighbours outside of the grid
+			const int32_t CellX = Cell % Width;
+			const int32_t CellY = Cell / Width;
+			const bool bBorder = CellX == 0 || CellY == 0 || CellX == Width - 1 || CellY == Height - 1;
+
+			for (int32_t Step = 0; Step < 8; ++Step)
+			{
+				if (bBorder)
+				{
+					const int32_t NeighbourX = CellX + OffsetX[Step];
+					const int32_t NeighbourY = CellY + OffsetY[Step];
+					if (NeighbourX < 0 || NeighbourY < 0 || NeighbourX >= Width || NeighbourY >= Height)
+					{
+						continue;
+					}
+				}
+
+				const int32_t Neighbour = Cell + NeighbourOffset[Step];
+				if (Cost[Neighbour] == Blocked)
+				{
+					continue;
+				}
+
+				const bool bDiagonal = Step & 1;
+				if (bDiagonal && (Cost[Cell + OffsetX[Step]] == Blocked || Cost[Cell + OffsetY[Step] * Width] == Blocked))
+				{
+					// Would cut the corner of a blocked cell
+					continue;
+				}
+
+				const uint32_t NewDistance = Current + (bDiagonal ? DiagonalStep : StraightStep) * EnterCost;
+				if (NewDistance < Distance[Neighbour] && NewDistance <= MaxDistance)
+				{
+					if (Distance[Neighbour] == Unreachable)
+					{
+						Field.Reached.push_back(Neighbour);
+					}
+					Distance[Neighbour] = NewDistance;
+					// The neighbour walks back the way the search came
+					Direction[Neighbour] = static_cast<uint8_t>((Step + 4) & 7);
+
+					const uint32_t NewBucket = BucketIndex + (NewDistance - Current);
+					Buckets[NewBucket < static_cast<uint32_t>(NumBuckets) ? NewBucket : NewBucket - NumBuckets].push_back(Neighbour);
+					++NumOpen;
+				}
+			}
+		}
+		Bucket.clear();
+	}
+}
+
+FSimVector FFlowFieldCore::Sample(int32_t Target, float X, float Y) const
+{
+	const FField& Field = Fields[Target];
+
+	int32_t CellX, CellY;
+	if (Field.TargetCell == NoCell || !CellOf(X, Y, CellX, CellY))
+	{
+		return StraightAt(Field.Target, X, Y);
+	}
+
+	const int32_t Cell = CellY * Config.Width + CellX;
+	uint8_t Direction = Field.Direction[Cell];
+
+	// Obstacles are rounded out to whole cells, an agent touching one may stand in a cell the field avoids
+	if (Direction == NoDirection && Costs[Cell] == Blocked && Cell != Field.TargetCell)
+	{
+		Direction = StepOut(Field, CellX, CellY);
+	}
+
+	if (Direction == NoDirection)
+	{
+		return StraightAt(Field.Target, X, Y);
+	}
+	return FSimVector(StepDirectionX[Direction], StepDirectionY[Direction], 0.f);
+}
+
+uint8_t FFlowFieldCore::StepOut(const FField& Field, int32_t CellX, int32_t CellY) const
+{
+	uint8_t Best = NoDirection;
+	uint32_t BestDistance = Unreachable;
+
+	for (int32_t Step = 0; Step < 8; ++Step)
+	{
+		const int32_t NeighbourX = CellX + OffsetX[Step];
+		const int32_t NeighbourY = CellY + OffsetY[Step];
+		if (NeighbourX < 0 || NeighbourY < 0 || NeighbourX >= Config.Width || NeighbourY >= Config.Height)
+		{
+			continue;
+		}
+
+		// Blocked cells are never reached, their distance stays Unreachable
+		const uint32_t Distance = Field.Distance[NeighbourY * Config.Width + NeighbourX];
+		if (Distance < BestDistance)
+		{
+			BestDistance = Distance;
+			Best = static_cast<uint8_t>(Step);
+		}
+	}
+	return Best;
+}
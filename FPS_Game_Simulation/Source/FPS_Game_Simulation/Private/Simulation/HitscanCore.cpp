@@ -0,0 +1,342 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Simulation/HitscanCore.h"
+
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <limits>
+
+namespace
+{
+	constexpr float NoHit = std::numeric_limits<float>::max();
+	constexpr int32_t MaxDepth = 64;
+
+	// Distance at which the ray enters each capsule of a leaf, NoHit if it misses. Distance is written while the five
+	// capsule columns are read, __restrict lets the compiler test the whole leaf in vector lanes.
+	void TestCapsules(float StartX, float StartY, float StartZ, float DirectionX, float DirectionY, float DirectionZ,
+		const float* __restrict CenterX, const float* __restrict CenterY, const float* __restrict CenterZ,
+		const float* __restrict HalfSegment, const float* __restrict Radius, float* __restrict Distance)
+	{
+		// Rays straight up or down never enter through the side
+		const float SideA = DirectionX * DirectionX + DirectionY * DirectionY;
+		const bool bCanHitSide = SideA > 1e-8f;
+		const float InvSideA = bCanHitSide ? 1.f / SideA : 0.f;
+
+		for (int32_t I = 0; I < FHitscanCore::LeafSize; ++I)
+		{
+			const float WX = StartX - CenterX[I];
+			const float WY = StartY - CenterY[I];
+			const float WZ = StartZ - CenterZ[I];
+			const float H = HalfSegment[I];
+			const float RadiusSquared = Radius[I] * Radius[I];
+			const float WSquared2D = WX * WX + WY * WY;
+
+			// Starting inside: closer to the segment than the radius
+			const float InsideZ = WZ - std::min(std::max(WZ, -H), H);
+			const bool bInside = WSquared2D + InsideZ * InsideZ <= RadiusSquared;
+
+			// Side of the cylinder between the hemispheres, a 2D ray circle test. Square roots take the absolute value of
+			// the discriminants so they never branch on a negative one, the masks drop those lanes.
+			const float SideB = WX * DirectionX + WY * DirectionY;
+			const float SideDisc = SideB * SideB - SideA * (WSquared2D - RadiusSquared);
+			const float SideT = (-SideB - std::sqrt(std::fabs(SideDisc))) * InvSideA;
+			const float SideZ = WZ + SideT * DirectionZ;
+			const bool bSide = bCanHitSide & (SideDisc >= 0.f) & (SideT >= 0.f) & (SideZ >= -H) & (SideZ <= H);
+
+			// Hemispheres, ray sphere tests around both ends of the segment
+			const float TopZ = WZ - H;
+			const float TopB = SideB + TopZ * DirectionZ;
+			const float TopDisc = TopB * TopB - (WSquared2D + TopZ * TopZ - RadiusSquared);
+			const float TopT = -TopB - std::sqrt(std::fabs(TopDisc));
+			const bool bTop = (TopDisc >= 0.f) & (TopT >= 0.f);
+
+			const float BottomZ = WZ + H;
+			const float BottomB = SideB + BottomZ * DirectionZ;
+			const float BottomDisc = BottomB * BottomB - (WSquared2D + BottomZ * BottomZ - RadiusSquared);
+			const float BottomT = -BottomB - std::sqrt(std::fabs(BottomDisc));
+			const bool bBottom = (BottomDisc >= 0.f) & (BottomT >= 0.f);
+
+			float T = bSide ? SideT : NoHit;
+			T = bTop & (TopT < T) ? TopT : T;
+			T = bBottom & (BottomT < T) ? BottomT : T;
+			Distance[I] = bInside ? 0.f : T;
+		}
+	}
+
+	bool IntersectsBox(const float* Min, const float* Max, const float* Start, const float* InvDirection,
+		float MaxDistance)
+	{
+		float Near = 0.f;
+		float Far = MaxDistance;
+		for (int32_t Axis = 0; Axis < 3; ++Axis)
+		{
+			const float T0 = (Min[Axis] - Start[Axis]) * InvDirection[Axis];
+			const float T1 = (Max[Axis] - Start[Axis]) * InvDirection[Axis];
+			Near = std::max(Near, std::min(T0, T1));
+			Far = std::min(Far, std::max(T0, T1));
+		}
+		return Near <= Far;
+	}
+}
+
+void FHitscanCore::Build(const std::vector<FSimCapsule>& Capsules)
+{
+	NumCapsules = static_cast<int32_t>(Capsules.size());
+
+	Nodes.clear();
+	CenterX.clear();
+	CenterY.clear();
+	CenterZ.clear();
+	HalfSegment.clear();
+	Radius.clear();
+	Target.clear();
+	if (NumCapsules == 0)
+	{
+		return;
+	}
+
+	const int32_t NumLeaves = (NumCapsules + LeafSize - 1) / LeafSize;
+	Nodes.reserve(NumLeaves * 4);
+	Target.reserve(NumLeaves * LeafSize * 2);
+
+	std::vector<int32_t> Indices(NumCapsules);
+	for (int32_t I = 0; I < NumCapsules; ++I)
+	{
+		Indices[I] = I;
+	}
+
+	Nodes.emplace_back();
+	BuildNode(Capsules, Indices.data(), NumCapsules, 0);
+
+	for (std::vector<float>* Column : {&CenterX, &CenterY, &CenterZ, &HalfSegment, &Radius})
+	{
+		Column->resize(Target.size());
+	}
+	for (int32_t Slot = 0; Slot < static_cast<int32_t>(Target.size()); ++Slot)
+	{
+		SetSlot(Slot, Capsules[Target[Slot]]);
+	}
+}
+
+void FHitscanCore::BuildNode(const std::vector<FSimCapsule>& Capsules, int32_t* Indices, int32_t Count,
+	int32_t NodeIndex)
+{
+	FNode Node;
+	float CenterMin[3] = {NoHit, NoHit, NoHit};
+	float CenterMax[3] = {-NoHit, -NoHit, -NoHit};
+	for (int32_t Axis = 0; Axis < 3; ++Axis)
+	{
+		Node.Min[Axis] = NoHit;
+		Node.Max[Axis] = -NoHit;
+	}
+	for (int32_t I = 0; I < Count; ++I)
+	{
+		const FSimCapsule& Capsule = Capsules[Indices[I]];
+		const float Center[3] = {Capsule.Center.X, Capsule.Center.Y, Capsule.Center.Z};
+		const float Extent[3] = {Capsule.Radius, Capsule.Radius, std::max(Capsule.HalfHeight, Capsule.Radius)};
+		for (int32_t Axis = 0; Axis < 3; ++Axis)
+		{
+			Node.Min[Axis] = std::min(Node.Min[Axis], Center[Axis] - Extent[Axis]);
+			Node.Max[Axis] = std::max(Node.Max[Axis], Center[Axis] + Extent[Axis]);
+			CenterMin[Axis] = std::min(CenterMin[Axis], Center[Axis]);
+			CenterMax[Axis] = std::max(CenterMax[Axis], Center[Axis]);
+		}
+	}
+
+	if (Count <= LeafSize)
+	{
+		Node.First = static_cast<int32_t>(Target.size());
+		Node.Count = Count;
+		for (int32_t I = 0; I < LeafSize; ++I)
+		{
+			// Padding slots repeat the last capsule, Trace only reads the first Count results of a leaf
+			Target.push_back(Indices[std::min(I, Count - 1)]);
+		}
+		Nodes[NodeIndex] = Node;
+		return;
+	}
+
+	// Median split along the widest axis of the centers, rounded so the left half fills whole leaves
+	int32_t SplitAxis = 0;
+	for (int32_t Axis = 1; Axis < 3; ++Axis)
+	{
+		if (CenterMax[Axis] - CenterMin[Axis] > CenterMax[SplitAxis] - CenterMin[SplitAxis])
+		{
+			SplitAxis = Axis;
+		}
+	}
+	const int32_t Split = std::min((Count / 2 + LeafSize - 1) / LeafSize * LeafSize, Count - 1);
+	const auto SplitAt = [&Capsules, Indices, Split, Count](auto CenterOf)
+	{
+		std::nth_element(Indices, Indices + Split, Indices + Count, [&Capsules, CenterOf](int32_t Left, int32_t Right)
+		{
+			return CenterOf(Capsules[Left]) < CenterOf(Capsules[Right]);
+		});
+	};
+	if (SplitAxis == 0)
+	{
+		SplitAt([](const FSimCapsule& Capsule) { return Capsule.Center.X; });
+	}
+	else if (SplitAxis == 1)
+	{
+		SplitAt([](const FSimCapsule& Capsule) { return Capsule.Center.Y; });
+	}
+	else
+	{
+		SplitAt([](const FSimCapsule& Capsule) { return Capsule.Center.Z; });
+	}
+
+	Node.First = static_cast<int32_t>(Nodes.size());
+	Node.Count = 0;
+	Nodes[NodeIndex] = Node;
+	Nodes.emplace_back();
+	Nodes.emplace_back();
+
+	BuildNode(Capsules, Indices, Split, Node.First);
+	BuildNode(Capsules, Indices + Split, Count - Split, Node.First + 1);
+}
+
+void FHitscanCore::Refit(const std::vector<FSimCapsule>& Capsules)
+{
+	for (int32_t Slot = 0; Slot < static_cast<int32_t>(Target.size()); ++Slot)
+	{
+		SetSlot(Slot, Capsules[Target[Slot]]);
+	}
+
+	// Children always come after their parent, so walking backwards sees them first
+	for (int32_t NodeIndex = static_cast<int32_t>(Nodes.size()) - 1; NodeIndex >= 0; --NodeIndex)
+	{
+		FNode& Node = Nodes[NodeIndex];
+		if (Node.Count == 0)
+		{
+			const FNode& Left = Nodes[Node.First];
+			const FNode& Right = Nodes[Node.First + 1];
+			for (int32_t Axis = 0; Axis < 3; ++Axis)
+			{
+				Node.Min[Axis] = std::min(Left.Min[Axis], Right.Min[Axis]);
+				Node.Max[Axis] = std::max(Left.Max[Axis], Right.Max[Axis]);
+			}
+			continue;
+		}
+
+		for (int32_t Axis = 0; Axis < 3; ++Axis)
+		{
+			Node.Min[Axis] = NoHit;
+			Node.Max[Axis] = -NoHit;
+		}
+		for (int32_t Slot = Node.First; Slot < Node.First + Node.Count; ++Slot)
+		{
+			const float Extent = HalfSegment[Slot] + Radius[Slot];
+			Node.Min[0] = std::min(Node.Min[0], CenterX[Slot] - Radius[Slot]);
+			Node.Max[0] = std::max(Node.Max[0], CenterX[Slot] + Radius[Slot]);
+			Node.Min[1] = std::min(Node.Min[1], CenterY[Slot] - Radius[Slot]);
+			Node.Max[1] = std::max(Node.Max[1], CenterY[Slot] + Radius[Slot]);
+			Node.Min[2] = std::min(Node.Min[2], CenterZ[Slot] - Extent);
+			Node.Max[2] = std::max(Node.Max[2], CenterZ[Slot] + Extent);
+		}
+	}
+}
+
+void FHitscanCore::SetSlot(int32_t Slot, const FSimCapsule& Capsule)
+{
+	CenterX[Slot] = Capsule.Center.X;
+	CenterY[Slot] = Capsule.Center.Y;
+	CenterZ[Slot] = Capsule.Center.Z;
+	HalfSegment[Slot] = std::max(Capsule.HalfHeight - Capsule.Radius, 0.f);
+	Radius[Slot] = Capsule.Radius;
+}
+
+void FHitscanCore::Trace(const FHitscanRay* Rays, int32_t NumRays, FHitscanResults& Results) const
+{
+	Results.HitStart.resize(NumRays + 1);
+	Results.Hits.clear();
+
+	for (int32_t RayIndex = 0; RayIndex < NumRays; ++RayIndex)
+	{
+		const FHitscanRay& Ray = Rays[RayIndex];
+		const int32_t FirstHit = static_cast<int32_t>(Results.Hits.size());
+		Results.HitStart[RayIndex] = FirstHit;
+		if (Nodes.empty())
+		{
+			continue;
+		}
+
+		const float Start[3] = {Ray.Start.X, Ray.Start.Y, Ray.Start.Z};
+		const float Direction[3] = {Ray.Direction.X, Ray.Direction.Y, Ray.Direction.Z};
+		float InvDirection[3];
+		for (int32_t Axis = 0; Axis < 3; ++Axis)
+		{
+			InvDirection[Axis] = Direction[Axis] != 0.f ? 1.f / Direction[Axis] : NoHit;
+		}
+
+		// A ray that doesn't pierce stops looking beyond its nearest hit
+		float MaxDistance = Ray.Length;
+		FHitscanHit Nearest;
+
+		int32_t Stack[MaxDepth];
+		int32_t StackSize = 0;
+		Stack[StackSize++] = 0;
+		while (StackSize > 0)
+		{
+			const FNode& Node = Nodes[Stack[--StackSize]];
+			if (!IntersectsBox(Node.Min, Node.Max, Start, InvDirection, MaxDistance))
+			{
+				continue;
+			}
+
+			if (Node.Count == 0)
+			{
+				// Visit the child nearer to the start first, it is pushed last
+				const FNode& Left = Nodes[Node.First];
+				const FNode& Right = Nodes[Node.First + 1];
+				float Along = 0.f;
+				for (int32_t Axis = 0; Axis < 3; ++Axis)
+				{
+					Along += (Left.Min[Axis] + Left.Max[Axis] - Right.Min[Axis] - Right.Max[Axis]) * Direction[Axis];
+				}
+				Stack[StackSize++] = Along < 0.f ? Node.First + 1 : Node.First;
+				Stack[StackSize++] = Along < 0.f ? Node.First : Node.First + 1;
+				continue;
+			}
+
+			float Distance[LeafSize];
+			TestCapsules(Start[0], Start[1], Start[2], Direction[0], Direction[1], Direction[2],
+				CenterX.data() + Node.First, CenterY.data() + Node.First, CenterZ.data() + Node.First,
+				HalfSegment.data() + Node.First, Radius.data() + Node.First, Distance);
+
+			for (int32_t I = 0; I < Node.Count; ++I)
+			{
+				if (Distance[I] > MaxDistance)
+				{
+					continue;
+				}
+
+				FHitscanHit Hit;
+				Hit.Target = Target[Node.First + I];
+				Hit.Distance = Distance[I];
+				if (Ray.bPierce)
+				{
+					Results.Hits.push_back(Hit);
+				}
+				else
+				{
+					Nearest = Hit;
+					MaxDistance = Hit.Distance;
+				}
+			}
+		}
+
+		if (Ray.bPierce)
+		{
+			std::sort(Results.Hits.begin() + FirstHit, Results.Hits.end(),
+				[](const FHitscanHit& Left, const FHitscanHit& Right) { return Left.Distance < Right.Distance; });
+		}
+		else if (Nearest.Target != -1)
+		{
+			Results.Hits.push_back(Nearest);
+		}
+	}
+	Results.HitStart[NumRays] = static_cast<int32_t>(Results.Hits.size());
+}
@@ -0,0 +1,170 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Simulation/PickupCore.h"
+
+#include <algorithm>
+#include <cmath>
+
+FPickupGridCore::FPickupGridCore(float InCellSize)
+	: CellSize(std::max(InCellSize, 1.f))
+{
+}
+
+int32_t FPickupGridCore::CellOf(float Coordinate) const
+{
+	return static_cast<int32_t>(std::floor(Coordinate / CellSize));
+}
+
+uint64_t FPickupGridCore::KeyOf(int32_t CellX, int32_t CellY)
+{
+	return static_cast<uint64_t>(static_cast<uint32_t>(CellX)) << 32 | static_cast<uint32_t>(CellY);
+}
+
+FSimAgentId FPickupGridCore::Add(const FSimVector& Location, float Radius)
+{
+	const FSimAgentId Pickup = Index.Add();
+	const uint64_t Key = KeyOf(CellOf(Location.X), CellOf(Location.Y));
+
+	FCell& Cell = Cells[Key];
+	CellKeys.push_back(Key);
+	CellSlots.push_back(static_cast<int32_t>(Cell.Pickups.size()));
+	Cell.X.push_back(Location.X);
+	Cell.Y.push_back(Location.Y);
+	Cell.Z.push_back(Location.Z);
+	Cell.Radius.push_back(Radius);
+	Cell.Pickups.push_back(Pickup);
+
+	MaxRadius = std::max(MaxRadius, Radius);
+	return Pickup;
+}
+
+void FPickupGridCore::Remove(FSimAgentId Pickup)
+{
+	const int32_t Removed = Index.Remove(Pickup);
+	const uint64_t Key = CellKeys[Removed];
+	const int32_t Slot = CellSlots[Removed];
+	SimRemoveAtSwap(CellKeys, Removed);
+	SimRemoveAtSwap(CellSlots, Removed);
+
+	// Swap-remove from the cell too, the pickup moved into the slot learns its new place
+	const auto Found = Cells.find(Key);
+	FCell& Cell = Found->second;
+	SimRemoveAtSwap(Cell.X, Slot);
+	SimRemoveAtSwap(Cell.Y, Slot);
+	SimRemoveAtSwap(Cell.Z, Slot);
+	SimRemoveAtSwap(Cell.Radius, Slot);
+	SimRemoveAtSwap(Cell.Pickups, Slot);
+	if (Slot < static_cast<int32_t>(Cell.Pickups.size()))
+	{
+		CellSlots[Index.IndexOf(Cell.Pickups[Slot])] = Slot;
+	}
+	if (Cell.Pickups.empty())
+	{
+		Cells.erase(Found);
+	}
+
+	// The id gets reused, a new pickup under it must be reported
+	for (std::vector<FSimAgentId>& PlayerInside : Inside)
+	{
+		const auto Was = std::lower_bound(PlayerInside.begin(), PlayerInside.end(), Pickup);
+		if (Was != PlayerInside.end() && *Was == Pickup)
+		{
+			PlayerInside.erase(Was);
+		}
+	}
+}
+
+void FPickupGridCore::Reserve(int32_t Count)
+{
+	Index.Reserve(Count);
+	CellKeys.reserve(Count);
+	CellSlots.reserve(Count);
+}
+
+void FPickupGridCore::Query(const FPickupPlayer* Players, int32_t NumPlayers, std::vector<FPickupContact>& Contacts)
+{
+	Contacts.clear();
+	Inside.resize(NumPlayers);
+
+	for (int32_t Player = 0; Player < NumPlayers; ++Player)
+	{
+		const FPickupPlayer& Capsule = Players[Player];
+		const float Reach = MaxRadius + Capsule.Radius;
+
+		// The capsule is a sphere swept along this vertical segment
+		const float SegmentHalfHeight = std::max(Capsule.HalfHeight - Capsule.Radius, 0.f);
+		const float Bottom = Capsule.Location.Z - SegmentHalfHeight;
+		const float Top = Capsule.Location.Z + SegmentHalfHeight;
+
+		NowInside.clear();
+		for (int32_t CellY = CellOf(Capsule.Location.Y - Reach); CellY <= CellOf(Capsule.Location.Y + Reach); ++CellY)
+		{
+			for (int32_t CellX = CellOf(Capsule.Location.X - Reach); CellX <= CellOf(Capsule.Location.X + Reach); ++CellX)
+			{
+				const auto Found = Cells.find(KeyOf(CellX, CellY));
+				if (Found == Cells.end())
+				{
+					continue;
+				}
+
+				const FCell& Cell = Found->second;
+				for (int32_t I = 0; I < static_cast<int32_t>(Cell.Pickups.size()); ++I)
+				{
+					const float ToX = Cell.X[I] - Capsule.Location.X;
+					const float ToY = Cell.Y[I] - Capsule.Location.Y;
+					const float ToZ = Cell.Z[I] - std::min(std::max(Cell.Z[I], Bottom), Top);
+					const float Touch = Cell.Radius[I] + Capsule.Radius;
+					if (ToX * ToX + ToY * ToY + ToZ * ToZ <= Touch * Touch)
+					{
+						NowInside.push_back(Cell.Pickups[I]);
+					}
+				}
+			}
+		}
+
+		// Report only the pickups the player wasn't inside before
+		std::sort(NowInside.begin(), NowInside.end());
+		std::vector<FSimAgentId>& WasInside = Inside[Player];
+		for (FSimAgentId Pickup : NowInside)
+		{
+			if (!std::binary_search(WasInside.begin(), WasInside.end(), Pickup))
+			{
+				Contacts.push_back({Player, Pickup});
+			}
+		}
+		WasInside.swap(NowInside);
+	}
+}
+
+FAmmoPickupResult ResolveAmmoPickup(int32_t CurrentAmmo, int32_t AmmoLimit, int32_t AmmoAmount)
+{
+	FAmmoPickupResult Result;
+	Result.Remaining = AmmoAmount;
+
+	// A full weapon takes nothing
+	const int32_t Missing = AmmoLimit - CurrentAmmo;
+	if (Missing <= 0)
+	{
+		return Result;
+	}
+
+	Result.Taken = std::min(Missing, AmmoAmount);
+	Result.Remaining = AmmoAmount - Result.Taken;
+	Result.bConsumed = Result.Remaining == 0;
+	return Result;
+}
+
+FHealthPickupResult ResolveHealthPickup(float CurrentHealth, float MaxHealth, float HealthAmount)
+{
+	FHealthPickupResult Result;
+	Result.NewHealth = CurrentHealth;
+	if (CurrentHealth > MaxHealth)
+	{
+		return Result;
+	}
+
+	Result.NewHealth = std::min(CurrentHealth + HealthAmount, MaxHealth);
+	Result.bConsumed = true;
+	return Result;
+}
@@ -0,0 +1,167 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Simulation/SightQueryCore.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+	constexpr int32_t MinBuckets = 64;
+
+	// Keeps the closest target each candidate sees in [Begin, End). The best distance and target are read and written per
+	// candidate, __restrict promises they don't alias the position and facing columns so the selects are vectorized.
+	void TestCandidates(int32_t Begin, int32_t End, float TargetX, float TargetY, float TargetZ, int32_t Target,
+		float RadiusSquared, float CosPeripheralAngle, const float* __restrict X, const float* __restrict Y,
+		const float* __restrict Z, const float* __restrict FacingX, const float* __restrict FacingY,
+		float* __restrict BestDistanceSquared, int32_t* __restrict BestTarget)
+	{
+		// Beyond 90 degrees the cone includes everything in front and part of what is behind
+		const bool bWideCone = CosPeripheralAngle < 0.f;
+		const float CosSquared = CosPeripheralAngle * CosPeripheralAngle;
+
+		for (int32_t I = Begin; I < End; ++I)
+		{
+			const float ToTargetX = TargetX - X[I];
+			const float ToTargetY = TargetY - Y[I];
+			const float ToTargetZ = TargetZ - Z[I];
+			const float DistanceSquared = ToTargetX * ToTargetX + ToTargetY * ToTargetY + ToTargetZ * ToTargetZ;
+
+			// Dot / Distance >= CosPeripheralAngle, squared so the loop needs neither a division nor a square root
+			const float Dot = FacingX[I] * ToTargetX + FacingY[I] * ToTargetY;
+			const float DotSquared = Dot * Dot;
+			const float ConeSquared = CosSquared * DistanceSquared;
+			const bool bInCone = bWideCone ? (Dot >= 0.f) | (DotSquared <= ConeSquared)
+										   : (Dot >= 0.f) & (DotSquared >= ConeSquared);
+			const float PreviousDistance = BestDistanceSquared[I];
+			const int32_t PreviousTarget = BestTarget[I];
+			const bool bCloser = (DistanceSquared <= RadiusSquared) & bInCone & (DistanceSquared < PreviousDistance);
+
+			BestDistanceSquared[I] = bCloser ? DistanceSquared : PreviousDistance;
+			BestTarget[I] = bCloser ? Target : PreviousTarget;
+		}
+	}
+}
+
+FSightQueryCore::FSightQueryCore(const FSightConfig& InConfig)
+{
+	SetConfig(InConfig);
+}
+
+void FSightQueryCore::SetConfig(const FSightConfig& InConfig)
+{
+	Config = InConfig;
+	CellSize = std::max(Config.SightRadius, 1.f);
+	CosPeripheralAngle = std::cos(Config.PeripheralVisionAngleDegrees * SimDegreesToRadians);
+}
+
+int32_t FSightQueryCore::CellOf(float Coordinate) const
+{
+	return static_cast<int32_t>(std::floor(Coordinate / CellSize));
+}
+
+uint32_t FSightQueryCore::BucketOf(int32_t CellX, int32_t CellY) const
+{
+	// Distant cells may share a bucket, the radius test drops their observers
+	const uint32_t Hash = static_cast<uint32_t>(CellX) * 73856093u ^ static_cast<uint32_t>(CellY) * 19349663u;
+	return Hash & BucketMask;
+}
+
+void FSightQueryCore::BuildHash(const FSightObservers& Observers)
+{
+	const int32_t Num = Observers.Num;
+
+	int32_t BucketCount = MinBuckets;
+	while (BucketCount < Num)
+	{
+		BucketCount <<= 1;
+	}
+	BucketMask = static_cast<uint32_t>(BucketCount - 1);
+
+	// Counting sort of the observers by bucket
+	ObserverBucket.resize(Num);
+	BucketStart.assign(BucketCount + 1, 0);
+	for (int32_t I = 0; I < Num; ++I)
+	{
+		const uint32_t Bucket = BucketOf(CellOf(Observers.X[I]), CellOf(Observers.Y[I]));
+		ObserverBucket[I] = Bucket;
+		++BucketStart[Bucket + 1];
+	}
+	for (int32_t B = 0; B < BucketCount; ++B)
+	{
+		BucketStart[B + 1] += BucketStart[B];
+	}
+
+	SortedObserver.resize(Num);
+	SortedX.resize(Num);
+	SortedY.resize(Num);
+	SortedZ.resize(Num);
+	SortedFacingX.resize(Num);
+	SortedFacingY.resize(Num);
+
+	// BucketStart[B] serves as the insertion cursor of bucket B, afterwards it is where bucket B + 1 starts
+	for (int32_t I = 0; I < Num; ++I)
+	{
+		const int32_t Slot = BucketStart[ObserverBucket[I]]++;
+		SortedObserver[Slot] = I;
+		SortedX[Slot] = Observers.X[I];
+		SortedY[Slot] = Observers.Y[I];
+		SortedZ[Slot] = Observers.Z[I];
+		SortedFacingX[Slot] = Observers.FacingX[I];
+		SortedFacingY[Slot] = Observers.FacingY[I];
+	}
+	for (int32_t B = BucketCount; B > 0; --B)
+	{
+		BucketStart[B] = BucketStart[B - 1];
+	}
+	BucketStart[0] = 0;
+}
+
+void FSightQueryCore::Query(const FSightObservers& Observers, const std::vector<FSimVector>& Targets,
+	int32_t* VisibleTarget)
+{
+	const int32_t Num = Observers.Num;
+	if (Num == 0)
+	{
+		return;
+	}
+
+	BuildHash(Observers);
+	BestDistanceSquared.assign(Num, std::numeric_limits<float>::max());
+	BestTarget.assign(Num, NoTarget);
+
+	const float RadiusSquared = Config.SightRadius * Config.SightRadius;
+	for (int32_t Target = 0; Target < static_cast<int32_t>(Targets.size()); ++Target)
+	{
+		const FSimVector& Location = Targets[Target];
+		const int32_t CellX = CellOf(Location.X);
+		const int32_t CellY = CellOf(Location.Y);
+
+		// Cells are as large as the sight radius, so every observer that can see the target is in one of these
+		uint32_t Visited[9];
+		int32_t NumVisited = 0;
+		for (int32_t OffsetY = -1; OffsetY <= 1; ++OffsetY)
+		{
+			for (int32_t OffsetX = -1; OffsetX <= 1; ++OffsetX)
+			{
+				const uint32_t Bucket = BucketOf(CellX + OffsetX, CellY + OffsetY);
+				if (std::find(Visited, Visited + NumVisited, Bucket) != Visited + NumVisited)
+				{
+					continue;
+				}
+				Visited[NumVisited++] = Bucket;
+
+				TestCandidates(BucketStart[Bucket], BucketStart[Bucket + 1], Location.X, Location.Y, Location.Z, Target,
+					RadiusSquared, CosPeripheralAngle, SortedX.data(), SortedY.data(), SortedZ.data(),
+					SortedFacingX.data(), SortedFacingY.data(), BestDistanceSquared.data(), BestTarget.data());
+			}
+		}
+	}
+
+	for (int32_t Slot = 0; Slot < Num; ++Slot)
+	{
+		VisibleTarget[SortedObserver[Slot]] = BestTarget[Slot];
+	}
+}
@@ -0,0 +1,222 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Simulation/SignificanceCore.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+	// Waking up from dormant makes an agent due at once
+	constexpr int32_t DormantFrames = 1 << 20;
+
+	// Folds one viewer into every agent's nearest distance and in-view flag. The two outputs are updated in place next to
+	// three position columns, __restrict keeps those stores from forcing the positions to be reloaded one agent at a time.
+	void TestViewer(int32_t Count, const FSignificanceViewer& Viewer, float CosHalfFieldOfView,
+		const float* __restrict X, const float* __restrict Y, const float* __restrict Z,
+		float* __restrict NearestDistanceSquared, uint8_t* __restrict InView)
+	{
+		// Beyond 90 degrees the view includes everything in front and part of what is behind
+		const bool bWideView = CosHalfFieldOfView < 0.f;
+		const float CosSquared = CosHalfFieldOfView * CosHalfFieldOfView;
+
+		for (int32_t I = 0; I < Count; ++I)
+		{
+			const float ToX = X[I] - Viewer.Location.X;
+			const float ToY = Y[I] - Viewer.Location.Y;
+			const float ToZ = Z[I] - Viewer.Location.Z;
+			const float DistanceSquared = ToX * ToX + ToY * ToY + ToZ * ToZ;
+
+			// Dot / Distance >= CosHalfFieldOfView, squared as in FSightQueryCore
+			const float Dot = Viewer.Forward.X * ToX + Viewer.Forward.Y * ToY + Viewer.Forward.Z * ToZ;
+			const float DotSquared = Dot * Dot;
+			const float ConeSquared = CosSquared * DistanceSquared;
+			const bool bInView = bWideView ? (Dot >= 0.f) | (DotSquared <= ConeSquared)
+										   : (Dot >= 0.f) & (DotSquared >= ConeSquared);
+
+			const float Nearest = NearestDistanceSquared[I];
+			NearestDistanceSquared[I] = DistanceSquared < Nearest ? DistanceSquared : Nearest;
+			InView[I] = InView[I] | static_cast<uint8_t>(bInView);
+		}
+	}
+
+	// Bucket by distance to the nearest viewer, one lower out of view
+	void ClassifyAgents(int32_t Count, const float* BucketDistance, const float* __restrict NearestDistanceSquared,
+		const uint8_t* __restrict InView, uint8_t* __restrict NewBucket)
+	{
+		const float Near = BucketDistance[0] * BucketDistance[0];
+		const float Middle = BucketDistance[1] * BucketDistance[1];
+		const float Far = BucketDistance[2] * BucketDistance[2];
+
+		for (int32_t I = 0; I < Count; ++I)
+		{
+			const float DistanceSquared = NearestDistanceSquared[I];
+			const int32_t ByDistance = (DistanceSquared >= Near) + (DistanceSquared >= Middle) + (DistanceSquared >= Far);
+			const int32_t Bucket = ByDistance + (InView[I] == 0);
+			NewBucket[I] = static_cast<uint8_t>(Bucket < FSignificanceCore::Dormant ? Bucket : FSignificanceCore::Dormant);
+		}
+	}
+
+	// Every frame agents take the time since their previous update, lower rate ones keep collecting it and are due
+	// once their period is over. Dormant agents (period 0) stand still.
+	void AdvanceClock(int32_t Count, float DeltaTime, const int32_t* __restrict Period, float* __restrict PendingTime,
+		int32_t* __restrict FramesSinceUpdate, float* __restrict AgentDeltaTime, int32_t* __restrict Due)
+	{
+		for (int32_t I = 0; I < Count; ++I)
+		{
+			// Arithmetic instead of selects, GCC doesn't vectorize the selects of this loop
+			const int32_t Awake = Period[I] != 0;
+			const int32_t EveryFrame = Period[I] == 1;
+			const float Pending = PendingTime[I] + DeltaTime * static_cast<float>(Awake);
+			const int32_t Frames = FramesSinceUpdate[I] + Awake;
+
+			AgentDeltaTime[I] = Pending * static_cast<float>(EveryFrame);
+			PendingTime[I] = Pending * static_cast<float>(1 - EveryFrame);
+			FramesSinceUpdate[I] = Frames * (1 - EveryFrame);
+			Due[I] = (Period[I] > 1) & (Frames >= Period[I]);
+		}
+	}
+}
+
+FSignificanceCore::FSignificanceCore(const FSignificanceConfig& InConfig)
+	: Config(InConfig)
+{
+}
+
+void FSignificanceCore::SetConfig(const FSignificanceConfig& InConfig)
+{
+	Config = InConfig;
+	for (int32_t I = 0; I < Num(); ++I)
+	{
+		Period[I] = Bucket[I] == Dormant ? 0 : std::max(Config.BucketPeriod[Bucket[I]], 1);
+	}
+}
+
+void FSignificanceCore::Add()
+{
+	Bucket.push_back(EveryFrame);
+	Period.push_back(std::max(Config.BucketPeriod[EveryFrame], 1));
+	++NumInBucket[EveryFrame];
+	InView.push_back(1);
+	PendingTime.push_back(0.f);
+	FramesSinceUpdate.push_back(0);
+}
+
+void FSignificanceCore::RemoveAtSwap(int32_t Index)
+{
+	--NumInBucket[Bucket[Index]];
+	SimRemoveAtSwap(Bucket, Index);
+	SimRemoveAtSwap(Period, Index);
+	SimRemoveAtSwap(InView, Index);
+	SimRemoveAtSwap(PendingTime, Index);
+	SimRemoveAtSwap(FramesSinceUpdate, Index);
+}
+
+void FSignificanceCore::Reserve(int32_t Count)
+{
+	Bucket.reserve(Count);
+	Period.reserve(Count);
+	InView.reserve(Count);
+	PendingTime.reserve(Count);
+	FramesSinceUpdate.reserve(Count);
+}
+
+void FSignificanceCore::UpdateBuckets(const float* X, const float* Y, const float* Z,
+	const std::vector<FSignificanceViewer>& Viewers)
+{
+	const int32_t Count = Num();
+
+	NearestDistanceSquared.assign(Count, std::numeric_limits<float>::max());
+	std::fill(InView.begin(), InView.end(), 0);
+	for (const FSignificanceViewer& Viewer : Viewers)
+	{
+		TestViewer(Count, Viewer, std::cos(Viewer.HalfFieldOfViewDegrees * SimDegreesToRadians), X, Y, Z,
+			NearestDistanceSquared.data(), InView.data());
+	}
+
+	NewBucket.resize(Count);
+	ClassifyAgents(Count, Config.BucketDistance, NearestDistanceSquared.data(), InView.data(), NewBucket.data());
+
+	// Few agents change bucket per frame
+	for (int32_t I = 0; I < Count; ++I)
+	{
+		const uint8_t AgentBucket = NewBucket[I];
+		if (AgentBucket == Bucket[I])
+		{
+			continue;
+		}
+
+		if (AgentBucket == Dormant)
+		{
+			Period[I] = 0;
+			FramesSinceUpdate[I] = DormantFrames;
+		}
+		else if (Bucket[I] == Dormant)
+		{
+			// Time doesn't pass for dormant agents, they carry on from where they stopped
+			PendingTime[I] = 0.f;
+		}
+		else
+		{
+			// Spread agents that change bucket together over the frames of the new period
+			FramesSinceUpdate[I] = std::max(FramesSinceUpdate[I], I % Config.BucketPeriod[AgentBucket]);
+		}
+		if (AgentBucket != Dormant)
+		{
+			Period[I] = std::max(Config.BucketPeriod[AgentBucket], 1);
+		}
+
+		--NumInBucket[Bucket[I]];
+		++NumInBucket[AgentBucket];
+		Bucket[I] = AgentBucket;
+	}
+}
+
+int32_t FSignificanceCore::Schedule(float DeltaTime, float* AgentDeltaTime)
+{
+	const int32_t Count = Num();
+
+	Stats = FSignificanceStats();
+	std::copy(NumInBucket, NumInBucket + 4, Stats.NumInBucket);
+	Stats.NumUpdated = NumInBucket[EveryFrame];
+
+	DueMask.resize(Count);
+	AdvanceClock(Count, DeltaTime, Period.data(), PendingTime.data(), FramesSinceUpdate.data(), AgentDeltaTime,
+		DueMask.data());
+
+	// Branch-free compaction, which agents are due is anyone's guess for the branch predictor
+	Due.resize(Count);
+	int32_t NumDue = 0;
+	for (int32_t I = 0; I < Count; ++I)
+	{
+		Due[NumDue] = I;
+		NumDue += DueMask[I];
+	}
+	Due.resize(NumDue);
+
+	// Over budget, the agents most overdue relative to their period go first. The others wait and are more overdue
+	// next frame.
+	const int32_t Budget = std::max(Config.MaxUpdatesPerFrame, 0);
+	if (static_cast<int32_t>(Due.size()) > Budget)
+	{
+		std::nth_element(Due.begin(), Due.begin() + Budget, Due.end(), [this](int32_t A, int32_t B)
+		{
+			return static_cast<int64_t>(FramesSinceUpdate[A]) * Period[B]
+				> static_cast<int64_t>(FramesSinceUpdate[B]) * Period[A];
+		});
+		Stats.NumDeferred = static_cast<int32_t>(Due.size()) - Budget;
+		Due.resize(Budget);
+	}
+
+	for (int32_t I : Due)
+	{
+		AgentDeltaTime[I] = PendingTime[I];
+		PendingTime[I] = 0.f;
+		FramesSinceUpdate[I] = 0;
+	}
+	Stats.NumUpdated += static_cast<int32_t>(Due.size());
+
+	return Stats.NumUpdated;
+}
@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Simulation/SimAgentIndex.h"
+
+FSimAgentId FSimAgentIndex::Add()
+{
+	FSimAgentId Agent;
+	if (!FreeIds.empty())
+	{
+		Agent = FreeIds.back();
+		FreeIds.pop_back();
+	}
+	else
+	{
+		Agent = static_cast<FSimAgentId>(Dense.size());
+		Dense.push_back(InvalidIndex);
+	}
+
+	Dense[Agent] = Num();
+	Agents.push_back(Agent);
+	return Agent;
+}
+
+int32_t FSimAgentIndex::Remove(FSimAgentId Agent)
+{
+	const int32_t Index = Dense[Agent];
+	const FSimAgentId Last = Agents.back();
+
+	// Last agent takes over the freed index
+	Agents[Index] = Last;
+	Dense[Last] = Index;
+	Agents.pop_back();
+
+	Dense[Agent] = InvalidIndex;
+	FreeIds.push_back(Agent);
+	return Index;
+}
+
+void FSimAgentIndex::Reserve(int32_t Count)
+{
+	Dense.reserve(Count);
+	Agents.reserve(Count);
+}
@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Simulation/SimParallel.h"
+
+#include <algorithm>
+
+FSimThreadPool::FSimThreadPool(int32_t NumWorkers)
+{
+	if (NumWorkers < 0)
+	{
+		NumWorkers = std::max(static_cast<int32_t>(std::thread::hardware_concurrency()) - 1, 0);
+	}
+
+	Workers.reserve(NumWorkers);
+	for (int32_t I = 0; I < NumWorkers; ++I)
+	{
+		Workers.emplace_back([this] { WorkerLoop(); });
+	}
+}
+
+FSimThreadPool::~FSimThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+		bStopping = true;
+	}
+	WorkReady.notify_all();
+
+	for (std::thread& Worker : Workers)
+	{
+		Worker.join();
+	}
+}
+
+void FSimThreadPool::ParallelFor(int32_t InNumTasks, const std::function<void(int32_t Task)>& InBody)
+{
+	if (Workers.empty() || InNumTasks <= 1)
+	{
+		for (int32_t Task = 0; Task < InNumTasks; ++Task)
+		{
+			InBody(Task);
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+		Body = &InBody;
+		NumTasks = InNumTasks;
+		NextTask.store(0, std::memory_order_relaxed);
+		NumBusy = static_cast<int32_t>(Workers.size());
+		++Generation;
+	}
+	WorkReady.notify_all();
+
+	RunTasks();
+
+	// Body must outlive every worker still in RunTasks
+	std::unique_lock<std::mutex> Lock(Mutex);
+	WorkDone.wait(Lock, [this] { return NumBusy == 0; });
+	Body = nullptr;
+}
+
+FSimParallelFor FSimThreadPool::AsParallelFor()
+{
+	return [this](int32_t InNumTasks, const std::function<void(int32_t Task)>& InBody)
+	{
+		ParallelFor(InNumTasks, InBody);
+	};
+}
+
+void FSimThreadPool::WorkerLoop()
+{
+	uint64_t SeenGeneration = 0;
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> Lock(Mutex);
+			WorkReady.wait(Lock, [this, SeenGeneration] { return bStopping || Generation != SeenGeneration; });
+			if (bStopping)
+			{
+				return;
+			}
+			SeenGeneration = Generation;
+		}
+
+		RunTasks();
+
+		bool bLast;
+		{
+			std::lock_guard<std::mutex> Lock(Mutex);
+			bLast = --NumBusy == 0;
+		}
+		if (bLast)
+		{
+			WorkDone.notify_one();
+		}
+	}
+}
+
+void FSimThreadPool::RunTasks()
+{
+	for (int32_t Task = NextTask.fetch_add(1); Task < NumTasks; Task = NextTask.fetch_add(1))
+	{
+		(*Body)(Task);
+	}
+}
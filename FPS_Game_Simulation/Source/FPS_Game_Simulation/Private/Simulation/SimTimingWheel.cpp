@@ -0,0 +1,138 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Simulation/SimTimingWheel.h"
+
+FSimTimingWheel::FSimTimingWheel()
+	: Head(NumLevels * NumSlots, None)
+{
+}
+
+void FSimTimingWheel::Reserve(int32_t Count)
+{
+	if (static_cast<int32_t>(Timers.size()) < Count)
+	{
+		Timers.resize(Count);
+	}
+}
+
+void FSimTimingWheel::Schedule(int32_t Timer, uint32_t Tick)
+{
+	Reserve(Timer + 1);
+	if (Timers[Timer].Slot != Unscheduled)
+	{
+		Unlink(Timer);
+	}
+	else
+	{
+		++Scheduled;
+	}
+
+	// The slot of the current tick has expired already
+	if (static_cast<int32_t>(Tick - CurrentTick) <= 0)
+	{
+		Tick = CurrentTick + 1;
+	}
+	Timers[Timer].DueTick = Tick;
+	Link(Timer);
+}
+
+void FSimTimingWheel::Cancel(int32_t Timer)
+{
+	if (IsScheduled(Timer))
+	{
+		Unlink(Timer);
+		Timers[Timer].Slot = Unscheduled;
+		--Scheduled;
+	}
+}
+
+int32_t FSimTimingWheel::Advance(uint32_t NumTicks, std::vector<int32_t>& Expired)
+{
+	int32_t NumMoved = 0;
+
+	for (uint32_t Step = 0; Step < NumTicks; ++Step)
+	{
+		if (Scheduled == 0)
+		{
+			CurrentTick += NumTicks - Step;
+			break;
+		}
+
+		++CurrentTick;
+
+		// Coarser slots come up when all finer levels wrap around, the coarsest first. A timer moves down into a slot
+		// that comes up later, or into the current tick's slot which expires below.
+		for (int32_t Level = NumLevels - 1; Level > 0; --Level)
+		{
+			const uint32_t LevelShift = SlotBits * Level;
+			if ((CurrentTick & ((1u << LevelShift) - 1)) != 0)
+			{
+				continue;
+			}
+
+			const int32_t Slot = Level * NumSlots + ((CurrentTick >> LevelShift) & (NumSlots - 1));
+			int32_t Timer = Head[Slot];
+			Head[Slot] = None;
+			while (Timer != None)
+			{
+				const int32_t NextTimer = Timers[Timer].Next;
+				Link(Timer);
+				Timer = NextTimer;
+				++NumMoved;
+			}
+		}
+
+		const int32_t Slot = CurrentTick & (NumSlots - 1);
+		for (int32_t Timer = Head[Slot]; Timer != None; Timer = Timers[Timer].Next)
+		{
+			Timers[Timer].Slot = Unscheduled;
+			Expired.push_back(Timer);
+			--Scheduled;
+		}
+		Head[Slot] = None;
+	}
+
+	return NumMoved;
+}
+
+void FSimTimingWheel::Link(int32_t Timer)
+{
+	FTimer& Linked = Timers[Timer];
+
+	// The finest level that reaches the due tick, a level of slots of 64^L ticks reaches 64^(L+1) ticks ahead
+	const uint32_t Delay = Linked.DueTick - CurrentTick;
+	const uint32_t Tick = Delay <= MaxDelay ? Linked.DueTick : CurrentTick + MaxDelay;
+	int32_t Level = 0;
+	while (Level < NumLevels - 1 && Tick - CurrentTick >= (1u << (SlotBits * (Level + 1))))
+	{
+		++Level;
+	}
+
+	const int32_t Slot = Level * NumSlots + ((Tick >> (SlotBits * Level)) & (NumSlots - 1));
+	Linked.Prev = None;
+	Linked.Next = Head[Slot];
+	if (Head[Slot] != None)
+	{
+		Timers[Head[Slot]].Prev = Timer;
+	}
+	Head[Slot] = Timer;
+	Linked.Slot = Slot;
+}
+
+void FSimTimingWheel::Unlink(int32_t Timer)
+{
+	const FTimer& Unlinked = Timers[Timer];
+	if (Unlinked.Prev != None)
+	{
+		Timers[Unlinked.Prev].Next = Unlinked.Next;
+	}
+	else
+	{
+		Head[Unlinked.Slot] = Unlinked.Next;
+	}
+	if (Unlinked.Next != None)
+	{
+		Timers[Unlinked.Next].Prev = Unlinked.Prev;
+	}
+}
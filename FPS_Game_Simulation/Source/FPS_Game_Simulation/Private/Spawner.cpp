@@ -4,6 +4,8 @@
 #include "Spawner.h"
 
 #include "Ammo.h"
+#include "PooledActor.h"
+#include "SpawnerRegistrySubsystem.h"
 #include "Components/BoxComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
@@ -25,7 +27,43 @@ void ASpawner::BeginPlay()
 {
 	Super::BeginPlay();
 
-	
+	// Fill the pool up front so the first spawns don't construct anything
+	if(bUsePool && ActorToSpawn)
+	{
+		Pool.Reserve(PoolPrewarmCount);
+		for (int32 Index = 0; Index < PoolPrewarmCount; ++Index)
+		{
+			if(AActor* const PrewarmedActor = SpawnNewActor(GetActorLocation(), FRotator::ZeroRotator))
+			{
+				AddToPool(PrewarmedActor, false);
+			}
+		}
+	}
+}
+
+void ASpawner::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Level actors look for their spawner in BeginPlay, all spawners of the level must be registered by then
+	UWorld* World = GetWorld();
+	if(World && World->IsGameWorld())
+	{
+		if(USpawnerRegistrySubsystem* Registry = World->GetSubsystem<USpawnerRegistrySubsystem>())
+		{
+			Registry->RegisterSpawner(this);
+		}
+	}
+}
+
+void ASpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if(USpawnerRegistrySubsystem* Registry = GetWorld()->GetSubsystem<USpawnerRegistrySubsystem>())
+	{
+		Registry->UnregisterSpawner(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 FVector ASpawner::GetRandomPointInBox()
@@ -46,20 +84,120 @@ void ASpawner::Spawn()
 	GEngine->AddOnScreenDebugMessage(-1, 10.f, FColor::Red, TEXT("spawning"));
 	if(ActorToSpawn)
 	{
-		UWorld* World = GetWorld();
-		if(World)
+		FVector SpawnLocation = GetRandomPointInBox();
+		FRotator SpawnRotation = FRotator::ZeroRotator;
+
+		// Bring back a pooled actor if there is a free one
+		if(bUsePool)
+		{
+			if(AActor* const PooledActor = Pool.Acquire())
+			{
+				PooledActor->SetActorLocationAndRotation(SpawnLocation, SpawnRotation, false, nullptr, ETeleportType::ResetPhysics);
+				SetPooledActorActive(PooledActor, true);
+				UE_LOG(LogTemp, Verbose, TEXT("%s spawned %s from its pool"), *GetName(), *PooledActor->GetName());
+				return;
+			}
+		}
+
+		AActor* const SpawnedActor = SpawnNewActor(SpawnLocation, SpawnRotation);
+		if(bUsePool && SpawnedActor)
 		{
-			FActorSpawnParameters SpawnParameters;
-			SpawnParameters.Owner = this;
-			// SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding;
-
-			FVector SpawnLocation = GetRandomPointInBox();
-			FRotator SpawnRotation = FRotator::ZeroRotator;
-			
-			AActor* const SpawnedAmmo = World->SpawnActor<AActor>(ActorToSpawn, SpawnLocation, SpawnRotation, SpawnParameters);
-			GEngine->AddOnScreenDebugMessage(-1, 10.f, FColor::Red, TEXT("spawned"));
+			AddToPool(SpawnedActor, true);
 		}
+		GEngine->AddOnScreenDebugMessage(-1, 10.f, FColor::Red, TEXT("spawned"));
+	}
+}
+
+bool ASpawner::ReturnToPool(AActor* Actor)
+{
+	if(!bUsePool || !Actor || Actor->GetClass() != ActorToSpawn)
+	{
+		return false;
+	}
+
+	// Actors placed in the level join the pool when they are done
+	if(!Pool.Contains(Actor))
+	{
+		AddToPool(Actor, true);
+	}
+
+	if(Pool.Release(Actor))
+	{
+		SetPooledActorActive(Actor, false);
+	}
+	return true;
+}
+
+FSpawnerPoolStats ASpawner::GetPoolStats() const
+{
+	const FSimPoolStats& Stats = Pool.GetStats();
+
+	FSpawnerPoolStats PoolStats;
+	PoolStats.NumActors = Stats.NumItems;
+	PoolStats.NumActive = Stats.NumActive;
+	PoolStats.NumFree = Pool.NumFree();
+	PoolStats.PeakActive = Stats.PeakActive;
+	PoolStats.NumReused = Stats.NumReused;
+	PoolStats.NumSpawned = Stats.NumMissed;
+	PoolStats.NumReturned = Stats.NumReleased;
+	return PoolStats;
+}
+
+AActor* ASpawner::SpawnNewActor(const FVector& Location, const FRotator& Rotation)
+{
+	UWorld* World = GetWorld();
+	if(!World)
+	{
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.Owner = this;
+	// SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding;
+
+	return World->SpawnActor<AActor>(ActorToSpawn, Location, Rotation, SpawnParameters);
+}
+
+void ASpawner::AddToPool(AActor* Actor, bool bActive)
+{
+	if(!Pool.Add(Actor, bActive))
+	{
+		return;
+	}
+
+	PooledActors.Add(Actor);
+	Actor->OnDestroyed.AddDynamic(this, &ASpawner::OnPooledActorDestroyed);
+	if(!bActive)
+	{
+		SetPooledActorActive(Actor, false);
 	}
 }
 
+void ASpawner::SetPooledActorActive(AActor* Actor, bool bActive)
+{
+	IPooledActor* PooledActor = Cast<IPooledActor>(Actor);
+	if(PooledActor && !bActive)
+	{
+		PooledActor->OnReturnedToPool();
+	}
+
+	Actor->SetActorHiddenInGame(!bActive);
+	Actor->SetActorEnableCollision(bActive);
+	// Only ticks that were on when spawned are turned on again
+	Actor->SetActorTickEnabled(bActive && Actor->PrimaryActorTick.bStartWithTickEnabled);
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		Component->SetComponentTickEnabled(bActive && Component->PrimaryComponentTick.bStartWithTickEnabled);
+	}
+
+	if(PooledActor && bActive)
+	{
+		PooledActor->OnTakenFromPool();
+	}
+}
 
+void ASpawner::OnPooledActorDestroyed(AActor* DestroyedActor)
+{
+	Pool.Remove(DestroyedActor);
+	PooledActors.RemoveSingleSwap(DestroyedActor);
+}
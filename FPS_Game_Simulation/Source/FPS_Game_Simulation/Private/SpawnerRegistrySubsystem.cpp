@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SpawnerRegistrySubsystem.h"
+
+#include "Engine/World.h"
+#include "Spawner.h"
+
+void USpawnerRegistrySubsystem::RegisterSpawner(ASpawner* Spawner)
+{
+	for (const FName& Tag : Spawner->Tags)
+	{
+		Registry.Register(ToKey(Tag), Spawner);
+	}
+}
+
+void USpawnerRegistrySubsystem::UnregisterSpawner(ASpawner* Spawner)
+{
+	for (const FName& Tag : Spawner->Tags)
+	{
+		Registry.Unregister(ToKey(Tag), Spawner);
+	}
+}
+
+ASpawner* USpawnerRegistrySubsystem::FindSpawner(FName Tag) const
+{
+	return Registry.Find(ToKey(Tag));
+}
+
+ASpawner* USpawnerRegistrySubsystem::FindSpawnerOf(const AActor* Actor, FName Tag)
+{
+	// Spawners own what they spawn
+	ASpawner* Owner = Cast<ASpawner>(Actor->GetOwner());
+	if(Owner && Owner->ActorHasTag(Tag))
+	{
+		return Owner;
+	}
+
+	// Placed in the level
+	const USpawnerRegistrySubsystem* Registry = Actor->GetWorld()->GetSubsystem<USpawnerRegistrySubsystem>();
+	return Registry ? Registry->FindSpawner(Tag) : nullptr;
+}
+
+TSpawnerRegistry<ASpawner>::FKey USpawnerRegistrySubsystem::ToKey(FName Tag)
+{
+	// Same comparison ActorHasTag makes, tags are case insensitive
+	return static_cast<uint64>(Tag.GetComparisonIndex().ToUnstableInt()) << 32 | static_cast<uint32>(Tag.GetNumber());
+}
@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WeaponTraceSubsystem.h"
+
+#include "Components/CapsuleComponent.h"
+#include "Enemy.h"
+#include "EnemyMovementSubsystem.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Weapon Trace"), STAT_WeaponTrace, STATGROUP_Game);
+
+namespace
+{
+	FSimVector ToSimVector(const FVector& Vector)
+	{
+		return FSimVector(static_cast<float>(Vector.X), static_cast<float>(Vector.Y), static_cast<float>(Vector.Z));
+	}
+}
+
+void UWeaponTraceSubsystem::TraceShots(TArrayView<const FWeaponShot> Shots, TArray<FWeaponShotResult>& OutResults)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WeaponTrace);
+
+	UpdateTargets();
+
+	UWorld* World = GetWorld();
+	OutResults.Reset();
+	OutResults.SetNum(Shots.Num());
+	Rays.resize(Shots.Num());
+
+	// Enemies are left to the hitscan core, the engine trace only looks for level geometry
+	FCollisionResponseParams ResponseParams;
+	ResponseParams.CollisionResponse.SetResponse(ECC_Pawn, ECR_Ignore);
+
+	for (int32 Index = 0; Index < Shots.Num(); ++Index)
+	{
+		const FWeaponShot& Shot = Shots[Index];
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(WeaponTrace), false, Shot.IgnoredActor);
+		FHitResult HitResult;
+		World->LineTraceSingleByChannel(HitResult, Shot.Start, Shot.Start + Shot.Direction * Shot.Range, ECC_Camera,
+			QueryParams, ResponseParams);
+
+		OutResults[Index].FirstHit = HitResult.GetActor();
+
+		// Enemies behind level geometry can't be hit
+		FHitscanRay& Ray = Rays[Index];
+		Ray.Start = ToSimVector(Shot.Start);
+		Ray.Direction = ToSimVector(Shot.Direction);
+		Ray.Length = HitResult.bBlockingHit ? HitResult.Distance : Shot.Range;
+		Ray.bPierce = Shot.bPierce;
+	}
+
+	HitscanCore.Trace(Rays.data(), static_cast<int32_t>(Rays.size()), HitscanResults);
+
+	for (int32 Index = 0; Index < Shots.Num(); ++Index)
+	{
+		FWeaponShotResult& Result = OutResults[Index];
+		const FHitscanHit* Hits = HitscanResults.GetHits(Index);
+		for (int32 Hit = 0; Hit < HitscanResults.NumHits(Index); ++Hit)
+		{
+			// An earlier shot of this frame may have killed it
+			AEnemy* Enemy = Targets[Hits[Hit].Target];
+			if (IsValid(Enemy))
+			{
+				Result.Enemies.Add(Enemy);
+			}
+		}
+
+		if (Result.Enemies.Num() > 0)
+		{
+			Result.FirstHit = Result.Enemies[0];
+		}
+	}
+}
+
+void UWeaponTraceSubsystem::UpdateTargets()
+{
+	if (TargetsFrame == GFrameCounter)
+	{
+		return;
+	}
+	TargetsFrame = GFrameCounter;
+
+	GatheredTargets.Reset();
+	if (const UEnemyMovementSubsystem* EnemyMovement = GetWorld()->GetSubsystem<UEnemyMovementSubsystem>())
+	{
+		for (AEnemy* Enemy : EnemyMovement->GetEnemies())
+		{
+			if (IsValid(Enemy))
+			{
+				GatheredTargets.Add(Enemy);
+			}
+		}
+	}
+
+	Capsules.resize(GatheredTargets.Num());
+	for (int32 Index = 0; Index < GatheredTargets.Num(); ++Index)
+	{
+		const UCapsuleComponent* Capsule = GatheredTargets[Index]->GetCapsuleComponent();
+		Capsules[Index].Center = ToSimVector(Capsule->GetComponentLocation());
+		Capsules[Index].HalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+		Capsules[Index].Radius = Capsule->GetScaledCapsuleRadius();
+	}
+
+	// Same enemies as last time only moved, nobody spawned or died
+	if (GatheredTargets == Targets)
+	{
+		HitscanCore.Refit(Capsules);
+	}
+	else
+	{
+		Targets = GatheredTargets;
+		HitscanCore.Build(Capsules);
+	}
+}
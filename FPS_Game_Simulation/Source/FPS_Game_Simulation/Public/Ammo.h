@@ -4,10 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "PooledActor.h"
+#include "Simulation/SimulationTypes.h"
 #include "Ammo.generated.h"
 
 UCLASS()
-class FPS_GAME_SIMULATION_API AAmmo : public AActor
+class FPS_GAME_SIMULATION_API AAmmo : public AActor, public IPooledActor
 {
 	GENERATED_BODY()
 	
@@ -19,9 +21,16 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	// Called when the ammo is destroyed or the level ends
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// A pooled ammo comes back full
+	virtual void OnTakenFromPool() override;
+	virtual void OnReturnedToPool() override;
+
 public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	// Called by UPickupSubsystem when character got into the interact sphere
+	void OnReachedBy(class AFPS_Game_SimulationCharacter* Character);
 
 	// Ammo amount 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
@@ -40,19 +49,19 @@ private:
 	UPROPERTY(EditDefaultsOnly)
 	class UBoxComponent* BoxComponent;
 
-	// If player overlaps with sphere component s/he can gain ammo
+	// If player gets into this sphere s/he can gain ammo. It has no collision, UPickupSubsystem only takes its radius.
 	UPROPERTY(EditDefaultsOnly)
 	class USphereComponent* InteractSphereComponent;
-	
-	UFUNCTION()
-	void OnSphereBeginOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp,
-		int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 
-	// FPS character Ref
-	class AFPS_Game_SimulationCharacter* Character;
-	
-	// Weapon Ref
-	class UTP_WeaponComponent* Weapon;
+	// Checks the players against this ammo
+	UPROPERTY()
+	class UPickupSubsystem* PickupSubsystem;
+
+	// Id of this ammo in the pickup subsystem
+	FSimAgentId PickupId = InvalidSimAgent;
+
+	void RegisterPickup();
+	void UnregisterPickup();
 	
 	// Spawner Ref
 	class ASpawner* Spawner;
@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Simulation/DamageQueueCore.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DamageSubsystem.generated.h"
+
+class AFPS_Game_SimulationCharacter;
+
+// Queues the damage dealt during a frame and applies it once per frame with FDamageQueueCore: one hit per damaged
+// enemy or player, a shot counts once per target. Kills are handed to AEnemy::OnKilled and the players' game over,
+// the XP and kill score of a frame go to each player at once. Enemies and player characters register in BeginPlay.
+UCLASS()
+class FPS_GAME_SIMULATION_API UDamageSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Adds an enemy or player character that can take damage, returns its id in the queue
+	FSimAgentId RegisterTarget(AActor* Target);
+
+	// Removes the target, damage queued for it is dropped
+	void UnregisterTarget(FSimAgentId Target);
+
+	// Id for the damage of one weapon shot
+	FORCEINLINE uint32 NewShot() { return DamageQueue.NewShot(); }
+
+	// Damages Target at the end of the frame. Instigator is the id of the player who dealt it, if any.
+	FORCEINLINE void QueueDamage(FSimAgentId Target, float Amount, uint32 Shot = FDamageQueueCore::NoShot,
+		FSimAgentId Instigator = InvalidSimAgent)
+	{
+		DamageQueue.Push(Target, Amount, Shot, Instigator);
+	}
+
+	// Events, hits and kills of the last frame that had damage
+	FORCEINLINE const FDamageQueueStats& GetStats() const { return DamageQueue.GetStats(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FDamageQueueCore DamageQueue;
+
+	// Registered targets by id
+	UPROPERTY()
+	TArray<AActor*> Targets;
+
+	// Enemies killed this frame per player
+	TMap<AFPS_Game_SimulationCharacter*, int32> KillsByPlayer;
+};
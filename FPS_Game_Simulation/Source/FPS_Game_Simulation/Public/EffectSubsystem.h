@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Simulation/EffectCore.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EffectSubsystem.generated.h"
+
+// Stats effects modify, indices of the stats in UEffectSubsystem's FEffectCore
+enum class EEffectStat : int32
+{
+	MoveSpeed,
+	JumpVelocity,
+	ShotDamage,
+	AmmoLimit,
+	// 1 while shots pierce through enemies
+	PierceShot,
+	Num
+};
+
+// Runs the timed effects of the world with one FEffectCore, today the talents of the player characters and their
+// weapons. An owner registers with its base stats and applies effects by spec id, instead of arming a timer and writing
+// a reset function per effect. Owners are told when their stats changed and when an effect ran out.
+UCLASS()
+class FPS_GAME_SIMULATION_API UEffectSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Id of what an effect does, shared by all owners. A spec is registered the first time it is asked for, owners
+	// describing the same effect (every character's Super Sprint, again after a respawn) get the same id.
+	FEffectSpecId FindOrAddSpec(const FEffectSpec& Spec);
+
+	// Adds a character or weapon with EEffectStat::Num base stats, returns its id in the effect core
+	FSimAgentId RegisterOwner(UObject* Owner, const float* BaseStats);
+
+	// Removes the owner, its effects end without running out
+	void UnregisterOwner(FSimAgentId Owner);
+
+	// Stats change at the end of the frame, returns false if the owner has too many effects
+	FORCEINLINE bool ApplyEffect(FSimAgentId Owner, FEffectSpecId Spec) { return Effects.Apply(Owner, Spec); }
+
+	FORCEINLINE void SetBaseStat(FSimAgentId Owner, EEffectStat Stat, float Value)
+	{
+		Effects.SetBaseStat(Owner, static_cast<int32>(Stat), Value);
+	}
+
+	FORCEINLINE float GetStat(FSimAgentId Owner, EEffectStat Stat) const
+	{
+		return Effects.GetStat(Owner, static_cast<int32>(Stat));
+	}
+
+	// Seconds until the owner's effect runs out, 0 if it has none
+	FORCEINLINE float GetRemainingTime(FSimAgentId Owner, FEffectSpecId Spec) const
+	{
+		return Effects.GetRemainingTime(Owner, Spec);
+	}
+
+	// Effects active and what the last frame did
+	FORCEINLINE const FEffectStats& GetStats() const { return Effects.GetStats(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FEffectCore Effects;
+
+	// Registered owners by id
+	UPROPERTY()
+	TArray<UObject*> Owners;
+};
@@ -4,11 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "PooledActor.h"
+#include "Simulation/SimulationTypes.h"
 #include "Enemy.generated.h"
 class UBoxComponent;
 
-UCLASS()
-class FPS_GAME_SIMULATION_API AEnemy : public ACharacter
+UCLASS(meta=(ChildCanTick))
+class FPS_GAME_SIMULATION_API AEnemy : public ACharacter, public IPooledActor
 {
 	GENERATED_BODY()
 
@@ -20,10 +22,14 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
-public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	// Called when the enemy is destroyed or the level ends
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
+	// A pooled enemy starts a new life at its new location
+	virtual void OnTakenFromPool() override;
+	virtual void OnReturnedToPool() override;
+
+public:
 	// Called to bind functionality to input
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
@@ -43,17 +49,14 @@ public:
 	void OnHitEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
 		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
 
-	// To implement senses for an actor (sight, hear etc..)
-	UPROPERTY(VisibleDefaultsOnly, Category="Enemy")
-	class UAIPerceptionComponent* AIPerceptionComponent;
+	// Called by the movement subsystem when enemy saw the player, enemy chases with NewVelocity unless attacking
+	void OnSightGained(const FVector& TargetLocation, const FVector& NewVelocity);
 
-	// Is used for configure AI perception component for site detection
-	UPROPERTY(VisibleDefaultsOnly, Category="Enemy")
-	class UAISenseConfig_Sight* SightConfig;
+	// Called by the movement subsystem when enemy lost the player and heads back to base with NewVelocity
+	void OnSightLost(const FVector& NewVelocity);
 
-	// This will inform enemy if any actors are detected by AI perception
-	UFUNCTION()
-	void OnSensed(const TArray<AActor*> &UpdatedActors);
+	// Called by the movement subsystem when the path to the player bends, enemy keeps chasing with NewVelocity
+	void OnTurned(const FVector& NewVelocity);
 
 	// Enemy rotation
 	UPROPERTY(VisibleAnywhere, Category="Movement")
@@ -74,13 +77,15 @@ public:
 	// Sets new rotation for enemy
 	void SetNewRotation(FVector TargetPosition, FVector CurrentPosition);
 
-	// Checks if enemy back to its base location
-	bool bBackToBaseLocation;
-	
-	FVector NewLocation;
-	
-	// Calculation result for the distance between enemy and player
-	float DistanceSquared;
+	// Called by the movement subsystem when enemy got back to its base location and stopped
+	void OnReturnedToBaseLocation();
+
+	// Moves the enemy to where the movement subsystem moved it, and the mesh back onto the capsule
+	void SetSimulatedLocation(const FVector& Location);
+
+	// Moves only the mesh to Location, for frames the movement subsystem skipped this enemy. The capsule catches up
+	// at the next update.
+	void SetInterpolatedLocation(const FVector& Location);
 
 	// Current health of enemy
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
@@ -90,10 +95,16 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	float DamageValue = 5.f;
 
-	// Getting damage by player
+	// Getting damage by player, applied with all other damage at the end of the frame
 	UFUNCTION(BlueprintCallable)
 	void DealDamage(float DamageAmount);
 
+	// Called by the damage subsystem when health dropped to zero, the players got their XP already
+	void OnKilled();
+
+	// Id of this enemy in the damage subsystem
+	FORCEINLINE FSimAgentId GetDamageTarget() const { return DamageTarget; }
+
 private:
 	// Spawner Ref
 	class ASpawner* Spawner;
@@ -104,5 +115,21 @@ private:
 
 	// Character Ref
 	class AFPS_Game_SimulationCharacter* Character;
+
+	// Moves this enemy together with all others, enemies don't tick
+	UPROPERTY()
+	class UEnemyMovementSubsystem* MovementSubsystem;
+
+	// Id of this enemy in the movement subsystem
+	FSimAgentId MovementAgent = InvalidSimAgent;
+
+	// Applies the damage this enemy takes together with all other damage
+	UPROPERTY()
+	class UDamageSubsystem* DamageSubsystem;
+
+	FSimAgentId DamageTarget = InvalidSimAgent;
+
+	// Mesh is ahead of the capsule, see SetInterpolatedLocation
+	bool bMeshInterpolated = false;
 };
 
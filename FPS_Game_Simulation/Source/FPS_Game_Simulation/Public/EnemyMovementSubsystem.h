@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Simulation/EnemyMovementCore.h"
+#include "Simulation/FlowFieldCore.h"
+#include "Simulation/SightQueryCore.h"
+#include "Simulation/SignificanceCore.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyMovementSubsystem.generated.h"
+
+class AEnemy;
+
+// Moves all enemies of the world in one batched FEnemyMovementCore step per frame, then checks in one FSightQueryCore
+// query which of them see a player and copies the results to the enemy actors. Enemies register in BeginPlay and
+// don't tick or perceive by themselves. Distant enemies and the ones behind the players are only moved every 4th or
+// 16th frame or not at all, as FSignificanceCore schedules them; in between their meshes are interpolated. Chasing
+// enemies walk around obstacles along one FFlowFieldCore field per player.
+UCLASS()
+class FPS_GAME_SIMULATION_API UEnemyMovementSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Adds enemy to the batch, returns its agent id in the movement core
+	FSimAgentId RegisterEnemy(AEnemy* Enemy);
+
+	// Removes enemy from the batch
+	void UnregisterEnemy(FSimAgentId Agent);
+
+	// Starts moving from the current actor location with Velocity
+	void MoveEnemy(FSimAgentId Agent, const FVector& Location, const FVector& Velocity);
+
+	// Stops enemy where it is
+	void StopEnemy(FSimAgentId Agent);
+
+	// Heads enemy back to its base location, returns false if it is already there
+	bool ReturnEnemyToBase(FSimAgentId Agent, const FVector& Location);
+
+	// Attacking enemies don't chase the players they see
+	void SetEnemyAttacking(FSimAgentId Agent, bool bAttacking);
+
+	// Direction enemy looks at for sight checks
+	void SetEnemyFacing(FSimAgentId Agent, const FVector& Direction);
+
+	// Chasing enemies walk around Box, called by obstacles in BeginPlay
+	void AddObstacle(const FBox& Box);
+
+	// Undoes AddObstacle with the same box, called by obstacles in EndPlay
+	void RemoveObstacle(const FBox& Box);
+
+	FORCEINLINE int32 GetNumEnemies() const { return MovementCore.Num(); }
+
+	// Registered enemies by agent id, null where an enemy unregistered
+	FORCEINLINE const TArray<AEnemy*>& GetEnemies() const { return Enemies; }
+
+	// Enemies per update rate and how many were moved in the last frame
+	FORCEINLINE const FSignificanceStats& GetSignificanceStats() const { return Significance.GetStats(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FEnemyMovementCore MovementCore;
+
+	// Same values the enemies' UAISenseConfig_Sight used to have
+	FSightConfig SightConfig;
+	FSightQueryCore SightQuery;
+
+	// Update rate of every enemy, indexed like the movement core's dense columns
+	FSignificanceCore Significance;
+	std::vector<FSignificanceViewer> Viewers;
+
+	// Paths of chasing enemies to each of the SightTargets
+	FFlowFieldCore FlowField;
+
+	// Time each enemy moves by this frame, zero for the ones not scheduled
+	std::vector<float> AgentDeltaTimes;
+
+	// Registered enemies by agent id
+	UPROPERTY()
+	TArray<AEnemy*> Enemies;
+
+	// Player characters enemies can see this frame, and their locations for the sight query
+	TArray<AActor*> SightTargets;
+	std::vector<FSimVector> SightTargetLocations;
+
+	// Sight query result by dense agent index
+	std::vector<int32_t> VisibleTargets;
+
+	// Collects the player characters and where the players look from
+	void GatherPlayers();
+
+	// Brings the flow field of every player up to date, players who stayed in their cell keep theirs
+	void UpdateFlowField();
+
+	// Moves the enemies scheduled for this frame
+	void StepMovement(float DeltaTime);
+
+	// Runs the sight query for all enemies and lets the movement core react to it
+	void UpdateSight(float DeltaTime);
+
+	// Nothing blocks the view from enemy to target
+	bool HasLineOfSight(const AEnemy* Enemy, const AActor* Target) const;
+
+	static FSimVector ToSimVector(const FVector& Vector);
+	static FVector ToVector(const FSimVector& Vector);
+};
@@ -4,10 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "PooledActor.h"
+#include "Simulation/SimulationTypes.h"
 #include "Health.generated.h"
 
 UCLASS()
-class FPS_GAME_SIMULATION_API AHealth : public AActor
+class FPS_GAME_SIMULATION_API AHealth : public AActor, public IPooledActor
 {
 	GENERATED_BODY()
 	
@@ -19,9 +21,16 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	// Called when the health is destroyed or the level ends
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// A pooled health joins the pickup grid at its new location
+	virtual void OnTakenFromPool() override;
+	virtual void OnReturnedToPool() override;
+
 public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	// Called by UPickupSubsystem when character got into the interact sphere
+	void OnReachedBy(class AFPS_Game_SimulationCharacter* Character);
 
 protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
@@ -36,16 +45,19 @@ private:
 	UPROPERTY(EditDefaultsOnly)
 	class UBoxComponent* BoxComponent;
 
-	// If player overlaps with sphere component s/he gain health
+	// If player gets into this sphere s/he gain health. It has no collision, UPickupSubsystem only takes its radius.
 	UPROPERTY(EditDefaultsOnly)
 	class USphereComponent* InteractSphereComponent;
 
-	UFUNCTION()
-	void OnSphereBeginOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp,
-		int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+	// Checks the players against this health
+	UPROPERTY()
+	class UPickupSubsystem* PickupSubsystem;
+
+	// Id of this health in the pickup subsystem
+	FSimAgentId PickupId = InvalidSimAgent;
 
-	// FPS character Ref
-	class AFPS_Game_SimulationCharacter* Character;
+	void RegisterPickup();
+	void UnregisterPickup();
 
 	// Spawner Ref
 	class ASpawner* Spawner;
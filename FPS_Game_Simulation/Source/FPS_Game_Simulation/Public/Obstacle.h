@@ -20,14 +20,13 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	// Called when the obstacle is destroyed or the level ends
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	UFUNCTION()
 	virtual void NotifyHit(UPrimitiveComponent* MyComp, AActor* Other, UPrimitiveComponent* OtherComp,
 		bool bSelfMoved, FVector HitLocation, FVector HitNormal, FVector NormalImpulse, const FHitResult& Hit) override;
 
-public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
-
 private:
 	UPROPERTY(EditDefaultsOnly)
 	UStaticMeshComponent* MeshComponent;
@@ -36,6 +35,10 @@ private:
 	float DamageAmount = 30.f;
 
 	AFPS_Game_SimulationCharacter* FPSCharacter;
+
+	// The box blocked in the enemies' flow field, unblocked again in EndPlay
+	FBox BlockedBox;
+	bool bBlocksFlowField = false;
 	
 
 };
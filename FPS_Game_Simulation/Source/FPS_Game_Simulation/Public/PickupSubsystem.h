@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Simulation/PickupCore.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PickupSubsystem.generated.h"
+
+// Tests the players against all ammo and health pickups of the world once per frame with FPickupGridCore and hands
+// the pickups they reached to AAmmo::OnReachedBy and AHealth::OnReachedBy. Pickups register in BeginPlay and have
+// neither overlap events nor ticking of their own.
+UCLASS()
+class FPS_GAME_SIMULATION_API UPickupSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Adds a pickup sphere at the actor location, returns its id in the grid
+	FSimAgentId RegisterPickup(AActor* Pickup, float Radius);
+
+	// Removes the pickup, e.g. when it got picked up
+	void UnregisterPickup(FSimAgentId Pickup);
+
+	FORCEINLINE int32 GetNumPickups() const { return PickupGrid.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FPickupGridCore PickupGrid;
+
+	// Registered pickups by id
+	UPROPERTY()
+	TArray<AActor*> Pickups;
+
+	// Player characters of this frame, and their capsules for the query
+	UPROPERTY()
+	TArray<class AFPS_Game_SimulationCharacter*> Players;
+	std::vector<FPickupPlayer> PlayerCapsules;
+
+	std::vector<FPickupContact> Contacts;
+};
@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "PooledActor.generated.h"
+
+UINTERFACE(MinimalAPI, meta=(CannotImplementInterfaceInBlueprint))
+class UPooledActor : public UInterface
+{
+	GENERATED_BODY()
+};
+
+// Actors a pooling ASpawner hides and reuses instead of destroying and spawning again. BeginPlay only runs for the
+// first life of a pooled actor, state of a single life is reset here.
+class FPS_GAME_SIMULATION_API IPooledActor
+{
+	GENERATED_BODY()
+
+public:
+	// Called after the spawner moved the actor to its new location and showed it again
+	virtual void OnTakenFromPool() {}
+
+	// Called before the spawner hides the actor
+	virtual void OnReturnedToPool() {}
+};
@@ -0,0 +1,134 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Simulation/SimAgentIndex.h"
+#include "Simulation/SimulationTypes.h"
+
+#include <vector>
+
+// What the last Resolve and ApplyHits did
+struct FDamageQueueStats
+{
+	// Events pushed since the previous Resolve
+	int32_t NumEvents = 0;
+	// Events for targets that weren't registered or were removed in the meantime
+	int32_t NumDropped = 0;
+	// Events of a shot that already hit the same target
+	int32_t NumDuplicates = 0;
+	// Targets damaged
+	int32_t NumHits = 0;
+	// Targets whose health dropped to zero
+	int32_t NumKills = 0;
+};
+
+// Collects the damage events of a frame and applies them in one pass. Events are coalesced into their target as they
+// are pushed: a shot hits each target at most once however often it was reported, everything else is summed into one
+// hit per target. Resolve gathers the hits, their health is then updated in a loop the compiler vectorizes.
+//
+// Health isn't kept here, the caller copies it in for the hit targets only:
+//
+//	Resolve(); write GetHitHealth()[Hit] for every hit; ApplyHits(); copy GetHitHealth() back; handle GetKills().
+class FDamageQueueCore
+{
+public:
+	// Events of this shot are never taken for duplicates, e.g. damage over time or contact damage
+	static constexpr uint32_t NoShot = 0;
+
+	// Adds something that can take damage
+	FSimAgentId AddTarget();
+
+	// Removes the target, its pending events are dropped
+	void RemoveTarget(FSimAgentId Target);
+
+	int32_t NumTargets() const { return Index.Num(); }
+	void Reserve(int32_t NumTargetsToReserve);
+
+	// Id for the events of one shot, a pierce shot that reports a target twice damages it once
+	uint32_t NewShot();
+
+	// Queues Amount of damage to Target until the next Resolve. Amounts of zero or less are ignored. The events of a
+	// shot must be pushed before those of the target's next shot, as a weapon does when it fires.
+	void Push(FSimAgentId Target, float Amount, uint32_t Shot = NoShot, FSimAgentId Instigator = InvalidSimAgent);
+
+	int32_t NumPending() const { return PendingStats.NumEvents; }
+
+	// Turns the pending damage into one hit per damaged target and empties the queue. Returns the number of hits,
+	// indexed from 0 by the accessors below until the next Resolve.
+	int32_t Resolve();
+
+	int32_t NumHits() const { return static_cast<int32_t>(HitTarget.size()); }
+	FSimAgentId HitTargetAt(int32_t Hit) const { return HitTarget[Hit]; }
+	float HitDamageAt(int32_t Hit) const { return HitDamage[Hit]; }
+	// Instigator of the target's last event
+	FSimAgentId HitInstigatorAt(int32_t Hit) const { return HitInstigator[Hit]; }
+
+	// Health of each hit target, filled in by the caller before ApplyHits and updated by it
+	float* GetHitHealth() { return HitHealth.data(); }
+	const float* GetHitHealth() const { return HitHealth.data(); }
+
+	// Takes the damage off the hit health. A target with health left before and none after is killed, returns the
+	// number of kills.
+	int32_t ApplyHits();
+
+	// Hits that killed their target, in order
+	const std::vector<int32_t>& GetKills() const { return Kills; }
+
+	const FDamageQueueStats& GetStats() const { return Stats; }
+
+private:
+	FSimAgentIndex Index;
+	uint32_t LastShot = NoShot;
+
+	// Damage of the frame so far, by target id. Every push touches all fields, one array of them costs a single cache
+	// line per event.
+	struct FPending
+	{
+		float Damage = 0.f;
+		FSimAgentId Instigator = InvalidSimAgent;
+		uint32_t LastShot = NoShot;
+		// Events that weren't duplicates, 0 for targets without damage
+		int32_t NumEvents = 0;
+	};
+
+	std::vector<FPending> Pending;
+	FDamageQueueStats PendingStats;
+
+	// Hits, one per damaged target
+	std::vector<FSimAgentId> HitTarget;
+	std::vector<float> HitDamage;
+	std::vector<FSimAgentId> HitInstigator;
+	std::vector<float> HitHealth;
+	std::vector<uint8_t> KillMask;
+	std::vector<int32_t> Kills;
+
+	FDamageQueueStats Stats;
+};
+
+// Called once per event, inline so a loop of pushes stays one loop
+inline void FDamageQueueCore::Push(FSimAgentId Target, float Amount, uint32_t Shot, FSimAgentId Instigator)
+{
+	if (!(Amount > 0.f))
+	{
+		return;
+	}
+
+	++PendingStats.NumEvents;
+	if (!Index.IsValid(Target))
+	{
+		++PendingStats.NumDropped;
+		return;
+	}
+
+	FPending& TargetPending = Pending[Target];
+	if (Shot != NoShot && Shot == TargetPending.LastShot)
+	{
+		++PendingStats.NumDuplicates;
+		return;
+	}
+
+	TargetPending.Damage += Amount;
+	TargetPending.Instigator = Instigator;
+	TargetPending.LastShot = Shot;
+	++TargetPending.NumEvents;
+}
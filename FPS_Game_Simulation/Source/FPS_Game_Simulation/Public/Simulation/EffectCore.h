@@ -0,0 +1,189 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Simulation/SimAgentIndex.h"
+#include "Simulation/SimTimingWheel.h"
+#include "Simulation/SimulationTypes.h"
+
+#include <vector>
+
+using FEffectSpecId = int32_t;
+
+enum class EEffectModifier : uint8_t
+{
+	// Stat is (Base + sum of Add) * product of Multiply
+	Add,
+	Multiply,
+	// Stat is the magnitude of the most recently applied override, whatever the others say
+	Override,
+};
+
+enum class EEffectStacking : uint8_t
+{
+	// Applying it again restarts the duration of the one instance
+	Refresh,
+	// Each application is an instance of its own up to MaxStacks, beyond that the one expiring first is restarted
+	Stack,
+};
+
+// What an effect does, registered once with AddSpec and applied by its id
+struct FEffectSpec
+{
+	int32_t Stat = 0;
+	EEffectModifier Modifier = EEffectModifier::Add;
+	float Magnitude = 0.f;
+	// Seconds, effects of 0 or less last until removed
+	float Duration = 0.f;
+	EEffectStacking Stacking = EEffectStacking::Refresh;
+	int32_t MaxStacks = 1;
+
+	bool operator==(const FEffectSpec& Other) const
+	{
+		return Stat == Other.Stat && Modifier == Other.Modifier && Magnitude == Other.Magnitude &&
+			Duration == Other.Duration && Stacking == Other.Stacking && MaxStacks == Other.MaxStacks;
+	}
+};
+
+struct FEffectConfig
+{
+	// Stats of each owner, specs modify one of them by index
+	int32_t NumStats = 4;
+
+	// Effects an owner can have at once, its effects are kept next to each other in slots of this many
+	int32_t EffectsPerOwner = 8;
+
+	// Durations are rounded up to whole ticks of the timing wheel
+	float TickSeconds = 0.05f;
+};
+
+struct FEffectStats
+{
+	int32_t NumActive = 0;
+	// Since the previous Update
+	int32_t NumApplied = 0;
+	int32_t NumRefreshed = 0;
+	// Applications refused because the owner had no free slot
+	int32_t NumRefused = 0;
+	int32_t NumExpired = 0;
+	// Owners whose stats were computed again, and the ones whose stats came out different
+	int32_t NumRecomputed = 0;
+	int32_t NumChanged = 0;
+	// Timers moved down a level of the timing wheel
+	int32_t NumCascaded = 0;
+};
+
+// An effect of an owner that ran out during the last Update
+struct FExpiredEffect
+{
+	FSimAgentId Owner = InvalidSimAgent;
+	FEffectSpecId Spec = 0;
+};
+
+// Timed stat modifiers, e.g. the talents of a player or buffs of many enemies. Effects are data (FEffectSpec), each
+// owner's are kept contiguously in a fixed number of slots, and their expiry is driven by an FSimTimingWheel whose timer
+// index is the effect's slot. Stats are only computed again for owners whose effects or base stats changed, Update
+// lists the owners whose stats came out different so the caller copies only those to its actors.
+class FEffectCore
+{
+public:
+	explicit FEffectCore(const FEffectConfig& InConfig = FEffectConfig());
+
+	const FEffectConfig& GetConfig() const { return Config; }
+
+	FEffectSpecId AddSpec(const FEffectSpec& Spec);
+	const FEffectSpec& GetSpec(FEffectSpecId Spec) const { return Specs[Spec]; }
+	int32_t NumSpecs() const { return static_cast<int32_t>(Specs.size()); }
+
+	// Adds an owner with Config.NumStats base stats, its stats are the base stats until effects are applied
+	FSimAgentId AddOwner(const float* BaseStats);
+
+	// Removes the owner and its effects, they don't expire
+	void RemoveOwner(FSimAgentId Owner);
+
+	int32_t NumOwners() const { return Index.Num(); }
+	void Reserve(int32_t NumOwnersToReserve);
+
+	void SetBaseStat(FSimAgentId Owner, int32_t Stat, float Value);
+	float GetBaseStat(FSimAgentId Owner, int32_t Stat) const
+	{
+		return BaseStats[Owner * Config.NumStats + Stat];
+	}
+
+	// Stat with the effects applied, as of the last Update
+	float GetStat(FSimAgentId Owner, int32_t Stat) const { return Stats[Owner * Config.NumStats + Stat]; }
+
+	// Applies Spec to Owner following its stacking rule, the stats change on the next Update. Returns false if the
+	// owner has no free slot for a new instance.
+	bool Apply(FSimAgentId Owner, FEffectSpecId Spec);
+
+	// Removes the owner's instances of Spec without them expiring, returns how many there were
+	int32_t Remove(FSimAgentId Owner, FEffectSpecId Spec);
+
+	int32_t NumInstances(FSimAgentId Owner, FEffectSpecId Spec) const;
+
+	// Seconds until the first instance of Spec runs out, 0 if the owner has none or they don't run out
+	float GetRemainingTime(FSimAgentId Owner, FEffectSpecId Spec) const;
+
+	// Advances the clock by DeltaTime, expires the effects that ran out and computes the stats of the owners that
+	// changed. Returns the number of owners whose stats are different now.
+	int32_t Update(float DeltaTime);
+
+	const std::vector<FSimAgentId>& GetChangedOwners() const { return ChangedOwners; }
+	const std::vector<FExpiredEffect>& GetExpired() const { return Expired; }
+
+	const FEffectStats& GetStats() const { return UpdateStats; }
+
+private:
+	static constexpr FEffectSpecId NoSpec = -1;
+
+	FEffectConfig Config;
+	std::vector<FEffectSpec> Specs;
+	// Specs' durations in ticks of the wheel, 0 for the ones that don't run out
+	std::vector<uint32_t> SpecTicks;
+
+	FSimAgentIndex Index;
+	FSimTimingWheel Wheel;
+	// Time of the current tick that has passed
+	float PendingTime = 0.f;
+
+	// By owner id, Config.NumStats each
+	std::vector<float> BaseStats;
+	std::vector<float> Stats;
+
+	// An instance of an effect, the slot index is its timer in the wheel
+	struct FSlot
+	{
+		FEffectSpecId Spec = NoSpec;
+		// When it was applied, for the order of overrides
+		uint32_t Applied = 0;
+	};
+
+	// By owner id, Config.EffectsPerOwner each
+	std::vector<FSlot> Slots;
+	uint32_t NumApplications = 0;
+
+	// By owner id
+	std::vector<int32_t> NumEffectsOf;
+	std::vector<uint8_t> DirtyMask;
+	std::vector<FSimAgentId> DirtyOwners;
+
+	std::vector<FSimAgentId> ChangedOwners;
+	std::vector<int32_t> ExpiredTimers;
+	std::vector<FExpiredEffect> Expired;
+	int32_t NumActive = 0;
+	FEffectStats PendingStats;
+	FEffectStats UpdateStats;
+
+	// Scratch of Recompute, Config.NumStats each
+	std::vector<float> Sum;
+	std::vector<float> Product;
+	std::vector<float> OverrideValue;
+	std::vector<uint32_t> OverrideApplied;
+
+	void MarkDirty(FSimAgentId Owner);
+	void FreeSlot(int32_t Slot);
+
+	// Computes the owner's stats from its base stats and effects, returns whether any changed
+	bool Recompute(FSimAgentId Owner);
+};
@@ -0,0 +1,138 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Simulation/SightQueryCore.h"
+#include "Simulation/SimAgentIndex.h"
+#include "Simulation/SimulationTypes.h"
+
+#include <vector>
+
+class FFlowFieldCore;
+
+// Moves every enemy in one pass. Position, velocity, base location, patrol and sight state are kept in
+// struct-of-arrays columns, Step is a branch-free loop over them the compiler vectorizes. Actors don't tick, they copy
+// the locations of the agents that moved (see UEnemyMovementSubsystem).
+class FEnemyMovementCore
+{
+public:
+	// Per agent state bits
+	enum EAgentFlags : uint32_t
+	{
+		// Agent is heading back to its base location
+		Returning = 1 << 0,
+		// Agent is attacking and doesn't chase what it sees
+		Attacking = 1 << 1,
+
+		// Events, cleared by every Step
+		// Agent moved during the last Step
+		Moved = 1 << 8,
+		// Agent reached its base location during the last Step and stopped
+		ReturnedToBase = 1 << 9,
+		// ApplySight found a new target for the agent
+		SightGained = 1 << 10,
+		// Agent hasn't seen its target for longer than the sight max age, ApplySight sent it back to base
+		SightLost = 1 << 11,
+		// FollowFlowField changed the direction the agent chases its target in
+		Turned = 1 << 12,
+
+		EventFlags = Moved | ReturnedToBase | SightGained | SightLost | Turned,
+	};
+
+	// Speed is used when the agent chases a target or heads back to base on its own
+	FSimAgentId Add(const FSimVector& Location, const FSimVector& BaseLocation, float AgentSpeed);
+	void Remove(FSimAgentId Agent);
+	void Reserve(int32_t Count);
+
+	// Starts moving from [Location] with [Velocity], cancels a return to base
+	void Move(FSimAgentId Agent, const FSimVector& Location, const FSimVector& Velocity);
+
+	// Stops the agent where it is, cancels a return to base
+	void Stop(FSimAgentId Agent);
+
+	// Heads back to the base location from [Location] on the XY plane. Returns false if the agent is already there
+	// (within 1 unit) and the call did nothing.
+	bool ReturnToBase(FSimAgentId Agent, const FSimVector& Location);
+
+	void SetAttacking(FSimAgentId Agent, bool bAttacking);
+
+	// Direction the agent looks at on the XY plane, used by sight queries
+	void SetFacing(FSimAgentId Agent, const FSimVector& Direction);
+
+	// Advances every agent by DeltaTime. An agent heading back to base stops as soon as a step takes it no closer to
+	// its base location.
+	void Step(float DeltaTime);
+
+	// Advances agent I by AgentDeltaTime[I] (indexed densely), agents with zero stay where they are. Lets a scheduler
+	// such as FSignificanceCore update distant agents less often and by larger steps.
+	void Step(const float* AgentDeltaTime);
+
+	// Observer columns for FSightQueryCore::Query, indexed like the dense accessors below
+	FSightObservers GetSightObservers() const;
+
+	// Reacts to the result of a sight query. An agent that sees a new target turns to it and, unless attacking, chases
+	// it. An agent that hasn't seen its target for longer than MaxAge forgets it and heads back to base.
+	// VisibleTarget is indexed densely, Elapsed is the time since the previous call.
+	void ApplySight(const int32_t* VisibleTarget, const std::vector<FSimVector>& Targets, float Elapsed, float MaxAge);
+
+	// Seconds since the agent's sight of its target was confirmed, e.g. by a line of sight trace. Gaining a target
+	// confirms it, a caller checking again whether the target is still in sight confirms it with ConfirmSightAt.
+	float SightConfirmedAgeAt(int32_t DenseIndex) const { return SightConfirmedAge[DenseIndex]; }
+	void ConfirmSightAt(int32_t DenseIndex) { SightConfirmedAge[DenseIndex] = 0.f; }
+
+	// Steers every chasing agent along the flow field of its sight target, whose fields are indexed like the targets
+	// passed to ApplySight. Agents that attack or head back to base keep their velocity.
+	void FollowFlowField(const FFlowFieldCore& FlowField);
+
+	FSimVector GetLocation(FSimAgentId Agent) const { return LocationAt(Index.IndexOf(Agent)); }
+	FSimVector GetVelocity(FSimAgentId Agent) const;
+	bool IsReturning(FSimAgentId Agent) const { return (Flags[Index.IndexOf(Agent)] & Returning) != 0; }
+	int32_t GetSightTarget(FSimAgentId Agent) const { return SightTargetAt(Index.IndexOf(Agent)); }
+
+	// Dense access for syncing the results of a Step, indices are only stable until the next Add or Remove
+	int32_t Num() const { return Index.Num(); }
+	int32_t IndexOf(FSimAgentId Agent) const { return Index.IndexOf(Agent); }
+	FSimAgentId AgentAt(int32_t DenseIndex) const { return Index.AgentAt(DenseIndex); }
+	uint32_t FlagsAt(int32_t DenseIndex) const { return Flags[DenseIndex]; }
+	FSimVector LocationAt(int32_t DenseIndex) const;
+	FSimVector VelocityAt(int32_t DenseIndex) const;
+	int32_t SightTargetAt(int32_t DenseIndex) const { return SightTarget[DenseIndex]; }
+
+private:
+	FSimAgentIndex Index;
+
+	std::vector<float> LocationX;
+	std::vector<float> LocationY;
+	std::vector<float> LocationZ;
+
+	std::vector<float> VelocityX;
+	std::vector<float> VelocityY;
+	std::vector<float> VelocityZ;
+
+	std::vector<float> BaseX;
+	std::vector<float> BaseY;
+
+	// Closest squared 2D distance to base reached while returning
+	std::vector<float> ClosestToBase;
+
+	std::vector<float> Speed;
+
+	std::vector<float> FacingX;
+	std::vector<float> FacingY;
+
+	// Index of the target the agent saw last, FSightQueryCore::NoTarget for none
+	std::vector<int32_t> SightTarget;
+	// Time since the agent saw its target
+	std::vector<float> SightAge;
+	// Time since the sight of the target was confirmed
+	std::vector<float> SightConfirmedAge;
+
+	std::vector<uint32_t> Flags;
+
+	// Stops the agents heading back to base that moved past it during a step
+	void StopAtBase();
+
+	void MoveAt(int32_t I, const FSimVector& Location, const FSimVector& Velocity);
+	bool ReturnToBaseAt(int32_t I, const FSimVector& Location);
+	void FaceAt(int32_t I, float DirectionX, float DirectionY);
+};
@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Simulation/SimParallel.h"
+#include "Simulation/SimulationTypes.h"
+
+#include <vector>
+
+// Grid the flow fields cover, on the XY plane
+struct FFlowFieldConfig
+{
+	// World location of the grid's minimum corner
+	float OriginX = -25600.f;
+	float OriginY = -25600.f;
+
+	float CellSize = 100.f;
+	int32_t Width = 512;
+	int32_t Height = 512;
+
+	// Cells whose path to a target is longer get no direction, agents there head straight at the target. Keeps
+	// recomputing cheap when agents only chase from nearby, 0 covers the whole grid.
+	float MaxPathLength = 0.f;
+};
+
+// Leads any number of agents to a few targets around obstacles. The grid holds a cost per cell; for every target the
+// core integrates the cost of the cheapest path from each cell to the target's cell (Dijkstra with a bucket queue,
+// 8-connected, no corner cutting) and stores per cell the direction of the neighbour its cheapest path leads through.
+// An agent then looks up its direction in O(1), no matter how many agents chase the same target.
+//
+// A target's field is only recomputed when the target moves into another cell or the costs changed. Fields of
+// different targets are integrated in parallel.
+class FFlowFieldCore
+{
+public:
+	static constexpr uint8_t Blocked = 255;
+
+	explicit FFlowFieldCore(const FFlowFieldConfig& InConfig = FFlowFieldConfig());
+
+	// Replaces the grid, all cells cost 1 again
+	void SetConfig(const FFlowFieldConfig& InConfig);
+	const FFlowFieldConfig& GetConfig() const { return Config; }
+
+	// Cost of walking through a cell, 1 to 254, or Blocked. A cell a box blocks stays blocked whatever its cost.
+	void SetCost(int32_t CellX, int32_t CellY, uint8_t Cost);
+	uint8_t GetCost(int32_t CellX, int32_t CellY) const { return Costs[CellY * Config.Width + CellX]; }
+
+	// Blocks every cell the box touches
+	void BlockBox(float MinX, float MinY, float MaxX, float MaxY);
+
+	// Undoes BlockBox with the same box, cells are walkable again unless another box blocks them too
+	void UnblockBox(float MinX, float MinY, float MaxX, float MaxY);
+
+	// Brings the field of each target up to date, fields are indexed like Targets
+	void Update(const std::vector<FSimVector>& Targets, const FSimParallelFor& ParallelFor = FSimParallelFor());
+
+	// Unit direction on the XY plane an agent at (X, Y) walks to reach Target. An agent overlapping a blocked cell
+	// steps out into the neighbour with the cheapest path. Straight at the target from its own cell, and where the
+	// field has no direction: outside of the grid and in cells the target can't be reached from.
+	FSimVector Sample(int32_t Target, float X, float Y) const;
+
+	int32_t NumTargets() const { return static_cast<int32_t>(Fields.size()); }
+
+	// Fields recomputed by all Update calls so far
+	int64_t GetNumRecomputed() const { return NumRecomputed; }
+
+	// Cell of a world location, false if it is outside of the grid
+	bool CellOf(float X, float Y, int32_t& OutCellX, int32_t& OutCellY) const;
+
+private:
+	static constexpr uint8_t NoDirection = 8;
+	static constexpr int32_t NoCell = -1;
+
+	struct FField
+	{
+		FSimVector Target;
+		int32_t TargetCell = NoCell;
+
+		// Cost of the cheapest path to the target per cell
+		std::vector<uint32_t> Distance;
+		// Direction to the next cell of the cheapest path per cell, 0 to 7 or NoDirection
+		std::vector<uint8_t> Direction;
+
+		// Cells the last integration reached, the next one only resets these
+		std::vector<int32_t> Reached;
+
+		// Bucket queue of Integrate, kept to save reallocating it
+		std::vector<std::vector<int32_t>> Buckets;
+	};
+
+	FFlowFieldConfig Config;
+	// Cost of each cell as Integrate sees it, Blocked where a box blocks it
+	std::vector<uint8_t> Costs;
+	// The costs SetCost gave, and how many boxes block each cell
+	std::vector<uint8_t> CellCosts;
+	std::vector<uint16_t> NumBlockers;
+	bool bCostsChanged = true;
+
+	std::vector<FField> Fields;
+	std::vector<int32_t> Changed;
+	int64_t NumRecomputed = 0;
+
+	void Integrate(FField& Field) const;
+
+	// Direction from a blocked cell to its unblocked neighbour closest to the target, NoDirection if there is none
+	uint8_t StepOut(const FField& Field, int32_t CellX, int32_t CellY) const;
+
+	// Calls Visit with every cell the box touches
+	template <typename FVisit>
+	void ForEachCellIn(float MinX, float MinY, float MaxX, float MaxY, FVisit Visit) const;
+};
@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Simulation/SimulationTypes.h"
+
+#include <vector>
+
+// Upright capsule, sized like UCapsuleComponent: HalfHeight includes the hemispheres
+struct FSimCapsule
+{
+	FSimVector Center;
+	float HalfHeight = 0.f;
+	float Radius = 0.f;
+};
+
+// A shot. Direction is a unit vector, a piercing ray reports every capsule it passes through, any other only the first.
+struct FHitscanRay
+{
+	FSimVector Start;
+	FSimVector Direction;
+	float Length = 0.f;
+	bool bPierce = false;
+};
+
+struct FHitscanHit
+{
+	// Index into the capsules passed to FHitscanCore::Build
+	int32_t Target = -1;
+	// Distance from the ray start to where the ray enters the capsule, 0 if it starts inside
+	float Distance = 0.f;
+};
+
+// Hits of a batch of rays. Hits of ray R are [HitStart[R], HitStart[R + 1]) in Hits, nearest first, so the first hit
+// and the pierce list come from the same query.
+struct FHitscanResults
+{
+	std::vector<int32_t> HitStart;
+	std::vector<FHitscanHit> Hits;
+
+	int32_t NumHits(int32_t Ray) const { return HitStart[Ray + 1] - HitStart[Ray]; }
+	const FHitscanHit* GetHits(int32_t Ray) const { return Hits.data() + HitStart[Ray]; }
+};
+
+// Traces batches of rays against many capsules. Build puts the capsules into a bounding volume hierarchy whose leaves
+// hold LeafSize capsules in struct-of-arrays columns, a ray that reaches a leaf tests all of them in one vectorized
+// loop. Trace doesn't modify the core, shots of several shooters may be traced from several threads at once.
+class FHitscanCore
+{
+public:
+	static constexpr int32_t LeafSize = 8;
+
+	// Rebuilds the hierarchy, capsules are identified by their index in Capsules
+	void Build(const std::vector<FSimCapsule>& Capsules);
+
+	// Moves the capsules of the last Build without changing the hierarchy, much cheaper than a rebuild while they
+	// haven't moved far. Capsules must hold as many capsules as the last Build did, in the same order.
+	void Refit(const std::vector<FSimCapsule>& Capsules);
+
+	// Replaces the contents of Results with the hits of Rays
+	void Trace(const FHitscanRay* Rays, int32_t NumRays, FHitscanResults& Results) const;
+
+	int32_t NumTargets() const { return NumCapsules; }
+
+private:
+	struct FNode
+	{
+		float Min[3];
+		float Max[3];
+		// Inner node: index of the first of two adjacent children. Leaf: index of its first slot in the columns.
+		int32_t First;
+		// Capsules of a leaf, 0 for inner nodes
+		int32_t Count;
+	};
+
+	int32_t NumCapsules = 0;
+	std::vector<FNode> Nodes;
+
+	// Capsule columns in leaf order, every leaf padded to LeafSize slots
+	std::vector<float> CenterX;
+	std::vector<float> CenterY;
+	std::vector<float> CenterZ;
+	// Half length of the segment between the hemisphere centers
+	std::vector<float> HalfSegment;
+	std::vector<float> Radius;
+	std::vector<int32_t> Target;
+
+	void BuildNode(const std::vector<FSimCapsule>& Capsules, int32_t* Indices, int32_t Count, int32_t NodeIndex);
+	void SetSlot(int32_t Slot, const FSimCapsule& Capsule);
+};
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Simulation/SimAgentIndex.h"
+#include "Simulation/SimulationTypes.h"
+
+#include <unordered_map>
+#include <vector>
+
+// A player capsule as seen by the pickup query, Location is the capsule center
+struct FPickupPlayer
+{
+	FSimVector Location;
+	float Radius = 0.f;
+	float HalfHeight = 0.f;
+};
+
+// Player [Player] (index into the query's players) reached pickup [Pickup]
+struct FPickupContact
+{
+	int32_t Player = 0;
+	FSimAgentId Pickup = InvalidSimAgent;
+};
+
+// Finds which pickups the players reached, in place of an overlap sphere per pickup. Pickups don't move, they are
+// kept in a uniform grid and each player only tests the pickups of the cells its capsule can reach. Like a begin
+// overlap event a contact is reported once, when the player gets into the pickup's sphere; it takes leaving and
+// coming back to be reported again.
+class FPickupGridCore
+{
+public:
+	explicit FPickupGridCore(float InCellSize = 512.f);
+
+	// Adds a pickup sphere, returns its id
+	FSimAgentId Add(const FSimVector& Location, float Radius);
+
+	void Remove(FSimAgentId Pickup);
+
+	bool IsValid(FSimAgentId Pickup) const { return Index.IsValid(Pickup); }
+	int32_t Num() const { return Index.Num(); }
+
+	void Reserve(int32_t Count);
+
+	// Writes into Contacts the pickups each player got into since the previous query
+	void Query(const FPickupPlayer* Players, int32_t NumPlayers, std::vector<FPickupContact>& Contacts);
+
+private:
+	// Pickups of one grid cell, struct-of-arrays
+	struct FCell
+	{
+		std::vector<float> X;
+		std::vector<float> Y;
+		std::vector<float> Z;
+		std::vector<float> Radius;
+		std::vector<FSimAgentId> Pickups;
+	};
+
+	float CellSize = 0.f;
+
+	// The largest pickup radius so far, a query reaches this far beyond the player capsule
+	float MaxRadius = 0.f;
+
+	std::unordered_map<uint64_t, FCell> Cells;
+
+	// Where each pickup is stored, by dense index
+	FSimAgentIndex Index;
+	std::vector<uint64_t> CellKeys;
+	std::vector<int32_t> CellSlots;
+
+	// Pickups each player was inside at the previous query, sorted
+	std::vector<std::vector<FSimAgentId>> Inside;
+	std::vector<FSimAgentId> NowInside;
+
+	int32_t CellOf(float Coordinate) const;
+	static uint64_t KeyOf(int32_t CellX, int32_t CellY);
+};
+
+// What picking up ammo does: the weapon takes as much as fits up to its limit. If it all fits the pickup is
+// consumed, otherwise Remaining stays on the ground.
+struct FAmmoPickupResult
+{
+	int32_t Taken = 0;
+	int32_t Remaining = 0;
+	bool bConsumed = false;
+};
+
+FAmmoPickupResult ResolveAmmoPickup(int32_t CurrentAmmo, int32_t AmmoLimit, int32_t AmmoAmount);
+
+// What picking up health does: health grows by the pickup amount, clamped to max health. A character already above max
+// health leaves the pickup where it is.
+struct FHealthPickupResult
+{
+	float NewHealth = 0.f;
+	bool bConsumed = false;
+};
+
+FHealthPickupResult ResolveHealthPickup(float CurrentHealth, float MaxHealth, float HealthAmount);
@@ -0,0 +1,73 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Simulation/SimulationTypes.h"
+
+#include <vector>
+
+// Sight parameters, the same meaning as in UAISenseConfig_Sight
+struct FSightConfig
+{
+	float SightRadius = 1500.f;
+
+	// How far to the side an observer sees, measured from its facing direction
+	float PeripheralVisionAngleDegrees = 100.f;
+
+	// How long an observer remembers a target it no longer sees, in seconds. Not used by the query itself.
+	float MaxAge = .1f;
+};
+
+// Read-only view of the observer columns of a simulation core. Facing is a unit vector on the XY plane.
+struct FSightObservers
+{
+	int32_t Num = 0;
+	const float* X = nullptr;
+	const float* Y = nullptr;
+	const float* Z = nullptr;
+	const float* FacingX = nullptr;
+	const float* FacingY = nullptr;
+};
+
+// Answers "which target does each observer see" for many observers and few targets in one batch, instead of one
+// perception query per observer. Observers are bucketed into a spatial hash with cells as large as the sight radius,
+// each target then only tests the observers of the 3x3 cells around it. Observers of a cell are copied next to each
+// other so the radius and cone test runs as a vectorized loop over them.
+class FSightQueryCore
+{
+public:
+	static constexpr int32_t NoTarget = -1;
+
+	explicit FSightQueryCore(const FSightConfig& InConfig = FSightConfig());
+
+	void SetConfig(const FSightConfig& InConfig);
+	const FSightConfig& GetConfig() const { return Config; }
+
+	// Writes into VisibleTarget[Observer] the index of the nearest target within sight radius and peripheral vision
+	// angle of the observer, NoTarget if it sees none. VisibleTarget must hold Observers.Num entries.
+	void Query(const FSightObservers& Observers, const std::vector<FSimVector>& Targets, int32_t* VisibleTarget);
+
+private:
+	FSightConfig Config;
+	float CellSize = 0.f;
+	float CosPeripheralAngle = 0.f;
+
+	// Spatial hash, rebuilt by every Query: observers of bucket B are at [BucketStart[B], BucketStart[B + 1]) in the
+	// sorted columns
+	uint32_t BucketMask = 0;
+	std::vector<uint32_t> ObserverBucket;
+	std::vector<int32_t> BucketStart;
+
+	std::vector<int32_t> SortedObserver;
+	std::vector<float> SortedX;
+	std::vector<float> SortedY;
+	std::vector<float> SortedZ;
+	std::vector<float> SortedFacingX;
+	std::vector<float> SortedFacingY;
+	std::vector<float> BestDistanceSquared;
+	std::vector<int32_t> BestTarget;
+
+	void BuildHash(const FSightObservers& Observers);
+	uint32_t BucketOf(int32_t CellX, int32_t CellY) const;
+	int32_t CellOf(float Coordinate) const;
+};
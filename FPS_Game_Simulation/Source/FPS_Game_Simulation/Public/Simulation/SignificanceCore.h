@@ -0,0 +1,102 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Simulation/SimAgentIndex.h"
+#include "Simulation/SimulationTypes.h"
+
+#include <vector>
+
+// Where a player looks from, for deciding how significant agents are
+struct FSignificanceViewer
+{
+	FSimVector Location;
+	// Unit vector
+	FSimVector Forward = FSimVector(1.f, 0.f, 0.f);
+	float HalfFieldOfViewDegrees = 45.f;
+};
+
+struct FSignificanceConfig
+{
+	// Agents nearer to a viewer than BucketDistance[B] go into bucket B, farther ones are dormant
+	float BucketDistance[3] = {2500.f, 6000.f, 12000.f};
+
+	// Agents of bucket B are updated every BucketPeriod[B] frames
+	int32_t BucketPeriod[3] = {1, 4, 16};
+
+	// At most this many agents of the lower rate buckets are updated per frame, the rest wait for the next frame.
+	// Agents of the every frame bucket are always updated.
+	int32_t MaxUpdatesPerFrame = 512;
+};
+
+struct FSignificanceStats
+{
+	int32_t NumInBucket[4] = {};
+	int32_t NumUpdated = 0;
+	// Agents that were due but didn't fit into the budget
+	int32_t NumDeferred = 0;
+};
+
+// Decides how often each agent gets updated: every frame, every 4th, every 16th or not at all, by its distance to the
+// nearest viewer. An agent outside of every viewer's field of view drops one bucket. Schedule then picks the agents
+// to update this frame within a budget and tells each how much time passed since its previous update, so a lower rate
+// agent makes up for the frames it skipped. Agents are indexed densely like the owner's struct-of-arrays storage: the
+// owner appends with Add and mirrors its swap removals with RemoveAtSwap.
+class FSignificanceCore
+{
+public:
+	enum ETickBucket : uint8_t
+	{
+		EveryFrame,
+		Every4thFrame,
+		Every16thFrame,
+		Dormant,
+	};
+
+	explicit FSignificanceCore(const FSignificanceConfig& InConfig = FSignificanceConfig());
+
+	void SetConfig(const FSignificanceConfig& InConfig);
+	const FSignificanceConfig& GetConfig() const { return Config; }
+
+	// Appends an agent, it is updated every frame until the next UpdateBuckets
+	void Add();
+	void RemoveAtSwap(int32_t Index);
+	void Reserve(int32_t Count);
+	int32_t Num() const { return static_cast<int32_t>(Bucket.size()); }
+
+	// Buckets every agent by its location, X, Y and Z hold Num() entries
+	void UpdateBuckets(const float* X, const float* Y, const float* Z, const std::vector<FSignificanceViewer>& Viewers);
+
+	// Advances the clock by DeltaTime and writes into AgentDeltaTime[I] the time agent I has to be advanced by this
+	// frame, zero for agents not updated. Returns the number of agents updated.
+	int32_t Schedule(float DeltaTime, float* AgentDeltaTime);
+
+	ETickBucket BucketAt(int32_t Index) const { return static_cast<ETickBucket>(Bucket[Index]); }
+	bool IsInViewAt(int32_t Index) const { return InView[Index] != 0; }
+
+	// Time since agent was updated last. Location + Velocity * PendingTimeAt is where a lower rate agent would be
+	// by now, actors use it to interpolate between updates.
+	float PendingTimeAt(int32_t Index) const { return PendingTime[Index]; }
+
+	const FSignificanceStats& GetStats() const { return Stats; }
+
+private:
+	FSignificanceConfig Config;
+	FSignificanceStats Stats;
+
+	std::vector<uint8_t> Bucket;
+	// Frames between updates of the agent's bucket, 0 for dormant
+	std::vector<int32_t> Period;
+	int32_t NumInBucket[4] = {};
+	std::vector<uint8_t> InView;
+	std::vector<float> PendingTime;
+	std::vector<int32_t> FramesSinceUpdate;
+
+	// Distance to the nearest viewer and the bucket it asks for, only used by UpdateBuckets
+	std::vector<float> NearestDistanceSquared;
+	std::vector<uint8_t> NewBucket;
+
+	// Lower rate agents due this frame, and the same as a flag per agent
+	std::vector<int32_t> Due;
+	std::vector<int32_t> DueMask;
+};
@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Simulation/SimulationTypes.h"
+
+#include <vector>
+
+// Maps stable agent ids to dense indices of struct-of-arrays storage. Removal swaps the last agent into the freed
+// index, so the owner must apply the same swap to each of its arrays. Ids of removed agents are reused.
+class FSimAgentIndex
+{
+public:
+	// Returns the id of a new agent, its dense index is Num() - 1
+	FSimAgentId Add();
+
+	// Frees [Agent] and returns its dense index, the agent at Num() (after the call) moved there
+	int32_t Remove(FSimAgentId Agent);
+
+	bool IsValid(FSimAgentId Agent) const
+	{
+		return Agent >= 0 && Agent < static_cast<FSimAgentId>(Dense.size()) && Dense[Agent] != InvalidIndex;
+	}
+
+	int32_t IndexOf(FSimAgentId Agent) const { return Dense[Agent]; }
+	FSimAgentId AgentAt(int32_t Index) const { return Agents[Index]; }
+	int32_t Num() const { return static_cast<int32_t>(Agents.size()); }
+
+	void Reserve(int32_t Count);
+
+private:
+	static constexpr int32_t InvalidIndex = -1;
+
+	// Dense index by agent id, InvalidIndex for free ids
+	std::vector<int32_t> Dense;
+	// Agent id by dense index
+	std::vector<FSimAgentId> Agents;
+	std::vector<FSimAgentId> FreeIds;
+};
+
+// Swap-removes [Index] from a struct-of-arrays column the way FSimAgentIndex::Remove did
+template <typename T>
+void SimRemoveAtSwap(std::vector<T>& Column, int32_t Index)
+{
+	Column[Index] = Column.back();
+	Column.pop_back();
+}
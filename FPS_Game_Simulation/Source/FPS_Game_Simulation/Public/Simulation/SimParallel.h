@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs Body(Task) for every Task in [0, NumTasks), possibly on several threads, and returns once all ran. Cores that
+// split their work take one of these instead of starting threads themselves: the game passes the engine's ParallelFor,
+// the benchmarks an FSimThreadPool. An empty one runs the tasks on the calling thread.
+using FSimParallelFor = std::function<void(int32_t NumTasks, const std::function<void(int32_t Task)>& Body)>;
+
+// Runs the tasks of NumTasks on ParallelFor, or in order on this thread if it is empty
+inline void SimParallelFor(const FSimParallelFor& ParallelFor, int32_t NumTasks,
+	const std::function<void(int32_t Task)>& Body)
+{
+	if (ParallelFor && NumTasks > 1)
+	{
+		ParallelFor(NumTasks, Body);
+		return;
+	}
+	for (int32_t Task = 0; Task < NumTasks; ++Task)
+	{
+		Body(Task);
+	}
+}
+
+// Worker threads for running the cores outside of Unreal. The calling thread takes tasks too, so a pool of N workers
+// runs N + 1 tasks at a time. One ParallelFor at a time.
+class FSimThreadPool
+{
+public:
+	// NumWorkers < 0 starts one worker less than the machine has hardware threads
+	explicit FSimThreadPool(int32_t NumWorkers = -1);
+	~FSimThreadPool();
+
+	FSimThreadPool(const FSimThreadPool&) = delete;
+	FSimThreadPool& operator=(const FSimThreadPool&) = delete;
+
+	void ParallelFor(int32_t NumTasks, const std::function<void(int32_t Task)>& Body);
+
+	// ParallelFor of this pool as an FSimParallelFor, valid while the pool lives
+	FSimParallelFor AsParallelFor();
+
+	int32_t NumWorkers() const { return static_cast<int32_t>(Workers.size()); }
+
+private:
+	std::vector<std::thread> Workers;
+
+	std::mutex Mutex;
+	std::condition_variable WorkReady;
+	std::condition_variable WorkDone;
+
+	// Bumped for every ParallelFor, workers wake up when it changes
+	uint64_t Generation = 0;
+	bool bStopping = false;
+
+	const std::function<void(int32_t)>* Body = nullptr;
+	int32_t NumTasks = 0;
+	std::atomic<int32_t> NextTask{0};
+	// Workers still running tasks of the current ParallelFor
+	int32_t NumBusy = 0;
+
+	void WorkerLoop();
+	void RunTasks();
+};
@@ -0,0 +1,155 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct FSimPoolStats
+{
+	// Items the pool knows about, active or free
+	int32_t NumItems = 0;
+	int32_t NumActive = 0;
+	int32_t PeakActive = 0;
+
+	// Acquire calls served by a free item, and the ones that found none and made the caller create one
+	int64_t NumReused = 0;
+	int64_t NumMissed = 0;
+
+	int64_t NumReleased = 0;
+};
+
+// Bookkeeping of a pool of items the caller creates, activates and deactivates (ASpawner pools actors with it).
+// The pool only tracks which items are free: Acquire hands out the most recently released one, Release takes an active
+// one back. Lookups are by pointer, so releasing an item the pool doesn't know or twice is detected and refused.
+template <typename ItemType>
+class TSimPool
+{
+public:
+	void Reserve(int32_t Count)
+	{
+		Slots.reserve(Count);
+		Free.reserve(Count);
+	}
+
+	// Adds an item the caller created, free or already in use. Returns false if the pool knows it already.
+	bool Add(ItemType* Item, bool bActive)
+	{
+		const auto Inserted = Slots.emplace(Item, FSlot());
+		if (!Inserted.second)
+		{
+			return false;
+		}
+
+		++Stats.NumItems;
+		if (bActive)
+		{
+			MarkActive(Inserted.first->second);
+		}
+		else
+		{
+			PushFree(Item, Inserted.first->second);
+		}
+		return true;
+	}
+
+	// A free item, now active. Null if there is none, the caller then creates one and adds it as active.
+	ItemType* Acquire()
+	{
+		if (Free.empty())
+		{
+			++Stats.NumMissed;
+			return nullptr;
+		}
+
+		ItemType* Item = Free.back();
+		Free.pop_back();
+		MarkActive(Slots.find(Item)->second);
+		++Stats.NumReused;
+		return Item;
+	}
+
+	// Takes an active item back. Returns false if the item isn't in the pool or is free already.
+	bool Release(ItemType* Item)
+	{
+		const auto Found = Slots.find(Item);
+		if (Found == Slots.end() || Found->second.FreeIndex != Active)
+		{
+			return false;
+		}
+
+		--Stats.NumActive;
+		++Stats.NumReleased;
+		PushFree(Item, Found->second);
+		return true;
+	}
+
+	// Forgets an item, e.g. because it got destroyed by someone else. Returns false if the pool didn't know it.
+	bool Remove(ItemType* Item)
+	{
+		const auto Found = Slots.find(Item);
+		if (Found == Slots.end())
+		{
+			return false;
+		}
+
+		const int32_t FreeIndex = Found->second.FreeIndex;
+		if (FreeIndex == Active)
+		{
+			--Stats.NumActive;
+		}
+		else
+		{
+			// Swap with the last free item
+			ItemType* Last = Free.back();
+			Free[FreeIndex] = Last;
+			Slots.find(Last)->second.FreeIndex = FreeIndex;
+			Free.pop_back();
+		}
+
+		Slots.erase(Found);
+		--Stats.NumItems;
+		return true;
+	}
+
+	bool Contains(ItemType* Item) const { return Slots.find(Item) != Slots.end(); }
+
+	bool IsActive(ItemType* Item) const
+	{
+		const auto Found = Slots.find(Item);
+		return Found != Slots.end() && Found->second.FreeIndex == Active;
+	}
+
+	int32_t NumFree() const { return static_cast<int32_t>(Free.size()); }
+	const FSimPoolStats& GetStats() const { return Stats; }
+
+private:
+	static constexpr int32_t Active = -1;
+
+	struct FSlot
+	{
+		// Position in Free, Active while the item is in use
+		int32_t FreeIndex = Active;
+	};
+
+	std::unordered_map<ItemType*, FSlot> Slots;
+	std::vector<ItemType*> Free;
+	FSimPoolStats Stats;
+
+	void MarkActive(FSlot& Slot)
+	{
+		Slot.FreeIndex = Active;
+		++Stats.NumActive;
+		if (Stats.NumActive > Stats.PeakActive)
+		{
+			Stats.PeakActive = Stats.NumActive;
+		}
+	}
+
+	void PushFree(ItemType* Item, FSlot& Slot)
+	{
+		Slot.FreeIndex = static_cast<int32_t>(Free.size());
+		Free.push_back(Item);
+	}
+};
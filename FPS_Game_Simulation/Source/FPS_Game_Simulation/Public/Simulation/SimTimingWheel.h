@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Hierarchical timing wheel: timers due within 64 ticks sit in the slot of their tick, later ones in a coarser level of
+// 64 slots of 64, 4096 or 262144 ticks. Scheduling and cancelling are O(1), and advancing a tick touches only the
+// timers due then, plus every 64th tick one coarser slot whose timers move down a level. Timers are identified by an
+// index the caller picks, e.g. the slot of what the timer is for, and are linked through arrays indexed by it.
+class FSimTimingWheel
+{
+public:
+	static constexpr int32_t SlotBits = 6;
+	static constexpr int32_t NumSlots = 1 << SlotBits;
+	static constexpr int32_t NumLevels = 4;
+
+	// Timers further out wait in the last level and move down when its slot comes up
+	static constexpr uint32_t MaxDelay = (1u << (SlotBits * NumLevels)) - 1;
+
+	FSimTimingWheel();
+
+	// Timers are indexed from 0 to Count - 1, Schedule grows the arrays as needed
+	void Reserve(int32_t Count);
+
+	// Makes Timer due at Tick, moving it if it was scheduled already. A tick that has passed is due at the next one.
+	void Schedule(int32_t Timer, uint32_t Tick);
+
+	void Cancel(int32_t Timer);
+
+	bool IsScheduled(int32_t Timer) const
+	{
+		return Timer < static_cast<int32_t>(Timers.size()) && Timers[Timer].Slot != Unscheduled;
+	}
+
+	// Tick the timer is due at, only valid while it is scheduled
+	uint32_t DueTickOf(int32_t Timer) const { return Timers[Timer].DueTick; }
+
+	uint32_t Now() const { return CurrentTick; }
+	int32_t NumScheduled() const { return Scheduled; }
+
+	// Advances by NumTicks and appends the timers that came due to Expired, in the order of their ticks. They are
+	// unscheduled and can be scheduled again right away. Returns the number of timers moved down a level.
+	int32_t Advance(uint32_t NumTicks, std::vector<int32_t>& Expired);
+
+private:
+	static constexpr int32_t Unscheduled = -1;
+	static constexpr int32_t None = -1;
+
+	uint32_t CurrentTick = 0;
+	int32_t Scheduled = 0;
+
+	// First timer of each slot, level by level
+	std::vector<int32_t> Head;
+
+	// Scheduling, expiring and moving a timer reads and writes all of these, one array of them costs a single cache line
+	// per timer
+	struct FTimer
+	{
+		// Doubly linked list of its slot
+		int32_t Next = None;
+		int32_t Prev = None;
+		int32_t Slot = Unscheduled;
+		uint32_t DueTick = 0;
+	};
+
+	std::vector<FTimer> Timers;
+
+	void Link(int32_t Timer);
+	void Unlink(int32_t Timer);
+};
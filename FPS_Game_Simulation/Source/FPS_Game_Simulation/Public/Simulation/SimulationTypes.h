@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+// Types shared by the engine-independent simulation cores under Simulation/. They must not include engine headers,
+// the cores are also built and benchmarked outside of Unreal (see CMakeLists.txt next to the Build.cs).
+
+#include <cstdint>
+
+// Single precision vector of the simulation cores, actors convert from and to FVector at the boundary
+struct FSimVector
+{
+	float X = 0.f;
+	float Y = 0.f;
+	float Z = 0.f;
+
+	FSimVector() = default;
+
+	FSimVector(float InX, float InY, float InZ) : X(InX), Y(InY), Z(InZ)
+	{
+	}
+
+	FSimVector operator+(const FSimVector& Other) const { return FSimVector(X + Other.X, Y + Other.Y, Z + Other.Z); }
+	FSimVector operator-(const FSimVector& Other) const { return FSimVector(X - Other.X, Y - Other.Y, Z - Other.Z); }
+	FSimVector operator*(float Scale) const { return FSimVector(X * Scale, Y * Scale, Z * Scale); }
+
+	float SizeSquared2D() const { return X * X + Y * Y; }
+	bool IsZero() const { return X == 0.f && Y == 0.f && Z == 0.f; }
+};
+
+// Angles of the cores' configs are in degrees like the engine's, the cores compute in radians. Shared here so each core
+// doesn't define its own, they are compiled into one translation unit in unity builds.
+constexpr float SimDegreesToRadians = 3.14159265f / 180.f;
+
+// Stable id of an agent in a simulation core, dense storage indices change when agents are removed
+using FSimAgentId = int32_t;
+
+constexpr FSimAgentId InvalidSimAgent = -1;
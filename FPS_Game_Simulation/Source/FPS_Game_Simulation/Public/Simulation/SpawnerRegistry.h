@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Spawners by gameplay type, so a spawned actor finds its spawner with one hash lookup instead of searching the world.
+// Keys are whatever identifies a type on the game side (USpawnerRegistrySubsystem packs the comparison index and number
+// of a tag name). A key may have several spawners, Find returns the one registered last.
+template <typename SpawnerType>
+class TSpawnerRegistry
+{
+public:
+	using FKey = uint64_t;
+
+	void Register(FKey Key, SpawnerType* Spawner)
+	{
+		Spawners[Key].push_back(Spawner);
+	}
+
+	void Unregister(FKey Key, SpawnerType* Spawner)
+	{
+		const auto Found = Spawners.find(Key);
+		if (Found == Spawners.end())
+		{
+			return;
+		}
+
+		std::vector<SpawnerType*>& OfKey = Found->second;
+		OfKey.erase(std::remove(OfKey.begin(), OfKey.end(), Spawner), OfKey.end());
+		if (OfKey.empty())
+		{
+			Spawners.erase(Found);
+		}
+	}
+
+	SpawnerType* Find(FKey Key) const
+	{
+		const auto Found = Spawners.find(Key);
+		return Found != Spawners.end() ? Found->second.back() : nullptr;
+	}
+
+	int32_t Num(FKey Key) const
+	{
+		const auto Found = Spawners.find(Key);
+		return Found != Spawners.end() ? static_cast<int32_t>(Found->second.size()) : 0;
+	}
+
+private:
+	std::unordered_map<FKey, std::vector<SpawnerType*>> Spawners;
+};
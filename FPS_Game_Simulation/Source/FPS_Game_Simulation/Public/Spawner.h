@@ -4,8 +4,42 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Simulation/SimPool.h"
 #include "Spawner.generated.h"
 
+// Pool statistics of a spawner, see ASpawner::GetPoolStats
+USTRUCT(BlueprintType)
+struct FSpawnerPoolStats
+{
+	GENERATED_BODY()
+
+	// Actors in the pool, visible or hidden
+	UPROPERTY(BlueprintReadOnly, Category="Spawning")
+	int32 NumActors = 0;
+
+	// Visible actors, the pool takes them back when they are picked up or killed
+	UPROPERTY(BlueprintReadOnly, Category="Spawning")
+	int32 NumActive = 0;
+
+	// Hidden actors waiting for the next spawn
+	UPROPERTY(BlueprintReadOnly, Category="Spawning")
+	int32 NumFree = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="Spawning")
+	int32 PeakActive = 0;
+
+	// Spawns served by a hidden actor
+	UPROPERTY(BlueprintReadOnly, Category="Spawning")
+	int64 NumReused = 0;
+
+	// Spawns that had to create a new actor
+	UPROPERTY(BlueprintReadOnly, Category="Spawning")
+	int64 NumSpawned = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="Spawning")
+	int64 NumReturned = 0;
+};
+
 UCLASS()
 class FPS_GAME_SIMULATION_API ASpawner : public AActor
 {
@@ -19,6 +53,12 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	// Registers in the spawner registry before anything begins play
+	virtual void PostInitializeComponents() override;
+
+	// Called when the spawner is destroyed or the level ends
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:	
 	// Returns the WhereToSpawn subobject
 	FORCEINLINE class UBoxComponent* GetWhereToSpawn() const { return WhereToSpawn; }
@@ -30,6 +70,13 @@ public:
 	// Trigger to work spawner using timers
 	void TrigSpawnerWithTimer(float SpawnRate);
 
+	// Hides Actor and keeps it for a later spawn. Returns false if this spawner doesn't pool or doesn't spawn actors of
+	// that class, the caller destroys the actor then.
+	bool ReturnToPool(AActor* Actor);
+
+	UFUNCTION(BlueprintPure, Category="Spawning")
+	FSpawnerPoolStats GetPoolStats() const;
+
 protected:
 	// Actor to be spawned
 	UPROPERTY(EditAnywhere, Category="Spawning")
@@ -37,6 +84,14 @@ protected:
 	
 	FTimerHandle SpawnTimerHandle;
 
+	// Reuse spawned actors instead of destroying them and spawning new ones
+	UPROPERTY(EditAnywhere, Category="Spawning")
+	bool bUsePool = false;
+
+	// Hidden actors spawned in BeginPlay, ready for the first spawns
+	UPROPERTY(EditAnywhere, Category="Spawning", meta=(EditCondition="bUsePool", ClampMin="0"))
+	int32 PoolPrewarmCount = 0;
+
 		
 private:
 	// Box Component to specify where ammos should be spawned
@@ -48,6 +103,21 @@ private:
 	
 	// Handle spawning a new ammo
 	void Spawn();
+
+	// Every actor in the pool, referenced here so hidden ones aren't garbage collected
+	UPROPERTY()
+	TArray<AActor*> PooledActors;
+
+	TSimPool<AActor> Pool;
+
+	AActor* SpawnNewActor(const FVector& Location, const FRotator& Rotation);
+	void AddToPool(AActor* Actor, bool bActive);
+
+	// Shows or hides the actor, turns its collision and ticking on or off
+	void SetPooledActorActive(AActor* Actor, bool bActive);
+
+	UFUNCTION()
+	void OnPooledActorDestroyed(AActor* DestroyedActor);
 	
 
 };
@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Simulation/SpawnerRegistry.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SpawnerRegistrySubsystem.generated.h"
+
+class ASpawner;
+
+// Spawners of the world by tag (AmmoSpawner, HealthSpawner, EnemySpawner...). Spawners register themselves, so actors
+// find theirs without GetAllActorsOfClass when they begin play.
+UCLASS()
+class FPS_GAME_SIMULATION_API USpawnerRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Adds spawner under each of its tags
+	void RegisterSpawner(ASpawner* Spawner);
+
+	// Removes spawner from each of its tags
+	void UnregisterSpawner(ASpawner* Spawner);
+
+	// The last registered spawner with Tag, null if there is none
+	ASpawner* FindSpawner(FName Tag) const;
+
+	// The spawner that spawned Actor if it has Tag, otherwise the last registered spawner with Tag
+	static ASpawner* FindSpawnerOf(const AActor* Actor, FName Tag);
+
+private:
+	TSpawnerRegistry<ASpawner> Registry;
+
+	static TSpawnerRegistry<ASpawner>::FKey ToKey(FName Tag);
+};
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Simulation/HitscanCore.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WeaponTraceSubsystem.generated.h"
+
+class AEnemy;
+
+// One shot of a hitscan weapon
+struct FWeaponShot
+{
+	FVector Start = FVector::ZeroVector;
+	// Unit vector
+	FVector Direction = FVector::ForwardVector;
+	float Range = 0.f;
+	// Passes through every enemy up to the level geometry instead of stopping at the first one
+	bool bPierce = false;
+	// Actor the shot starts in, usually the shooter
+	const AActor* IgnoredActor = nullptr;
+};
+
+struct FWeaponShotResult
+{
+	// What the shot hit first, an enemy or level geometry. Null for a miss.
+	AActor* FirstHit = nullptr;
+	// Enemies the shot hit, nearest first. At most one unless the shot pierces.
+	TArray<AEnemy*, TInlineAllocator<8>> Enemies;
+};
+
+// Traces hitscan shots. Level geometry is traced by the engine, enemies by FHitscanCore against their capsules, so a
+// shot costs one engine trace whether it pierces or not, and all shots of a frame (players, bots, shotgun pellets)
+// share one enemy hierarchy.
+UCLASS()
+class FPS_GAME_SIMULATION_API UWeaponTraceSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Fills OutResults with one result per shot, in the order of Shots
+	void TraceShots(TArrayView<const FWeaponShot> Shots, TArray<FWeaponShotResult>& OutResults);
+
+private:
+	FHitscanCore HitscanCore;
+	FHitscanResults HitscanResults;
+
+	// Enemies in the hierarchy by capsule index, and the frame they were gathered in
+	UPROPERTY()
+	TArray<AEnemy*> Targets;
+	uint64 TargetsFrame = MAX_uint64;
+
+	TArray<AEnemy*> GatheredTargets;
+	std::vector<FSimCapsule> Capsules;
+	std::vector<FHitscanRay> Rays;
+
+	// Brings the hierarchy up to date with the enemies of this frame
+	void UpdateTargets();
+};
@@ -3,6 +3,8 @@
 
 #include "TP_WeaponComponent.h"
 
+#include "DamageSubsystem.h"
+#include "EffectSubsystem.h"
 #include "Enemy.h"
 #include "FPS_Game_SimulationCharacter.h"
 #include "FPS_Game_SimulationProjectile.h"
@@ -14,6 +16,7 @@
 #include "Camera/CameraComponent.h"
 #include "Engine/SkeletalMeshSocket.h"
 #include "Particles/ParticleSystem.h"
+#include "WeaponTraceSubsystem.h"
 #include "ProfilingDebugging/CookStats.h"
 
 // Sets default values for this component's properties
@@ -39,44 +42,45 @@ void UTP_WeaponComponent::Fire()
 		{
 			bIsTotalAmmoZero = false;
 			// Shooting using line tracing
-			FVector ShootStartLocation = GetChildComponent(1)->GetComponentLocation(); 	// Getting Shoot Point scene component location
-			const FVector ForwardVector = Character->GetFirstPersonCameraComponent()->GetForwardVector();
-			FVector ShootEndLocation = ShootStartLocation + ForwardVector * BulletRange;
-			FCollisionQueryParams QueryParams;
-			FHitResult HitResult;
-			QueryParams.AddIgnoredComponent(this);
-			World->LineTraceSingleByChannel(HitResult, ShootStartLocation, ShootEndLocation,ECC_Camera);
-
-			// If found actor
-			if(HitResult.GetActor())
+			FWeaponShot Shot;
+			Shot.Start = GetChildComponent(1)->GetComponentLocation(); 	// Getting Shoot Point scene component location
+			Shot.Direction = Character->GetFirstPersonCameraComponent()->GetForwardVector();
+			Shot.Range = BulletRange;
+			Shot.bPierce = bHasUsedTalentPierceShot;
+			Shot.IgnoredActor = Character;
+
+			// One trace gives both the first hit and, with pierce shot activated, everything behind it
+			UWeaponTraceSubsystem* WeaponTrace = World->GetSubsystem<UWeaponTraceSubsystem>();
+			TArray<FWeaponShotResult> ShotResults;
+			if(WeaponTrace)
 			{
-				UGameplayStatics::SpawnEmitterAtLocation(World, ExplosionEffect, HitResult.GetActor()->GetActorLocation());
+				WeaponTrace->TraceShots(MakeArrayView(&Shot, 1), ShotResults);
+			}
+
+			// Damage is applied at the end of the frame, an enemy the shot reports twice is hit once
+			UDamageSubsystem* Damage = World->GetSubsystem<UDamageSubsystem>();
+			const uint32 ShotId = Damage ? Damage->NewShot() : FDamageQueueCore::NoShot;
 
-				AEnemy* EnemySingleTraced = Cast<AEnemy>(HitResult.GetActor());
-				// If found actor is enemy, damage
-				if(EnemySingleTraced)
+			for (const FWeaponShotResult& ShotResult : ShotResults)
+			{
+				// If found actor that isn't an enemy
+				if(ShotResult.FirstHit && ShotResult.Enemies.Num() == 0)
 				{
-					EnemySingleTraced->DealDamage(CurrentDamageAmount);
+					UGameplayStatics::SpawnEmitterAtLocation(World, ExplosionEffect, ShotResult.FirstHit->GetActorLocation());
 				}
-			}
 
-			// Pierce shot activated firing
-			if(bHasUsedTalentPierceShot)
-			{
-				TArray<FHitResult> HitResults;
-				World->LineTraceMultiByChannel(HitResults, ShootStartLocation, ShootEndLocation,ECC_Camera);
-				for (FHitResult Hit : HitResults)
+				// Damage every enemy the shot went through
+				for (AEnemy* Enemy : ShotResult.Enemies)
 				{
-					// If found actor
-					if(Hit.GetActor())
+					UGameplayStatics::SpawnEmitterAtLocation(World, ExplosionEffect, Enemy->GetActorLocation());
+					if(Damage && Enemy->GetDamageTarget() != InvalidSimAgent)
 					{
-						UGameplayStatics::SpawnEmitterAtLocation(World, ExplosionEffect, Hit.GetActor()->GetActorLocation());
-						AEnemy* EnemyMultiTraced = Cast<AEnemy>(Hit.GetActor());
-						// If found actor is enemy, damage
-						if(EnemyMultiTraced)
-						{
-							EnemyMultiTraced->DealDamage(CurrentDamageAmount);
-						}
+						Damage->QueueDamage(Enemy->GetDamageTarget(), CurrentDamageAmount, ShotId,
+							Character->GetDamageTarget());
+					}
+					else
+					{
+						Enemy->DealDamage(CurrentDamageAmount);
 					}
 				}
 			}
@@ -134,6 +138,9 @@ void UTP_WeaponComponent::AttachWeapon(AFPS_Game_SimulationCharacter* TargetChar
 	// switch bHasRifle so the animation blueprint can switch to another animation set
 	Character->SetHasRifle(true);
 
+	// Time the talents with all other effects of the world
+	RegisterEffects();
+
 	// Set up action bindings
 	if (APlayerController* PlayerController = Cast<APlayerController>(Character->GetController()))
 	{
@@ -158,6 +165,12 @@ void UTP_WeaponComponent::AttachWeapon(AFPS_Game_SimulationCharacter* TargetChar
 
 void UTP_WeaponComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	if (EffectSubsystem && EffectOwner != InvalidSimAgent)
+	{
+		EffectSubsystem->UnregisterOwner(EffectOwner);
+		EffectOwner = InvalidSimAgent;
+	}
+
 	if (Character == nullptr)
 	{
 		return;
@@ -172,10 +185,44 @@ void UTP_WeaponComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	}
 }
 
+void UTP_WeaponComponent::RegisterEffects()
+{
+	EffectSubsystem = GetWorld()->GetSubsystem<UEffectSubsystem>();
+	if (EffectSubsystem == nullptr || EffectOwner != InvalidSimAgent)
+	{
+		return;
+	}
+
+	float BaseStats[static_cast<int32>(EEffectStat::Num)] = {};
+	BaseStats[static_cast<int32>(EEffectStat::ShotDamage)] = DefaultDamageAmount;
+	BaseStats[static_cast<int32>(EEffectStat::AmmoLimit)] = DefaultAmmoCapacity;
+	BaseStats[static_cast<int32>(EEffectStat::PierceShot)] = 0.f;
+	EffectOwner = EffectSubsystem->RegisterOwner(this, BaseStats);
+
+	FEffectSpec Spec;
+	Spec.Modifier = EEffectModifier::Override;
+	Spec.Stacking = EEffectStacking::Refresh;
+
+	Spec.Stat = static_cast<int32>(EEffectStat::ShotDamage);
+	Spec.Magnitude = TalentDamageIncreaserAmount;
+	Spec.Duration = TalentDamageIncreaserDuration;
+	TalentDamageIncreaserEffect = EffectSubsystem->FindOrAddSpec(Spec);
+
+	Spec.Stat = static_cast<int32>(EEffectStat::AmmoLimit);
+	Spec.Magnitude = TalentCapacityGrowthAmount;
+	Spec.Duration = TalentCapacityGrowthDuration;
+	TalentCapacityGrowthEffect = EffectSubsystem->FindOrAddSpec(Spec);
+
+	Spec.Stat = static_cast<int32>(EEffectStat::PierceShot);
+	Spec.Magnitude = 1.f;
+	Spec.Duration = TalentPierceShotDuration;
+	TalentPierceShotEffect = EffectSubsystem->FindOrAddSpec(Spec);
+}
+
 bool UTP_WeaponComponent::CanUseTalentDamageIncreaser()
 {
 	// Ok player can use the talent
-	if(Character->CurrentLevel >= 5 && Character->CurrentTalentPoints >= 1)
+	if(Character->CurrentLevel >= 5 && Character->CurrentTalentPoints >= 1 && EffectOwner != InvalidSimAgent)
 	{
 		return true;
 	}
@@ -186,7 +233,7 @@ bool UTP_WeaponComponent::CanUseTalentDamageIncreaser()
 bool UTP_WeaponComponent::CanUseTalentCapacityGrowth()
 {
 	// Ok player can use the talent
-	if(Character->CurrentLevel >= 5 && Character->CurrentTalentPoints >= 1)
+	if(Character->CurrentLevel >= 5 && Character->CurrentTalentPoints >= 1 && EffectOwner != InvalidSimAgent)
 	{
 		return true;
 	}
@@ -196,7 +243,7 @@ bool UTP_WeaponComponent::CanUseTalentCapacityGrowth()
 bool UTP_WeaponComponent::CanUseTalentPierceShot()
 {
 	// Ok player can use the talent
-	if(Character->CurrentLevel >= 1 && Character->CurrentTalentPoints >= 3)
+	if(Character->CurrentLevel >= 1 && Character->CurrentTalentPoints >= 3 && EffectOwner != InvalidSimAgent)
 	{
 		return true;
 	}
@@ -209,51 +256,40 @@ void UTP_WeaponComponent::UseTalent(Talents Talent)
 	switch (Talent)
 	{
 	case DamageIncreaser:
-		if(CanUseTalentDamageIncreaser())
+		if(CanUseTalentDamageIncreaser() && EffectSubsystem->ApplyEffect(EffectOwner, TalentDamageIncreaserEffect))
 		{
 			GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Blue, TEXT("DamageIncreaser"));
-			CurrentDamageAmount = TalentDamageIncreaserAmount;
 			Character->TalentInfo = "DamageIncreaser Activated!";
 			Character->CurrentTalentPoints -= 1;
 		}else
 		{
-			Character->TalentInfo = "Can't use right now!!!";
+			ShowTalentRefused(TalentDamageIncreaserDuration);
 		}
-		GetWorld()->GetTimerManager().SetTimer(TalentDamageIncreaserTimerHandle, this,
-			&UTP_WeaponComponent::ResetTalentDamageIncreaser, TalentDamageIncreaserDuration, false);
 		break;
 		
 	case CapacityGrowth:
-		if(CanUseTalentCapacityGrowth())
+		if(CanUseTalentCapacityGrowth() && EffectSubsystem->ApplyEffect(EffectOwner, TalentCapacityGrowthEffect))
 		{
 			GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Blue, TEXT("CapacityGrowth"));
-			CurrentAmmoLimit = TalentCapacityGrowthAmount;
 			Character->TalentInfo = "CapacityGrowth Activated!";
 			Character->CurrentTalentPoints -= 1;
 		}else
 		{
-			Character->TalentInfo = "Can't use right now!!!";
+			ShowTalentRefused(TalentCapacityGrowthDuration);
 		}
-
-		GetWorld()->GetTimerManager().SetTimer(TalentCapacityGrowthTimerHandle, this,
-				&UTP_WeaponComponent::ResetTalentCapacityGrowth, TalentCapacityGrowthDuration, false);
 		break;
 	
 	case PierceShot:
-		if(CanUseTalentPierceShot())
+		if(CanUseTalentPierceShot() && EffectSubsystem->ApplyEffect(EffectOwner, TalentPierceShotEffect))
 		{
 			GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Blue, TEXT("PierceShot"));
 			Character->TalentInfo = "PierceShot Activated!";
-			bHasUsedTalentPierceShot = true;
 			Character->CurrentTalentPoints -= 3;
 		}else
 		{
-			Character->TalentInfo = "Can't use right now!!!";
+			ShowTalentRefused(TalentPierceShotDuration);
 			UE_LOG(LogTemp, Error, TEXT("freeband"))
 		}
-
-		GetWorld()->GetTimerManager().SetTimer(TalentPierceShotTimerHandle, this,
-				&UTP_WeaponComponent::ResetTalentPierceShot, TalentPierceShotDuration, false);
 		break;
 	}
 }
@@ -273,29 +309,40 @@ void UTP_WeaponComponent::TriggerTalentPierceShot()
 	UseTalent(Talents::PierceShot);
 }
 
-void UTP_WeaponComponent::ResetTalentDamageIncreaser()
+void UTP_WeaponComponent::ShowTalentRefused(float Duration)
 {
-	GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Blue, TEXT("ResetTalentDamageIncreaser"));
-	
-	CurrentDamageAmount = DefaultDamageAmount;
-	
-	Character->TalentInfo = "";
+	Character->TalentInfo = "Can't use right now!!!";
+	Character->GetWorldTimerManager().SetTimer(Character->TalentInfoTimerHandle,
+		Character, &AFPS_Game_SimulationCharacter::ResetScreenTalentInfo, Duration, false);
 }
 
-void UTP_WeaponComponent::ResetTalentCapacityGrowth()
+void UTP_WeaponComponent::OnEffectStatsChanged()
 {
-	GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Blue, TEXT("ResetTalentCapacityGrowth"));
-	
-	CurrentAmmoLimit = DefaultAmmoCapacity;
-	CurrentAmmo = DefaultAmmoCapacity;
-
-	Character->TalentInfo = "";
-
+	CurrentDamageAmount = EffectSubsystem->GetStat(EffectOwner, EEffectStat::ShotDamage);
+	CurrentAmmoLimit = FMath::RoundToInt(EffectSubsystem->GetStat(EffectOwner, EEffectStat::AmmoLimit));
+	bHasUsedTalentPierceShot = EffectSubsystem->GetStat(EffectOwner, EEffectStat::PierceShot) > 0.f;
 }
 
-void UTP_WeaponComponent::ResetTalentPierceShot()
+void UTP_WeaponComponent::OnEffectExpired(FEffectSpecId Spec)
 {
-	GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Blue, TEXT("ResetTalentPierceShot"));
-	Character->TalentInfo = "";
-	bHasUsedTalentPierceShot = false;
+	if(Spec == TalentDamageIncreaserEffect)
+	{
+		GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Blue, TEXT("ResetTalentDamageIncreaser"));
+	}
+	else if(Spec == TalentCapacityGrowthEffect)
+	{
+		GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Blue, TEXT("ResetTalentCapacityGrowth"));
+
+		// The ammo limit is back to the default with this frame's stats, so is the ammo
+		CurrentAmmo = DefaultAmmoCapacity;
+	}
+	else if(Spec == TalentPierceShotEffect)
+	{
+		GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Blue, TEXT("ResetTalentPierceShot"));
+	}
+
+	if(Character)
+	{
+		Character->TalentInfo = "";
+	}
 }
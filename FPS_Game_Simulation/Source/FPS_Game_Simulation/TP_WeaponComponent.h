@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Simulation/EffectCore.h"
 #include "TP_WeaponComponent.generated.h"
 
 class AFPS_Game_SimulationCharacter;
@@ -125,18 +126,19 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Talents")
 	int TalentCapacityGrowthAmount = 70;
 
-	// Determines if the character has used their talent
+	// Determines if the character has used their talent, set while the pierce shot effect lasts
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Talents")
 	bool bHasUsedTalentPierceShot = false;
 
-	// The durations and timers of the character's talent
+	// The durations of the character's talent
 	float TalentDamageIncreaserDuration = 6.f;
 	float TalentCapacityGrowthDuration = 10.f;
 	float TalentPierceShotDuration = 5.5f;
-	
-	FTimerHandle TalentDamageIncreaserTimerHandle;
-	FTimerHandle TalentCapacityGrowthTimerHandle;
-	FTimerHandle TalentPierceShotTimerHandle;
+
+	// The talents are effects of the effect subsystem, registered in AttachWeapon
+	FEffectSpecId TalentDamageIncreaserEffect = 0;
+	FEffectSpecId TalentCapacityGrowthEffect = 0;
+	FEffectSpecId TalentPierceShotEffect = 0;
 
 	// Determines whether the character can use the talent
 	bool CanUseTalentDamageIncreaser();
@@ -148,9 +150,24 @@ protected:
 	void TriggerTalentDamageIncreaser();
 	void TriggerTalentCapacityGrowth();
 	void TriggerTalentPierceShot();
-	void ResetTalentDamageIncreaser();
-	void ResetTalentCapacityGrowth();
-	void ResetTalentPierceShot();
-	
-	
+
+	// Registers the weapon with the effect subsystem and its talents as effects
+	void RegisterEffects();
+
+	// Shows a failed talent for as long as the talent would have lasted
+	void ShowTalentRefused(float Duration);
+
+public:
+	// Damage, ammo limit and pierce shot take the stats the talents changed, called by the effect subsystem
+	void OnEffectStatsChanged();
+
+	// Called by the effect subsystem when a talent ran out
+	void OnEffectExpired(FEffectSpecId Spec);
+
+private:
+	// Times the talents of this weapon
+	UPROPERTY()
+	class UEffectSubsystem* EffectSubsystem;
+
+	FSimAgentId EffectOwner = InvalidSimAgent;
 };
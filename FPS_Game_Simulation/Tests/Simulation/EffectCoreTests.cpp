@@ -0,0 +1,237 @@
+#include "Simulation/EffectCore.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+// Ticks of a quarter second so durations and deltas are exact in float
+FEffectConfig TestConfig()
+{
+	FEffectConfig Config;
+	Config.NumStats = 2;
+	Config.EffectsPerOwner = 4;
+	Config.TickSeconds = 0.25f;
+	return Config;
+}
+
+FEffectSpec MakeSpec(EEffectModifier Modifier, float Magnitude, float Duration,
+	EEffectStacking Stacking = EEffectStacking::Refresh, int32_t MaxStacks = 1)
+{
+	FEffectSpec Spec;
+	Spec.Stat = 0;
+	Spec.Modifier = Modifier;
+	Spec.Magnitude = Magnitude;
+	Spec.Duration = Duration;
+	Spec.Stacking = Stacking;
+	Spec.MaxStacks = MaxStacks;
+	return Spec;
+}
+
+const float BaseStats[] = {10.f, 1.f};
+}	 // namespace
+
+TEST(EffectCore, AddAndMultiplyCombineAndUndoOnExpiry)
+{
+	FEffectCore Core(TestConfig());
+	const FEffectSpecId Add = Core.AddSpec(MakeSpec(EEffectModifier::Add, 5.f, 1.f));
+	const FEffectSpecId Multiply = Core.AddSpec(MakeSpec(EEffectModifier::Multiply, 2.f, 2.f));
+	const FSimAgentId Owner = Core.AddOwner(BaseStats);
+
+	ASSERT_TRUE(Core.Apply(Owner, Add));
+	ASSERT_TRUE(Core.Apply(Owner, Multiply));
+	EXPECT_EQ(Core.GetStat(Owner, 0), 10.f) << "stats change on the next Update";
+	Core.Update(0.f);
+	EXPECT_EQ(Core.GetStat(Owner, 0), 30.f);
+	EXPECT_EQ(Core.GetStat(Owner, 1), 1.f);
+
+	Core.Update(1.f);
+	EXPECT_EQ(Core.GetStat(Owner, 0), 20.f);
+	ASSERT_EQ(Core.GetExpired().size(), 1u);
+	EXPECT_EQ(Core.GetExpired()[0].Owner, Owner);
+	EXPECT_EQ(Core.GetExpired()[0].Spec, Add);
+
+	Core.Update(1.f);
+	EXPECT_EQ(Core.GetStat(Owner, 0), 10.f);
+	EXPECT_EQ(Core.GetStats().NumActive, 0);
+}
+
+TEST(EffectCore, MostRecentOverrideWinsUntilItExpires)
+{
+	FEffectCore Core(TestConfig());
+	const FEffectSpecId Add = Core.AddSpec(MakeSpec(EEffectModifier::Add, 5.f, 0.f));
+	const FEffectSpecId Long = Core.AddSpec(MakeSpec(EEffectModifier::Override, 100.f, 2.f));
+	const FEffectSpecId Short = Core.AddSpec(MakeSpec(EEffectModifier::Override, 50.f, 1.f));
+	const FSimAgentId Owner = Core.AddOwner(BaseStats);
+
+	Core.Apply(Owner, Add);
+	Core.Apply(Owner, Long);
+	Core.Apply(Owner, Short);
+	Core.Update(0.f);
+	EXPECT_EQ(Core.GetStat(Owner, 0), 50.f);
+
+	// Falls back to the older override, then to the other modifiers
+	Core.Update(1.f);
+	EXPECT_EQ(Core.GetStat(Owner, 0), 100.f);
+	Core.Update(1.f);
+	EXPECT_EQ(Core.GetStat(Owner, 0), 15.f);
+}
+
+TEST(EffectCore, RefreshingAnOverrideMakesItTheMostRecent)
+{
+	FEffectCore Core(TestConfig());
+	const FEffectSpecId First = Core.AddSpec(MakeSpec(EEffectModifier::Override, 100.f, 2.f));
+	const FEffectSpecId Second = Core.AddSpec(MakeSpec(EEffectModifier::Override, 50.f, 2.f));
+	const FSimAgentId Owner = Core.AddOwner(BaseStats);
+
+	Core.Apply(Owner, First);
+	Core.Apply(Owner, Second);
+	Core.Update(0.f);
+	EXPECT_EQ(Core.GetStat(Owner, 0), 50.f);
+
+	Core.Apply(Owner, First);
+	EXPECT_EQ(Core.Update(0.f), 1);
+	EXPECT_EQ(Core.GetStat(Owner, 0), 100.f);
+	EXPECT_EQ(Core.GetStats().NumRefreshed, 1);
+}
+
+TEST(EffectCore, RefreshRestartsTheOneInstance)
+{
+	FEffectCore Core(TestConfig());
+	const FEffectSpecId Add = Core.AddSpec(MakeSpec(EEffectModifier::Add, 5.f, 1.f));
+	const FSimAgentId Owner = Core.AddOwner(BaseStats);
+
+	Core.Apply(Owner, Add);
+	Core.Update(0.75f);
+	EXPECT_EQ(Core.GetRemainingTime(Owner, Add), 0.25f);
+
+	Core.Apply(Owner, Add);
+	EXPECT_EQ(Core.NumInstances(Owner, Add), 1);
+	EXPECT_EQ(Core.GetRemainingTime(Owner, Add), 1.f);
+
+	// Past where the first application would have run out
+	Core.Update(0.5f);
+	EXPECT_EQ(Core.GetStat(Owner, 0), 15.f);
+	Core.Update(0.5f);
+	EXPECT_EQ(Core.GetStat(Owner, 0), 10.f);
+	EXPECT_EQ(Core.GetStats().NumExpired, 1);
+}
+
+TEST(EffectCore, StackBeyondMaxStacksRestartsTheOneExpiringFirst)
+{
+	FEffectCore Core(TestConfig());
+	const FEffectSpecId Stack = Core.AddSpec(MakeSpec(EEffectModifier::Add, 1.f, 1.f, EEffectStacking::Stack, 3));
+	const FSimAgentId Owner = Core.AddOwner(BaseStats);
+
+	// Applied at ticks 0, 1, 2 and 3, the fourth restarts the first: they run out at ticks 5, 6 and 7
+	for (int32_t Application = 0; Application < 4; ++Application)
+	{
+		ASSERT_TRUE(Core.Apply(Owner, Stack));
+		Core.Update(0.25f);
+	}
+	EXPECT_EQ(Core.NumInstances(Owner, Stack), 3);
+	EXPECT_EQ(Core.GetStat(Owner, 0), 13.f);
+
+	const std::vector<float> StatAtTick = {12.f, 11.f, 10.f};
+	for (int32_t Tick = 0; Tick < static_cast<int32_t>(StatAtTick.size()); ++Tick)
+	{
+		Core.Update(0.25f);
+		EXPECT_EQ(Core.GetStat(Owner, 0), StatAtTick[Tick]) << "at tick " << 5 + Tick;
+	}
+	EXPECT_EQ(Core.NumInstances(Owner, Stack), 0);
+}
+
+TEST(EffectCore, ApplyWithoutAFreeSlotIsRefused)
+{
+	FEffectConfig Config = TestConfig();
+	Config.EffectsPerOwner = 2;
+	FEffectCore Core(Config);
+	const FSimAgentId Owner = Core.AddOwner(BaseStats);
+	const FSimAgentId Other = Core.AddOwner(BaseStats);
+	std::vector<FEffectSpecId> Specs;
+	for (int32_t Spec = 0; Spec < 3; ++Spec)
+	{
+		Specs.push_back(Core.AddSpec(MakeSpec(EEffectModifier::Add, 1.f, 1.f)));
+	}
+
+	EXPECT_TRUE(Core.Apply(Owner, Specs[0]));
+	EXPECT_TRUE(Core.Apply(Owner, Specs[1]));
+	EXPECT_FALSE(Core.Apply(Owner, Specs[2]));
+	// Refreshing doesn't need a slot, and the other owner's slots are its own
+	EXPECT_TRUE(Core.Apply(Owner, Specs[0]));
+	EXPECT_TRUE(Core.Apply(Other, Specs[2]));
+
+	Core.Update(0.f);
+	EXPECT_EQ(Core.GetStats().NumRefused, 1);
+	EXPECT_EQ(Core.GetStats().NumApplied, 3);
+	EXPECT_EQ(Core.GetStat(Owner, 0), 12.f);
+	EXPECT_EQ(Core.GetStat(Other, 0), 11.f);
+}
+
+TEST(EffectCore, OnlyOwnersThatChangedAreRecomputed)
+{
+	FEffectCore Core(TestConfig());
+	const FEffectSpecId Add = Core.AddSpec(MakeSpec(EEffectModifier::Add, 5.f, 1.f));
+	const FEffectSpecId Override = Core.AddSpec(MakeSpec(EEffectModifier::Override, 100.f, 0.f));
+	const FSimAgentId Owner = Core.AddOwner(BaseStats);
+	const FSimAgentId Other = Core.AddOwner(BaseStats);
+
+	Core.Apply(Owner, Add);
+	EXPECT_EQ(Core.Update(0.f), 1);
+	EXPECT_EQ(Core.GetChangedOwners(), std::vector<FSimAgentId>({Owner}));
+	EXPECT_EQ(Core.GetStats().NumRecomputed, 1);
+
+	// Nothing changed, nothing expired
+	EXPECT_EQ(Core.Update(0.25f), 0);
+	EXPECT_EQ(Core.GetStats().NumRecomputed, 0);
+
+	// A base stat set to what it is doesn't count as a change
+	Core.SetBaseStat(Other, 0, 10.f);
+	Core.Update(0.f);
+	EXPECT_EQ(Core.GetStats().NumRecomputed, 0);
+
+	Core.SetBaseStat(Other, 0, 20.f);
+	EXPECT_EQ(Core.Update(0.f), 1);
+	EXPECT_EQ(Core.GetChangedOwners(), std::vector<FSimAgentId>({Other}));
+	EXPECT_EQ(Core.GetStat(Other, 0), 20.f);
+
+	// Under an override the owner is recomputed but comes out the same
+	Core.Apply(Other, Override);
+	Core.Update(0.f);
+	Core.SetBaseStat(Other, 0, 30.f);
+	EXPECT_EQ(Core.Update(0.f), 0);
+	EXPECT_EQ(Core.GetStats().NumRecomputed, 1);
+	EXPECT_EQ(Core.GetStats().NumChanged, 0);
+	EXPECT_EQ(Core.GetStat(Other, 0), 100.f);
+
+	// An expiry recomputes its owner
+	Core.Update(0.75f);
+	EXPECT_EQ(Core.GetChangedOwners(), std::vector<FSimAgentId>({Owner}));
+	EXPECT_EQ(Core.GetStat(Owner, 0), 10.f);
+}
+
+TEST(EffectCore, RemoveAndRemoveOwnerDontExpire)
+{
+	FEffectCore Core(TestConfig());
+	const FEffectSpecId Add = Core.AddSpec(MakeSpec(EEffectModifier::Add, 5.f, 1.f));
+	const FEffectSpecId Multiply = Core.AddSpec(MakeSpec(EEffectModifier::Multiply, 2.f, 1.f));
+	const FSimAgentId Owner = Core.AddOwner(BaseStats);
+	const FSimAgentId Removed = Core.AddOwner(BaseStats);
+
+	Core.Apply(Owner, Add);
+	Core.Apply(Owner, Multiply);
+	Core.Apply(Removed, Add);
+	Core.Update(0.f);
+
+	EXPECT_EQ(Core.Remove(Owner, Multiply), 1);
+	Core.RemoveOwner(Removed);
+	Core.Update(0.f);
+	EXPECT_EQ(Core.GetStat(Owner, 0), 15.f);
+	EXPECT_EQ(Core.GetStats().NumActive, 1);
+
+	Core.Update(1.f);
+	ASSERT_EQ(Core.GetExpired().size(), 1u);
+	EXPECT_EQ(Core.GetExpired()[0].Owner, Owner);
+	EXPECT_EQ(Core.GetExpired()[0].Spec, Add);
+}
@@ -0,0 +1,348 @@
+#include "Simulation/FlowFieldCore.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr uint32_t Unreachable = std::numeric_limits<uint32_t>::max();
+constexpr float CellSize = 100.f;
+
+// Grid of Size x Size cells of 1 m from the origin
+FFlowFieldConfig SmallGrid(int32_t Size, float MaxPathLength = 0.f)
+{
+	FFlowFieldConfig Config;
+	Config.OriginX = 0.f;
+	Config.OriginY = 0.f;
+	Config.CellSize = CellSize;
+	Config.Width = Size;
+	Config.Height = Size;
+	Config.MaxPathLength = MaxPathLength;
+	return Config;
+}
+
+FSimVector CenterOf(int32_t CellX, int32_t CellY)
+{
+	return FSimVector((CellX + 0.5f) * CellSize, (CellY + 0.5f) * CellSize, 0.f);
+}
+
+void BlockCell(FFlowFieldCore& Core, int32_t CellX, int32_t CellY)
+{
+	Core.BlockBox(CellX * CellSize + 1.f, CellY * CellSize + 1.f, (CellX + 1) * CellSize - 1.f,
+		(CellY + 1) * CellSize - 1.f);
+}
+
+bool IsBlocked(const FFlowFieldCore& Core, int32_t CellX, int32_t CellY)
+{
+	return Core.GetCost(CellX, CellY) == FFlowFieldCore::Blocked;
+}
+
+// Cost of stepping from a cell into its neighbour, Unreachable where the core doesn't let agents walk. The target is
+// free to enter, a diagonal step can't cut the corner of a blocked cell.
+uint32_t StepCost(const FFlowFieldCore& Core, int32_t FromX, int32_t FromY, int32_t ToX, int32_t ToY, int32_t TargetX,
+	int32_t TargetY)
+{
+	const int32_t Size = Core.GetConfig().Width;
+	if (ToX < 0 || ToY < 0 || ToX >= Size || ToY >= Size || IsBlocked(Core, FromX, FromY) || IsBlocked(Core, ToX, ToY))
+	{
+		return Unreachable;
+	}
+
+	const bool bDiagonal = FromX != ToX && FromY != ToY;
+	if (bDiagonal && (IsBlocked(Core, ToX, FromY) || IsBlocked(Core, FromX, ToY)))
+	{
+		return Unreachable;
+	}
+	const uint32_t EnterCost = ToX == TargetX && ToY == TargetY ? 1u : Core.GetCost(ToX, ToY);
+	return (bDiagonal ? 14u : 10u) * EnterCost;
+}
+
+// Cheapest path cost from every cell to the target, relaxing every step until nothing changes
+std::vector<uint32_t> ReferenceDistances(const FFlowFieldCore& Core, int32_t TargetX, int32_t TargetY)
+{
+	const int32_t Size = Core.GetConfig().Width;
+	std::vector<uint32_t> Distance(Size * Size, Unreachable);
+	Distance[TargetY * Size + TargetX] = 0;
+
+	for (bool bChanged = true; bChanged;)
+	{
+		bChanged = false;
+		for (int32_t CellY = 0; CellY < Size; ++CellY)
+		{
+			for (int32_t CellX = 0; CellX < Size; ++CellX)
+			{
+				for (int32_t OffsetY = -1; OffsetY <= 1; ++OffsetY)
+				{
+					for (int32_t OffsetX = -1; OffsetX <= 1; ++OffsetX)
+					{
+						const int32_t NextX = CellX + OffsetX;
+						const int32_t NextY = CellY + OffsetY;
+						const uint32_t Step = StepCost(Core, CellX, CellY, NextX, NextY, TargetX, TargetY);
+						if ((OffsetX == 0 && OffsetY == 0) || Step == Unreachable ||
+							Distance[NextY * Size + NextX] == Unreachable)
+						{
+							continue;
+						}
+
+						const uint32_t Through = Distance[NextY * Size + NextX] + Step;
+						if (Through < Distance[CellY * Size + CellX])
+						{
+							Distance[CellY * Size + CellX] = Through;
+							bChanged = true;
+						}
+					}
+				}
+			}
+		}
+	}
+	return Distance;
+}
+
+// Walks the field from a cell to the target's cell, returns the cost of the walk or Unreachable if it takes a step
+// agents can't take or doesn't arrive
+uint32_t FollowField(const FFlowFieldCore& Core, int32_t CellX, int32_t CellY, int32_t TargetX, int32_t TargetY)
+{
+	const int32_t Size = Core.GetConfig().Width;
+	uint32_t Cost = 0;
+	for (int32_t NumSteps = 0; NumSteps < Size * Size; ++NumSteps)
+	{
+		if (CellX == TargetX && CellY == TargetY)
+		{
+			return Cost;
+		}
+
+		const FSimVector Center = CenterOf(CellX, CellY);
+		const FSimVector Direction = Core.Sample(0, Center.X, Center.Y);
+		const int32_t NextX = CellX + (Direction.X > 0.5f ? 1 : Direction.X < -0.5f ? -1 : 0);
+		const int32_t NextY = CellY + (Direction.Y > 0.5f ? 1 : Direction.Y < -0.5f ? -1 : 0);
+		const uint32_t Step = StepCost(Core, CellX, CellY, NextX, NextY, TargetX, TargetY);
+		if (Step == Unreachable || (NextX == CellX && NextY == CellY))
+		{
+			return Unreachable;
+		}
+
+		Cost += Step;
+		CellX = NextX;
+		CellY = NextY;
+	}
+	return Unreachable;
+}
+
+void ExpectStraightAt(const FSimVector& Direction, const FSimVector& From, const FSimVector& Target)
+{
+	const float ToX = Target.X - From.X;
+	const float ToY = Target.Y - From.Y;
+	const float Size = std::sqrt(ToX * ToX + ToY * ToY);
+	EXPECT_NEAR(Direction.X, ToX / Size, 1e-5f);
+	EXPECT_NEAR(Direction.Y, ToY / Size, 1e-5f);
+}
+}	 // namespace
+
+TEST(FlowFieldCore, PathGoesAroundAWall)
+{
+	FFlowFieldCore Core(SmallGrid(10));
+	// Wall along x = 5 from the bottom up to y = 7, the way round is over the top
+	Core.BlockBox(5 * CellSize + 10.f, 0.f, 6 * CellSize - 10.f, 8 * CellSize - 10.f);
+	Core.Update({CenterOf(8, 2)});
+
+	const std::vector<uint32_t> Reference = ReferenceDistances(Core, 8, 2);
+	const uint32_t Cost = FollowField(Core, 2, 2, 8, 2);
+	EXPECT_EQ(Cost, Reference[2 * 10 + 2]);
+	// Straight would be 60, over the wall at least 2 * 40 + 20
+	EXPECT_GE(Cost, 100u);
+
+	// Next to the wall the field leads up, not into it
+	const FSimVector Beside = CenterOf(4, 2);
+	EXPECT_GT(Core.Sample(0, Beside.X, Beside.Y).Y, 0.5f);
+}
+
+TEST(FlowFieldCore, FollowingTheFieldMatchesTheCheapestPathOnRandomGrids)
+{
+	constexpr int32_t Size = 16;
+	std::mt19937 Random(7);
+	std::uniform_int_distribution<int32_t> Cell(0, Size - 1);
+	std::uniform_int_distribution<int32_t> Cost(1, 6);
+	std::bernoulli_distribution IsWall(0.25);
+
+	for (int32_t Grid = 0; Grid < 20; ++Grid)
+	{
+		FFlowFieldCore Core(SmallGrid(Size));
+		const int32_t TargetX = Cell(Random);
+		const int32_t TargetY = Cell(Random);
+		for (int32_t CellY = 0; CellY < Size; ++CellY)
+		{
+			for (int32_t CellX = 0; CellX < Size; ++CellX)
+			{
+				Core.SetCost(CellX, CellY, static_cast<uint8_t>(Cost(Random)));
+				if (IsWall(Random) && (CellX != TargetX || CellY != TargetY))
+				{
+					BlockCell(Core, CellX, CellY);
+				}
+			}
+		}
+
+		const FSimVector Target = CenterOf(TargetX, TargetY);
+		Core.Update({Target});
+		const std::vector<uint32_t> Reference = ReferenceDistances(Core, TargetX, TargetY);
+
+		for (int32_t CellY = 0; CellY < Size; ++CellY)
+		{
+			for (int32_t CellX = 0; CellX < Size; ++CellX)
+			{
+				if (IsBlocked(Core, CellX, CellY))
+				{
+					continue;
+				}
+
+				SCOPED_TRACE(testing::Message() << "grid " << Grid << " cell " << CellX << ", " << CellY);
+				const FSimVector Center = CenterOf(CellX, CellY);
+				if (Reference[CellY * Size + CellX] == Unreachable)
+				{
+					ExpectStraightAt(Core.Sample(0, Center.X, Center.Y), Center, Target);
+				}
+				else
+				{
+					EXPECT_EQ(FollowField(Core, CellX, CellY, TargetX, TargetY), Reference[CellY * Size + CellX]);
+				}
+			}
+		}
+	}
+}
+
+TEST(FlowFieldCore, NoDiagonalThroughABlockedCorner)
+{
+	FFlowFieldCore Core(SmallGrid(10));
+	BlockCell(Core, 5, 4);
+	Core.Update({CenterOf(5, 5)});
+
+	// The diagonal from (4, 4) would graze the corner of (5, 4), the way is up and then right
+	const FSimVector From = CenterOf(4, 4);
+	const FSimVector Direction = Core.Sample(0, From.X, From.Y);
+	EXPECT_FLOAT_EQ(Direction.X, 0.f);
+	EXPECT_FLOAT_EQ(Direction.Y, 1.f);
+
+	// The other diagonal neighbour of the target still goes straight in
+	const FSimVector Other = CenterOf(4, 6);
+	const FSimVector OtherDirection = Core.Sample(0, Other.X, Other.Y);
+	EXPECT_GT(OtherDirection.X, 0.5f);
+	EXPECT_LT(OtherDirection.Y, -0.5f);
+}
+
+TEST(FlowFieldCore, CellUnderTwoBoxesStaysBlockedUntilBothAreGone)
+{
+	FFlowFieldCore Core(SmallGrid(10));
+	Core.SetCost(4, 3, 7);
+	// Boxes over cells 3-4 and 4-5 of row 3
+	const float FirstMinX = 3 * CellSize + 10.f, FirstMaxX = 5 * CellSize - 10.f;
+	const float SecondMinX = 4 * CellSize + 10.f, SecondMaxX = 6 * CellSize - 10.f;
+	const float MinY = 3 * CellSize + 10.f, MaxY = 4 * CellSize - 10.f;
+	Core.BlockBox(FirstMinX, MinY, FirstMaxX, MaxY);
+	Core.BlockBox(SecondMinX, MinY, SecondMaxX, MaxY);
+	Core.Update({CenterOf(0, 0)});
+	const int64_t NumRecomputed = Core.GetNumRecomputed();
+
+	Core.UnblockBox(FirstMinX, MinY, FirstMaxX, MaxY);
+	EXPECT_EQ(Core.GetCost(3, 3), 1);
+	EXPECT_TRUE(IsBlocked(Core, 4, 3));
+	EXPECT_TRUE(IsBlocked(Core, 5, 3));
+	Core.Update({CenterOf(0, 0)});
+	EXPECT_EQ(Core.GetNumRecomputed(), NumRecomputed + 1);
+
+	Core.UnblockBox(SecondMinX, MinY, SecondMaxX, MaxY);
+	EXPECT_EQ(Core.GetCost(4, 3), 7) << "the cost SetCost gave comes back";
+	EXPECT_EQ(Core.GetCost(5, 3), 1);
+
+	// Unblocking again doesn't wrap the count of boxes, a later box still blocks
+	Core.UnblockBox(SecondMinX, MinY, SecondMaxX, MaxY);
+	Core.BlockBox(SecondMinX, MinY, SecondMaxX, MaxY);
+	EXPECT_TRUE(IsBlocked(Core, 4, 3));
+	Core.UnblockBox(SecondMinX, MinY, SecondMaxX, MaxY);
+	EXPECT_EQ(Core.GetCost(4, 3), 7);
+
+	// With nothing changed since, the field isn't recomputed
+	Core.Update({CenterOf(0, 0)});
+	const int64_t AfterUnblock = Core.GetNumRecomputed();
+	Core.Update({CenterOf(0, 0)});
+	EXPECT_EQ(Core.GetNumRecomputed(), AfterUnblock);
+}
+
+TEST(FlowFieldCore, UnreachableCellsHeadStraightAtTheTarget)
+{
+	FFlowFieldCore Core(SmallGrid(10));
+	// A ring of walls round the target's cell
+	for (int32_t CellY = 3; CellY <= 7; ++CellY)
+	{
+		for (int32_t CellX = 3; CellX <= 7; ++CellX)
+		{
+			if (CellX == 3 || CellX == 7 || CellY == 3 || CellY == 7)
+			{
+				BlockCell(Core, CellX, CellY);
+			}
+		}
+	}
+	const FSimVector Target = CenterOf(5, 5) + FSimVector(20.f, -30.f, 0.f);
+	Core.Update({Target});
+
+	for (const FSimVector& From : {CenterOf(0, 0), CenterOf(9, 4), CenterOf(1, 8)})
+	{
+		ExpectStraightAt(Core.Sample(0, From.X, From.Y), From, Target);
+	}
+
+	// Outside of the grid too
+	const FSimVector Outside(-250.f, 420.f, 0.f);
+	ExpectStraightAt(Core.Sample(0, Outside.X, Outside.Y), Outside, Target);
+
+	// Inside the ring the field leads the way
+	const FSimVector Inside = CenterOf(4, 4);
+	const FSimVector Direction = Core.Sample(0, Inside.X, Inside.Y);
+	EXPECT_NEAR(Direction.X, 0.70710678f, 1e-6f);
+	EXPECT_NEAR(Direction.Y, 0.70710678f, 1e-6f);
+}
+
+TEST(FlowFieldCore, CellsBeyondMaxPathLengthHeadStraightAtTheTarget)
+{
+	// 3 m of straight steps
+	FFlowFieldCore Core(SmallGrid(16, 300.f));
+	const FSimVector Target = CenterOf(5, 5);
+	Core.Update({Target});
+
+	// 14 + 10 away follows a step of the grid, 14 + 4 * 10 away doesn't
+	const FSimVector Near = CenterOf(7, 6);
+	const FSimVector NearDirection = Core.Sample(0, Near.X, Near.Y);
+	const bool bStraightStep = NearDirection.X == -1.f && NearDirection.Y == 0.f;
+	const bool bDiagonalStep =
+		std::fabs(NearDirection.X + 0.70710678f) < 1e-6f && std::fabs(NearDirection.Y + 0.70710678f) < 1e-6f;
+	EXPECT_TRUE(bStraightStep || bDiagonalStep) << NearDirection.X << ", " << NearDirection.Y;
+
+	const FSimVector Far = CenterOf(10, 6);
+	ExpectStraightAt(Core.Sample(0, Far.X, Far.Y), Far, Target);
+}
+
+TEST(FlowFieldCore, AgentInABlockedCellStepsOutTowardsTheTarget)
+{
+	FFlowFieldCore Core(SmallGrid(10));
+	BlockCell(Core, 5, 5);
+	// The corner of a block of walls has nowhere to step out to
+	for (int32_t CellY = 0; CellY <= 2; ++CellY)
+	{
+		for (int32_t CellX = 0; CellX <= 2; ++CellX)
+		{
+			BlockCell(Core, CellX, CellY);
+		}
+	}
+	const FSimVector Target = CenterOf(8, 5);
+	Core.Update({Target});
+
+	const FSimVector InWall = CenterOf(5, 5);
+	const FSimVector Direction = Core.Sample(0, InWall.X, InWall.Y);
+	EXPECT_FLOAT_EQ(Direction.X, 1.f);
+	EXPECT_FLOAT_EQ(Direction.Y, 0.f);
+
+	// (0, 0) only has blocked neighbours
+	const FSimVector Enclosed = CenterOf(0, 0);
+	ExpectStraightAt(Core.Sample(0, Enclosed.X, Enclosed.Y), Enclosed, Target);
+}
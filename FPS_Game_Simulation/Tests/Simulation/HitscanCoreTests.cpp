@@ -0,0 +1,358 @@
+#include "Simulation/HitscanCore.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+// Rays closer than this to grazing a capsule, or to reaching one at exactly their length, can go either way in single
+// precision and aren't compared
+constexpr double Ambiguous = 1e-2;
+constexpr float DistanceTolerance = 0.05f;
+
+FSimCapsule MakeCapsule(float X, float Y, float Z, float HalfHeight, float Radius)
+{
+	FSimCapsule Capsule;
+	Capsule.Center = FSimVector(X, Y, Z);
+	Capsule.HalfHeight = HalfHeight;
+	Capsule.Radius = Radius;
+	return Capsule;
+}
+
+FHitscanRay MakeRay(const FSimVector& Start, const FSimVector& Direction, float Length, bool bPierce = false)
+{
+	FHitscanRay Ray;
+	Ray.Start = Start;
+	Ray.Direction = Direction;
+	Ray.Length = Length;
+	Ray.bPierce = bPierce;
+	return Ray;
+}
+
+// Distance of a point to the surface of the capsule, negative inside
+double SignedDistance(const FSimCapsule& Capsule, double X, double Y, double Z)
+{
+	const double Segment = std::max<double>(Capsule.HalfHeight - Capsule.Radius, 0.0);
+	const double DX = X - Capsule.Center.X;
+	const double DY = Y - Capsule.Center.Y;
+	const double DZ = Z - Capsule.Center.Z;
+	const double OffZ = DZ - std::clamp(DZ, -Segment, Segment);
+	return std::sqrt(DX * DX + DY * DY + OffZ * OffZ) - Capsule.Radius;
+}
+
+struct FReferenceHit
+{
+	// Where the ray enters the capsule, negative if it doesn't within its length
+	double Entry = -1.0;
+	bool bAmbiguous = false;
+};
+
+// The distance to a capsule is convex along a line: a ternary search finds the closest approach within the ray's
+// length, a bisection before it the entry. Shares no math with the closed-form tests of FHitscanCore.
+FReferenceHit ReferenceHit(const FSimCapsule& Capsule, const FHitscanRay& Ray)
+{
+	const auto At = [&Capsule, &Ray](double T)
+	{
+		return SignedDistance(Capsule, Ray.Start.X + Ray.Direction.X * T, Ray.Start.Y + Ray.Direction.Y * T,
+			Ray.Start.Z + Ray.Direction.Z * T);
+	};
+
+	FReferenceHit Hit;
+	if (At(0.0) <= 0.0)
+	{
+		Hit.Entry = 0.0;
+		Hit.bAmbiguous = At(0.0) > -Ambiguous;
+		return Hit;
+	}
+
+	double Low = 0.0;
+	double High = Ray.Length;
+	for (int32_t Step = 0; Step < 200; ++Step)
+	{
+		const double Left = Low + (High - Low) / 3.0;
+		const double Right = High - (High - Low) / 3.0;
+		if (At(Left) < At(Right))
+		{
+			High = Right;
+		}
+		else
+		{
+			Low = Left;
+		}
+	}
+	const double Closest = (Low + High) / 2.0;
+	Hit.bAmbiguous = std::fabs(At(Closest)) < Ambiguous;
+	if (At(Closest) > 0.0)
+	{
+		return Hit;
+	}
+
+	Low = 0.0;
+	High = Closest;
+	for (int32_t Step = 0; Step < 200; ++Step)
+	{
+		const double Middle = (Low + High) / 2.0;
+		if (At(Middle) > 0.0)
+		{
+			Low = Middle;
+		}
+		else
+		{
+			High = Middle;
+		}
+	}
+	Hit.Entry = High;
+	Hit.bAmbiguous |= Ray.Length - High < Ambiguous;
+	return Hit;
+}
+
+// Every capsule the ray enters within its length, nearest first. Empty with bAmbiguous set if any capsule is too close
+// to call.
+std::vector<FHitscanHit> BruteForceHits(const std::vector<FSimCapsule>& Capsules, const FHitscanRay& Ray,
+	bool& bAmbiguous)
+{
+	std::vector<FHitscanHit> Hits;
+	bAmbiguous = false;
+	for (int32_t I = 0; I < static_cast<int32_t>(Capsules.size()); ++I)
+	{
+		const FReferenceHit Reference = ReferenceHit(Capsules[I], Ray);
+		bAmbiguous |= Reference.bAmbiguous;
+		if (Reference.Entry >= 0.0)
+		{
+			FHitscanHit Hit;
+			Hit.Target = I;
+			Hit.Distance = static_cast<float>(Reference.Entry);
+			Hits.push_back(Hit);
+		}
+	}
+	std::sort(Hits.begin(), Hits.end(),
+		[](const FHitscanHit& Left, const FHitscanHit& Right) { return Left.Distance < Right.Distance; });
+	return Hits;
+}
+
+std::vector<FHitscanHit> TraceOne(const FHitscanCore& Core, const FHitscanRay& Ray)
+{
+	FHitscanResults Results;
+	Core.Trace(&Ray, 1, Results);
+	return std::vector<FHitscanHit>(Results.GetHits(0), Results.GetHits(0) + Results.NumHits(0));
+}
+
+std::vector<FSimCapsule> RandomCapsules(std::mt19937& Random, int32_t Count)
+{
+	std::uniform_real_distribution<float> Coordinate(-1000.f, 1000.f);
+	std::uniform_real_distribution<float> Radius(10.f, 60.f);
+	std::uniform_real_distribution<float> Stretch(1.f, 3.f);
+	std::vector<FSimCapsule> Capsules;
+	for (int32_t I = 0; I < Count; ++I)
+	{
+		const float CapsuleRadius = Radius(Random);
+		Capsules.push_back(MakeCapsule(Coordinate(Random), Coordinate(Random), Coordinate(Random) * 0.2f,
+			CapsuleRadius * Stretch(Random), CapsuleRadius));
+	}
+	return Capsules;
+}
+
+// Directions spread over the whole sphere, a few of them exactly vertical
+std::vector<FHitscanRay> RandomRays(std::mt19937& Random, int32_t Count, bool bPierce)
+{
+	std::uniform_real_distribution<float> Coordinate(-1000.f, 1000.f);
+	std::normal_distribution<float> Axis(0.f, 1.f);
+	std::vector<FHitscanRay> Rays;
+	for (int32_t I = 0; I < Count; ++I)
+	{
+		FSimVector Direction(0.f, 0.f, I % 2 == 0 ? -1.f : 1.f);
+		if (I % 16 > 1)
+		{
+			Direction = FSimVector(Axis(Random), Axis(Random), Axis(Random) * 0.3f);
+			Direction = Direction * (1.f / std::sqrt(Direction.SizeSquared2D() + Direction.Z * Direction.Z));
+		}
+		const FSimVector Start(Coordinate(Random), Coordinate(Random), Coordinate(Random) * 0.2f);
+		Rays.push_back(MakeRay(Start, Direction, 1500.f, bPierce));
+	}
+	return Rays;
+}
+
+// Compares every unambiguous ray with the brute force, returns how many were compared
+int32_t ExpectMatchesBruteForce(const FHitscanCore& Core, const std::vector<FSimCapsule>& Capsules,
+	const std::vector<FHitscanRay>& Rays)
+{
+	FHitscanResults Results;
+	Core.Trace(Rays.data(), static_cast<int32_t>(Rays.size()), Results);
+
+	int32_t Compared = 0;
+	for (int32_t R = 0; R < static_cast<int32_t>(Rays.size()); ++R)
+	{
+		bool bAmbiguous = false;
+		const std::vector<FHitscanHit> Expected = BruteForceHits(Capsules, Rays[R], bAmbiguous);
+		if (bAmbiguous)
+		{
+			continue;
+		}
+		++Compared;
+
+		const FHitscanHit* Hits = Results.GetHits(R);
+		if (!Rays[R].bPierce)
+		{
+			EXPECT_EQ(Results.NumHits(R), Expected.empty() ? 0 : 1) << "ray " << R;
+			if (Results.NumHits(R) == 1 && !Expected.empty())
+			{
+				EXPECT_NEAR(Hits[0].Distance, Expected[0].Distance, DistanceTolerance) << "ray " << R;
+				// Capsules may overlap, either of two entered at the same distance is the first hit
+				const bool bTie =
+					Expected.size() > 1 && Expected[1].Distance - Expected[0].Distance < DistanceTolerance;
+				EXPECT_TRUE(Hits[0].Target == Expected[0].Target || bTie) << "ray " << R;
+			}
+			continue;
+		}
+
+		EXPECT_EQ(Results.NumHits(R), static_cast<int32_t>(Expected.size())) << "ray " << R;
+		if (Results.NumHits(R) != static_cast<int32_t>(Expected.size()))
+		{
+			continue;
+		}
+		std::vector<int32_t> Targets, ExpectedTargets;
+		for (int32_t H = 0; H < Results.NumHits(R); ++H)
+		{
+			EXPECT_NEAR(Hits[H].Distance, Expected[H].Distance, DistanceTolerance) << "ray " << R << " hit " << H;
+			if (H > 0)
+			{
+				EXPECT_LE(Hits[H - 1].Distance, Hits[H].Distance) << "ray " << R;
+			}
+			Targets.push_back(Hits[H].Target);
+			ExpectedTargets.push_back(Expected[H].Target);
+		}
+		std::sort(Targets.begin(), Targets.end());
+		std::sort(ExpectedTargets.begin(), ExpectedTargets.end());
+		EXPECT_EQ(Targets, ExpectedTargets) << "ray " << R;
+	}
+	return Compared;
+}
+}	 // namespace
+
+TEST(HitscanCore, FirstHitMatchesBruteForce)
+{
+	std::mt19937 Random(7);
+	const std::vector<FSimCapsule> Capsules = RandomCapsules(Random, 300);
+	const std::vector<FHitscanRay> Rays = RandomRays(Random, 400, false);
+	FHitscanCore Core;
+	Core.Build(Capsules);
+
+	EXPECT_GT(ExpectMatchesBruteForce(Core, Capsules, Rays), 380);
+}
+
+TEST(HitscanCore, PierceListMatchesBruteForce)
+{
+	std::mt19937 Random(11);
+	const std::vector<FSimCapsule> Capsules = RandomCapsules(Random, 300);
+	const std::vector<FHitscanRay> Rays = RandomRays(Random, 400, true);
+	FHitscanCore Core;
+	Core.Build(Capsules);
+
+	EXPECT_GT(ExpectMatchesBruteForce(Core, Capsules, Rays), 380);
+}
+
+TEST(HitscanCore, RayStartingInsideHitsAtZero)
+{
+	FHitscanCore Core;
+	Core.Build({MakeCapsule(0.f, 0.f, 0.f, 90.f, 30.f), MakeCapsule(200.f, 0.f, 0.f, 90.f, 30.f)});
+
+	const auto Single = TraceOne(Core, MakeRay(FSimVector(10.f, 0.f, 70.f), FSimVector(1.f, 0.f, 0.f), 1000.f));
+	ASSERT_EQ(Single.size(), 1u);
+	EXPECT_EQ(Single[0].Target, 0);
+	EXPECT_EQ(Single[0].Distance, 0.f);
+
+	const auto Pierce = TraceOne(Core, MakeRay(FSimVector(10.f, 0.f, 70.f), FSimVector(1.f, 0.f, 0.f), 1000.f, true));
+	ASSERT_EQ(Pierce.size(), 2u);
+	EXPECT_EQ(Pierce[0].Target, 0);
+	EXPECT_EQ(Pierce[0].Distance, 0.f);
+	EXPECT_EQ(Pierce[1].Target, 1);
+	// 10 above the segment, so through the hemisphere
+	EXPECT_NEAR(Pierce[1].Distance, 190.f - std::sqrt(30.f * 30.f - 10.f * 10.f), 0.01f);
+}
+
+TEST(HitscanCore, VerticalRaysEnterThroughTheHemispheres)
+{
+	FHitscanCore Core;
+	// Segment between z 40 and 160, radius 40
+	Core.Build({MakeCapsule(0.f, 0.f, 100.f, 100.f, 40.f)});
+
+	const auto Down = TraceOne(Core, MakeRay(FSimVector(0.f, 0.f, 500.f), FSimVector(0.f, 0.f, -1.f), 1000.f));
+	ASSERT_EQ(Down.size(), 1u);
+	EXPECT_NEAR(Down[0].Distance, 300.f, 0.01f);
+
+	// Off the axis the ray meets the top hemisphere lower than its pole
+	const auto OffAxis = TraceOne(Core, MakeRay(FSimVector(24.f, 0.f, 500.f), FSimVector(0.f, 0.f, -1.f), 1000.f));
+	ASSERT_EQ(OffAxis.size(), 1u);
+	EXPECT_NEAR(OffAxis[0].Distance, 500.f - (160.f + 32.f), 0.01f);
+
+	const auto Up = TraceOne(Core, MakeRay(FSimVector(0.f, 24.f, -300.f), FSimVector(0.f, 0.f, 1.f), 1000.f));
+	ASSERT_EQ(Up.size(), 1u);
+	EXPECT_NEAR(Up[0].Distance, 300.f + (40.f - 32.f), 0.01f);
+
+	EXPECT_TRUE(TraceOne(Core, MakeRay(FSimVector(41.f, 0.f, 500.f), FSimVector(0.f, 0.f, -1.f), 1000.f)).empty());
+	EXPECT_TRUE(TraceOne(Core, MakeRay(FSimVector(0.f, 0.f, 500.f), FSimVector(0.f, 0.f, -1.f), 299.f)).empty());
+}
+
+TEST(HitscanCore, HorizontalRayAboveTheSegmentHitsOnlyTheHemisphere)
+{
+	FHitscanCore Core;
+	// Segment between z -60 and 60, radius 40
+	Core.Build({MakeCapsule(0.f, 0.f, 0.f, 100.f, 40.f)});
+
+	// 20 above the segment the hemisphere is sqrt(40^2 - 20^2) wide, the cylinder would be 40
+	const auto Hit = TraceOne(Core, MakeRay(FSimVector(-500.f, 0.f, 80.f), FSimVector(1.f, 0.f, 0.f), 1000.f));
+	ASSERT_EQ(Hit.size(), 1u);
+	EXPECT_NEAR(Hit[0].Distance, 500.f - std::sqrt(40.f * 40.f - 20.f * 20.f), 0.01f);
+
+	const auto Bottom = TraceOne(Core, MakeRay(FSimVector(500.f, 0.f, -99.f), FSimVector(-1.f, 0.f, 0.f), 1000.f));
+	ASSERT_EQ(Bottom.size(), 1u);
+	EXPECT_NEAR(Bottom[0].Distance, 500.f - std::sqrt(40.f * 40.f - 39.f * 39.f), 0.01f);
+
+	EXPECT_TRUE(TraceOne(Core, MakeRay(FSimVector(-500.f, 0.f, 101.f), FSimVector(1.f, 0.f, 0.f), 1000.f)).empty());
+	// Passes the corner of the bounding box, outside of the hemisphere
+	EXPECT_TRUE(TraceOne(Core, MakeRay(FSimVector(-500.f, 35.f, 95.f), FSimVector(1.f, 0.f, 0.f), 1000.f)).empty());
+}
+
+TEST(HitscanCore, RefitFollowsMovedCapsules)
+{
+	std::mt19937 Random(3);
+	std::vector<FSimCapsule> Capsules = RandomCapsules(Random, 200);
+	FHitscanCore Core;
+	Core.Build(Capsules);
+
+	const FHitscanRay AtFirst =
+		MakeRay(Capsules[0].Center - FSimVector(0.f, 0.f, 800.f), FSimVector(0.f, 0.f, 1.f), 1600.f, true);
+	const auto Before = TraceOne(Core, AtFirst);
+	ASSERT_TRUE(std::any_of(Before.begin(), Before.end(), [](const FHitscanHit& Hit) { return Hit.Target == 0; }));
+
+	// Everyone drifts, the first capsule far out of its old leaf's box
+	std::uniform_real_distribution<float> Drift(-150.f, 150.f);
+	for (FSimCapsule& Capsule : Capsules)
+	{
+		Capsule.Center = Capsule.Center + FSimVector(Drift(Random), Drift(Random), Drift(Random) * 0.2f);
+	}
+	Capsules[0].Center = FSimVector(5000.f, 5000.f, 0.f);
+	Core.Refit(Capsules);
+
+	const auto After = TraceOne(Core, AtFirst);
+	EXPECT_TRUE(std::none_of(After.begin(), After.end(), [](const FHitscanHit& Hit) { return Hit.Target == 0; }));
+	const auto Moved =
+		TraceOne(Core, MakeRay(FSimVector(5000.f, 4000.f, 0.f), FSimVector(0.f, 1.f, 0.f), 2000.f));
+	ASSERT_EQ(Moved.size(), 1u);
+	EXPECT_EQ(Moved[0].Target, 0);
+
+	EXPECT_GT(ExpectMatchesBruteForce(Core, Capsules, RandomRays(Random, 200, false)), 190);
+	EXPECT_GT(ExpectMatchesBruteForce(Core, Capsules, RandomRays(Random, 200, true)), 190);
+}
+
+TEST(HitscanCore, EmptyCoreHasNoHits)
+{
+	FHitscanCore Core;
+	Core.Build({});
+
+	EXPECT_TRUE(TraceOne(Core, MakeRay(FSimVector(), FSimVector(1.f, 0.f, 0.f), 1000.f)).empty());
+}
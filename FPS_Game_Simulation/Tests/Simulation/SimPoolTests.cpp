@@ -0,0 +1,168 @@
+#include "Simulation/SimPool.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct Item
+{
+	int32_t Id = 0;
+};
+}	 // namespace
+
+TEST(SimPool, AcquireFromEmptyPoolMisses)
+{
+	TSimPool<Item> Pool;
+
+	EXPECT_EQ(Pool.Acquire(), nullptr);
+	EXPECT_EQ(Pool.GetStats().NumMissed, 1);
+	EXPECT_EQ(Pool.GetStats().NumReused, 0);
+}
+
+TEST(SimPool, AddActiveThenReleaseAndAcquireReusesIt)
+{
+	TSimPool<Item> Pool;
+	Item A;
+
+	ASSERT_TRUE(Pool.Add(&A, true));
+	EXPECT_TRUE(Pool.IsActive(&A));
+	EXPECT_EQ(Pool.NumFree(), 0);
+
+	ASSERT_TRUE(Pool.Release(&A));
+	EXPECT_FALSE(Pool.IsActive(&A));
+	EXPECT_EQ(Pool.NumFree(), 1);
+
+	EXPECT_EQ(Pool.Acquire(), &A);
+	EXPECT_TRUE(Pool.IsActive(&A));
+	EXPECT_EQ(Pool.NumFree(), 0);
+	EXPECT_EQ(Pool.GetStats().NumReused, 1);
+}
+
+TEST(SimPool, AddTwiceIsRefused)
+{
+	TSimPool<Item> Pool;
+	Item A;
+
+	EXPECT_TRUE(Pool.Add(&A, false));
+	EXPECT_FALSE(Pool.Add(&A, true));
+	EXPECT_EQ(Pool.GetStats().NumItems, 1);
+	EXPECT_FALSE(Pool.IsActive(&A));
+}
+
+TEST(SimPool, AcquireHandsOutTheMostRecentlyReleased)
+{
+	TSimPool<Item> Pool;
+	Item A, B, C;
+	Pool.Add(&A, true);
+	Pool.Add(&B, true);
+	Pool.Add(&C, true);
+
+	Pool.Release(&B);
+	Pool.Release(&A);
+	Pool.Release(&C);
+
+	EXPECT_EQ(Pool.Acquire(), &C);
+	EXPECT_EQ(Pool.Acquire(), &A);
+	EXPECT_EQ(Pool.Acquire(), &B);
+}
+
+TEST(SimPool, DoubleReleaseIsRefused)
+{
+	TSimPool<Item> Pool;
+	Item A;
+	Pool.Add(&A, true);
+
+	EXPECT_TRUE(Pool.Release(&A));
+	EXPECT_FALSE(Pool.Release(&A));
+	EXPECT_EQ(Pool.NumFree(), 1);
+	EXPECT_EQ(Pool.GetStats().NumReleased, 1);
+	EXPECT_EQ(Pool.GetStats().NumActive, 0);
+}
+
+TEST(SimPool, ReleaseOfUnknownItemIsRefused)
+{
+	TSimPool<Item> Pool;
+	Item A;
+
+	EXPECT_FALSE(Pool.Release(&A));
+	EXPECT_EQ(Pool.NumFree(), 0);
+	EXPECT_EQ(Pool.GetStats().NumReleased, 0);
+}
+
+TEST(SimPool, ExhaustedPoolMissesUntilAnItemIsReleased)
+{
+	TSimPool<Item> Pool;
+	Item Items[3];
+	for (Item& Each : Items)
+	{
+		Pool.Add(&Each, false);
+	}
+
+	for (int32_t I = 0; I < 3; ++I)
+	{
+		EXPECT_NE(Pool.Acquire(), nullptr);
+	}
+	EXPECT_EQ(Pool.Acquire(), nullptr);
+	EXPECT_EQ(Pool.GetStats().NumMissed, 1);
+
+	Pool.Release(&Items[1]);
+	EXPECT_EQ(Pool.Acquire(), &Items[1]);
+	EXPECT_EQ(Pool.Acquire(), nullptr);
+	EXPECT_EQ(Pool.GetStats().NumMissed, 2);
+}
+
+TEST(SimPool, RemoveFreeItemKeepsTheOthersFree)
+{
+	TSimPool<Item> Pool;
+	Item A, B, C;
+	Pool.Add(&A, false);
+	Pool.Add(&B, false);
+	Pool.Add(&C, false);
+
+	// B sits in the middle of the free list, C is swapped into its place
+	ASSERT_TRUE(Pool.Remove(&B));
+	EXPECT_FALSE(Pool.Contains(&B));
+	EXPECT_EQ(Pool.NumFree(), 2);
+
+	EXPECT_EQ(Pool.Acquire(), &C);
+	EXPECT_EQ(Pool.Acquire(), &A);
+	EXPECT_EQ(Pool.Acquire(), nullptr);
+}
+
+TEST(SimPool, RemoveActiveItem)
+{
+	TSimPool<Item> Pool;
+	Item A;
+	Pool.Add(&A, true);
+
+	ASSERT_TRUE(Pool.Remove(&A));
+	EXPECT_FALSE(Pool.Contains(&A));
+	EXPECT_FALSE(Pool.Release(&A));
+	EXPECT_FALSE(Pool.Remove(&A));
+	EXPECT_EQ(Pool.GetStats().NumItems, 0);
+	EXPECT_EQ(Pool.GetStats().NumActive, 0);
+}
+
+TEST(SimPool, StatsFollowTheItems)
+{
+	TSimPool<Item> Pool;
+	Item Items[4];
+	Pool.Add(&Items[0], true);
+	Pool.Add(&Items[1], true);
+	Pool.Add(&Items[2], true);
+	Pool.Add(&Items[3], false);
+
+	Pool.Release(&Items[0]);
+	Pool.Release(&Items[1]);
+	Pool.Acquire();
+	Pool.Remove(&Items[2]);
+
+	const FSimPoolStats& Stats = Pool.GetStats();
+	EXPECT_EQ(Stats.NumItems, 3);
+	EXPECT_EQ(Stats.NumActive, 1);
+	EXPECT_EQ(Stats.PeakActive, 3);
+	EXPECT_EQ(Stats.NumReused, 1);
+	EXPECT_EQ(Stats.NumMissed, 0);
+	EXPECT_EQ(Stats.NumReleased, 2);
+	EXPECT_EQ(Pool.NumFree(), 2);
+}
@@ -0,0 +1,201 @@
+#include "Simulation/SimTimingWheel.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// Delays either side of where a timer goes one level up
+const std::vector<uint32_t> BoundaryDelays = {
+	1, 2, 62, 63, 64, 65, 127, 128, 4031, 4095, 4096, 4097, 4160, 262143, 262144, 262145, 266305};
+
+// Advances to one tick before the due tick and then onto it, the timer must expire on exactly the second step
+void ExpectExpiresAt(FSimTimingWheel& Wheel, int32_t Timer, uint32_t DueTick)
+{
+	std::vector<int32_t> Expired;
+	Wheel.Advance(DueTick - 1 - Wheel.Now(), Expired);
+	EXPECT_TRUE(Expired.empty()) << "due " << DueTick << " expired early";
+	EXPECT_TRUE(Wheel.IsScheduled(Timer));
+
+	Wheel.Advance(1, Expired);
+	EXPECT_EQ(Expired, std::vector<int32_t>({Timer})) << "due " << DueTick;
+	EXPECT_FALSE(Wheel.IsScheduled(Timer));
+}
+}	 // namespace
+
+TEST(SimTimingWheel, AdvanceWithNothingScheduledJumpsAhead)
+{
+	FSimTimingWheel Wheel;
+	std::vector<int32_t> Expired;
+
+	EXPECT_EQ(Wheel.Advance(1000000, Expired), 0);
+	EXPECT_EQ(Wheel.Now(), 1000000u);
+	EXPECT_TRUE(Expired.empty());
+}
+
+TEST(SimTimingWheel, LevelFollowsTheDelay)
+{
+	// Timers move down once per level they start above level 0, 266305 = 262144 + 4096 + 64 + 1 starts on level 3
+	const std::vector<std::pair<uint32_t, int32_t>> MovesByDelay = {
+		{1, 0}, {63, 0}, {64, 1}, {65, 1}, {4095, 1}, {4096, 1}, {4161, 2}, {262144, 1}, {266305, 3}};
+	for (const auto& [Delay, NumMoves] : MovesByDelay)
+	{
+		FSimTimingWheel Wheel;
+		std::vector<int32_t> Expired;
+		Wheel.Schedule(0, Delay);
+
+		EXPECT_EQ(Wheel.Advance(Delay, Expired), NumMoves) << "delay " << Delay;
+		EXPECT_EQ(Expired, std::vector<int32_t>({0})) << "delay " << Delay;
+	}
+}
+
+TEST(SimTimingWheel, ExpiresOnTheDueTickFromAnyStart)
+{
+	// Starts where the slot index of a level wraps, so the due slot can be one the level passed already, including the
+	// wrap of the tick counter itself
+	const std::vector<uint32_t> Starts = {0, 1, 63, 69, 4000, 4095, 12388, 262143, 16777213, 0xFFFFFFF0u};
+	for (const uint32_t Start : Starts)
+	{
+		for (const uint32_t Delay : BoundaryDelays)
+		{
+			FSimTimingWheel Wheel;
+			std::vector<int32_t> Expired;
+			Wheel.Advance(Start, Expired);
+			ASSERT_EQ(Wheel.Now(), Start);
+
+			Wheel.Schedule(0, Start + Delay);
+			SCOPED_TRACE(testing::Message() << "start " << Start << " delay " << Delay);
+			ExpectExpiresAt(Wheel, 0, Start + Delay);
+		}
+	}
+}
+
+TEST(SimTimingWheel, ExpiresInTickOrderAcrossLevels)
+{
+	FSimTimingWheel Wheel;
+	std::vector<int32_t> Expired;
+	Wheel.Advance(10, Expired);
+
+	// Timer i is due at the i-th delay, scheduled in an order that mixes the levels
+	std::vector<int32_t> Order(BoundaryDelays.size());
+	for (int32_t Timer = 0; Timer < static_cast<int32_t>(Order.size()); ++Timer)
+	{
+		Order[Timer] = (Timer * 7) % static_cast<int32_t>(Order.size());
+	}
+	for (const int32_t Timer : Order)
+	{
+		Wheel.Schedule(Timer, Wheel.Now() + BoundaryDelays[Timer]);
+	}
+	ASSERT_EQ(Wheel.NumScheduled(), static_cast<int32_t>(BoundaryDelays.size()));
+
+	Wheel.Advance(BoundaryDelays.back(), Expired);
+
+	std::vector<int32_t> InTickOrder(BoundaryDelays.size());
+	for (int32_t Timer = 0; Timer < static_cast<int32_t>(InTickOrder.size()); ++Timer)
+	{
+		InTickOrder[Timer] = Timer;
+	}
+	EXPECT_EQ(Expired, InTickOrder);
+	EXPECT_EQ(Wheel.NumScheduled(), 0);
+}
+
+TEST(SimTimingWheel, TimersBeyondMaxDelayWaitOnTheCoarsestLevel)
+{
+	FSimTimingWheel Wheel;
+	const uint32_t Near = FSimTimingWheel::MaxDelay + 1000;
+	const uint32_t Far = 2 * FSimTimingWheel::MaxDelay + 5;
+	Wheel.Schedule(0, Near);
+	Wheel.Schedule(1, Far);
+
+	EXPECT_EQ(Wheel.DueTickOf(0), Near);
+	EXPECT_EQ(Wheel.DueTickOf(1), Far);
+	ExpectExpiresAt(Wheel, 0, Near);
+	ExpectExpiresAt(Wheel, 1, Far);
+}
+
+TEST(SimTimingWheel, TickThatHasPassedIsDueNextTick)
+{
+	FSimTimingWheel Wheel;
+	std::vector<int32_t> Expired;
+	Wheel.Advance(50, Expired);
+
+	Wheel.Schedule(0, 10);
+	Wheel.Schedule(1, Wheel.Now());
+
+	EXPECT_EQ(Wheel.DueTickOf(0), 51u);
+	EXPECT_EQ(Wheel.DueTickOf(1), 51u);
+	Wheel.Advance(1, Expired);
+	std::sort(Expired.begin(), Expired.end());
+	EXPECT_EQ(Expired, std::vector<int32_t>({0, 1}));
+}
+
+TEST(SimTimingWheel, RescheduleWhileLinkedMovesTheTimer)
+{
+	FSimTimingWheel Wheel;
+	std::vector<int32_t> Expired;
+
+	// Sooner, from level 1 to level 0
+	Wheel.Schedule(0, 5000);
+	Wheel.Schedule(0, 10);
+	EXPECT_EQ(Wheel.NumScheduled(), 1);
+	ExpectExpiresAt(Wheel, 0, 10);
+
+	// Nothing is left in the slot it was first linked to, another timer keeps the wheel stepping through it
+	Wheel.Schedule(1, 6000);
+	Wheel.Advance(5000, Expired);
+	EXPECT_TRUE(Expired.empty());
+	Wheel.Cancel(1);
+
+	// Later, from level 0 to level 2, with another timer in the slot it leaves
+	Wheel.Schedule(0, Wheel.Now() + 20);
+	Wheel.Schedule(1, Wheel.Now() + 20);
+	Wheel.Schedule(0, Wheel.Now() + 300000);
+	EXPECT_EQ(Wheel.NumScheduled(), 2);
+	ExpectExpiresAt(Wheel, 1, Wheel.Now() + 20);
+	ExpectExpiresAt(Wheel, 0, Wheel.DueTickOf(0));
+}
+
+TEST(SimTimingWheel, CancelAnywhereInASlotKeepsTheOthers)
+{
+	// Timers of a slot are linked newest first, 2 is the head, 1 in the middle and 0 the tail
+	for (int32_t Cancelled = 0; Cancelled < 3; ++Cancelled)
+	{
+		for (const uint32_t Delay : {30u, 3000u})
+		{
+			FSimTimingWheel Wheel;
+			std::vector<int32_t> Expired;
+			for (int32_t Timer = 0; Timer < 3; ++Timer)
+			{
+				Wheel.Schedule(Timer, Delay);
+			}
+
+			Wheel.Cancel(Cancelled);
+			EXPECT_FALSE(Wheel.IsScheduled(Cancelled));
+			EXPECT_EQ(Wheel.NumScheduled(), 2);
+
+			Wheel.Advance(Delay, Expired);
+			std::sort(Expired.begin(), Expired.end());
+			std::vector<int32_t> Others = {0, 1, 2};
+			Others.erase(Others.begin() + Cancelled);
+			EXPECT_EQ(Expired, Others) << "cancelled " << Cancelled << " delay " << Delay;
+		}
+	}
+}
+
+TEST(SimTimingWheel, CancelOfATimerThatIsNotScheduledDoesNothing)
+{
+	FSimTimingWheel Wheel;
+	std::vector<int32_t> Expired;
+	Wheel.Schedule(0, 5);
+	Wheel.Advance(5, Expired);
+
+	Wheel.Cancel(0);
+	Wheel.Cancel(1);
+	EXPECT_EQ(Wheel.NumScheduled(), 0);
+
+	// Its slot is free to be scheduled again
+	Wheel.Schedule(0, Wheel.Now() + 64);
+	ExpectExpiresAt(Wheel, 0, Wheel.DueTickOf(0));
+}